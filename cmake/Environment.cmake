@@ -138,10 +138,17 @@ if(Python_Development_FOUND)
 	endif()
 	option(Lass_WITH_STUBGEN "Use lass-stubgen to generate Python stubs" "${_Lass_WITH_STUBGEN}")
 
+	option(Lass_WITH_PYTHON_CALL_STATS "Collect call statistics of exported Python functions and methods" OFF)
+	set(LASS_PYTHON_CALL_STATS "${Lass_WITH_PYTHON_CALL_STATS}")
+
+	option(Lass_WITH_PYTHON_PER_INTERPRETER_GIL "Allow lass_python modules in subinterpreters with their own GIL (requires Python 3.13 or later)" OFF)
+	set(LASS_PYTHON_PER_INTERPRETER_GIL "${Lass_WITH_PYTHON_PER_INTERPRETER_GIL}")
+
 endif()
 
 # --- check available headers ---
 
+CHECK_INCLUDE_FILE("execinfo.h" LASS_HAVE_EXECINFO_H)
 CHECK_INCLUDE_FILE("fcntl.h" LASS_HAVE_FCNTL_H)
 CHECK_INCLUDE_FILE("limits.h" LASS_HAVE_LIMITS_H)
 CHECK_INCLUDE_FILE("poll.h" LASS_HAVE_POLL_H)
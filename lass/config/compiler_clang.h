@@ -67,7 +67,7 @@
 #	define LASS_DLL_LOCAL __attribute__ ((visibility ("hidden")))
 #endif
 #define LASS_CALL
-#define LASS_NO_INLINE
+#define LASS_NO_INLINE __attribute__((noinline))
 #define LASS_PER_THREAD __thread
 #define LASS_ALIGN(n) __attribute__((aligned(n)))
 #define LASS_ALIGNED(x, n) x LASS_ALIGN(n)
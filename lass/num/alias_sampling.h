@@ -0,0 +1,353 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_ALIAS_SAMPLING_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_ALIAS_SAMPLING_H
+
+#include "num_common.h"
+#include "impl/parallel.h"
+#include "../prim/point_2d.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  One bin of an alias table: the probability of keeping the bin itself rather than taking the 
+ *  alias, and the pdfs of both, so that a sample only needs to read one bin.
+ */
+template <typename T>
+struct AliasBin
+{
+	T probability;
+	T pdf;
+	T aliasPdf;
+	Tuint32 alias;
+};
+
+/** @internal
+ *  Builds an alias table of @a n bins for @a weights in O(n), using Vose's method.
+ *  @a work must have room for @a n indices.  If all weights are zero, all bins are equally likely.
+ */
+template <typename T>
+void buildAliasTable(const T* weights, size_t n, AliasBin<T>* bins, Tuint32* work)
+{
+	LASS_ASSERT(n > 0);
+	T sum = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		sum += weights[i];
+	}
+	if (!(sum > 0))
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			bins[i] = AliasBin<T>{ 1, 1, 1, static_cast<Tuint32>(i) };
+		}
+		return;
+	}
+
+	// probability holds the residual weight of a bin while it's on the worklist,
+	// with the small ones at the front and the large ones at the back.
+	const T scale = static_cast<T>(n) / sum;
+	size_t numSmall = 0;
+	size_t firstLarge = n;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const T q = weights[i] * scale;
+		bins[i] = AliasBin<T>{ q, q, 0, static_cast<Tuint32>(i) };
+		// branchless, as small or large is anyone's guess for random weights.  Writing to the 
+		// unused slot between small and large ones is harmless.
+		const bool isSmall = q < 1;
+		work[numSmall] = static_cast<Tuint32>(i);
+		work[firstLarge - 1] = static_cast<Tuint32>(i);
+		numSmall += isSmall;
+		firstLarge -= !isSmall;
+	}
+
+	// pair the top small bin with the first large one, until it drops below 1 and becomes small
+	// itself.  Its residual is kept out of memory meanwhile.
+	Tuint32* small = work + numSmall;
+	Tuint32* large = work + firstLarge;
+	Tuint32* const largeEnd = work + n;
+	if (large != largeEnd)
+	{
+		Tuint32 l = *large;
+		T residual = bins[l].probability;
+		while (small != work)
+		{
+			const Tuint32 s = *--small;
+			bins[s].alias = l;
+			residual -= 1 - bins[s].probability;
+			if (residual < 1)
+			{
+				bins[l].probability = residual;
+				*small++ = l;
+				if (++large == largeEnd)
+				{
+					break;
+				}
+				l = *large;
+				residual = bins[l].probability;
+			}
+		}
+	}
+
+	// what's left is 1 but for rounding errors.
+	while (small != work)
+	{
+		bins[*--small].probability = 1;
+	}
+	for (; large != largeEnd; ++large)
+	{
+		bins[*large].probability = 1;
+	}
+	for (size_t i = 0; i < n; ++i)
+	{
+		bins[i].aliasPdf = bins[bins[i].alias].pdf;
+	}
+}
+
+/** @internal
+ *  Picks a bin of an alias table of @a n bins by @a sample in [0, 1], in O(1).
+ *  @param pdf [out] probability density of returned sample
+ *  @param index [out] the picked bin
+ *  @return value between 0 and 1, in bin @a index.
+ */
+template <typename T>
+T sampleAlias(const AliasBin<T>* bins, size_t n, T sample, T& pdf, size_t& index)
+{
+	LASS_ASSERT(n > 0);
+	const T oneMinusEpsilon = 1 - std::numeric_limits<T>::epsilon() / 2;
+	const T scaled = sample * static_cast<T>(n);
+	const size_t i = std::min(static_cast<size_t>(scaled), n - 1);
+	const T frac = std::min(scaled - static_cast<T>(i), oneMinusEpsilon);
+	const AliasBin<T>& bin = bins[i];
+	T x;
+	if (frac < bin.probability)
+	{
+		index = i;
+		pdf = bin.pdf;
+		x = frac / bin.probability;
+	}
+	else
+	{
+		index = bin.alias;
+		pdf = bin.aliasPdf;
+		x = (frac - bin.probability) / (1 - bin.probability);
+	}
+	return std::min((static_cast<T>(index) + x) / static_cast<T>(n), oneMinusEpsilon);
+}
+
+}
+
+
+
+/** Samples a piecewise constant 1D distribution in O(1), using an alias table.
+ *  @ingroup Random
+ *
+ *  Like impl::sampleCdf1D(), it maps a sample from [0, 1] to [0, 1), with the probability density 
+ *  of the bins given by the weights in the constructor, and also returns the pdf and bin index.
+ *  Unlike inverse transform sampling, the mapping isn't monotonic, so it doesn't keep the 
+ *  stratification of low-discrepancy samples as well.
+ *
+ *  <i>M. D. Vose, "A linear algorithm for generating random numbers with a given distribution",
+ *  IEEE Trans. Softw. Eng. 17(9), 1991</i>
+ */
+template <typename T>
+class AliasSampling1D
+{
+public:
+	typedef T TValue;
+
+	AliasSampling1D() {}
+
+	template <typename InputIterator>
+	AliasSampling1D(InputIterator first, InputIterator last)
+	{
+		reset(first, last);
+	}
+
+	template <typename InputIterator>
+	void reset(InputIterator first, InputIterator last)
+	{
+		const TValues weights(first, last);
+		LASS_ENFORCE(!weights.empty() && weights.size() <= std::numeric_limits<Tuint32>::max());
+		bins_.resize(weights.size());
+		std::vector<Tuint32> work(weights.size());
+		impl::buildAliasTable(&weights[0], weights.size(), &bins_[0], &work[0]);
+	}
+
+	size_t size() const
+	{
+		return bins_.size();
+	}
+
+	TValue operator()(TValue in, TValue& pdf, size_t& index) const
+	{
+		LASS_ASSERT(!bins_.empty());
+		return impl::sampleAlias(&bins_[0], bins_.size(), in, pdf, index);
+	}
+
+private:
+	typedef std::vector<TValue> TValues;
+
+	std::vector<impl::AliasBin<TValue>> bins_;
+};
+
+
+
+/** Samples a piecewise constant 2D distribution in O(1), using alias tables.
+ *  @ingroup Random
+ *
+ *  A drop-in for InverseTransformSampling2D, with the same constructor and the same pdf and index
+ *  output.  It picks the u index from the marginal distribution, and the v index from the
+ *  conditional one of that u index, each in constant time instead of by binary search.  Each takes 
+ *  a single bin, so it's one memory access per dimension.  The tables are built in O(uSize * vSize), 
+ *  with the conditional ones in parallel.
+ *
+ *  Unlike inverse transform sampling, the mapping isn't monotonic, so it doesn't keep the
+ *  stratification of low-discrepancy samples as well.
+ */
+template <typename T>
+class AliasSampling2D
+{
+public:
+	typedef T TValue;
+	typedef prim::Point2D<T> TSample;
+	typedef prim::Point2D<size_t> TIndex;
+
+	AliasSampling2D(): uSize_(0), vSize_(0) {}
+
+	template <typename InputIterator>
+	AliasSampling2D(InputIterator first, InputIterator last, size_t uSize, size_t vSize)
+	{
+		reset(first, last, uSize, vSize);
+	}
+
+	template <typename InputIterator>
+	void reset(InputIterator first, InputIterator last, size_t uSize, size_t vSize)
+	{
+		LASS_ENFORCE(uSize > 0 && vSize > 0);
+		LASS_ENFORCE(uSize <= std::numeric_limits<Tuint32>::max() && vSize <= std::numeric_limits<Tuint32>::max());
+		const TValues weights(first, last);
+		LASS_ENFORCE(weights.size() == uSize * vSize);
+		uSize_ = uSize;
+		vSize_ = vSize;
+		buildTables(weights);
+	}
+
+	TSample operator()(const TSample& in, TValue& pdf, TIndex& index) const
+	{
+		LASS_ASSERT(!margU_.empty());
+		TValue pdfU, pdfV;
+		const TValue u = impl::sampleAlias(&margU_[0], uSize_, in.x, pdfU, index.x);
+		const TValue v = impl::sampleAlias(&condV_[index.x * vSize_], vSize_, in.y, pdfV, index.y);
+		pdf = pdfU * pdfV;
+		return TSample(u, v);
+	}
+
+	/** maps @a count samples of the unit square in structure-of-arrays layout, as written by 
+	 *  SobolSequence::generate() or HaltonSequence::generate().  The output may overwrite the input.
+	 */
+	void operator()(size_t count, const TValue* inU, const TValue* inV, TValue* outU, TValue* outV, TValue* pdf) const
+	{
+		for (size_t k = 0; k < count; ++k)
+		{
+			TIndex index;
+			const TSample sample = (*this)(TSample(inU[k], inV[k]), pdf[k], index);
+			outU[k] = sample.x;
+			outV[k] = sample.y;
+		}
+	}
+
+private:
+	typedef std::vector<TValue> TValues;
+	typedef std::vector<impl::AliasBin<TValue>> TBins;
+
+	enum { grainSize = 16384 }; /**< minimum number of cells per parallel task */
+
+	void buildTables(const TValues& weights)
+	{
+		condV_.resize(uSize_ * vSize_);
+		TValues rowWeights(uSize_);
+		const size_t vSize = vSize_;
+		impl::parallelFor(uSize_, std::max<size_t>(grainSize / vSize, 1), [&](size_t begin, size_t end)
+		{
+			std::vector<Tuint32> work(vSize);
+			for (size_t i = begin; i < end; ++i)
+			{
+				const TValue* row = &weights[i * vSize];
+				rowWeights[i] = std::accumulate(row, row + vSize, TValue(0));
+				impl::buildAliasTable(row, vSize, &condV_[i * vSize], &work[0]);
+			}
+		});
+		margU_.resize(uSize_);
+		std::vector<Tuint32> work(uSize_);
+		impl::buildAliasTable(&rowWeights[0], uSize_, &margU_[0], &work[0]);
+	}
+
+	TBins condV_;
+	TBins margU_;
+	size_t uSize_;
+	size_t vSize_;
+};
+
+
+}
+}
+
+#endif
+
+// EOF
@@ -52,6 +52,11 @@
  *  @arg @ref DistributionExponential
  *  @arg @ref DistributionNormal
  *
+ *  bulk generation:
+ *
+ *  @arg @ref fillUniform
+ *  @arg @ref fillNormal
+ *
  *  backwards compatible functions:
  *  
  *  @arg @ref uniform
@@ -65,6 +70,11 @@
 #include "num_common.h"
 #include "num_traits.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
 namespace lass
 {
 namespace num
@@ -207,6 +217,20 @@ T distributeExponential(RandomGenerator& generator, T mean = T(0), T standardDev
 
 
 
+// bulk generation
+
+template <typename RandomGenerator, typename ForwardIterator>
+void fillUniform(RandomGenerator& generator, ForwardIterator first, ForwardIterator last,
+	typename std::iterator_traits<ForwardIterator>::value_type infimum = 0,
+	typename std::iterator_traits<ForwardIterator>::value_type supremum = 1);
+
+template <typename RandomGenerator, typename ForwardIterator>
+void fillNormal(RandomGenerator& generator, ForwardIterator first, ForwardIterator last,
+	typename std::iterator_traits<ForwardIterator>::value_type mean = 0,
+	typename std::iterator_traits<ForwardIterator>::value_type standardDeviation = 1);
+
+
+
 // backwards compatibility functions
 
 template<class T,class RG>
@@ -94,6 +94,49 @@ struct RangePolicy<rtOpen>
 	static bool isInRange(const T& x, const T& inf, const T& sup) { return x > inf && x < sup; }
 };
 
+template <typename RandomGenerator, typename = void>
+struct HasFill: std::false_type {};
+
+template <typename RandomGenerator>
+struct HasFill<RandomGenerator, std::void_t<decltype(std::declval<RandomGenerator&>().fill(
+	static_cast<Tuint64*>(nullptr), static_cast<Tuint64*>(nullptr)))>>: std::true_type {};
+
+/** draws random bits in bulk, by the generator's own fill() if it has one.
+ */
+template <typename RandomGenerator>
+void fillBits(RandomGenerator& generator, Tuint64* first, Tuint64* last)
+{
+	static_assert(RandomGenerator::min() == 0 && RandomGenerator::max() == 0xffffffffffffffff,
+		"bulk generation requires a generator of 64 random bits");
+	if constexpr (HasFill<RandomGenerator>::value)
+	{
+		generator.fill(first, last);
+	}
+	else
+	{
+		for (; first != last; ++first)
+		{
+			*first = generator();
+		}
+	}
+}
+
+/** maps random bits to [0, 1), using as many of the high bits as the mantissa of T can hold.
+ */
+template <typename T>
+T unitFromBits(Tuint64 bits)
+{
+	static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
+	if constexpr (std::numeric_limits<T>::digits < 53)
+	{
+		return static_cast<T>(bits >> 40) * static_cast<T>(0x1.0p-24);
+	}
+	else
+	{
+		return static_cast<T>(static_cast<double>(bits >> 11) * 0x1.0p-53);
+	}
+}
+
 }
 
 
@@ -288,6 +331,86 @@ T distributeNormal(RandomGenerator& generator, T mean, T standardDeviation)
 
 
 
+// --- bulk generation -----------------------------------------------------------------------------
+
+/** @ingroup Distribution
+ *  fills [first, last) with uniform random samples from [infimum, supremum).
+ *
+ *  The random bits are drawn in chunks, by the generator's fill() if it has one, see
+ *  RandomXoshiro256PlusPlusX8.  @a generator must draw 64 random bits, like std::mt19937_64.
+ */
+template <typename RandomGenerator, typename ForwardIterator>
+void fillUniform(RandomGenerator& generator, ForwardIterator first, ForwardIterator last,
+	typename std::iterator_traits<ForwardIterator>::value_type infimum,
+	typename std::iterator_traits<ForwardIterator>::value_type supremum)
+{
+	typedef typename std::iterator_traits<ForwardIterator>::value_type TValue;
+	enum { chunkSize = 256 };
+	Tuint64 bits[chunkSize];
+	const TValue range = supremum - infimum;
+	for (size_t n = static_cast<size_t>(std::distance(first, last)); n > 0; )
+	{
+		const size_t m = std::min<size_t>(n, chunkSize);
+		impl::fillBits(generator, bits, bits + m);
+		for (size_t k = 0; k < m; ++k)
+		{
+			*first++ = infimum + range * impl::unitFromBits<TValue>(bits[k]);
+		}
+		n -= m;
+	}
+}
+
+
+
+/** @ingroup Distribution
+ *  fills [first, last) with normal distributed random samples, using Marsaglia's polar method.
+ *
+ *  The random bits are drawn in chunks, by the generator's fill() if it has one, see
+ *  RandomXoshiro256PlusPlusX8.  @a generator must draw 64 random bits, like std::mt19937_64.
+ */
+template <typename RandomGenerator, typename ForwardIterator>
+void fillNormal(RandomGenerator& generator, ForwardIterator first, ForwardIterator last,
+	typename std::iterator_traits<ForwardIterator>::value_type mean,
+	typename std::iterator_traits<ForwardIterator>::value_type standardDeviation)
+{
+	typedef typename std::iterator_traits<ForwardIterator>::value_type TValue;
+	typedef num::NumTraits<TValue> TNumTraits;
+	enum { chunkSize = 256 };
+	Tuint64 bits[chunkSize];
+	size_t b = chunkSize;
+	TValue values[chunkSize];
+	for (size_t n = static_cast<size_t>(std::distance(first, last)); n > 0; )
+	{
+		const size_t m = std::min<size_t>(n, chunkSize);
+		for (size_t k = 0; k < m; )
+		{
+			if (b == chunkSize)
+			{
+				impl::fillBits(generator, bits, bits + chunkSize);
+				b = 0;
+			}
+			const TValue v1 = 2 * impl::unitFromBits<TValue>(bits[b]) - TNumTraits::one;
+			const TValue v2 = 2 * impl::unitFromBits<TValue>(bits[b + 1]) - TNumTraits::one;
+			b += 2;
+			const TValue rsq = v1 * v1 + v2 * v2;
+			if (rsq >= TNumTraits::one || rsq == TNumTraits::zero)
+			{
+				continue;
+			}
+			const TValue fac = standardDeviation * num::sqrt(-2 * num::log(rsq) / rsq);
+			values[k++] = mean + v1 * fac;
+			if (k < m)
+			{
+				values[k++] = mean + v2 * fac;
+			}
+		}
+		first = std::copy(values, values + m, first);
+		n -= m;
+	}
+}
+
+
+
 // --- backwards compatibility ---------------------------------------------------------------------
 
 /** @ingroup Distribution
@@ -32,6 +32,9 @@
 
 #include "num_common.h"
 #include "num_traits.h"
+#include "impl/partitioned_convolution.h"
+
+#include <type_traits>
 
 namespace lass
 {
@@ -71,6 +74,12 @@ private:
 
 /** Finite Impulse Response filter
  *  @ingroup Filters
+ *
+ *  Short impulse responses are convolved in direct form, at a cost of one multiplication per tap
+ *  per sample. From fftThreshold taps on, only the first few taps are convolved in direct form,
+ *  and the rest by uniformly partitioned overlap-save FFT convolution, at a cost that grows with
+ *  the square root of the number of taps. The output is the same up to rounding, and has no
+ *  latency either way.
  */
 template 
 <	
@@ -91,6 +100,10 @@ public:
 
 	typedef std::vector<T> TValues;
 
+	/** Impulse responses of at least this many taps are convolved by FFT, if T is a floating point type.
+	 */
+	static constexpr size_t fftThreshold = 96;
+
 	FirFilter(const TValues& impulseResponse);
 private:
 	typedef std::vector<size_t> TIndexTable;
@@ -101,6 +114,7 @@ private:
 	TValues taps_;
 	TValues buffer_;
 	TIndexTable nextIndex_;
+	impl::PartitionedConvolution<T> tail_;
 	size_t tapSize_;
 	size_t bufferIndex_;
 };
@@ -167,6 +181,71 @@ private:
 	size_t yBufferIndex_;
 };
 
+
+
+/** Infinite Impulse Response filter as a cascade of second order sections (biquads).
+ *  @ingroup Filters
+ *
+ *  A transfer function of high order is very sensitive to rounding of its coefficients, and the
+ *  direct form of IirFilter easily becomes inaccurate or even unstable. Factored in sections of
+ *  at most second order, each evaluated in transposed direct form II, it remains well behaved.
+ *
+ *  One BiquadFilter can filter several independent channels with the same sections. The input and
+ *  output are then interleaved frames of numChannels() samples each, and the channels of a frame
+ *  are filtered together in a loop that the compiler can run in SIMD lanes.
+ */
+template
+<
+	typename T,
+	typename InputIterator = const T*,
+	typename OutputIterator = T*
+>
+class BiquadFilter: public Filter<T, InputIterator, OutputIterator>
+{
+public:
+	typedef typename Filter<T, InputIterator, OutputIterator>::TValue TValue;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TParam TParam;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TReference TReference;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TConstReference TConstReference;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TInputIterator TInputIterator;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TOutputIterator TOutputIterator;
+	typedef typename Filter<T, InputIterator, OutputIterator>::TNumTraits TNumTraits;
+
+	typedef std::vector<T> TValues;
+	typedef std::pair<TValues, TValues> TValuesPair;
+
+	/** Second order section H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+	 */
+	struct Section
+	{
+		TValue b0, b1, b2;
+		TValue a1, a2;
+	};
+	typedef std::vector<Section> TSections;
+
+	explicit BiquadFilter(const TSections& sections, size_t numChannels = 1);
+	explicit BiquadFilter(const TValuesPair& coefficients, size_t numChannels = 1);
+
+	static BiquadFilter makeButterworthLowPass(unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, size_t numChannels = 1);
+	static BiquadFilter makeButterworthHighPass(unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, size_t numChannels = 1);
+
+	const TSections& sections() const;
+	size_t numChannels() const;
+
+private:
+	TOutputIterator doFilter(TInputIterator first, TInputIterator last, TOutputIterator output) override;
+	void doReset() override;
+
+	void init(const TSections& sections, size_t numChannels);
+	static Section makeSection(const TValuesPair& coefficients);
+	static BiquadFilter doMakeButterworth(unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, size_t numChannels, bool isHighPass);
+
+	TSections sections_;
+	TValues state_;
+	TValues frame_;
+	size_t numChannels_;
+};
+
 }
 
 }
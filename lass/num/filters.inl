@@ -95,7 +95,7 @@ namespace impl
 			den += s;
 		for (unsigned k = 0; k < n / 2; ++k)
 		{
-			const T theta = (TNumTraits::pi * (2 * k + n + 1)) / (2 * n);
+			const T theta = (TNumTraits::pi * static_cast<T>(2 * k + n + 1)) / static_cast<T>(2 * n);
 			den *= s2 - 2 * num::cos(theta) * s + TNumTraits::one;
 		}
 
@@ -130,8 +130,6 @@ namespace impl
 template <typename T, typename InIt, typename OutIt>
 FirFilter<T, InIt, OutIt>::FirFilter(const TValues& impulseResponse):
 	taps_(impulseResponse),
-	buffer_(2 * impulseResponse.size()),
-	nextIndex_(impulseResponse.size()),
 	tapSize_(impulseResponse.size()),
 	bufferIndex_(0)
 {
@@ -140,6 +138,18 @@ FirFilter<T, InIt, OutIt>::FirFilter(const TValues& impulseResponse):
 		LASS_THROW("Cannot use an empty vector as impulse response");
 	}
 
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		if (tapSize_ >= fftThreshold)
+		{
+			tail_ = impl::PartitionedConvolution<T>(impulseResponse, impl::partitionedConvolutionBlockSize(tapSize_));
+			tapSize_ = tail_.blockSize();
+			taps_.resize(tapSize_);
+		}
+	}
+
+	buffer_.resize(2 * tapSize_);
+	nextIndex_.resize(tapSize_);
 	for (size_t i = 0; i < tapSize_; ++i)
 	{
 		nextIndex_[i] = (i - 1 + tapSize_) % tapSize_;
@@ -163,6 +173,13 @@ FirFilter<T, InIt, OutIt>::doFilter(TInputIterator first, TInputIterator last, T
 		{
 			accumulator += taps[i] * buf[i];
 		}
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			if (!tail_.isEmpty())
+			{
+				accumulator += tail_(buf[0]);
+			}
+		}
 		bufferIndex_ = nextIndex_[bufferIndex_];
 		*output++ = accumulator;
 	}
@@ -175,6 +192,10 @@ template <typename T, typename InIt, typename OutIt>
 void FirFilter<T, InIt, OutIt>::doReset()
 {
 	std::fill(buffer_.begin(), buffer_.end(), TNumTraits::zero);
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		tail_.reset();
+	}
 }
 
 
@@ -529,6 +550,269 @@ IirFilter<T, InIt, OutIt> IirFilter<T, InIt, OutIt>::doMakeLaplace(
 		samplingFrequency);
 }
 
+
+
+// --- BiquadFilter --------------------------------------------------------------------------------
+
+/** construct a cascade of second order sections
+ *
+ * @param sections [in] sections to filter with, one after the other.
+ * @param numChannels [in] number of interleaved channels that are filtered independently.
+ */
+template <typename T, typename InIt, typename OutIt>
+BiquadFilter<T, InIt, OutIt>::BiquadFilter(const TSections& sections, size_t numChannels)
+{
+	this->init(sections, numChannels);
+}
+
+
+
+/** construct a single section from a transfer function H(z) of at most second order.
+ *
+ * @param coefficients [in] numerator (=first) and denominator (=second) of H(z), as for IirFilter.
+ * @param numChannels [in] number of interleaved channels that are filtered independently.
+ */
+template <typename T, typename InIt, typename OutIt>
+BiquadFilter<T, InIt, OutIt>::BiquadFilter(const TValuesPair& coefficients, size_t numChannels)
+{
+	this->init(TSections(1, makeSection(coefficients)), numChannels);
+}
+
+
+
+/** make a low-pass butterworth filter, with one section per pair of poles.
+ *
+ *	It has the same transfer function as IirFilter::makeButterworthLowPass.
+ *
+ *	@param order [in] order of filter.  filter rolls of at (order * 6) dB per decade.
+ *	@param cutoffAngularFrequency [in] cutoff frequency measured in radians per sec (w = 2 pi f).
+ *	@param gain [in] DC gain
+ *	@param samplingFrequency [in] sampling frequency of digital signal
+ *	@param numChannels [in] number of interleaved channels that are filtered independently.
+ */
+template <typename T, typename InIt, typename OutIt>
+BiquadFilter<T, InIt, OutIt> BiquadFilter<T, InIt, OutIt>::makeButterworthLowPass(
+		unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, size_t numChannels)
+{
+	return doMakeButterworth(order, cutoffAngularFrequency, gain, samplingFrequency, numChannels, false);
+}
+
+
+
+/** make a high-pass butterworth filter, with one section per pair of poles.
+ *
+ *	It has the same transfer function as IirFilter::makeButterworthHighPass.
+ *
+ *	@param order [in] order of filter.  filter rolls of at (order * 6) dB per decade.
+ *	@param cutoffAngularFrequency [in] cutoff frequency measured in radians per sec (w = 2 pi f).
+ *	@param gain [in] high frequency gain
+ *	@param samplingFrequency [in] sampling frequency of digital signal
+ *	@param numChannels [in] number of interleaved channels that are filtered independently.
+ */
+template <typename T, typename InIt, typename OutIt>
+BiquadFilter<T, InIt, OutIt> BiquadFilter<T, InIt, OutIt>::makeButterworthHighPass(
+		unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, size_t numChannels)
+{
+	return doMakeButterworth(order, cutoffAngularFrequency, gain, samplingFrequency, numChannels, true);
+}
+
+
+
+template <typename T, typename InIt, typename OutIt>
+const typename BiquadFilter<T, InIt, OutIt>::TSections&
+BiquadFilter<T, InIt, OutIt>::sections() const
+{
+	return sections_;
+}
+
+
+
+template <typename T, typename InIt, typename OutIt>
+size_t BiquadFilter<T, InIt, OutIt>::numChannels() const
+{
+	return numChannels_;
+}
+
+
+
+/** If there's more than one channel, the input must be a whole number of frames, or an exception
+ *  is thrown after the complete frames are filtered.
+ */
+template <typename T, typename InIt, typename OutIt>
+typename BiquadFilter<T, InIt, OutIt>::TOutputIterator
+BiquadFilter<T, InIt, OutIt>::doFilter(TInputIterator first, TInputIterator last, TOutputIterator output)
+{
+	const size_t numSections = sections_.size();
+	const Section* const sections = &sections_[0];
+	T* const state = &state_[0];
+
+	if (numChannels_ == 1)
+	{
+		while (first != last)
+		{
+			TValue x = *first++;
+			for (size_t k = 0; k < numSections; ++k)
+			{
+				const Section& section = sections[k];
+				T* const z = state + 2 * k;
+				const TValue y = section.b0 * x + z[0];
+				z[0] = section.b1 * x - section.a1 * y + z[1];
+				z[1] = section.b2 * x - section.a2 * y;
+				x = y;
+			}
+			*output++ = x;
+		}
+		return output;
+	}
+
+	// state is laid out per section as all first delays, followed by all second delays,
+	// so that the channels can be processed in lanes.
+	//
+	const size_t n = numChannels_;
+	T* const frame = &frame_[0];
+	while (first != last)
+	{
+		for (size_t c = 0; c < n; ++c)
+		{
+			if (first == last)
+			{
+				LASS_THROW("Input of BiquadFilter with " << n << " channels is not a whole number of frames");
+			}
+			frame[c] = *first++;
+		}
+		for (size_t k = 0; k < numSections; ++k)
+		{
+			const Section section = sections[k];
+			T* const z0 = state + 2 * k * n;
+			T* const z1 = z0 + n;
+			for (size_t c = 0; c < n; ++c)
+			{
+				const TValue x = frame[c];
+				const TValue y = section.b0 * x + z0[c];
+				z0[c] = section.b1 * x - section.a1 * y + z1[c];
+				z1[c] = section.b2 * x - section.a2 * y;
+				frame[c] = y;
+			}
+		}
+		for (size_t c = 0; c < n; ++c)
+		{
+			*output++ = frame[c];
+		}
+	}
+	return output;
+}
+
+
+
+template <typename T, typename InIt, typename OutIt>
+void BiquadFilter<T, InIt, OutIt>::doReset()
+{
+	std::fill(state_.begin(), state_.end(), TNumTraits::zero);
+}
+
+
+
+template <typename T, typename InIt, typename OutIt>
+void BiquadFilter<T, InIt, OutIt>::init(const TSections& sections, size_t numChannels)
+{
+	if (sections.empty())
+	{
+		LASS_THROW("Cannot use an empty vector of sections");
+	}
+	if (numChannels == 0)
+	{
+		LASS_THROW("Cannot filter zero channels");
+	}
+	sections_ = sections;
+	numChannels_ = numChannels;
+	state_.resize(2 * sections_.size() * numChannels_);
+	frame_.resize(numChannels_);
+	this->reset();
+}
+
+
+
+/** little private helper
+ */
+template <typename T, typename InIt, typename OutIt>
+typename BiquadFilter<T, InIt, OutIt>::Section
+BiquadFilter<T, InIt, OutIt>::makeSection(const TValuesPair& coefficients)
+{
+	const TValues& numerator = coefficients.first;
+	const TValues& denominator = coefficients.second;
+	if (numerator.empty() || denominator.empty())
+	{
+		LASS_THROW("Cannot use an empty vector as numerator or denominator");
+	}
+	if (numerator.size() > 3 || denominator.size() > 3)
+	{
+		LASS_THROW("Cannot use more than three coefficients in numerator or denominator of a second order section");
+	}
+	if (denominator[0] == TNumTraits::zero)
+	{
+		LASS_THROW("Cannot use a zero as first element in the denominator");
+	}
+
+	const TValue scaler = num::inv(denominator[0]);
+	auto coefficient = [scaler](const TValues& values, size_t i)
+	{
+		return i < values.size() ? scaler * values[i] : TNumTraits::zero;
+	};
+	Section section;
+	section.b0 = coefficient(numerator, 0);
+	section.b1 = coefficient(numerator, 1);
+	section.b2 = coefficient(numerator, 2);
+	section.a1 = coefficient(denominator, 1);
+	section.a2 = coefficient(denominator, 2);
+	return section;
+}
+
+
+
+/** little private helper
+ *
+ *  The poles of the Laplace transfer function are paired in quadratic factors, the same as
+ *  impl::laplaceButterworthLowPass does, and each is transformed to a section of its own.
+ *  The high-pass is the low-pass with s replaced by cutoff^2 / s, which mirrors the factors.
+ */
+template <typename T, typename InIt, typename OutIt>
+BiquadFilter<T, InIt, OutIt> BiquadFilter<T, InIt, OutIt>::doMakeButterworth(
+		unsigned order, TParam cutoffAngularFrequency, TParam gain, TParam samplingFrequency, 
+		size_t numChannels, bool isHighPass)
+{
+	if (order == 0)
+	{
+		LASS_THROW("Cannot make a butterworth filter of order zero");
+	}
+
+	const TValue zero = TNumTraits::zero;
+	const TValue one = TNumTraits::one;
+	const TValue s = num::inv(cutoffAngularFrequency);
+	const TValue s2 = num::sqr(s);
+
+	TSections sections;
+	for (unsigned k = 0; k < order / 2; ++k)
+	{
+		const TValue theta = (TNumTraits::pi * static_cast<TValue>(2 * k + order + 1)) / static_cast<TValue>(2 * order);
+		const TValue num[] = { isHighPass ? zero : one, zero, isHighPass ? s2 : zero };
+		const TValue den[] = { one, -2 * num::cos(theta) * s, s2 };
+		sections.push_back(makeSection(impl::laplaceToZ(num, num + 3, den, den + 3, samplingFrequency)));
+	}
+	if (order % 2 == 1)
+	{
+		const TValue num[] = { isHighPass ? zero : one, isHighPass ? s : zero };
+		const TValue den[] = { one, s };
+		sections.push_back(makeSection(impl::laplaceToZ(num, num + 2, den, den + 2, samplingFrequency)));
+	}
+
+	Section& first = sections.front();
+	first.b0 *= gain;
+	first.b1 *= gain;
+	first.b2 *= gain;
+
+	return BiquadFilter(sections, numChannels);
+}
+
 }
 
 }
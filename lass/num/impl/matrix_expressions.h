@@ -61,6 +61,7 @@ class MStorage
 {
 public:
 	enum { lvalue = true };
+	enum { parallel = true };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef typename util::CallTraits<T>::TParam TParam;
 	typedef typename util::CallTraits<T>::TReference TReference;
@@ -91,6 +92,8 @@ public:
 
 	typename std::vector<T>::iterator rowMajor() { return storage_.begin(); } 
 	typename std::vector<T>::const_iterator rowMajor() const { return storage_.begin(); } 
+	T* data() { return storage_.data(); }
+	const T* data() const { return storage_.data(); }
 
 private:
 	std::vector<T> storage_;
@@ -105,6 +108,7 @@ class MScalar
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = true };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef typename util::CallTraits<T>::TParam TParam;
 	typedef size_t TSize;
@@ -144,6 +148,7 @@ class LASS_CONCATENATE(M, i_name)\
 {\
 public:\
 	enum { lvalue = false };\
+	enum { parallel = Operand1::parallel && Operand2::parallel };\
 	typedef typename util::CallTraits<T>::TValue TValue;\
 	typedef size_t TSize;\
 	LASS_CONCATENATE(M, i_name)(const Operand1& iA, const Operand2& iB):\
@@ -175,6 +180,7 @@ class LASS_CONCATENATE(M, i_name)\
 {\
 public:\
 	enum { lvalue = false };\
+	enum { parallel = Operand1::parallel };\
 	typedef typename util::CallTraits<T>::TValue TValue;\
 	typedef size_t TSize;\
 	LASS_CONCATENATE(M, i_name)(const Operand1& iA):\
@@ -204,6 +210,7 @@ class MProd
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = Operand1::parallel && Operand2::parallel };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef size_t TSize;
 	MProd(const Operand1& iA, const Operand2& iB):
@@ -222,6 +229,8 @@ public:
 	}
 	TSize rows() const { return operand1_.rows(); }
 	TSize columns() const { return operand2_.columns(); }
+	const Operand1& operand1() const { return operand1_; }
+	const Operand2& operand2() const { return operand2_; }
 private:
 	typename MatrixExpressionTraits<Operand1>::TStorage operand1_;
 	typename MatrixExpressionTraits<Operand2>::TStorage operand2_;
@@ -237,6 +246,7 @@ class MTrans
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = Operand1::parallel };
 	typedef typename util::CallTraits<T>::TParam TParam;
 	typedef size_t TSize;
 	MTrans(const Operand1& iA): operand1_(iA) {}
@@ -258,6 +268,7 @@ class MFun
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = false }; // user functions may not be thread safe
 	typedef T (*TOperator)(T);
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef size_t TSize;
@@ -274,6 +285,34 @@ private:
 
 
 
+/** @internal
+ *  Resizes @a dest to the size of @a source and assigns it element by element.
+ */
+template <typename Dest, typename Source>
+void evaluateElements(Dest& dest, const Source& source)
+{
+	const size_t m = source.rows();
+	const size_t n = source.columns();
+	dest.resize(m, n);
+	for (size_t i = 0; i < m; ++i)
+	{
+		for (size_t j = 0; j < n; ++j)
+		{
+			dest(i, j) = source(i, j);
+		}
+	}
+}
+
+/** @internal
+ *  Assigns matrix expression @a source to storage @a dest, resizing it first.
+ *  Overloaded for expressions that have a faster way to be evaluated, like MProd.
+ */
+template <typename Dest, typename Source>
+void evaluate(Dest& dest, const Source& source)
+{
+	evaluateElements(dest, source);
+}
+
 }
 
 }
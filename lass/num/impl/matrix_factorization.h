@@ -0,0 +1,98 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_FACTORIZATION_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_FACTORIZATION_H
+
+#include "../num_common.h"
+
+#include <cstddef>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Column block size of the blocked factorizations. Panels of this width are factorized 
+ *  element by element, the trailing matrix is updated with gemm().
+ */
+constexpr size_t factorizationBlockSize = 64;
+
+template <typename T>
+void trsmLower(size_t n, size_t nrhs, const T* l, size_t ldl, T* b, size_t ldb, bool unitDiagonal);
+
+template <typename T>
+void trsmUpper(size_t n, size_t nrhs, const T* u, size_t ldu, T* b, size_t ldb);
+
+template <typename T>
+bool luFactorize(T* a, size_t n, size_t* pivots, int& sign);
+
+template <typename T>
+void luSolve(const T* lu, size_t n, const size_t* pivots, T* b, size_t nrhs);
+
+template <typename T>
+bool choleskyFactorize(T* a, size_t n);
+
+template <typename T>
+void choleskySolve(const T* llh, size_t n, T* b, size_t nrhs);
+
+template <typename T>
+void qrFactorize(T* a, size_t m, size_t n, T* tau);
+
+template <typename T>
+void qrApplyAdjoint(const T* qr, size_t m, size_t n, const T* tau, T* b, size_t nrhs);
+
+}
+
+}
+
+}
+
+#include "matrix_factorization.inl"
+
+#endif
+
+// EOF
@@ -0,0 +1,548 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_FACTORIZATION_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_FACTORIZATION_INL
+
+#include "../num_common.h"
+#include "../num_traits.h"
+#include "matrix_factorization.h"
+#include "matrix_gemm.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** Solves L X = B in place, for a lower triangular @a n x @a n matrix L.
+ *  @internal
+ *  @param l [in] row major L with leading dimension @a ldl. Only the lower triangle is read.
+ *  @param b [in,out] row major @a n x @a nrhs matrix B with leading dimension @a ldb, replaced by X.
+ *  @param unitDiagonal [in] if true, the diagonal of L is assumed to be one and is not read.
+ *
+ *  Method: forward substitution on blocks of rows, the remaining rows are updated with gemm().
+ */
+template <typename T>
+void trsmLower(size_t n, size_t nrhs, const T* l, size_t ldl, T* b, size_t ldb, bool unitDiagonal)
+{
+	for (size_t k0 = 0; k0 < n; k0 += factorizationBlockSize)
+	{
+		const size_t k1 = std::min(k0 + factorizationBlockSize, n);
+		for (size_t i = k0; i < k1; ++i)
+		{
+			const T* li = l + i * ldl;
+			T* bi = b + i * ldb;
+			for (size_t p = k0; p < i; ++p)
+			{
+				const T lip = li[p];
+				const T* bp = b + p * ldb;
+				for (size_t j = 0; j < nrhs; ++j)
+				{
+					bi[j] -= lip * bp[j];
+				}
+			}
+			if (!unitDiagonal)
+			{
+				const T inv = T(1) / li[i];
+				for (size_t j = 0; j < nrhs; ++j)
+				{
+					bi[j] *= inv;
+				}
+			}
+		}
+		if (k1 < n)
+		{
+			gemm(n - k1, nrhs, k1 - k0, T(-1), l + k1 * ldl + k0, ldl, b + k0 * ldb, ldb, T(1), b + k1 * ldb, ldb);
+		}
+	}
+}
+
+
+
+/** Solves U X = B in place, for an upper triangular @a n x @a n matrix U.
+ *  @internal
+ *  @param u [in] row major U with leading dimension @a ldu. Only the upper triangle is read.
+ *  @param b [in,out] row major @a n x @a nrhs matrix B with leading dimension @a ldb, replaced by X.
+ *
+ *  Method: backward substitution on blocks of rows, the remaining rows are updated with gemm().
+ */
+template <typename T>
+void trsmUpper(size_t n, size_t nrhs, const T* u, size_t ldu, T* b, size_t ldb)
+{
+	for (size_t k1 = n; k1 > 0; )
+	{
+		const size_t k0 = k1 > factorizationBlockSize ? k1 - factorizationBlockSize : 0;
+		for (size_t i = k1; i-- > k0; )
+		{
+			const T* ui = u + i * ldu;
+			T* bi = b + i * ldb;
+			for (size_t p = i + 1; p < k1; ++p)
+			{
+				const T uip = ui[p];
+				const T* bp = b + p * ldb;
+				for (size_t j = 0; j < nrhs; ++j)
+				{
+					bi[j] -= uip * bp[j];
+				}
+			}
+			const T inv = T(1) / ui[i];
+			for (size_t j = 0; j < nrhs; ++j)
+			{
+				bi[j] *= inv;
+			}
+		}
+		if (k0 > 0)
+		{
+			gemm(k0, nrhs, k1 - k0, T(-1), u + k0, ldu, b + k0 * ldb, ldb, T(1), b, ldb);
+		}
+		k1 = k0;
+	}
+}
+
+
+
+/** Replaces a square matrix A by the LU decomposition of a row wise permutation of itself.
+ *  @internal
+ *  @param a [in,out] 
+ *		@arg row major @a n x @a n matrix A.
+ *		@arg replaced by the unit lower triangular L (without its diagonal) and upper triangular U.
+ *  @param pivots [out]
+ *		@arg row @a j was interchanged with row @a pivots[j], in order of increasing @a j.
+ *		@arg [pivots, pivots + n) must be a valid range.
+ *  @param sign [out]
+ *		@arg indicates the number of row interchanges was even (+1) or odd (-1).
+ *  @return - true: LU decomposition completed
+ *          - false: matrix A is singular
+ *
+ *  L, U and @a pivots are in the same format as ludecomp(), so they can be used by lusolve() and 
+ *  lumprove() as well.
+ *
+ *  Method: right-looking blocked LU with partial pivoting. Each panel of factorizationBlockSize 
+ *  columns is factorized element by element, after which U of the panel rows is found with 
+ *  trsmLower() and the trailing matrix is updated with gemm(). Row interchanges are applied to 
+ *  whole rows at once.
+ */
+template <typename T>
+bool luFactorize(T* a, size_t n, size_t* pivots, int& sign)
+{
+	typedef typename NumTraits<T>::baseType TBase;
+
+	sign = 1;
+	for (size_t k0 = 0; k0 < n; k0 += factorizationBlockSize)
+	{
+		const size_t k1 = std::min(k0 + factorizationBlockSize, n);
+		for (size_t j = k0; j < k1; ++j)
+		{
+			size_t p = j;
+			TBase normMax = num::norm(a[j * n + j]);
+			for (size_t i = j + 1; i < n; ++i)
+			{
+				const TBase temp = num::norm(a[i * n + j]);
+				if (temp > normMax)
+				{
+					normMax = temp;
+					p = i;
+				}
+			}
+			pivots[j] = p;
+			if (!(normMax > 0))
+			{
+				return false;
+			}
+
+			T* rowJ = a + j * n;
+			if (p != j)
+			{
+				std::swap_ranges(rowJ, rowJ + n, a + p * n);
+				sign = -sign;
+			}
+
+			const T inv = T(1) / rowJ[j];
+			for (size_t i = j + 1; i < n; ++i)
+			{
+				T* rowI = a + i * n;
+				const T lij = (rowI[j] *= inv);
+				for (size_t c = j + 1; c < k1; ++c)
+				{
+					rowI[c] -= lij * rowJ[c];
+				}
+			}
+		}
+		if (k1 < n)
+		{
+			trsmLower(k1 - k0, n - k1, a + k0 * n + k0, n, a + k0 * n + k1, n, true);
+			gemm(n - k1, n - k1, k1 - k0, T(-1), a + k1 * n + k0, n, a + k0 * n + k1, n, T(1), a + k1 * n + k1, n);
+		}
+	}
+	return true;
+}
+
+
+
+/** Solves A X = B in place, using the decomposition of luFactorize().
+ *  @internal
+ *  @param b [in,out] row major @a n x @a nrhs matrix B, replaced by X.
+ */
+template <typename T>
+void luSolve(const T* lu, size_t n, const size_t* pivots, T* b, size_t nrhs)
+{
+	for (size_t j = 0; j < n; ++j)
+	{
+		if (pivots[j] != j)
+		{
+			std::swap_ranges(b + j * nrhs, b + (j + 1) * nrhs, b + pivots[j] * nrhs);
+		}
+	}
+	trsmLower(n, nrhs, lu, n, b, nrhs, true);
+	trsmUpper(n, nrhs, lu, n, b, nrhs);
+}
+
+
+
+/** Replaces a hermitian positive definite matrix A by its Cholesky decomposition A = L L^H.
+ *  @internal
+ *  @param a [in,out]
+ *		@arg row major @a n x @a n matrix A. Only the lower triangle is read.
+ *		@arg replaced by L in the lower triangle, and L^H in the upper triangle (they share the diagonal).
+ *  @return - true: Cholesky decomposition completed
+ *          - false: matrix A is not positive definite
+ *
+ *  Method: right-looking blocked Cholesky. Each panel of factorizationBlockSize columns is 
+ *  factorized element by element, after which the lower triangle of the trailing matrix is 
+ *  updated with gemm(), one block of rows at a time.
+ */
+template <typename T>
+bool choleskyFactorize(T* a, size_t n)
+{
+	typedef typename NumTraits<T>::baseType TBase;
+
+	std::vector<T> panelAdjoint;
+	for (size_t k0 = 0; k0 < n; k0 += factorizationBlockSize)
+	{
+		const size_t k1 = std::min(k0 + factorizationBlockSize, n);
+		const size_t kb = k1 - k0;
+		for (size_t j = k0; j < k1; ++j)
+		{
+			T* rowJ = a + j * n;
+			TBase d = std::real(rowJ[j]);
+			for (size_t p = k0; p < j; ++p)
+			{
+				d -= num::norm(rowJ[p]);
+			}
+			if (!(d > 0))
+			{
+				return false;
+			}
+			const TBase ljj = num::sqrt(d);
+			const TBase inv = TBase(1) / ljj;
+			rowJ[j] = ljj;
+			for (size_t i = j + 1; i < n; ++i)
+			{
+				T* rowI = a + i * n;
+				T sum = rowI[j];
+				for (size_t p = k0; p < j; ++p)
+				{
+					sum -= rowI[p] * num::conj(rowJ[p]);
+				}
+				rowI[j] = sum * inv;
+			}
+		}
+
+		const size_t m2 = n - k1;
+		if (m2 == 0)
+		{
+			continue;
+		}
+		panelAdjoint.resize(kb * m2);
+		for (size_t i = 0; i < m2; ++i)
+		{
+			const T* l = a + (k1 + i) * n + k0;
+			for (size_t p = 0; p < kb; ++p)
+			{
+				panelAdjoint[p * m2 + i] = num::conj(l[p]);
+			}
+		}
+		for (size_t i0 = 0; i0 < m2; i0 += factorizationBlockSize)
+		{
+			const size_t i1 = std::min(i0 + factorizationBlockSize, m2);
+			gemm(i1 - i0, i1, kb, T(-1), a + (k1 + i0) * n + k0, n, panelAdjoint.data(), m2, 
+				T(1), a + (k1 + i0) * n + k1, n);
+		}
+	}
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t j = i + 1; j < n; ++j)
+		{
+			a[i * n + j] = num::conj(a[j * n + i]);
+		}
+	}
+	return true;
+}
+
+
+
+/** Solves A X = B in place, using the decomposition of choleskyFactorize().
+ *  @internal
+ *  @param b [in,out] row major @a n x @a nrhs matrix B, replaced by X.
+ */
+template <typename T>
+void choleskySolve(const T* llh, size_t n, T* b, size_t nrhs)
+{
+	trsmLower(n, nrhs, llh, n, b, nrhs, false);
+	trsmUpper(n, nrhs, llh, n, b, nrhs);
+}
+
+
+
+/** Replaces a matrix A by its QR decomposition A = Q R, with Q = H_0 H_1 ... H_{k-1}.
+ *  @internal
+ *  @param a [in,out]
+ *		@arg row major @a m x @a n matrix A.
+ *		@arg replaced by R in the upper triangle, and the Householder vectors v_j below the diagonal.
+ *  @param tau [out]
+ *		@arg scalar factors of the Householder reflections H_j = I - tau[j] v_j v_j^H, 
+ *			with v_j[j] = 1 and v_j[i] = 0 for i < j.
+ *		@arg [tau, tau + min(m, n)) must be a valid range.
+ *
+ *  Method: blocked Householder QR. Each panel of factorizationBlockSize columns is factorized
+ *  column by column, after which its reflections are accumulated in the compact WY form 
+ *  I - V T V^H, and applied to the trailing matrix with gemm().
+ */
+template <typename T>
+void qrFactorize(T* a, size_t m, size_t n, T* tau)
+{
+	typedef typename NumTraits<T>::baseType TBase;
+
+	const size_t kMax = std::min(m, n);
+	std::vector<T> w, v, vAdjoint, vv, t;
+	for (size_t k0 = 0; k0 < kMax; k0 += factorizationBlockSize)
+	{
+		const size_t k1 = std::min(k0 + factorizationBlockSize, kMax);
+		const size_t kb = k1 - k0;
+		for (size_t j = k0; j < k1; ++j)
+		{
+			// find H_j so that H_j^H a[j:m, j] = (beta, 0, ..., 0)
+			T* rowJ = a + j * n;
+			const T alpha = rowJ[j];
+			TBase xnorm2 = 0;
+			for (size_t i = j + 1; i < m; ++i)
+			{
+				xnorm2 += num::norm(a[i * n + j]);
+			}
+			if (xnorm2 == 0 && std::imag(alpha) == 0)
+			{
+				tau[j] = T();
+				continue;
+			}
+			TBase beta = num::sqrt(num::norm(alpha) + xnorm2);
+			if (std::real(alpha) > 0)
+			{
+				beta = -beta;
+			}
+			tau[j] = (beta - alpha) / beta;
+			const T scale = T(1) / (alpha - beta);
+			for (size_t i = j + 1; i < m; ++i)
+			{
+				a[i * n + j] *= scale;
+			}
+			rowJ[j] = beta;
+
+			// apply H_j^H = I - conj(tau) v v^H to the remaining columns of the panel
+			if (j + 1 == k1)
+			{
+				continue;
+			}
+			w.assign(rowJ + j + 1, rowJ + k1);
+			for (size_t i = j + 1; i < m; ++i)
+			{
+				const T* rowI = a + i * n;
+				const T vi = num::conj(rowI[j]);
+				for (size_t c = j + 1; c < k1; ++c)
+				{
+					w[c - j - 1] += vi * rowI[c];
+				}
+			}
+			const T tauConj = num::conj(tau[j]);
+			for (size_t c = j + 1; c < k1; ++c)
+			{
+				w[c - j - 1] *= tauConj;
+				rowJ[c] -= w[c - j - 1];
+			}
+			for (size_t i = j + 1; i < m; ++i)
+			{
+				T* rowI = a + i * n;
+				const T vi = rowI[j];
+				for (size_t c = j + 1; c < k1; ++c)
+				{
+					rowI[c] -= vi * w[c - j - 1];
+				}
+			}
+		}
+
+		if (k1 == n)
+		{
+			continue;
+		}
+
+		// H_k0 ... H_k1-1 = I - V T V^H, with V explicit and T upper triangular.
+		const size_t mv = m - k0;
+		const size_t n2 = n - k1;
+		v.assign(mv * kb, T());
+		vAdjoint.assign(kb * mv, T());
+		for (size_t i = 0; i < mv; ++i)
+		{
+			const T* rowI = a + (k0 + i) * n + k0;
+			for (size_t p = 0; p < kb && p <= i; ++p)
+			{
+				const T x = p == i ? T(1) : rowI[p];
+				v[i * kb + p] = x;
+				vAdjoint[p * mv + i] = num::conj(x);
+			}
+		}
+		vv.resize(kb * kb);
+		gemm(kb, kb, mv, T(1), vAdjoint.data(), mv, v.data(), kb, T(0), vv.data(), kb);
+		t.assign(kb * kb, T());
+		for (size_t i = 0; i < kb; ++i)
+		{
+			const T tauI = tau[k0 + i];
+			for (size_t r = 0; r < i; ++r)
+			{
+				T sum = T();
+				for (size_t q = r; q < i; ++q)
+				{
+					sum += t[r * kb + q] * vv[q * kb + i];
+				}
+				t[r * kb + i] = -tauI * sum;
+			}
+			t[i * kb + i] = tauI;
+		}
+
+		// a[k0:m, k1:n] -= V (T^H (V^H a[k0:m, k1:n]))
+		T* a2 = a + k0 * n + k1;
+		w.resize(kb * n2);
+		gemm(kb, n2, mv, T(1), vAdjoint.data(), mv, a2, n, T(0), w.data(), n2);
+		for (size_t r = kb; r-- > 0; )
+		{
+			// T^H is lower triangular, so going bottom up, row r can be replaced in place.
+			T* wr = &w[r * n2];
+			const T trr = num::conj(t[r * kb + r]);
+			for (size_t c = 0; c < n2; ++c)
+			{
+				wr[c] *= trr;
+			}
+			for (size_t q = 0; q < r; ++q)
+			{
+				const T tqr = num::conj(t[q * kb + r]);
+				const T* wq = &w[q * n2];
+				for (size_t c = 0; c < n2; ++c)
+				{
+					wr[c] += tqr * wq[c];
+				}
+			}
+		}
+		gemm(mv, n2, kb, T(-1), v.data(), kb, w.data(), n2, T(1), a2, n);
+	}
+}
+
+
+
+/** Replaces B by Q^H B, using the decomposition of qrFactorize().
+ *  @internal
+ *  @param b [in,out] row major @a m x @a nrhs matrix B.
+ */
+template <typename T>
+void qrApplyAdjoint(const T* qr, size_t m, size_t n, const T* tau, T* b, size_t nrhs)
+{
+	const size_t kMax = std::min(m, n);
+	std::vector<T> w(nrhs);
+	for (size_t j = 0; j < kMax; ++j)
+	{
+		if (tau[j] == T())
+		{
+			continue;
+		}
+		T* rowJ = b + j * nrhs;
+		std::copy(rowJ, rowJ + nrhs, w.begin());
+		for (size_t i = j + 1; i < m; ++i)
+		{
+			const T vi = num::conj(qr[i * n + j]);
+			const T* rowI = b + i * nrhs;
+			for (size_t c = 0; c < nrhs; ++c)
+			{
+				w[c] += vi * rowI[c];
+			}
+		}
+		const T tauConj = num::conj(tau[j]);
+		for (size_t c = 0; c < nrhs; ++c)
+		{
+			w[c] *= tauConj;
+			rowJ[c] -= w[c];
+		}
+		for (size_t i = j + 1; i < m; ++i)
+		{
+			const T vi = qr[i * n + j];
+			T* rowI = b + i * nrhs;
+			for (size_t c = 0; c < nrhs; ++c)
+			{
+				rowI[c] -= vi * w[c];
+			}
+		}
+	}
+}
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,497 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "lass_common.h"
+#include "matrix_gemm.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <vector>
+
+#if LASS_HAVE_AVX
+#	include <immintrin.h>
+#endif
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+namespace
+{
+
+/** Register and cache blocking per scalar type.
+ *  A mr x nr tile of C is kept in registers by the microkernel. A packed kc x nr panel of B 
+ *  should stay in L1, a packed mc x kc block of A in L2, and a packed kc x nc block of B in L3.
+ */
+template <typename T> struct GemmBlocking;
+
+template <>
+struct GemmBlocking<double>
+{
+	constexpr static size_t mr = 6;
+	constexpr static size_t nr = 8;
+	constexpr static size_t kc = 256;
+	constexpr static size_t mc = 120;
+	constexpr static size_t nc = 2048;
+};
+
+template <>
+struct GemmBlocking<float>
+{
+	constexpr static size_t mr = 6;
+	constexpr static size_t nr = 16;
+	constexpr static size_t kc = 256;
+	constexpr static size_t mc = 120;
+	constexpr static size_t nc = 4096;
+};
+
+/** Below this number of multiply-adds, a product isn't worth splitting over threads.
+ */
+constexpr size_t parallelThreshold = 128 * 128 * 128;
+
+inline size_t roundUp(size_t x, size_t multiple)
+{
+	return (x + multiple - 1) / multiple * multiple;
+}
+
+
+
+/** Copies @a mc x @a kc block of alpha * A to micro-panels of mr rows, stored column by column.
+ *  Rows past @a mc are padded with zeros, so that the microkernel needs no edge cases.
+ */
+template <typename T>
+void packA(size_t mc, size_t kc, T alpha, const T* a, size_t lda, T* packed)
+{
+	constexpr size_t mr = GemmBlocking<T>::mr;
+	for (size_t ir = 0; ir < mc; ir += mr)
+	{
+		const size_t m = std::min(mr, mc - ir);
+		for (size_t i = 0; i < mr; ++i)
+		{
+			T* dest = packed + i;
+			if (i < m)
+			{
+				const T* row = a + (ir + i) * lda;
+				if (alpha == 1)
+				{
+					for (size_t p = 0; p < kc; ++p)
+					{
+						dest[p * mr] = row[p];
+					}
+				}
+				else
+				{
+					for (size_t p = 0; p < kc; ++p)
+					{
+						dest[p * mr] = alpha * row[p];
+					}
+				}
+			}
+			else
+			{
+				for (size_t p = 0; p < kc; ++p)
+				{
+					dest[p * mr] = T();
+				}
+			}
+		}
+		packed += mr * kc;
+	}
+}
+
+
+
+/** Copies @a kc x @a nc block of B to micro-panels of nr columns, stored row by row.
+ *  Columns past @a nc are padded with zeros.
+ */
+template <typename T>
+void packB(size_t kc, size_t nc, const T* b, size_t ldb, T* packed)
+{
+	constexpr size_t nr = GemmBlocking<T>::nr;
+	for (size_t jr = 0; jr < nc; jr += nr)
+	{
+		const size_t n = std::min(nr, nc - jr);
+		for (size_t p = 0; p < kc; ++p)
+		{
+			const T* row = b + p * ldb + jr;
+			std::copy(row, row + n, packed);
+			std::fill(packed + n, packed + nr, T());
+			packed += nr;
+		}
+	}
+}
+
+
+
+/** Computes a full mr x nr tile C (+)= A * B from packed micro-panels.
+ *  Portable version, written so that the compiler can keep the tile in registers.
+ */
+template <typename T>
+void microKernel(size_t kc, const T* a, const T* b, T* c, size_t ldc, bool accumulate)
+{
+	constexpr size_t mr = GemmBlocking<T>::mr;
+	constexpr size_t nr = GemmBlocking<T>::nr;
+	T ab[mr * nr] = {};
+	for (size_t p = 0; p < kc; ++p)
+	{
+		for (size_t i = 0; i < mr; ++i)
+		{
+			const T ai = a[i];
+			for (size_t j = 0; j < nr; ++j)
+			{
+				ab[i * nr + j] += ai * b[j];
+			}
+		}
+		a += mr;
+		b += nr;
+	}
+	for (size_t i = 0; i < mr; ++i)
+	{
+		T* row = c + i * ldc;
+		for (size_t j = 0; j < nr; ++j)
+		{
+			row[j] = accumulate ? row[j] + ab[i * nr + j] : ab[i * nr + j];
+		}
+	}
+}
+
+#if LASS_HAVE_AVX
+
+inline __m256d multiplyAdd(__m256d a, __m256d b, __m256d c)
+{
+#if defined(__FMA__) || defined(__AVX2__)
+	return _mm256_fmadd_pd(a, b, c);
+#else
+	return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+#if defined(__FMA__) || defined(__AVX2__)
+	return _mm256_fmadd_ps(a, b, c);
+#else
+	return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+inline void storeRow(double* c, __m256d c0, __m256d c1, bool accumulate)
+{
+	if (accumulate)
+	{
+		c0 = _mm256_add_pd(c0, _mm256_loadu_pd(c));
+		c1 = _mm256_add_pd(c1, _mm256_loadu_pd(c + 4));
+	}
+	_mm256_storeu_pd(c, c0);
+	_mm256_storeu_pd(c + 4, c1);
+}
+
+inline void storeRow(float* c, __m256 c0, __m256 c1, bool accumulate)
+{
+	if (accumulate)
+	{
+		c0 = _mm256_add_ps(c0, _mm256_loadu_ps(c));
+		c1 = _mm256_add_ps(c1, _mm256_loadu_ps(c + 8));
+	}
+	_mm256_storeu_ps(c, c0);
+	_mm256_storeu_ps(c + 8, c1);
+}
+
+/** 6 x 8 tile of doubles in twelve AVX registers.
+ */
+template <>
+void microKernel<double>(size_t kc, const double* a, const double* b, double* c, size_t ldc, bool accumulate)
+{
+	__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+	__m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+	__m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+	__m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+	__m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+	__m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+	for (size_t p = 0; p < kc; ++p)
+	{
+		const __m256d b0 = _mm256_loadu_pd(b);
+		const __m256d b1 = _mm256_loadu_pd(b + 4);
+		__m256d ai = _mm256_broadcast_sd(a);
+		c00 = multiplyAdd(ai, b0, c00);
+		c01 = multiplyAdd(ai, b1, c01);
+		ai = _mm256_broadcast_sd(a + 1);
+		c10 = multiplyAdd(ai, b0, c10);
+		c11 = multiplyAdd(ai, b1, c11);
+		ai = _mm256_broadcast_sd(a + 2);
+		c20 = multiplyAdd(ai, b0, c20);
+		c21 = multiplyAdd(ai, b1, c21);
+		ai = _mm256_broadcast_sd(a + 3);
+		c30 = multiplyAdd(ai, b0, c30);
+		c31 = multiplyAdd(ai, b1, c31);
+		ai = _mm256_broadcast_sd(a + 4);
+		c40 = multiplyAdd(ai, b0, c40);
+		c41 = multiplyAdd(ai, b1, c41);
+		ai = _mm256_broadcast_sd(a + 5);
+		c50 = multiplyAdd(ai, b0, c50);
+		c51 = multiplyAdd(ai, b1, c51);
+		a += 6;
+		b += 8;
+	}
+	storeRow(c, c00, c01, accumulate);
+	storeRow(c + ldc, c10, c11, accumulate);
+	storeRow(c + 2 * ldc, c20, c21, accumulate);
+	storeRow(c + 3 * ldc, c30, c31, accumulate);
+	storeRow(c + 4 * ldc, c40, c41, accumulate);
+	storeRow(c + 5 * ldc, c50, c51, accumulate);
+}
+
+/** 6 x 16 tile of floats in twelve AVX registers.
+ */
+template <>
+void microKernel<float>(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate)
+{
+	__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+	__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+	__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+	__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+	__m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+	__m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+	for (size_t p = 0; p < kc; ++p)
+	{
+		const __m256 b0 = _mm256_loadu_ps(b);
+		const __m256 b1 = _mm256_loadu_ps(b + 8);
+		__m256 ai = _mm256_broadcast_ss(a);
+		c00 = multiplyAdd(ai, b0, c00);
+		c01 = multiplyAdd(ai, b1, c01);
+		ai = _mm256_broadcast_ss(a + 1);
+		c10 = multiplyAdd(ai, b0, c10);
+		c11 = multiplyAdd(ai, b1, c11);
+		ai = _mm256_broadcast_ss(a + 2);
+		c20 = multiplyAdd(ai, b0, c20);
+		c21 = multiplyAdd(ai, b1, c21);
+		ai = _mm256_broadcast_ss(a + 3);
+		c30 = multiplyAdd(ai, b0, c30);
+		c31 = multiplyAdd(ai, b1, c31);
+		ai = _mm256_broadcast_ss(a + 4);
+		c40 = multiplyAdd(ai, b0, c40);
+		c41 = multiplyAdd(ai, b1, c41);
+		ai = _mm256_broadcast_ss(a + 5);
+		c50 = multiplyAdd(ai, b0, c50);
+		c51 = multiplyAdd(ai, b1, c51);
+		a += 6;
+		b += 16;
+	}
+	storeRow(c, c00, c01, accumulate);
+	storeRow(c + ldc, c10, c11, accumulate);
+	storeRow(c + 2 * ldc, c20, c21, accumulate);
+	storeRow(c + 3 * ldc, c30, c31, accumulate);
+	storeRow(c + 4 * ldc, c40, c41, accumulate);
+	storeRow(c + 5 * ldc, c50, c51, accumulate);
+}
+
+#endif
+
+
+
+/** C (+)= alpha * A * B for a @a mc x @a kc block of A and a packed @a kc x @a nc block of B.
+ *  Packs A in a buffer per thread, and runs the microkernel over all tiles of C.
+ *  Partial tiles at the edges are computed in a temporary tile first.
+ */
+template <typename T>
+void gemmBlock(size_t mc, size_t nc, size_t kc, T alpha, const T* a, size_t lda, const T* bPacked, 
+	T* c, size_t ldc, bool accumulate)
+{
+	constexpr size_t mr = GemmBlocking<T>::mr;
+	constexpr size_t nr = GemmBlocking<T>::nr;
+
+	thread_local std::vector<T> aPacked;
+	aPacked.resize(roundUp(mc, mr) * kc);
+	packA(mc, kc, alpha, a, lda, aPacked.data());
+
+	for (size_t jr = 0; jr < nc; jr += nr)
+	{
+		const size_t n = std::min(nr, nc - jr);
+		const T* bPanel = bPacked + jr * kc;
+		for (size_t ir = 0; ir < mc; ir += mr)
+		{
+			const size_t m = std::min(mr, mc - ir);
+			const T* aPanel = aPacked.data() + ir * kc;
+			T* cTile = c + ir * ldc + jr;
+			if (m == mr && n == nr)
+			{
+				microKernel(kc, aPanel, bPanel, cTile, ldc, accumulate);
+				continue;
+			}
+			T tile[mr * nr];
+			microKernel(kc, aPanel, bPanel, tile, nr, false);
+			for (size_t i = 0; i < m; ++i)
+			{
+				T* row = cTile + i * ldc;
+				for (size_t j = 0; j < n; ++j)
+				{
+					row[j] = accumulate ? row[j] + tile[i * nr + j] : tile[i * nr + j];
+				}
+			}
+		}
+	}
+}
+
+
+
+template <typename T>
+void scale(size_t m, size_t n, T beta, T* c, size_t ldc)
+{
+	for (size_t i = 0; i < m; ++i)
+	{
+		T* row = c + i * ldc;
+		if (beta == 0)
+		{
+			std::fill(row, row + n, T()); // don't propagate NaNs in C
+		}
+		else
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				row[j] *= beta;
+			}
+		}
+	}
+}
+
+
+
+template <typename T>
+void gemmImpl(size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, 
+	T beta, T* c, size_t ldc)
+{
+	typedef GemmBlocking<T> TBlocking;
+
+	if (m == 0 || n == 0)
+	{
+		return;
+	}
+	if (k == 0 || alpha == 0)
+	{
+		if (beta != 1)
+		{
+			scale(m, n, beta, c, ldc);
+		}
+		return;
+	}
+	if (beta != 0 && beta != 1)
+	{
+		scale(m, n, beta, c, ldc);
+	}
+
+	const bool parallel = m > TBlocking::mc && m * n * k >= parallelThreshold;
+
+	std::vector<T> bPacked(TBlocking::kc * roundUp(std::min(n, TBlocking::nc), TBlocking::nr));
+	for (size_t jc = 0; jc < n; jc += TBlocking::nc)
+	{
+		const size_t nc = std::min(TBlocking::nc, n - jc);
+		for (size_t pc = 0; pc < k; pc += TBlocking::kc)
+		{
+			const size_t kc = std::min(TBlocking::kc, k - pc);
+			const bool accumulate = pc > 0 || beta != 0;
+			packB(kc, nc, b + pc * ldb + jc, ldb, bPacked.data());
+			const T* bp = bPacked.data();
+			const auto blocks = [=](size_t begin, size_t end)
+			{
+				for (size_t ib = begin; ib < end; ++ib)
+				{
+					const size_t ic = ib * TBlocking::mc;
+					const size_t mc = std::min(TBlocking::mc, m - ic);
+					gemmBlock(mc, nc, kc, alpha, a + ic * lda + pc, lda, bp, c + ic * ldc + jc, ldc, accumulate);
+				}
+			};
+			const size_t numberOfBlocks = (m + TBlocking::mc - 1) / TBlocking::mc;
+			if (parallel)
+			{
+				parallelFor(numberOfBlocks, 1, blocks); // returns before bPacked is overwritten
+			}
+			else
+			{
+				blocks(0, numberOfBlocks);
+			}
+		}
+	}
+}
+
+}
+
+
+
+void gemm(size_t m, size_t n, size_t k, const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc)
+{
+	gemmImpl(m, n, k, 1.f, a, lda, b, ldb, 0.f, c, ldc);
+}
+
+
+
+void gemm(size_t m, size_t n, size_t k, float alpha, const float* a, size_t lda, const float* b, size_t ldb, 
+	float beta, float* c, size_t ldc)
+{
+	gemmImpl(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+
+
+void gemm(size_t m, size_t n, size_t k, const double* a, size_t lda, const double* b, size_t ldb, double* c, size_t ldc)
+{
+	gemmImpl(m, n, k, 1., a, lda, b, ldb, 0., c, ldc);
+}
+
+
+
+void gemm(size_t m, size_t n, size_t k, double alpha, const double* a, size_t lda, const double* b, size_t ldb, 
+	double beta, double* c, size_t ldc)
+{
+	gemmImpl(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+}
+
+}
+
+}
+
+// EOF
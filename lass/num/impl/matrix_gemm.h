@@ -0,0 +1,163 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_GEMM_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_MATRIX_GEMM_H
+
+#include "../num_common.h"
+#include "matrix_expressions.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  C = A * B for dense row major matrices: A is @a m x @a k, B is @a k x @a n, C is @a m x @a n.
+ *
+ *  A and B are copied in cache sized blocks to packed buffers, that are fed to a register
+ *  blocked microkernel (AVX if LASS_HAVE_AVX). Large products are split over a ThreadPool.
+ *  C may not overlap A or B.
+ */
+LASS_DLL void LASS_CALL gemm(size_t m, size_t n, size_t k, const float* a, size_t lda, 
+	const float* b, size_t ldb, float* c, size_t ldc);
+
+/** @internal
+ *  @copydoc gemm(size_t, size_t, size_t, const float*, size_t, const float*, size_t, float*, size_t)
+ */
+LASS_DLL void LASS_CALL gemm(size_t m, size_t n, size_t k, const double* a, size_t lda,
+	const double* b, size_t ldb, double* c, size_t ldc);
+
+/** @internal
+ *  C = alpha * A * B + beta * C, like BLAS xGEMM for row major matrices without transposes.
+ *  If @a beta is zero, C is not read.
+ */
+LASS_DLL void LASS_CALL gemm(size_t m, size_t n, size_t k, float alpha, const float* a, size_t lda, 
+	const float* b, size_t ldb, float beta, float* c, size_t ldc);
+
+/** @internal
+ *  @copydoc gemm(size_t, size_t, size_t, float, const float*, size_t, const float*, size_t, float, float*, size_t)
+ */
+LASS_DLL void LASS_CALL gemm(size_t m, size_t n, size_t k, double alpha, const double* a, size_t lda, 
+	const double* b, size_t ldb, double beta, double* c, size_t ldc);
+
+/** @internal
+ *  C = alpha * A * B + beta * C for other scalar types, like std::complex, evaluated straightforwardly.
+ */
+template <typename T>
+void gemm(size_t m, size_t n, size_t k, const T& alpha, const T* a, size_t lda, 
+	const T* b, size_t ldb, const T& beta, T* c, size_t ldc)
+{
+	std::vector<T> row(n);
+	for (size_t i = 0; i < m; ++i)
+	{
+		std::fill(row.begin(), row.end(), T());
+		const T* ai = a + i * lda;
+		for (size_t p = 0; p < k; ++p)
+		{
+			const T aip = alpha * ai[p];
+			const T* bp = b + p * ldb;
+			for (size_t j = 0; j < n; ++j)
+			{
+				row[j] += aip * bp[j];
+			}
+		}
+		T* ci = c + i * ldc;
+		for (size_t j = 0; j < n; ++j)
+		{
+			ci[j] = beta == T() ? row[j] : beta * ci[j] + row[j];
+		}
+	}
+}
+
+/** @internal
+ *  Products smaller than this number of multiply-adds are cheaper to evaluate element by element.
+ */
+constexpr size_t gemmThreshold = 16 * 16 * 16;
+
+/** @internal
+ *  Evaluates the product of two storage matrices with gemm() if T is float or double.
+ */
+template <typename T>
+void evaluate(MStorage<T>& dest, const MProd<T, MStorage<T>, MStorage<T> >& source)
+{
+	const size_t m = source.rows();
+	const size_t n = source.columns();
+	const size_t k = source.operand1().columns();
+	if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+	{
+		if (m * n * k >= gemmThreshold)
+		{
+			if (&dest == &source.operand1() || &dest == &source.operand2())
+			{
+				MStorage<T> result(m, n);
+				gemm(m, n, k, source.operand1().data(), k, source.operand2().data(), n, result.data(), n);
+				dest.swap(result);
+			}
+			else
+			{
+				dest.resize(m, n);
+				gemm(m, n, k, source.operand1().data(), k, source.operand2().data(), n, dest.data(), n);
+			}
+			return;
+		}
+	}
+	evaluateElements(dest, source);
+}
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
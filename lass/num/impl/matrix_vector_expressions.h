@@ -59,6 +59,7 @@ class MVColumn
 {
 public:
 	enum { lvalue = VectorOperand1::lvalue };
+	enum { parallel = VectorOperand1::parallel };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef typename util::CallTraits<T>::TReference TReference;
 	typedef size_t TSize;
@@ -84,6 +85,7 @@ class MVDiag
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = VectorOperand1::parallel };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef size_t TSize;
 	MVDiag(const VectorOperand1& iA): operand1_(iA) {}
@@ -104,6 +106,7 @@ class MVRightProd
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = MatrixOperand1::parallel && VectorOperand2::parallel };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef size_t TSize;
 	MVRightProd(const MatrixOperand1& iA, const VectorOperand2& iB):
@@ -0,0 +1,124 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "lass_common.h"
+#include "parallel.h"
+#include "../../util/thread_pool.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+namespace
+{
+
+typedef util::ThreadPool< std::function<void()> > TPool;
+
+/** Only one parallelFor at a time can use the pool, others (or nested ones) run single threaded.
+ */
+std::mutex& poolMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+TPool& pool()
+{
+	static TPool pool(TPool::autoNumberOfThreads, TPool::unlimitedNumberOfTasks, TPool::TConsumer(), "num");
+	return pool;
+}
+
+size_t numberOfProcessors()
+{
+	static const size_t n = util::numberOfAvailableProcessors();
+	return n;
+}
+
+}
+
+
+
+void parallelFor(size_t n, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	if (n == 0)
+	{
+		return;
+	}
+	grainSize = std::max<size_t>(grainSize, 1);
+
+	std::unique_lock<std::mutex> lock;
+	if (n > grainSize && numberOfProcessors() > 1)
+	{
+		lock = std::unique_lock<std::mutex>(poolMutex(), std::try_to_lock);
+	}
+	if (!lock.owns_lock())
+	{
+		body(0, n);
+		return;
+	}
+
+	// a few tasks per thread to even out the load
+	const size_t numberOfTasks = std::min((n + grainSize - 1) / grainSize, 4 * numberOfProcessors());
+	TPool& p = pool();
+	for (size_t i = 0; i < numberOfTasks; ++i)
+	{
+		const size_t begin = n * i / numberOfTasks;
+		const size_t end = n * (i + 1) / numberOfTasks;
+		p.addTask([&body, begin, end]() { body(begin, end); });
+	}
+	p.completeAllTasks();
+}
+
+}
+
+}
+
+}
+
+// EOF
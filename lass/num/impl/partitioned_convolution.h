@@ -0,0 +1,125 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_PARTITIONED_CONVOLUTION_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_PARTITIONED_CONVOLUTION_H
+
+#include "../num_common.h"
+#include "real_fft.h"
+
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Convolution with all but the first block of an impulse response, by uniformly partitioned
+ *  overlap-save.
+ *
+ *  The taps beyond the first blockSize() ones are cut in partitions of blockSize() taps, of which
+ *  the spectra are kept. Every time blockSize() input samples are gathered, the spectrum of the
+ *  last two blocks of input is stored in a frequency domain delay line, and multiplied with the
+ *  partitions to get the next blockSize() output samples. Because the first block of taps is
+ *  left out, these only depend on completed input blocks, and the convolution has no latency.
+ *  FirFilter adds the first block of taps in direct form.
+ */
+template <typename T>
+class PartitionedConvolution
+{
+public:
+	typedef std::vector<T> TValues;
+
+	PartitionedConvolution();
+	PartitionedConvolution(const TValues& impulseResponse, size_t blockSize);
+
+	size_t blockSize() const;
+	bool isEmpty() const;
+
+	T operator()(T input);
+	void reset();
+
+private:
+	typedef typename RealFft<T>::TComplex TComplex;
+	typedef typename RealFft<T>::TComplexValues TComplexValues;
+
+	void processBlock();
+
+	RealFft<T> fft_;
+	TComplexValues partitions_;
+	TComplexValues inputSpectra_;
+	TComplexValues outputSpectrum_;
+	TValues input_;
+	TValues output_;
+	TValues transformed_;
+	size_t blockSize_;
+	size_t numPartitions_;
+	size_t newestSpectrum_;
+	size_t position_;
+};
+
+/** @internal
+ *  Block size to convolve an impulse response of @a numTaps taps with.
+ *
+ *  The first block is convolved in direct form, at a cost of blockSize multiplications per sample.
+ *  The others cost about 4 * numTaps / blockSize for the spectra, and two transforms of
+ *  2 * blockSize per block. So blocks of about sqrt(numTaps) samples balance both.
+ */
+inline size_t partitionedConvolutionBlockSize(size_t numTaps);
+
+}
+
+}
+
+}
+
+#include "partitioned_convolution.inl"
+
+#endif
+
+// EOF
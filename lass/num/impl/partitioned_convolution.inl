@@ -0,0 +1,216 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_PARTITIONED_CONVOLUTION_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_PARTITIONED_CONVOLUTION_INL
+
+#include "../num_common.h"
+#include "partitioned_convolution.h"
+
+#include <algorithm>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+template <typename T>
+PartitionedConvolution<T>::PartitionedConvolution():
+	blockSize_(0),
+	numPartitions_(0),
+	newestSpectrum_(0),
+	position_(0)
+{
+}
+
+
+
+/** @param impulseResponse all taps, of which only the ones beyond the first @a blockSize are used.
+ *  @param blockSize a power of two.
+ */
+template <typename T>
+PartitionedConvolution<T>::PartitionedConvolution(const TValues& impulseResponse, size_t blockSize):
+	fft_(2 * blockSize),
+	input_(2 * blockSize),
+	output_(blockSize),
+	transformed_(2 * blockSize),
+	blockSize_(blockSize),
+	numPartitions_(0),
+	newestSpectrum_(0),
+	position_(0)
+{
+	const size_t numTaps = impulseResponse.size();
+	const size_t bins = fft_.spectrumSize();
+	numPartitions_ = numTaps > blockSize ? (numTaps - 1) / blockSize : 0;
+
+	// the inverse transform isn't normalized, so that's folded into the partitions.
+	const T scale = T(1) / static_cast<T>(fft_.size());
+	partitions_.resize(numPartitions_ * bins);
+	for (size_t p = 0; p < numPartitions_; ++p)
+	{
+		const size_t first = (p + 1) * blockSize;
+		const size_t last = std::min(first + blockSize, numTaps);
+		std::fill(transformed_.begin(), transformed_.end(), T(0));
+		for (size_t k = first; k < last; ++k)
+		{
+			transformed_[k - first] = scale * impulseResponse[k];
+		}
+		fft_.forward(&transformed_[0], &partitions_[p * bins]);
+	}
+
+	inputSpectra_.resize(numPartitions_ * bins);
+	outputSpectrum_.resize(bins);
+	reset();
+}
+
+
+
+template <typename T>
+size_t PartitionedConvolution<T>::blockSize() const
+{
+	return blockSize_;
+}
+
+
+
+/** Returns true if there are no taps beyond the first block, and operator() always returns zero.
+ */
+template <typename T>
+bool PartitionedConvolution<T>::isEmpty() const
+{
+	return numPartitions_ == 0;
+}
+
+
+
+/** Feeds one sample of input, and returns the contribution of all but the first block of taps
+ *  to the output of that same sample.
+ */
+template <typename T>
+T PartitionedConvolution<T>::operator()(T input)
+{
+	const T result = output_[position_];
+	input_[blockSize_ + position_] = input;
+	if (++position_ == blockSize_)
+	{
+		processBlock();
+	}
+	return result;
+}
+
+
+
+template <typename T>
+void PartitionedConvolution<T>::reset()
+{
+	std::fill(inputSpectra_.begin(), inputSpectra_.end(), TComplex());
+	std::fill(input_.begin(), input_.end(), T(0));
+	std::fill(output_.begin(), output_.end(), T(0));
+	newestSpectrum_ = 0;
+	position_ = 0;
+}
+
+
+
+/** Transforms the last two input blocks, and computes the output of the next block from it and
+ *  the spectra of the previous ones.
+ *
+ *  Partition p (starting at tap (p + 1) * blockSize) contributes to the next block by the spectrum
+ *  that's p blocks old, so the delay line goes backwards from the newest one.
+ */
+template <typename T>
+void PartitionedConvolution<T>::processBlock()
+{
+	position_ = 0;
+	if (numPartitions_ == 0)
+	{
+		return;
+	}
+
+	const size_t bins = fft_.spectrumSize();
+	newestSpectrum_ = (newestSpectrum_ + numPartitions_ - 1) % numPartitions_;
+	fft_.forward(&input_[0], &inputSpectra_[newestSpectrum_ * bins]);
+	std::copy(input_.begin() + static_cast<std::ptrdiff_t>(blockSize_), input_.end(), input_.begin());
+
+	T* const y = reinterpret_cast<T*>(&outputSpectrum_[0]);
+	std::fill(y, y + 2 * bins, T(0));
+	for (size_t p = 0; p < numPartitions_; ++p)
+	{
+		const T* const h = reinterpret_cast<const T*>(&partitions_[p * bins]);
+		const T* const x = reinterpret_cast<const T*>(&inputSpectra_[((newestSpectrum_ + p) % numPartitions_) * bins]);
+		for (size_t k = 0; k < 2 * bins; k += 2)
+		{
+			y[k] += h[k] * x[k] - h[k + 1] * x[k + 1];
+			y[k + 1] += h[k] * x[k + 1] + h[k + 1] * x[k];
+		}
+	}
+
+	fft_.inverse(&outputSpectrum_[0], &transformed_[0]);
+	std::copy(transformed_.begin() + static_cast<std::ptrdiff_t>(blockSize_), transformed_.end(), output_.begin());
+}
+
+
+
+inline size_t partitionedConvolutionBlockSize(size_t numTaps)
+{
+	size_t blockSize = 16;
+	while (blockSize * blockSize < numTaps)
+	{
+		blockSize *= 2;
+	}
+	return blockSize;
+}
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,108 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_REAL_FFT_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_REAL_FFT_H
+
+#include "../num_common.h"
+
+#include <complex>
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Fast Fourier transform of real sequences with a power of two length.
+ *
+ *  A sequence of size() real values is transformed as one complex sequence of half that length,
+ *  by an iterative radix-2 transform, and the spectra of the even and odd samples are separated
+ *  afterwards. Only the size() / 2 + 1 nonredundant bins of the spectrum are computed.
+ *
+ *  Twiddle factors and work space are allocated once by the constructor, so that forward and
+ *  inverse don't allocate. For the same reason, a single RealFft must not be used by several
+ *  threads at once.
+ */
+template <typename T>
+class RealFft
+{
+public:
+	typedef std::complex<T> TComplex;
+	typedef std::vector<TComplex> TComplexValues;
+
+	RealFft();
+	explicit RealFft(size_t size);
+
+	size_t size() const;
+	size_t spectrumSize() const;
+
+	void forward(const T* input, TComplex* spectrum);
+	void inverse(const TComplex* spectrum, T* output);
+
+private:
+	void transform(TComplex* data) const;
+
+	TComplexValues twiddles_;
+	TComplexValues splitTwiddles_;
+	TComplexValues work_;
+	std::vector<size_t> bitReversed_;
+	size_t size_;
+};
+
+}
+
+}
+
+}
+
+#include "real_fft.inl"
+
+#endif
+
+// EOF
@@ -0,0 +1,261 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_REAL_FFT_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_REAL_FFT_INL
+
+#include "../num_common.h"
+#include "real_fft.h"
+
+#include <cmath>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+namespace real_fft
+{
+
+/** @internal
+ *  a * b, without the NaN and infinity recovery that std::complex does and we don't need.
+ */
+template <typename T>
+inline std::complex<T> mul(const std::complex<T>& a, const std::complex<T>& b)
+{
+	return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+/** @internal
+ *  exp(-2 pi i k / n), evaluated in double precision.
+ */
+template <typename T>
+inline std::complex<T> twiddle(size_t k, size_t n)
+{
+	const double pi = 3.14159265358979323846264338327950288;
+	const double theta = -2 * pi * static_cast<double>(k) / static_cast<double>(n);
+	return std::complex<T>(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+}
+
+}
+
+
+
+template <typename T>
+RealFft<T>::RealFft():
+	size_(0)
+{
+}
+
+
+
+/** @param size number of real samples to transform, must be a power of two, at least 2.
+ */
+template <typename T>
+RealFft<T>::RealFft(size_t size):
+	size_(size)
+{
+	if (size < 2 || (size & (size - 1)) != 0)
+	{
+		LASS_THROW("RealFft: size " << size << " is not a power of two greater than one.");
+	}
+	const size_t half = size / 2;
+
+	twiddles_.resize(half / 2);
+	for (size_t k = 0; k < twiddles_.size(); ++k)
+	{
+		twiddles_[k] = real_fft::twiddle<T>(k, half);
+	}
+	splitTwiddles_.resize(half + 1);
+	for (size_t k = 0; k <= half; ++k)
+	{
+		splitTwiddles_[k] = real_fft::twiddle<T>(k, size);
+	}
+
+	bitReversed_.resize(half);
+	size_t bits = 0;
+	while ((size_t(1) << bits) < half)
+	{
+		++bits;
+	}
+	for (size_t k = 0; k < half; ++k)
+	{
+		size_t r = 0;
+		for (size_t b = 0; b < bits; ++b)
+		{
+			r |= ((k >> b) & 1) << (bits - 1 - b);
+		}
+		bitReversed_[k] = r;
+	}
+
+	work_.resize(half);
+}
+
+
+
+/** Number of real samples in the sequence.
+ */
+template <typename T>
+size_t RealFft<T>::size() const
+{
+	return size_;
+}
+
+
+
+/** Number of complex bins in the spectrum: size() / 2 + 1.
+ */
+template <typename T>
+size_t RealFft<T>::spectrumSize() const
+{
+	return size_ / 2 + 1;
+}
+
+
+
+/** Computes the spectrum X[k] = sum_n x[n] exp(-2 pi i k n / size()) of @a input, for k in [0, size() / 2].
+ *
+ *  @param input [in] size() real samples.
+ *  @param spectrum [out] spectrumSize() complex bins.
+ */
+template <typename T>
+void RealFft<T>::forward(const T* input, TComplex* spectrum)
+{
+	const size_t half = size_ / 2;
+	TComplex* const z = &work_[0];
+	for (size_t k = 0; k < half; ++k)
+	{
+		const size_t j = bitReversed_[k];
+		z[j] = TComplex(input[2 * k], input[2 * k + 1]);
+	}
+	transform(z);
+
+	// z holds the spectra E + i O of the even and odd samples, separate them using the symmetry
+	// of real spectra, and combine to the full spectrum X[k] = E[k] + exp(-2 pi i k / size) O[k].
+	//
+	const T h = T(0.5);
+	for (size_t k = 0; k <= half; ++k)
+	{
+		const TComplex a = z[k == half ? 0 : k];
+		const TComplex b = std::conj(z[k == 0 ? 0 : half - k]);
+		const TComplex even = h * (a + b);
+		const TComplex odd = h * TComplex(a.imag() - b.imag(), b.real() - a.real());
+		spectrum[k] = even + real_fft::mul(splitTwiddles_[k], odd);
+	}
+}
+
+
+
+/** Computes size() times the sequence of which @a spectrum is the forward transform.
+ *
+ *  The result isn't divided by size(), so inverse(forward(x)) equals size() * x. 
+ *  Like the spectrum of any real sequence, spectrum[0] and spectrum[size() / 2] must be real.
+ *
+ *  @param spectrum [in] spectrumSize() complex bins.
+ *  @param output [out] size() real samples.
+ */
+template <typename T>
+void RealFft<T>::inverse(const TComplex* spectrum, T* output)
+{
+	const size_t half = size_ / 2;
+	TComplex* const z = &work_[0];
+
+	// reassemble E + i O from the spectrum, conjugated so that the forward transform does the inverse.
+	//
+	for (size_t k = 0; k < half; ++k)
+	{
+		const TComplex a = spectrum[k];
+		const TComplex b = std::conj(spectrum[half - k]);
+		const TComplex even = a + b;
+		const TComplex odd = real_fft::mul(std::conj(splitTwiddles_[k]), a - b);
+		z[bitReversed_[k]] = std::conj(TComplex(even.real() - odd.imag(), even.imag() + odd.real()));
+	}
+	transform(z);
+
+	for (size_t k = 0; k < half; ++k)
+	{
+		output[2 * k] = z[k].real();
+		output[2 * k + 1] = -z[k].imag();
+	}
+}
+
+
+
+/** In place radix-2 decimation in time transform of size() / 2 complex values, 
+ *  which must already be permuted in bit reversed order.
+ */
+template <typename T>
+void RealFft<T>::transform(TComplex* data) const
+{
+	const size_t n = size_ / 2;
+	for (size_t length = 2; length <= n; length *= 2)
+	{
+		const size_t middle = length / 2;
+		const size_t stride = n / length;
+		for (size_t first = 0; first < n; first += length)
+		{
+			TComplex* const a = data + first;
+			TComplex* const b = a + middle;
+			for (size_t k = 0; k < middle; ++k)
+			{
+				const TComplex t = real_fft::mul(twiddles_[k * stride], b[k]);
+				b[k] = a[k] - t;
+				a[k] += t;
+			}
+		}
+	}
+}
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,144 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_SPARSE_EXPRESSIONS_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_SPARSE_EXPRESSIONS_H
+
+#include "../num_common.h"
+#include "vector_expressions.h"
+#include "parallel.h"
+
+#include <type_traits>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Number of rows per task when evaluating sparse products in parallel.
+ */
+constexpr size_t sparseGrainSize = 4096;
+
+/** @internal
+ *  Product of a compressed sparse row matrix with a vector expression.
+ */
+template <typename T, typename SparseMatrixType, typename VectorOperand2>
+class VSparseProd
+{
+public:
+	enum { lvalue = false };
+	enum { parallel = VectorOperand2::parallel };
+	typedef typename util::CallTraits<T>::TValue TValue;
+	typedef size_t TSize;
+	VSparseProd(const SparseMatrixType& iA, const VectorOperand2& iB):
+		operand1_(iA), operand2_(iB)
+	{
+		LASS_ASSERT(iA.columns() == iB.size());
+	}
+	TValue operator[](TSize iIndex) const
+	{
+		const TSize* rowPointers = operand1_.rowPointers().data();
+		const TSize* columns = operand1_.columnIndices().data();
+		const T* values = operand1_.values().data();
+		TValue result = NumTraits<T>::zero;
+		for (TSize k = rowPointers[iIndex], last = rowPointers[iIndex + 1]; k < last; ++k)
+		{
+			result += values[k] * operand2_[columns[k]];
+		}
+		return result;
+	}
+	TSize size() const { return operand1_.rows(); }
+	const VectorOperand2& operand2() const { return operand2_; }
+private:
+	const SparseMatrixType& operand1_;
+	typename VectorExpressionTraits<VectorOperand2>::TStorage operand2_;
+};
+
+
+
+/** @internal
+ *  Evaluates sparse matrix vector products in parallel, row by row.
+ */
+template <typename T, typename SparseMatrixType, typename VectorOperand2>
+void evaluateVector(VStorage<T>& dest, const VSparseProd<T, SparseMatrixType, VectorOperand2>& source)
+{
+	const size_t n = source.size();
+	if constexpr (std::is_same_v<VectorOperand2, VStorage<T> >)
+	{
+		if (&dest == &source.operand2())
+		{
+			VStorage<T> result;
+			evaluateVector(result, source);
+			dest.swap(result);
+			return;
+		}
+	}
+	dest.resize(n);
+	T* y = dest.data();
+	auto evaluateRows = [y, &source](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			y[i] = source[i];
+		}
+	};
+	if (!VectorOperand2::parallel)
+	{
+		evaluateRows(0, n);
+		return;
+	}
+	parallelFor(n, sparseGrainSize, evaluateRows);
+}
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
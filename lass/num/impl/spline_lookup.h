@@ -0,0 +1,262 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_SPLINE_LOOKUP_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_SPLINE_LOOKUP_H
+
+#include "../num_common.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Finds the segment of a spline's control values that contains a given control value.
+ *
+ *  find(x) returns the largest i <= last() with controls[i] <= x, or 0 if there isn't any.
+ *  It does a binary search, or if setNumCells() is called, it looks up a first guess in a
+ *  uniform grid over the control range, and walks from there. For nodes that are more or
+ *  less evenly spread and about as many cells as nodes, that takes constant time.
+ *
+ *  find(x, hint) first tries the segment of a previous result and its neighbours, which makes
+ *  a run over sorted or clustered control values cost constant time per value as well.
+ */
+template <typename ScalarType>
+class SplineLookup
+{
+public:
+	typedef ScalarType TScalar;
+	typedef std::vector<TScalar> TScalars;
+
+	SplineLookup():
+		origin_(0),
+		invCellWidth_(0),
+		last_(0)
+	{
+	}
+
+	template <typename ScalarInputIterator>
+	SplineLookup(ScalarInputIterator first, ScalarInputIterator lastControl, size_t last):
+		controls_(first, lastControl),
+		origin_(0),
+		invCellWidth_(0),
+		last_(last)
+	{
+		LASS_ASSERT(!controls_.empty() && last_ < controls_.size());
+	}
+
+	size_t last() const 
+	{ 
+		return last_; 
+	}
+
+	size_t numCells() const 
+	{ 
+		return cells_.size(); 
+	}
+
+	/** use a grid of @a numCells cells to look up segments, or a binary search if @a numCells is zero.
+	 */
+	void setNumCells(size_t numCells)
+	{
+		cells_.clear();
+		if (numCells == 0 || controls_.size() < 2)
+		{
+			return;
+		}
+		origin_ = controls_.front();
+		const TScalar width = (controls_.back() - origin_) / static_cast<TScalar>(numCells);
+		invCellWidth_ = num::inv(width);
+		cells_.resize(numCells);
+		for (size_t k = 0; k < numCells; ++k)
+		{
+			cells_[k] = search(origin_ + static_cast<TScalar>(k) * width);
+		}
+	}
+
+	size_t find(TScalar x) const
+	{
+		if (cells_.empty())
+		{
+			return search(x);
+		}
+		if (!(x >= controls_[0])) // also catches NaN
+		{
+			return 0;
+		}
+		if (x >= controls_[last_])
+		{
+			return last_;
+		}
+		const size_t cell = std::min(static_cast<size_t>((x - origin_) * invCellWidth_), cells_.size() - 1);
+		return walk(x, cells_[cell]);
+	}
+
+	size_t find(TScalar x, size_t hint) const
+	{
+		LASS_ASSERT(hint <= last_);
+		if (controls_[hint] <= x)
+		{
+			if (hint == last_ || x < controls_[hint + 1])
+			{
+				return hint;
+			}
+			if (hint + 1 == last_ || x < controls_[hint + 2])
+			{
+				return hint + 1;
+			}
+		}
+		else if (hint > 0 && controls_[hint - 1] <= x)
+		{
+			return hint - 1;
+		}
+		return find(x);
+	}
+
+	/** State of a batch lookup, carried from one chunk of control values to the next.
+	 */
+	struct Cursor
+	{
+		size_t hint = 0;
+		bool useHint = true;
+	};
+
+	/** finds the segments of the @a count control values @a xs.
+	 *
+	 *  Hints only pay off if most values are close to the previous one, and cost a branch 
+	 *  misprediction if they're not.  So @a cursor keeps track of how many values of a chunk land 
+	 *  next to the previous one, and only uses hints for the next chunk if that's at least half.
+	 *  Without hints or grid, the binary searches of the chunk are done side by side, one level at 
+	 *  a time, so that they don't wait on each other's loads.
+	 */
+	void find(const TScalar* xs, size_t count, size_t* indices, Cursor& cursor) const
+	{
+		if (!cursor.useHint && cells_.empty())
+		{
+			std::fill(indices, indices + count, size_t(0));
+			for (size_t n = last_ + 1; n > 1; )
+			{
+				const size_t half = n / 2;
+				for (size_t k = 0; k < count; ++k)
+				{
+					indices[k] = controls_[indices[k] + half] <= xs[k] ? indices[k] + half : indices[k];
+				}
+				n -= half;
+			}
+		}
+		else
+		{
+			size_t hint = cursor.hint;
+			for (size_t k = 0; k < count; ++k)
+			{
+				indices[k] = hint = cursor.useHint ? find(xs[k], hint) : find(xs[k]);
+			}
+		}
+		size_t hits = 0;
+		size_t hint = cursor.hint;
+		for (size_t k = 0; k < count; ++k)
+		{
+			hits += static_cast<size_t>(indices[k] + 1 >= hint && indices[k] <= hint + 1);
+			hint = indices[k];
+		}
+		cursor.hint = hint;
+		cursor.useHint = 2 * hits >= count;
+	}
+
+private:
+
+	/** branchless binary search in [0, last_]. Values below the range, and NaN, never pass a
+	 *  comparison and end up at 0.
+	 */
+	size_t search(TScalar x) const
+	{
+		size_t first = 0;
+		for (size_t n = last_ + 1; n > 1; )
+		{
+			const size_t half = n / 2;
+			first = controls_[first + half] <= x ? first + half : first;
+			n -= half;
+		}
+		return first;
+	}
+
+	/** walks from i to the segment of x, either way, as rounding of the cell bounds may put i 
+	 *  one too far.
+	 */
+	size_t walk(TScalar x, size_t i) const
+	{
+		while (i < last_ && controls_[i + 1] <= x)
+		{
+			++i;
+		}
+		while (i > 0 && controls_[i] > x)
+		{
+			--i;
+		}
+		return i;
+	}
+
+	TScalars controls_;
+	std::vector<size_t> cells_;
+	TScalar origin_;
+	TScalar invCellWidth_;
+	size_t last_;
+};
+
+}
+
+}
+
+}
+
+#endif
+
+// EOF
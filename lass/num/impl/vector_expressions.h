@@ -46,6 +46,9 @@
 #define LASS_GUARDIAN_OF_INCLUSION_NUM_IMPL_VECTOR_EXPRESSIONS_H
 
 #include "../num_common.h"
+#include "parallel.h"
+
+#include <vector>
 
 namespace lass
 {
@@ -59,6 +62,7 @@ class VStorage
 {
 public:
 	enum { lvalue = true };
+	enum { parallel = true };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef typename util::CallTraits<T>::TParam TParam;
 	typedef typename util::CallTraits<T>::TReference TReference;
@@ -75,6 +79,8 @@ public:
 	//
 	void resize(TSize iSize) { storage_.resize(iSize, T()); }
 	void swap(VStorage<T>& iOther) { storage_.swap(iOther.storage_); }
+	T* data() { return storage_.data(); }
+	const T* data() const { return storage_.data(); }
 private:
 	std::vector<T> storage_;
 };
@@ -86,6 +92,7 @@ class VScalar
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = true };
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef typename util::CallTraits<T>::TParam TParam;
 	typedef size_t TSize;
@@ -118,6 +125,157 @@ struct VectorExpressionTraits<VScalar<T> >
 
 
 
+/** @internal
+ *  Assigns vector expression @a source to storage @a dest, element by element.
+ */
+template <typename Dest, typename Source>
+void evaluateVectorElements(Dest& dest, const Source& source)
+{
+	const size_t n = source.size();
+	dest.resize(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		dest[i] = source[i];
+	}
+}
+
+/** @internal
+ *  Assigns vector expression @a source to storage @a dest.
+ *
+ *  Vector calls this unqualified, so that expressions with a faster way of evaluation can provide
+ *  an overload in namespace impl, found by argument dependent lookup.
+ */
+template <typename Dest, typename Source>
+void evaluateVector(Dest& dest, const Source& source)
+{
+	evaluateVectorElements(dest, source);
+}
+
+
+
+/** @internal
+ *  Minimum number of elements per task when a vector expression is evaluated or summed in parallel.
+ */
+const size_t vectorGrainSize = 32768;
+
+/** @internal
+ *  Ranges up to this length are summed directly, longer ones are split in two halves first.
+ */
+const size_t vectorReductionBlockSize = 128;
+
+/** @internal
+ *  Assigns vector expression @a source to contiguous storage @a dest.
+ *
+ *  The elements are written through a plain pointer, so that the compiler can turn the loop into
+ *  SIMD code, and long vectors are split over the lass::num thread pool. This requires that no
+ *  element of @a source depends on elements of @a dest other than the one it's assigned to,
+ *  which is already true for evaluating them one by one in order.
+ *
+ *  Expressions that call user functions, like VFun, have @c parallel set to false and are
+ *  always evaluated in order on the calling thread.
+ */
+template <typename T, typename Source>
+void evaluateVector(VStorage<T>& dest, const Source& source)
+{
+	const size_t n = source.size();
+	dest.resize(n);
+	T* const y = dest.data();
+	auto evaluateRange = [y, &source](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			y[i] = source[i];
+		}
+	};
+	if (!Source::parallel || n < 2 * vectorGrainSize)
+	{
+		evaluateRange(0, n);
+		return;
+	}
+	parallelFor(n, vectorGrainSize, evaluateRange);
+}
+
+
+
+/** @internal
+ *  Returns @a f(begin) + ... + @a f(end - 1), added pairwise.
+ *
+ *  The range is halved recursively until the parts are at most vectorReductionBlockSize long.
+ *  Each part is added in a few interleaved partial sums that can live in one SIMD register.
+ *  The rounding error grows with O(log n) instead of O(n) for a straight sum.
+ */
+template <typename T, typename Function>
+T pairwiseSum(size_t begin, size_t end, const Function& f)
+{
+	const size_t n = end - begin;
+	if (n > vectorReductionBlockSize)
+	{
+		const size_t halfBlocks = (n / vectorReductionBlockSize + 1) / 2;
+		const size_t middle = begin + halfBlocks * vectorReductionBlockSize;
+		return pairwiseSum<T>(begin, middle, f) + pairwiseSum<T>(middle, end, f);
+	}
+
+	enum { lanes = 8 };
+	T partial[lanes] = {};
+	size_t i = begin;
+	for (; i + lanes <= end; i += lanes)
+	{
+		for (size_t k = 0; k < lanes; ++k)
+		{
+			partial[k] += f(i + k);
+		}
+	}
+	for (size_t width = lanes / 2; width > 0; width /= 2)
+	{
+		for (size_t k = 0; k < width; ++k)
+		{
+			partial[k] += partial[k + width];
+		}
+	}
+	for (; i < end; ++i)
+	{
+		partial[0] += f(i);
+	}
+	return partial[0];
+}
+
+/** @internal
+ *  Returns @a f(0) + ... + @a f(n - 1), added pairwise, and in parallel for large @a n if @a parallel is true.
+ *
+ *  The range is cut in chunks of vectorGrainSize that are summed on the lass::num thread pool,
+ *  and the chunk sums are added pairwise again. The chunks don't depend on the number of
+ *  threads, so neither does the result, not even if it's summed serially.
+ */
+template <typename T, typename Function>
+T pairwiseSum(size_t n, const Function& f, bool parallel)
+{
+	if (n < 2 * vectorGrainSize)
+	{
+		return pairwiseSum<T>(0, n, f);
+	}
+	const size_t chunks = (n + vectorGrainSize - 1) / vectorGrainSize;
+	std::vector<T> partials(chunks);
+	auto sumChunks = [n, &f, &partials](size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; ++k)
+		{
+			const size_t begin = k * vectorGrainSize;
+			partials[k] = pairwiseSum<T>(begin, std::min(begin + vectorGrainSize, n), f);
+		}
+	};
+	if (parallel)
+	{
+		parallelFor(chunks, 1, sumChunks);
+	}
+	else
+	{
+		sumChunks(0, chunks);
+	}
+	return pairwiseSum<T>(0, chunks, [&partials](size_t k) { return partials[k]; });
+}
+
+
+
 /** @internal
  */
 #define LASS_NUM_VECTOR_BINARY_EXPRESSION(i_name, c_operator)\
@@ -126,6 +284,7 @@ class LASS_CONCATENATE(V, i_name)\
 {\
 public:\
 	enum { lvalue = false };\
+	enum { parallel = Operand1::parallel && Operand2::parallel };\
 	typedef typename util::CallTraits<T>::TValue TValue;\
 	typedef size_t TSize;\
 	LASS_CONCATENATE(V, i_name)(const Operand1& iA, const Operand2& iB):\
@@ -155,6 +314,7 @@ class LASS_CONCATENATE(V, i_name)\
 {\
 public:\
 	enum { lvalue = false };\
+	enum { parallel = Operand1::parallel };\
 	typedef typename util::CallTraits<T>::TValue TValue;\
 	typedef size_t TSize;\
 	LASS_CONCATENATE(V, i_name)(const Operand1& iA): operand1_(iA) {}\
@@ -170,12 +330,15 @@ LASS_NUM_VECTOR_UNARY_EXPRESSION(Rec, ::lass::num::NumTraits<T>::one /);
 
 
 /** @internal
+ *  Applies a user function to each element. Never evaluated in parallel, as the function
+ *  may not be thread safe, and its exceptions can't escape the thread pool.
  */
 template <typename T, typename Operand1>
 class VFun
 {
 public:
 	enum { lvalue = false };
+	enum { parallel = false };
 	typedef T (*TOperator)(T);
 	typedef typename util::CallTraits<T>::TValue TValue;
 	typedef size_t TSize;
@@ -128,6 +128,20 @@ public:
 		return TSample(u, v);
 	}
 
+	/** maps @a count samples of the unit square in structure-of-arrays layout, as written by 
+	 *  SobolSequence::generate() or HaltonSequence::generate().  The output may overwrite the input.
+	 */
+	void operator()(size_t count, const TValue* inU, const TValue* inV, TValue* outU, TValue* outV, TValue* pdf) const
+	{
+		for (size_t k = 0; k < count; ++k)
+		{
+			TIndex index;
+			const TSample sample = (*this)(TSample(inU[k], inV[k]), pdf[k], index);
+			outU[k] = sample.x;
+			outV[k] = sample.y;
+		}
+	}
+
 private:
 	typedef std::vector<TValue> TValues;
 
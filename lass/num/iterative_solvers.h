@@ -0,0 +1,163 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+/** @defgroup IterativeSolvers Iterative solvers
+ *  @brief Krylov subspace solvers for large sparse systems A x = b.
+ *
+ *  The solvers only need the product of A with a vector, so A can be a SparseMatrix as well as a
+ *  dense Matrix. Preconditioners have a member <tt>void apply(const Vector<T>& r, Vector<T>& z) 
+ *  const</tt> that approximately solves A z = r:
+ *
+ *  - IdentityPreconditioner: no preconditioning.
+ *  - JacobiPreconditioner: divides by the diagonal of A. Cheap, and trivially parallel.
+ *  - Ilu0Preconditioner: incomplete LU factorization without fill-in. Usually needs far fewer 
+ *    iterations, but applying it is sequential.
+ *
+ *  The solvers are meant for real valued systems.
+ *
+ *  @code
+ *  num::SparseMatrix<double> a(n, n, entries.begin(), entries.end());
+ *  num::Vector<double> x;
+ *  const auto result = num::conjugateGradient(a, b, x, num::Ilu0Preconditioner<double>(a), 1e-8, 1000);
+ *  LASS_ENFORCE(result.converged);
+ *  @endcode
+ */
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_ITERATIVE_SOLVERS_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_ITERATIVE_SOLVERS_H
+
+#include "num_common.h"
+#include "sparse_matrix.h"
+
+namespace lass
+{
+namespace num
+{
+
+/** outcome of an iterative solver.
+ *  @ingroup IterativeSolvers
+ */
+template <typename T>
+struct IterativeSolverResult
+{
+	size_t iterations; /**< number of iterations performed */
+	T residual; /**< relative residual |b - A x| / |b| of the solution */
+	bool converged; /**< true if residual is within tolerance */
+};
+
+
+
+/** @ingroup IterativeSolvers
+ */
+template <typename T>
+class IdentityPreconditioner
+{
+public:
+	void apply(const Vector<T>& r, Vector<T>& z) const;
+};
+
+
+
+/** @ingroup IterativeSolvers
+ */
+template <typename T>
+class JacobiPreconditioner
+{
+public:
+	template <typename MatrixType> explicit JacobiPreconditioner(const MatrixType& a);
+	void apply(const Vector<T>& r, Vector<T>& z) const;
+private:
+	Vector<T> inverseDiagonal_;
+};
+
+
+
+/** @ingroup IterativeSolvers
+ */
+template <typename T>
+class Ilu0Preconditioner
+{
+public:
+	typedef SparseMatrix<T> TSparseMatrix;
+	typedef typename TSparseMatrix::TSize TSize;
+	typedef typename TSparseMatrix::TIndices TIndices;
+
+	explicit Ilu0Preconditioner(const TSparseMatrix& a);
+	void apply(const Vector<T>& r, Vector<T>& z) const;
+	const TSparseMatrix& factors() const;
+private:
+	TSparseMatrix lu_;
+	TIndices diagonal_;
+};
+
+
+
+template <typename MatrixType, typename T, typename Preconditioner>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+conjugateGradient(const MatrixType& a, const Vector<T>& b, Vector<T>& x, const Preconditioner& preconditioner,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations);
+
+template <typename MatrixType, typename T>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+conjugateGradient(const MatrixType& a, const Vector<T>& b, Vector<T>& x,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations);
+
+template <typename MatrixType, typename T, typename Preconditioner>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+biConjugateGradientStabilized(const MatrixType& a, const Vector<T>& b, Vector<T>& x, const Preconditioner& preconditioner,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations);
+
+template <typename MatrixType, typename T>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+biConjugateGradientStabilized(const MatrixType& a, const Vector<T>& b, Vector<T>& x,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations);
+
+}
+
+}
+
+#include "iterative_solvers.inl"
+
+#endif
+
+// EOF
@@ -0,0 +1,425 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_ITERATIVE_SOLVERS_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_ITERATIVE_SOLVERS_INL
+
+#include "num_common.h"
+#include "iterative_solvers.h"
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** @internal
+ *  Checks dimensions, and starts from zero if no initial guess is given.
+ */
+template <typename MatrixType, typename T>
+void prepareIterativeSolver(const MatrixType& a, const Vector<T>& b, Vector<T>& x)
+{
+	LASS_ENFORCE(a.rows() == a.columns());
+	LASS_ENFORCE(a.rows() == b.size());
+	if (x.isEmpty())
+	{
+		Vector<T>(b.size()).swap(x);
+	}
+	LASS_ENFORCE(x.size() == b.size());
+}
+
+}
+
+// --- IdentityPreconditioner ----------------------------------------------------------------------
+
+template <typename T> inline
+void IdentityPreconditioner<T>::apply(const Vector<T>& r, Vector<T>& z) const
+{
+	z = r;
+}
+
+
+
+// --- JacobiPreconditioner ------------------------------------------------------------------------
+
+/** @throw util::SingularityError if the diagonal of @a a has a zero.
+ */
+template <typename T>
+template <typename MatrixType>
+JacobiPreconditioner<T>::JacobiPreconditioner(const MatrixType& a):
+	inverseDiagonal_(a.rows())
+{
+	LASS_ENFORCE(a.rows() == a.columns());
+	for (size_t i = 0, n = a.rows(); i < n; ++i)
+	{
+		const T d = a(i, i);
+		if (d == NumTraits<T>::zero)
+		{
+			LASS_THROW_EX(util::SingularityError, "Jacobi preconditioner needs nonzero diagonal");
+		}
+		inverseDiagonal_[i] = num::inv(d);
+	}
+}
+
+
+
+template <typename T>
+void JacobiPreconditioner<T>::apply(const Vector<T>& r, Vector<T>& z) const
+{
+	z = r * inverseDiagonal_;
+}
+
+
+
+// --- Ilu0Preconditioner --------------------------------------------------------------------------
+
+/** computes L and U with the same sparsity pattern as @a a, so that L U approximates @a a.
+ *
+ *  @throw util::SingularityError if the diagonal of @a a isn't stored, or if a zero pivot is 
+ *		encountered.
+ */
+template <typename T>
+Ilu0Preconditioner<T>::Ilu0Preconditioner(const TSparseMatrix& a):
+	lu_(a),
+	diagonal_(a.rows())
+{
+	LASS_ENFORCE(a.isSquare());
+
+	const TSize n = lu_.rows();
+	const TIndices& rowPointers = lu_.rowPointers();
+	const TIndices& columns = lu_.columnIndices();
+	typename TSparseMatrix::TValues& values = lu_.values();
+
+	for (TSize i = 0; i < n; ++i)
+	{
+		const auto first = columns.begin() + static_cast<std::ptrdiff_t>(rowPointers[i]);
+		const auto last = columns.begin() + static_cast<std::ptrdiff_t>(rowPointers[i + 1]);
+		const auto d = std::lower_bound(first, last, i);
+		if (d == last || *d != i)
+		{
+			LASS_THROW_EX(util::SingularityError, "ILU(0) preconditioner needs the diagonal to be stored");
+		}
+		diagonal_[i] = static_cast<TSize>(d - columns.begin());
+	}
+
+	// IKJ variant of Gaussian elimination, dropping everything outside the sparsity pattern.
+	const TSize none = static_cast<TSize>(-1);
+	TIndices position(n, none);
+	for (TSize i = 0; i < n; ++i)
+	{
+		for (TSize k = rowPointers[i]; k < rowPointers[i + 1]; ++k)
+		{
+			position[columns[k]] = k;
+		}
+		for (TSize k = rowPointers[i]; k < diagonal_[i]; ++k)
+		{
+			const TSize c = columns[k];
+			values[k] /= values[diagonal_[c]];
+			const T lik = values[k];
+			for (TSize kk = diagonal_[c] + 1; kk < rowPointers[c + 1]; ++kk)
+			{
+				const TSize p = position[columns[kk]];
+				if (p != none)
+				{
+					values[p] -= lik * values[kk];
+				}
+			}
+		}
+		if (values[diagonal_[i]] == NumTraits<T>::zero)
+		{
+			LASS_THROW_EX(util::SingularityError, "ILU(0) preconditioner encountered zero pivot");
+		}
+		for (TSize k = rowPointers[i]; k < rowPointers[i + 1]; ++k)
+		{
+			position[columns[k]] = none;
+		}
+	}
+}
+
+
+
+/** solves L U z = r by forward and backward substitution.
+ */
+template <typename T>
+void Ilu0Preconditioner<T>::apply(const Vector<T>& r, Vector<T>& z) const
+{
+	const TSize n = lu_.rows();
+	const TIndices& rowPointers = lu_.rowPointers();
+	const TIndices& columns = lu_.columnIndices();
+	const typename TSparseMatrix::TValues& values = lu_.values();
+
+	z = r;
+	for (TSize i = 0; i < n; ++i)
+	{
+		T sum = z[i];
+		for (TSize k = rowPointers[i]; k < diagonal_[i]; ++k)
+		{
+			sum -= values[k] * z[columns[k]];
+		}
+		z[i] = sum;
+	}
+	for (TSize i = n; i-- > 0; )
+	{
+		T sum = z[i];
+		for (TSize k = diagonal_[i] + 1; k < rowPointers[i + 1]; ++k)
+		{
+			sum -= values[k] * z[columns[k]];
+		}
+		z[i] = sum / values[diagonal_[i]];
+	}
+}
+
+
+
+/** unit lower triangular L (without its diagonal) and upper triangular U, in one matrix.
+ */
+template <typename T> inline
+const typename Ilu0Preconditioner<T>::TSparseMatrix&
+Ilu0Preconditioner<T>::factors() const
+{
+	return lu_;
+}
+
+
+
+// --- free ----------------------------------------------------------------------------------------
+
+/** solves A x = b for symmetric positive definite A, with the preconditioned conjugate gradient method.
+ *  @ingroup IterativeSolvers
+ *
+ *  @param a [in] symmetric positive definite matrix A, SparseMatrix or Matrix.
+ *  @param b [in] right-hand side b.
+ *  @param x [in,out] as input, the initial guess, or an empty vector to start from zero. 
+ *		As output, the solution.
+ *  @param preconditioner [in] must be symmetric positive definite as well.
+ *  @param tolerance [in] stop when |b - A x| <= tolerance * |b|.
+ *  @param maxIterations [in] stop after this many iterations, converged or not.
+ *
+ *  @par Complexity:
+ *		O(nonZeros) per iteration, plus applying the preconditioner.
+ */
+template <typename MatrixType, typename T, typename Preconditioner>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+conjugateGradient(const MatrixType& a, const Vector<T>& b, Vector<T>& x, const Preconditioner& preconditioner,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations)
+{
+	typedef typename NumTraits<T>::baseType TBase;
+
+	impl::prepareIterativeSolver(a, b, x);
+	IterativeSolverResult<TBase> result = { 0, TBase(0), false };
+
+	const TBase normB = b.norm();
+	if (normB == 0)
+	{
+		x = Vector<T>(b.size());
+		result.converged = true;
+		return result;
+	}
+
+	Vector<T> q;
+	q = a * x;
+	Vector<T> r = b - q;
+	Vector<T> z;
+	preconditioner.apply(r, z);
+	Vector<T> p = z;
+	T rz = dot(r, z);
+	for (;;)
+	{
+		result.residual = r.norm() / normB;
+		if (result.residual <= tolerance)
+		{
+			result.converged = true;
+			break;
+		}
+		if (result.iterations == maxIterations)
+		{
+			break;
+		}
+		++result.iterations;
+
+		q = a * p;
+		const T alpha = rz / dot(p, q);
+		x += alpha * p;
+		r -= alpha * q;
+		preconditioner.apply(r, z);
+		const T rzNew = dot(r, z);
+		p = z + (rzNew / rz) * p;
+		rz = rzNew;
+	}
+	return result;
+}
+
+
+
+/** solves A x = b for symmetric positive definite A, with the conjugate gradient method.
+ *  @ingroup IterativeSolvers
+ */
+template <typename MatrixType, typename T>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+conjugateGradient(const MatrixType& a, const Vector<T>& b, Vector<T>& x,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations)
+{
+	return conjugateGradient(a, b, x, IdentityPreconditioner<T>(), tolerance, maxIterations);
+}
+
+
+
+/** solves A x = b for general square A, with the right preconditioned BiCGSTAB method.
+ *  @ingroup IterativeSolvers
+ *
+ *  @param a [in] square matrix A, SparseMatrix or Matrix.
+ *  @param b [in] right-hand side b.
+ *  @param x [in,out] as input, the initial guess, or an empty vector to start from zero.
+ *		As output, the solution.
+ *  @param preconditioner [in] applies M^-1, the right preconditioner, like JacobiPreconditioner or Ilu0Preconditioner.
+ *  @param tolerance [in] stop when |b - A x| <= tolerance * |b|.
+ *  @param maxIterations [in] stop after this many iterations, converged or not.
+ *
+ *  The method stops early without converging if it breaks down.
+ *
+ *  @par Complexity:
+ *		O(nonZeros) per iteration, plus applying the preconditioner twice.
+ */
+template <typename MatrixType, typename T, typename Preconditioner>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+biConjugateGradientStabilized(const MatrixType& a, const Vector<T>& b, Vector<T>& x, const Preconditioner& preconditioner,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations)
+{
+	typedef typename NumTraits<T>::baseType TBase;
+
+	impl::prepareIterativeSolver(a, b, x);
+	IterativeSolverResult<TBase> result = { 0, TBase(0), false };
+
+	const TBase normB = b.norm();
+	if (normB == 0)
+	{
+		x = Vector<T>(b.size());
+		result.converged = true;
+		return result;
+	}
+
+	const size_t n = b.size();
+	Vector<T> v;
+	v = a * x;
+	Vector<T> r = b - v;
+	const Vector<T> rHat = r;
+	Vector<T> p(n);
+	Vector<T> s;
+	Vector<T> t;
+	Vector<T> pHat;
+	Vector<T> sHat;
+	v = Vector<T>(n);
+	T rho = 1;
+	T alpha = 1;
+	T omega = 1;
+	for (;;)
+	{
+		result.residual = r.norm() / normB;
+		if (result.residual <= tolerance)
+		{
+			result.converged = true;
+			break;
+		}
+		if (result.iterations == maxIterations)
+		{
+			break;
+		}
+		++result.iterations;
+
+		const T rhoNew = dot(rHat, r);
+		if (rhoNew == NumTraits<T>::zero)
+		{
+			break;
+		}
+		const T beta = (rhoNew / rho) * (alpha / omega);
+		p = r + beta * (p - omega * v);
+		preconditioner.apply(p, pHat);
+		v = a * pHat;
+		alpha = rhoNew / dot(rHat, v);
+		s = r - alpha * v;
+		if (s.norm() / normB <= tolerance)
+		{
+			x += alpha * pHat;
+			r.swap(s);
+			continue;
+		}
+
+		preconditioner.apply(s, sHat);
+		t = a * sHat;
+		const T tt = dot(t, t);
+		omega = tt == NumTraits<T>::zero ? NumTraits<T>::zero : dot(t, s) / tt;
+		if (omega == NumTraits<T>::zero)
+		{
+			x += alpha * pHat;
+			r.swap(s);
+			result.residual = r.norm() / normB;
+			break;
+		}
+		x += alpha * pHat + omega * sHat;
+		r = s - omega * t;
+		rho = rhoNew;
+	}
+	return result;
+}
+
+
+
+/** solves A x = b for general square A, with the BiCGSTAB method.
+ *  @ingroup IterativeSolvers
+ */
+template <typename MatrixType, typename T>
+IterativeSolverResult<typename NumTraits<T>::baseType>
+biConjugateGradientStabilized(const MatrixType& a, const Vector<T>& b, Vector<T>& x,
+	typename NumTraits<T>::baseType tolerance, size_t maxIterations)
+{
+	return biConjugateGradientStabilized(a, b, x, IdentityPreconditioner<T>(), tolerance, maxIterations);
+}
+
+}
+
+}
+
+#endif
+
+// EOF
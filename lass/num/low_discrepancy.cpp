@@ -0,0 +1,432 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#include "lass_common.h"
+#include "low_discrepancy.h"
+
+namespace lass
+{
+namespace num
+{
+
+namespace
+{
+
+/** primitive polynomial of degree s with inner coefficients a, and initial direction numbers m,
+ *  for the Sobol dimensions after the first, from Joe and Kuo's new-joe-kuo-6.21201.
+ */
+struct SobolPolynomial
+{
+	unsigned s;
+	unsigned a;
+	Tuint32 m[6];
+};
+
+const SobolPolynomial sobolPolynomials[SobolSequence::numBaseDimensions - 1] =
+{
+	{ 1, 0, { 1 } },
+	{ 2, 1, { 1, 3 } },
+	{ 3, 1, { 1, 3, 1 } },
+	{ 3, 2, { 1, 1, 1 } },
+	{ 4, 1, { 1, 1, 3, 3 } },
+	{ 4, 4, { 1, 3, 5, 13 } },
+	{ 5, 2, { 1, 1, 5, 5, 17 } },
+	{ 5, 4, { 1, 1, 5, 5, 5 } },
+	{ 5, 7, { 1, 1, 7, 11, 19 } },
+	{ 5, 11, { 1, 1, 5, 1, 1 } },
+	{ 5, 13, { 1, 1, 1, 3, 11 } },
+	{ 5, 14, { 1, 3, 5, 5, 31 } },
+	{ 6, 1, { 1, 3, 3, 9, 7, 49 } },
+	{ 6, 13, { 1, 1, 1, 15, 21, 21 } },
+	{ 6, 16, { 1, 3, 1, 13, 27, 49 } },
+};
+
+Tuint32 hashMix(Tuint32 x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352d;
+	x ^= x >> 15;
+	x *= 0x846ca68b;
+	x ^= x >> 16;
+	return x;
+}
+
+Tuint32 hashCombine(Tuint32 seed, Tuint32 x)
+{
+	return hashMix(seed ^ (x + 0x9e3779b9 + (seed << 6) + (seed >> 2)));
+}
+
+Tuint32 reverseBits(Tuint32 x)
+{
+	x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+	x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+	x = ((x >> 4) & 0x0f0f0f0f) | ((x & 0x0f0f0f0f) << 4);
+	x = ((x >> 8) & 0x00ff00ff) | ((x & 0x00ff00ff) << 8);
+	return (x >> 16) | (x << 16);
+}
+
+/** each bit of the result only depends on the same and less significant bits of x.
+ */
+Tuint32 laineKarrasPermutation(Tuint32 x, Tuint32 seed)
+{
+	x += seed;
+	x ^= x * 0x6c50b47c;
+	x ^= x * 0xb82f1e52;
+	x ^= x * 0xc7afe638;
+	x ^= x * 0x8d22f6e6;
+	return x;
+}
+
+/** Owen scrambling of a fraction: each bit is flipped depending on all more significant ones.
+ */
+Tuint32 nestedUniformScramble(Tuint32 x, Tuint32 seed)
+{
+	return reverseBits(laineKarrasPermutation(reverseBits(x), seed));
+}
+
+unsigned countTrailingZeros(Tuint32 x)
+{
+	LASS_ASSERT(x != 0);
+	unsigned n = 0;
+	for (; !(x & 1); x >>= 1)
+	{
+		++n;
+	}
+	return n;
+}
+
+}
+
+// --- SobolSequence -------------------------------------------------------------------------------
+
+/** @param numDimensions number of dimensions.  More than numBaseDimensions requires scrambling.
+ *  @param scramble stNone for the plain Sobol sequence, stOwen for Owen scrambling.
+ *  @param seed seed of the scrambling, ignored for stNone.
+ */
+SobolSequence::SobolSequence(size_t numDimensions, ScrambleType scramble, TBits seed):
+	numDimensions_(numDimensions),
+	scramble_(scramble)
+{
+	LASS_ENFORCE(numDimensions > 0);
+	if (scramble == stNone && numDimensions > numBaseDimensions)
+	{
+		LASS_THROW("More than " << numBaseDimensions << " dimensions require a scrambled Sobol sequence");
+	}
+
+	for (size_t k = 0; k < numBits; ++k)
+	{
+		directions_[0][k] = TBits(1) << (numBits - 1 - k);
+	}
+	for (size_t d = 1; d < numBaseDimensions; ++d)
+	{
+		const SobolPolynomial& polynomial = sobolPolynomials[d - 1];
+		const size_t s = polynomial.s;
+		TBits* v = directions_[d];
+		for (size_t k = 0; k < s; ++k)
+		{
+			v[k] = polynomial.m[k] << (numBits - 1 - k);
+		}
+		for (size_t k = s; k < numBits; ++k)
+		{
+			v[k] = v[k - s] ^ (v[k - s] >> s);
+			for (size_t l = 1; l < s; ++l)
+			{
+				if ((polynomial.a >> (s - 1 - l)) & 1)
+				{
+					v[k] ^= v[k - l];
+				}
+			}
+		}
+	}
+	for (size_t d = 0; d < numBaseDimensions; ++d)
+	{
+		prefixDirections_[d][0] = directions_[d][0];
+		for (size_t k = 1; k < numBits; ++k)
+		{
+			prefixDirections_[d][k] = prefixDirections_[d][k - 1] ^ directions_[d][k];
+		}
+	}
+
+	if (scramble_ == stOwen)
+	{
+		valueSeeds_.resize(numDimensions_);
+		for (size_t d = 0; d < numDimensions_; ++d)
+		{
+			valueSeeds_[d] = hashCombine(seed, static_cast<TBits>(2 * d));
+		}
+		blockSeeds_.resize((numDimensions_ + numBaseDimensions - 1) / numBaseDimensions);
+		for (size_t b = 0; b < blockSeeds_.size(); ++b)
+		{
+			blockSeeds_[b] = hashCombine(seed, static_cast<TBits>(2 * b + 1));
+		}
+	}
+}
+
+
+
+size_t SobolSequence::numDimensions() const
+{
+	return numDimensions_;
+}
+
+
+
+ScrambleType SobolSequence::scramble() const
+{
+	return scramble_;
+}
+
+
+
+/** sample @a index of @a dimension, as a 32-bit fixed point fraction.
+ */
+SobolSequence::TBits SobolSequence::bits(size_t index, size_t dimension) const
+{
+	LASS_ASSERT(dimension < numDimensions_);
+	return scrambleValue(sobol(shuffle(index, dimension), dimension % numBaseDimensions), dimension);
+}
+
+
+
+/** sample @a index of @a dimension, in [0, 1).
+ */
+double SobolSequence::operator()(size_t index, size_t dimension) const
+{
+	return impl::unitFromFraction32<double>(bits(index, dimension));
+}
+
+
+
+/** writes samples [firstIndex, firstIndex + count) of one @a dimension to @a output, as 32-bit
+ *  fixed point fractions.
+ */
+void SobolSequence::generateBits(size_t firstIndex, size_t count, size_t dimension, TBits* output) const
+{
+	LASS_ASSERT(dimension < numDimensions_);
+	if (count == 0)
+	{
+		return;
+	}
+	LASS_ASSERT(firstIndex + (count - 1) <= 0xffffffff);
+	if (dimension >= numBaseDimensions)
+	{
+		for (size_t k = 0; k < count; ++k)
+		{
+			output[k] = bits(firstIndex + k, dimension);
+		}
+		return;
+	}
+
+	// going from index i - 1 to i flips the trailing zeros of i and the bit before.
+	const TBits* prefixDirections = prefixDirections_[dimension];
+	TBits index = static_cast<TBits>(firstIndex);
+	TBits x = sobol(index, dimension);
+	output[0] = scrambleValue(x, dimension);
+	for (size_t k = 1; k < count; ++k)
+	{
+		++index;
+		x ^= prefixDirections[countTrailingZeros(index)];
+		output[k] = scrambleValue(x, dimension);
+	}
+}
+
+
+
+/** the index of the sample in the underlying Sobol sequence: 
+ *  unchanged for the first block of dimensions, Owen scrambled for the next.
+ */
+SobolSequence::TBits SobolSequence::shuffle(size_t index, size_t dimension) const
+{
+	LASS_ASSERT(index <= 0xffffffff);
+	const size_t block = dimension / numBaseDimensions;
+	return block == 0 
+		? static_cast<TBits>(index) 
+		: nestedUniformScramble(static_cast<TBits>(index), blockSeeds_[block]);
+}
+
+
+
+SobolSequence::TBits SobolSequence::sobol(TBits index, size_t dimension) const
+{
+	LASS_ASSERT(dimension < numBaseDimensions);
+	const TBits* directions = directions_[dimension];
+	TBits x = 0;
+	for (size_t k = 0; index; index >>= 1, ++k)
+	{
+		x ^= directions[k] & (0 - (index & 1)); // branchless, as the bits of shuffled indices are random
+	}
+	return x;
+}
+
+
+
+SobolSequence::TBits SobolSequence::scrambleValue(TBits x, size_t dimension) const
+{
+	return scramble_ == stOwen ? nestedUniformScramble(x, valueSeeds_[dimension]) : x;
+}
+
+
+
+// --- HaltonSequence ------------------------------------------------------------------------------
+
+/** @param numDimensions number of dimensions, at most maxDimensions.
+ *  @param scramble stNone for the plain Halton sequence, stOwen for Owen scrambling.
+ *  @param seed seed of the scrambling, ignored for stNone.
+ */
+HaltonSequence::HaltonSequence(size_t numDimensions, ScrambleType scramble, Tuint32 seed):
+	scramble_(scramble)
+{
+	LASS_ENFORCE(numDimensions > 0 && numDimensions <= maxDimensions);
+
+	bases_.reserve(numDimensions);
+	for (Tuint64 n = 2; bases_.size() < numDimensions; ++n)
+	{
+		bool isPrime = true;
+		for (Tuint64 p : bases_)
+		{
+			if (p * p > n)
+			{
+				break;
+			}
+			if (n % p == 0)
+			{
+				isPrime = false;
+				break;
+			}
+		}
+		if (isPrime)
+		{
+			bases_.push_back(n);
+		}
+	}
+
+	seeds_.resize(numDimensions);
+	for (size_t d = 0; d < numDimensions; ++d)
+	{
+		seeds_[d] = hashCombine(seed, static_cast<Tuint32>(d));
+	}
+}
+
+
+
+size_t HaltonSequence::numDimensions() const
+{
+	return bases_.size();
+}
+
+
+
+ScrambleType HaltonSequence::scramble() const
+{
+	return scramble_;
+}
+
+
+
+/** the prime base of @a dimension.
+ */
+size_t HaltonSequence::base(size_t dimension) const
+{
+	LASS_ASSERT(dimension < bases_.size());
+	return static_cast<size_t>(bases_[dimension]);
+}
+
+
+
+/** sample @a index of @a dimension, in [0, 1).
+ *
+ *  Scrambled samples have digits up to double precision, as the scrambling also shifts the 
+ *  leading zeros of the index.
+ */
+double HaltonSequence::operator()(size_t index, size_t dimension) const
+{
+	LASS_ASSERT(dimension < bases_.size());
+	const Tuint64 base = bases_[dimension];
+	const double invBase = 1. / static_cast<double>(base);
+	Tuint64 a = index;
+	Tuint64 reversed = 0;
+	double invBaseM = 1;
+	if (scramble_ == stNone)
+	{
+		while (a > 0)
+		{
+			const Tuint64 next = a / base;
+			reversed = reversed * base + (a - next * base);
+			invBaseM *= invBase;
+			a = next;
+		}
+	}
+	else
+	{
+		const Tuint32 seed = seeds_[dimension];
+		for (Tuint32 digitIndex = 0; 1 - invBaseM < 1; ++digitIndex)
+		{
+			Tuint64 digit = 0;
+			if (a > 0)
+			{
+				const Tuint64 next = a / base;
+				digit = a - next * base;
+				a = next;
+			}
+			// random shift in [0, base) by multiplication rather than modulo, saves a division.
+			const Tuint32 hash = hashCombine(seed ^ (digitIndex * 0x9e3779b9), static_cast<Tuint32>(reversed));
+			digit += (static_cast<Tuint64>(hash) * base) >> 32;
+			if (digit >= base)
+			{
+				digit -= base;
+			}
+			reversed = reversed * base + digit;
+			invBaseM *= invBase;
+		}
+	}
+	const double oneMinusEpsilon = 1 - std::numeric_limits<double>::epsilon() / 2;
+	return std::min(static_cast<double>(reversed) * invBaseM, oneMinusEpsilon);
+}
+
+}
+
+}
+
+// EOF
@@ -0,0 +1,173 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_LOW_DISCREPANCY_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_LOW_DISCREPANCY_H
+
+#include "num_common.h"
+
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+
+/** @ingroup Random
+ *  enumeration indicating how a low-discrepancy sequence is scrambled.
+ */
+enum ScrambleType
+{
+	stNone = 0,	///< plain sequence
+	stOwen,		///< hash-based Owen scrambling, a nested random permutation of the digits.
+};
+
+
+
+/** multi-dimensional Sobol sequence, with optional Owen scrambling.
+ *  @ingroup Random
+ *
+ *  The first numBaseDimensions dimensions use the direction numbers of Joe and Kuo.  If it's
+ *  scrambled, more dimensions are padded: each next block of numBaseDimensions dimensions reuses the 
+ *  direction numbers, with the sample index shuffled by an Owen scramble of its own.  That shuffle 
+ *  keeps the first 2^m samples of each block in an aligned block of 2^m Sobol samples, so they 
+ *  keep their stratification, but decorrelates the blocks from each other.
+ *
+ *  The Owen scrambling is the hash-based one of Burley, that keeps the net properties of the 
+ *  sequence.  Different seeds give independent randomizations, e.g. to estimate the error of a 
+ *  quasi-Monte Carlo integral.
+ *
+ *  Indices are limited to 32 bits.  generate() writes whole ranges of sample indices at once, in 
+ *  structure-of-arrays layout.  Consecutive indices of an unshuffled dimension cost O(1) each.
+ *
+ *  <i>S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional
+ *  projections", SIAM J. Sci. Comput. 30, 2635-2654 (2008)</i>, https://web.maths.unsw.edu.au/~fkuo/sobol/ \n
+ *  <i>B. Burley, "Practical Hash-based Owen Scrambling", Journal of Computer Graphics Techniques
+ *  9(4), 2020</i>
+ */
+class LASS_DLL SobolSequence
+{
+public:
+	typedef num::Tuint32 TBits; /**< samples as 32-bit fixed point fractions */
+
+	enum 
+	{ 
+		numBaseDimensions = 16, /**< number of dimensions with their own direction numbers */
+		numBits = 32
+	};
+
+	explicit SobolSequence(size_t numDimensions, ScrambleType scramble = stOwen, TBits seed = 0);
+
+	size_t numDimensions() const;
+	ScrambleType scramble() const;
+
+	TBits bits(size_t index, size_t dimension) const;
+	double operator()(size_t index, size_t dimension) const;
+
+	void generateBits(size_t firstIndex, size_t count, size_t dimension, TBits* output) const;
+	template <typename T> void generate(size_t firstIndex, size_t count, size_t dimension, T* output) const;
+	template <typename T> void generate(size_t firstIndex, size_t count, T* output) const;
+
+private:
+	TBits shuffle(size_t index, size_t dimension) const;
+	TBits sobol(TBits index, size_t dimension) const;
+	TBits scrambleValue(TBits x, size_t dimension) const;
+
+	TBits directions_[numBaseDimensions][numBits];
+	TBits prefixDirections_[numBaseDimensions][numBits];
+	std::vector<TBits> valueSeeds_;
+	std::vector<TBits> blockSeeds_;
+	size_t numDimensions_;
+	ScrambleType scramble_;
+};
+
+
+
+/** multi-dimensional Halton sequence, with optional Owen scrambling.
+ *  @ingroup Random
+ *
+ *  Dimension d is the radical inverse of the sample index in the (d + 1)-th prime base.  Unscrambled, 
+ *  higher dimensions correlate badly, so use stOwen for more than a few dimensions.  Scrambling 
+ *  applies a nested random digit shift, that depends on the seed, the dimension, and all less 
+ *  significant digits of the index.  Like full Owen scrambling, it keeps the stratification of 
+ *  each dimension.
+ *
+ *  Unlike RandomRadicalInverse, samples are a function of their index and dimension, and 
+ *  generate() writes whole ranges of sample indices at once, in structure-of-arrays layout.
+ */
+class LASS_DLL HaltonSequence
+{
+public:
+	enum 
+	{ 
+		maxDimensions = 256 /**< keeps the digits of scrambled samples in 64 bits */
+	};
+
+	explicit HaltonSequence(size_t numDimensions, ScrambleType scramble = stOwen, num::Tuint32 seed = 0);
+
+	size_t numDimensions() const;
+	ScrambleType scramble() const;
+	size_t base(size_t dimension) const;
+
+	double operator()(size_t index, size_t dimension) const;
+
+	template <typename T> void generate(size_t firstIndex, size_t count, size_t dimension, T* output) const;
+	template <typename T> void generate(size_t firstIndex, size_t count, T* output) const;
+
+private:
+	std::vector<num::Tuint64> bases_;
+	std::vector<num::Tuint32> seeds_;
+	ScrambleType scramble_;
+};
+
+}
+
+}
+
+#include "low_discrepancy.inl"
+
+#endif
+
+// EOF
@@ -0,0 +1,148 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_LOW_DISCREPANCY_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_LOW_DISCREPANCY_INL
+
+#include "num_common.h"
+#include "low_discrepancy.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace lass
+{
+namespace num
+{
+namespace impl
+{
+
+/** maps a 32-bit fixed point fraction to [0, 1), truncated to the precision of T so that it
+ *  can't round up to 1.
+ */
+template <typename T>
+T unitFromFraction32(Tuint32 bits)
+{
+	constexpr int digits = std::numeric_limits<T>::digits < 32 ? std::numeric_limits<T>::digits : 32;
+	return static_cast<T>(bits >> (32 - digits)) / static_cast<T>(Tuint64(1) << digits);
+}
+
+}
+
+// --- SobolSequence -------------------------------------------------------------------------------
+
+/** writes samples [firstIndex, firstIndex + count) of one @a dimension to @a output.
+ */
+template <typename T>
+void SobolSequence::generate(size_t firstIndex, size_t count, size_t dimension, T* output) const
+{
+	enum { chunkSize = 256 };
+	TBits bits[chunkSize];
+	while (count > 0)
+	{
+		const size_t m = std::min<size_t>(count, chunkSize);
+		generateBits(firstIndex, m, dimension, bits);
+		for (size_t k = 0; k < m; ++k)
+		{
+			output[k] = impl::unitFromFraction32<T>(bits[k]);
+		}
+		firstIndex += m;
+		count -= m;
+		output += m;
+	}
+}
+
+
+
+/** writes samples [firstIndex, firstIndex + count) of all dimensions to @a output, 
+ *  dimension d to [output + d * count, output + (d + 1) * count).
+ */
+template <typename T>
+void SobolSequence::generate(size_t firstIndex, size_t count, T* output) const
+{
+	for (size_t d = 0; d < numDimensions_; ++d)
+	{
+		generate(firstIndex, count, d, output + d * count);
+	}
+}
+
+
+
+// --- HaltonSequence ------------------------------------------------------------------------------
+
+/** writes samples [firstIndex, firstIndex + count) of one @a dimension to @a output.
+ */
+template <typename T>
+void HaltonSequence::generate(size_t firstIndex, size_t count, size_t dimension, T* output) const
+{
+	LASS_ASSERT(dimension < bases_.size());
+	const T oneMinusEpsilon = 1 - std::numeric_limits<T>::epsilon() / 2;
+	for (size_t k = 0; k < count; ++k)
+	{
+		output[k] = std::min(static_cast<T>((*this)(firstIndex + k, dimension)), oneMinusEpsilon);
+	}
+}
+
+
+
+/** writes samples [firstIndex, firstIndex + count) of all dimensions to @a output, 
+ *  dimension d to [output + d * count, output + (d + 1) * count).
+ */
+template <typename T>
+void HaltonSequence::generate(size_t firstIndex, size_t count, T* output) const
+{
+	for (size_t d = 0; d < bases_.size(); ++d)
+	{
+		generate(firstIndex, count, d, output + d * count);
+	}
+}
+
+}
+
+}
+
+#endif
+
+// EOF
@@ -48,6 +48,8 @@
 #include "num_common.h"
 #include "matrix.h"
 #include "impl/matrix_solve.h"
+#include "impl/matrix_gemm.h"
+#include "impl/matrix_factorization.h"
 #include "../meta/meta_assert.h"
 
 #include <cstddef>
@@ -134,17 +136,7 @@ Matrix<T, S>::Matrix(const Matrix<T2, S2>& other):
 	storage_(other.rows(), other.columns())
 {
 	static_assert(TStorage::lvalue, "this must be an lvalue");
-
-	const S2& b = other.storage();
-	const TSize m = rows();
-	const TSize n = columns();
-	for (TSize i = 0; i < m; ++i)
-	{
-		for (TSize j = 0; j < n; ++j)
-		{
-			storage_(i, j) = b(i, j);
-		}
-	}
+	impl::evaluate(storage_, other.storage());
 }
 
 
@@ -164,18 +156,7 @@ template <typename T2, typename S2>
 Matrix<T, S>& Matrix<T, S>::operator=(const Matrix<T2, S2>& other)
 {
 	static_assert(TStorage::lvalue, "this must be an lvalue");
-
-	const S2& b = other.storage();
-	const TSize m = other.rows();
-	const TSize n = other.columns();
-	storage_.resize(m, n);
-	for (TSize i = 0; i < m; ++i)
-	{
-		for (TSize j = 0; j < n; ++j)
-		{
-			storage_(i, j) = b(i, j);
-		}
-	}
+	impl::evaluate(storage_, other.storage());
 	return *this;
 }
 
@@ -691,6 +672,8 @@ Matrix<T, S>::transposed() const
  *
  *  @result true if succeeded, false if not.
  *  @throw an exception is thrown if this is not a square matrix
+ *
+ *  If you need to solve against the same matrix repeatedly, keep a LuDecomposition instead.
  */
 template <typename T, typename S>
 void Matrix<T, S>::invert()
@@ -700,20 +683,16 @@ void Matrix<T, S>::invert()
 
 	const TSize size = rows();
 	Matrix<T> lu(*this);
-	std::vector<std::ptrdiff_t> index(size);
-	const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(size);
-	int d;
+	std::vector<size_t> pivots(size);
+	int sign;
 
-	if (!impl::ludecomp<T>(lu.storage().rowMajor(), index.begin(), n, d))
+	if (!impl::luFactorize(lu.storage().data(), size, pivots.data(), sign))
 	{
 		LASS_THROW_EX(util::SingularityError, "failed to invert matrix");
 	}
 
 	setIdentity(size);
-	for (std::ptrdiff_t i = 0; i < n; ++i)
-	{
-		impl::lusolve<T>(lu.storage().rowMajor(), index.begin(), column(i).begin(), n);
-	}
+	impl::luSolve(lu.storage().data(), size, pivots.data(), storage_.data(), size);
 }
 
 
@@ -853,6 +832,10 @@ operator-(const Matrix<T, S1>& a, const Matrix<T, S2>& b)
  *  denotes a matrix with @n a rows and @n b columns.</i>
  *  http://mathworld.wolfram.com/MatrixMultiplication.html
  *
+ *  Assigning the product of two storage matrices of float or double evaluates it with a
+ *  blocked, vectorized and multithreaded kernel (impl::gemm). Other products, or products
+ *  that are part of a larger expression, are evaluated element by element.
+ *
  *  @throw an exception is throw in @a a and @a b don't meet the requirement
  *         @n a.columns()==b.rows() .
  *
@@ -1011,37 +994,36 @@ void solve(const Matrix<T, S>& a, Matrix<T, S2>& bx, bool improve)
 
 	const size_t n = a.rows();
 	Matrix<T> lu(a);
-	std::vector<std::ptrdiff_t> pivot(n);
+	std::vector<size_t> pivot(n);
 	int d;
 
 	Matrix<T> aa;
-	std::vector<T> bcol;
 	if (improve)
 	{
 		aa = a;
-		bcol.resize(n);
 	}
 
-	if (!impl::ludecomp<T>(lu.storage().rowMajor(), pivot.begin(), static_cast<std::ptrdiff_t>(n), d))
+	if (!impl::luFactorize(lu.storage().data(), n, pivot.data(), d))
 	{
 		LASS_THROW_EX(util::SingularityError, "failed to solve matrix equation");
 	}
 
-	for (size_t i = 0; i < bx.columns(); ++i)
+	// solve all columns at once in a dense copy, bx keeps B for the improvement step.
+	Matrix<T> x(bx);
+	const size_t m = bx.columns();
+	impl::luSolve(lu.storage().data(), n, pivot.data(), x.storage().data(), m);
+	for (size_t i = 0; i < m; ++i)
 	{
 		LASS_ASSERT(static_cast<int>(i) >= 0);
 		typename Matrix<T, S2>::Column xcol = bx.column(static_cast<int>(i));
 		if (improve)
 		{
-			for (size_t j = 0; j < n; ++j)
-			{
-				bcol[j] = xcol[j];
-			}
+			impl::lumprove<T>(aa.storage().rowMajor(), lu.storage().rowMajor(), pivot.begin(), 
+				xcol.begin(), x.column(static_cast<int>(i)).begin(), static_cast<std::ptrdiff_t>(n));
 		}
-		impl::lusolve<T>(lu.storage().rowMajor(), pivot.begin(), xcol.begin(), static_cast<std::ptrdiff_t>(n));
-		if (improve)
+		for (size_t j = 0; j < n; ++j)
 		{
-			impl::lumprove<T>(aa.storage().rowMajor(), lu.storage().rowMajor(), pivot.begin(), bcol.begin(), xcol.begin(), static_cast<std::ptrdiff_t>(n));
+			xcol[j] = x(j, i);
 		}
 	}
 }
@@ -0,0 +1,191 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+/** @class lass::num::LuDecomposition
+ *  @brief LU decomposition with partial pivoting of a square matrix, to solve A X = B repeatedly.
+ *
+ *  The decomposition costs O(n³) once, after which each solve costs O(n²) per right-hand side.
+ *  Both use blocked algorithms that spend most of their time in the matrix product kernel.
+ *
+ *  @code
+ *  num::LuDecomposition<double> lu(a);
+ *  lu.solve(bx); // bx can have many columns, all solved at once.
+ *  @endcode
+ */
+
+/** @class lass::num::CholeskyDecomposition
+ *  @brief Cholesky decomposition A = L L^H of a hermitian (symmetric) positive definite matrix.
+ *
+ *  About twice as fast as LuDecomposition, and needs no pivoting. Only the lower triangle of A is
+ *  used.
+ */
+
+/** @class lass::num::QrDecomposition
+ *  @brief Householder QR decomposition A = Q R of an m x n matrix, with m >= n.
+ *
+ *  solve() finds the least squares solution of A X = B, if A is not square.
+ */
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_MATRIX_DECOMPOSITION_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_MATRIX_DECOMPOSITION_H
+
+#include "num_common.h"
+#include "matrix.h"
+
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+
+template <typename T>
+class LuDecomposition
+{
+public:
+
+	typedef LuDecomposition<T> TSelf;
+	typedef Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	typedef typename TMatrix::TValue TValue;
+	typedef std::vector<TSize> TPivots;
+
+	LuDecomposition();
+	template <typename S> explicit LuDecomposition(const Matrix<T, S>& a);
+
+	template <typename S> void factorize(const Matrix<T, S>& a);
+
+	TSize size() const;
+	bool isEmpty() const;
+
+	void solve(TMatrix& bx) const;
+	template <typename RandomIterator> void solve(RandomIterator bx) const;
+
+	const TValue determinant() const;
+	const TMatrix inverse() const;
+
+	const TMatrix& factors() const;
+	const TPivots& pivots() const;
+
+private:
+
+	TMatrix lu_;
+	TPivots pivots_;
+	int sign_;
+};
+
+
+
+template <typename T>
+class CholeskyDecomposition
+{
+public:
+
+	typedef CholeskyDecomposition<T> TSelf;
+	typedef Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	typedef typename TMatrix::TValue TValue;
+
+	CholeskyDecomposition();
+	template <typename S> explicit CholeskyDecomposition(const Matrix<T, S>& a);
+
+	template <typename S> void factorize(const Matrix<T, S>& a);
+
+	TSize size() const;
+	bool isEmpty() const;
+
+	void solve(TMatrix& bx) const;
+	template <typename RandomIterator> void solve(RandomIterator bx) const;
+
+	const TValue determinant() const;
+
+	const TMatrix& factors() const;
+
+private:
+
+	TMatrix llh_;
+};
+
+
+
+template <typename T>
+class QrDecomposition
+{
+public:
+
+	typedef QrDecomposition<T> TSelf;
+	typedef Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	typedef typename TMatrix::TValue TValue;
+	typedef std::vector<T> TScales;
+
+	QrDecomposition();
+	template <typename S> explicit QrDecomposition(const Matrix<T, S>& a);
+
+	template <typename S> void factorize(const Matrix<T, S>& a);
+
+	TSize rows() const;
+	TSize columns() const;
+	bool isEmpty() const;
+
+	void solve(TMatrix& bx) const;
+
+	const TMatrix r() const;
+	const TMatrix& factors() const;
+	const TScales& scales() const;
+
+private:
+
+	TMatrix qr_;
+	TScales tau_;
+};
+
+}
+
+}
+
+#include "matrix_decomposition.inl"
+
+#endif
+
+// EOF
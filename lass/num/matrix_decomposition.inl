@@ -0,0 +1,506 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_MATRIX_DECOMPOSITION_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_MATRIX_DECOMPOSITION_INL
+
+#include "num_common.h"
+#include "matrix_decomposition.h"
+#include "impl/matrix_factorization.h"
+
+#include <algorithm>
+
+namespace lass
+{
+namespace num
+{
+
+// --- LuDecomposition -----------------------------------------------------------------------------
+
+/** constructs an empty decomposition.
+ */
+template <typename T>
+LuDecomposition<T>::LuDecomposition():
+	lu_(),
+	pivots_(),
+	sign_(1)
+{
+}
+
+
+
+/** decomposes square matrix @a a.
+ *  @throw util::SingularityError if @a a is singular.
+ */
+template <typename T>
+template <typename S>
+LuDecomposition<T>::LuDecomposition(const Matrix<T, S>& a):
+	lu_(),
+	pivots_(),
+	sign_(1)
+{
+	factorize(a);
+}
+
+
+
+/** decomposes square matrix @a a, replacing the previous decomposition.
+ *
+ *  @par Complexity:
+ *		O(n³)
+ *
+ *  @par Exception safety:
+ *		strong guarantee.
+ *
+ *  @throw util::SingularityError if @a a is singular.
+ */
+template <typename T>
+template <typename S>
+void LuDecomposition<T>::factorize(const Matrix<T, S>& a)
+{
+	LASS_ENFORCE(a.isSquare());
+
+	TMatrix lu(a);
+	TPivots pivots(lu.rows());
+	int sign;
+	if (!impl::luFactorize(lu.storage().data(), lu.rows(), pivots.data(), sign))
+	{
+		LASS_THROW_EX(util::SingularityError, "failed to decompose singular matrix");
+	}
+
+	lu_.swap(lu);
+	pivots_.swap(pivots);
+	sign_ = sign;
+}
+
+
+
+template <typename T> inline
+typename LuDecomposition<T>::TSize
+LuDecomposition<T>::size() const
+{
+	return lu_.rows();
+}
+
+
+
+template <typename T> inline
+bool LuDecomposition<T>::isEmpty() const
+{
+	return lu_.isEmpty();
+}
+
+
+
+/** solves A X = B for all columns of B at once.
+ *
+ *  @param bx [in,out] serves both as the input matrix B and the output matrix X.
+ *
+ *  @par Complexity:
+ *		O(n² * bx.columns())
+ *
+ *  @throw an exception is thrown if dimensions don't match (this->size() == bx.rows())
+ */
+template <typename T>
+void LuDecomposition<T>::solve(TMatrix& bx) const
+{
+	LASS_NUM_MATRIX_ENFORCE_ADJACENT_DIMENSION(lu_, bx);
+	impl::luSolve(lu_.storage().data(), size(), pivots_.data(), bx.storage().data(), bx.columns());
+}
+
+
+
+/** solves A x = b for a single column.
+ *
+ *  @param bx [in,out] random access iterator to the first element of b, which is replaced by x.
+ *		[bx, bx + this->size()) must be a valid range.
+ */
+template <typename T>
+template <typename RandomIterator>
+void LuDecomposition<T>::solve(RandomIterator bx) const
+{
+	const TSize n = size();
+	std::vector<T> column(bx, bx + static_cast<std::ptrdiff_t>(n));
+	impl::luSolve(lu_.storage().data(), n, pivots_.data(), column.data(), 1);
+	std::copy(column.begin(), column.end(), bx);
+}
+
+
+
+template <typename T>
+const typename LuDecomposition<T>::TValue
+LuDecomposition<T>::determinant() const
+{
+	TValue result = TValue(sign_);
+	for (TSize i = 0, n = size(); i < n; ++i)
+	{
+		result *= lu_(i, i);
+	}
+	return result;
+}
+
+
+
+/** returns the inverse of A, solving all columns of the identity matrix at once.
+ */
+template <typename T>
+const typename LuDecomposition<T>::TMatrix
+LuDecomposition<T>::inverse() const
+{
+	TMatrix result;
+	result.setIdentity(size());
+	solve(result);
+	return result;
+}
+
+
+
+/** unit lower triangular L (without its diagonal) and upper triangular U, in one matrix.
+ */
+template <typename T> inline
+const typename LuDecomposition<T>::TMatrix&
+LuDecomposition<T>::factors() const
+{
+	return lu_;
+}
+
+
+
+/** row @c j was interchanged with row @c pivots()[j], in order of increasing @c j.
+ */
+template <typename T> inline
+const typename LuDecomposition<T>::TPivots&
+LuDecomposition<T>::pivots() const
+{
+	return pivots_;
+}
+
+
+
+// --- CholeskyDecomposition -----------------------------------------------------------------------
+
+/** constructs an empty decomposition.
+ */
+template <typename T>
+CholeskyDecomposition<T>::CholeskyDecomposition():
+	llh_()
+{
+}
+
+
+
+/** decomposes hermitian positive definite matrix @a a.
+ *  @throw util::SingularityError if @a a is not positive definite.
+ */
+template <typename T>
+template <typename S>
+CholeskyDecomposition<T>::CholeskyDecomposition(const Matrix<T, S>& a):
+	llh_()
+{
+	factorize(a);
+}
+
+
+
+/** decomposes hermitian positive definite matrix @a a, replacing the previous decomposition.
+ *
+ *  Only the lower triangle of @a a is read, the upper triangle is assumed to be its conjugate.
+ *
+ *  @par Complexity:
+ *		O(n³)
+ *
+ *  @par Exception safety:
+ *		strong guarantee.
+ *
+ *  @throw util::SingularityError if @a a is not positive definite.
+ */
+template <typename T>
+template <typename S>
+void CholeskyDecomposition<T>::factorize(const Matrix<T, S>& a)
+{
+	LASS_ENFORCE(a.isSquare());
+
+	TMatrix llh(a);
+	if (!impl::choleskyFactorize(llh.storage().data(), llh.rows()))
+	{
+		LASS_THROW_EX(util::SingularityError, "failed to decompose matrix that is not positive definite");
+	}
+
+	llh_.swap(llh);
+}
+
+
+
+template <typename T> inline
+typename CholeskyDecomposition<T>::TSize
+CholeskyDecomposition<T>::size() const
+{
+	return llh_.rows();
+}
+
+
+
+template <typename T> inline
+bool CholeskyDecomposition<T>::isEmpty() const
+{
+	return llh_.isEmpty();
+}
+
+
+
+/** solves A X = B for all columns of B at once.
+ *
+ *  @param bx [in,out] serves both as the input matrix B and the output matrix X.
+ *
+ *  @par Complexity:
+ *		O(n² * bx.columns())
+ *
+ *  @throw an exception is thrown if dimensions don't match (this->size() == bx.rows())
+ */
+template <typename T>
+void CholeskyDecomposition<T>::solve(TMatrix& bx) const
+{
+	LASS_NUM_MATRIX_ENFORCE_ADJACENT_DIMENSION(llh_, bx);
+	impl::choleskySolve(llh_.storage().data(), size(), bx.storage().data(), bx.columns());
+}
+
+
+
+/** solves A x = b for a single column.
+ *
+ *  @param bx [in,out] random access iterator to the first element of b, which is replaced by x.
+ *		[bx, bx + this->size()) must be a valid range.
+ */
+template <typename T>
+template <typename RandomIterator>
+void CholeskyDecomposition<T>::solve(RandomIterator bx) const
+{
+	const TSize n = size();
+	std::vector<T> column(bx, bx + static_cast<std::ptrdiff_t>(n));
+	impl::choleskySolve(llh_.storage().data(), n, column.data(), 1);
+	std::copy(column.begin(), column.end(), bx);
+}
+
+
+
+template <typename T>
+const typename CholeskyDecomposition<T>::TValue
+CholeskyDecomposition<T>::determinant() const
+{
+	TValue result = TValue(1);
+	for (TSize i = 0, n = size(); i < n; ++i)
+	{
+		result *= num::norm(llh_(i, i));
+	}
+	return result;
+}
+
+
+
+/** lower triangular L, and its conjugate transpose L^H in the upper triangle.
+ */
+template <typename T> inline
+const typename CholeskyDecomposition<T>::TMatrix&
+CholeskyDecomposition<T>::factors() const
+{
+	return llh_;
+}
+
+
+
+// --- QrDecomposition -----------------------------------------------------------------------------
+
+/** constructs an empty decomposition.
+ */
+template <typename T>
+QrDecomposition<T>::QrDecomposition():
+	qr_(),
+	tau_()
+{
+}
+
+
+
+/** decomposes m x n matrix @a a, with m >= n.
+ */
+template <typename T>
+template <typename S>
+QrDecomposition<T>::QrDecomposition(const Matrix<T, S>& a):
+	qr_(),
+	tau_()
+{
+	factorize(a);
+}
+
+
+
+/** decomposes m x n matrix @a a, with m >= n, replacing the previous decomposition.
+ *
+ *  @par Complexity:
+ *		O(m * n²)
+ *
+ *  @par Exception safety:
+ *		strong guarantee.
+ *
+ *  @throw an exception is thrown if @a a has fewer rows than columns.
+ */
+template <typename T>
+template <typename S>
+void QrDecomposition<T>::factorize(const Matrix<T, S>& a)
+{
+	LASS_ENFORCE(a.rows() >= a.columns());
+
+	TMatrix qr(a);
+	TScales tau(qr.columns());
+	impl::qrFactorize(qr.storage().data(), qr.rows(), qr.columns(), tau.data());
+
+	qr_.swap(qr);
+	tau_.swap(tau);
+}
+
+
+
+template <typename T> inline
+typename QrDecomposition<T>::TSize
+QrDecomposition<T>::rows() const
+{
+	return qr_.rows();
+}
+
+
+
+template <typename T> inline
+typename QrDecomposition<T>::TSize
+QrDecomposition<T>::columns() const
+{
+	return qr_.columns();
+}
+
+
+
+template <typename T> inline
+bool QrDecomposition<T>::isEmpty() const
+{
+	return qr_.isEmpty();
+}
+
+
+
+/** finds X that minimizes |A X - B| for all columns of B at once.
+ *
+ *  @param bx [in,out] as input, the m x k matrix B. As output, the n x k matrix X.
+ *
+ *  @par Complexity:
+ *		O(m * n * bx.columns())
+ *
+ *  @throw an exception is thrown if dimensions don't match (this->rows() == bx.rows())
+ *  @throw util::SingularityError if A does not have full column rank.
+ */
+template <typename T>
+void QrDecomposition<T>::solve(TMatrix& bx) const
+{
+	LASS_ENFORCE(rows() == bx.rows());
+
+	const TSize n = columns();
+	for (TSize j = 0; j < n; ++j)
+	{
+		if (qr_(j, j) == T())
+		{
+			LASS_THROW_EX(util::SingularityError, "failed to solve matrix equation of rank deficient matrix");
+		}
+	}
+
+	const TSize nrhs = bx.columns();
+	impl::qrApplyAdjoint(qr_.storage().data(), rows(), n, tau_.data(), bx.storage().data(), nrhs);
+	impl::trsmUpper(n, nrhs, qr_.storage().data(), n, bx.storage().data(), nrhs);
+	bx.storage().resize(n, nrhs); // X is in the first n rows
+}
+
+
+
+/** upper triangular n x n matrix R.
+ */
+template <typename T>
+const typename QrDecomposition<T>::TMatrix
+QrDecomposition<T>::r() const
+{
+	const TSize n = columns();
+	TMatrix result(n, n);
+	for (TSize i = 0; i < n; ++i)
+	{
+		for (TSize j = i; j < n; ++j)
+		{
+			result(i, j) = qr_(i, j);
+		}
+	}
+	return result;
+}
+
+
+
+/** R in the upper triangle, and the Householder vectors v_j below the diagonal.
+ *  Q = H_0 H_1 ... H_{n-1}, with H_j = I - scales()[j] v_j v_j^H and v_j[j] = 1.
+ */
+template <typename T> inline
+const typename QrDecomposition<T>::TMatrix&
+QrDecomposition<T>::factors() const
+{
+	return qr_;
+}
+
+
+
+template <typename T> inline
+const typename QrDecomposition<T>::TScales&
+QrDecomposition<T>::scales() const
+{
+	return tau_;
+}
+
+}
+
+}
+
+#endif
+
+// EOF
@@ -215,6 +215,25 @@ RandomXorShift128Plus::TValue RandomXorShift128Plus::operator()()
 	return state_[1] + y;
 }
 
+/** draw last - first random numbers in [first, last)
+ */
+void RandomXorShift128Plus::fill(result_type* first, result_type* last)
+{
+	TValue s0 = state_[0];
+	TValue s1 = state_[1];
+	for (; first != last; ++first)
+	{
+		TValue x = s0;
+		const TValue y = s1;
+		s0 = y;
+		x ^= x << 23; // a
+		s1 = x ^ y ^ (x >> 17) ^ (y >> 26); // b, c
+		*first = s1 + y;
+	}
+	state_[0] = s0;
+	state_[1] = s1;
+}
+
 void RandomXorShift128Plus::seed(result_type seed)
 {
 	state_[0] = seed;
@@ -223,6 +242,261 @@ void RandomXorShift128Plus::seed(result_type seed)
 
 
 
+// --- RandomXoshiro256PlusPlus --------------------------------------------------------------------
+
+namespace
+{
+
+/** splitmix64, to expand a seed into a full state, as recommended by the xoshiro authors.
+ */
+num::Tuint64 splitMix64(num::Tuint64& x)
+{
+	num::Tuint64 z = (x += 0x9e3779b97f4a7c15);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+	return z ^ (z >> 31);
+}
+
+const num::Tuint64 xoshiro256Jump[4] = 
+{
+	0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c 
+};
+
+const num::Tuint64 xoshiro256LongJump[4] = 
+{
+	0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 
+};
+
+}
+
+/** default constructor.
+ *  will seed with default value
+ */
+RandomXoshiro256PlusPlus::RandomXoshiro256PlusPlus()
+{
+	seed(0);
+}
+
+
+
+/** construct with seed.
+ */
+RandomXoshiro256PlusPlus::RandomXoshiro256PlusPlus(result_type seed)
+{
+	this->seed(seed);
+}
+
+
+
+/** initializes with a seed.
+ */
+void RandomXoshiro256PlusPlus::seed(result_type seed)
+{
+	for (result_type& s : state_)
+	{
+		s = splitMix64(seed);
+	}
+}
+
+
+
+/** draw last - first random numbers in [first, last)
+ */
+void RandomXoshiro256PlusPlus::fill(result_type* first, result_type* last)
+{
+	RandomXoshiro256PlusPlus local = *this; // keeps the state out of memory, as it can't alias first
+	for (; first != last; ++first)
+	{
+		*first = local();
+	}
+	*this = local;
+}
+
+
+
+/** advance the generator by 2^128 draws.
+ */
+void RandomXoshiro256PlusPlus::jump()
+{
+	jump(xoshiro256Jump);
+}
+
+
+
+/** advance the generator by 2^192 draws.
+ */
+void RandomXoshiro256PlusPlus::longJump()
+{
+	jump(xoshiro256LongJump);
+}
+
+
+
+/** returns a copy of the generator, and long-jumps itself past the 2^192 draws of the copy.
+ */
+RandomXoshiro256PlusPlus RandomXoshiro256PlusPlus::split()
+{
+	RandomXoshiro256PlusPlus result = *this;
+	longJump();
+	return result;
+}
+
+
+
+void RandomXoshiro256PlusPlus::jump(const result_type (&polynomial)[4])
+{
+	result_type s[4] = { 0, 0, 0, 0 };
+	for (result_type word : polynomial)
+	{
+		for (int b = 0; b < 64; ++b)
+		{
+			if (word & (result_type(1) << b))
+			{
+				for (size_t k = 0; k < 4; ++k)
+				{
+					s[k] ^= state_[k];
+				}
+			}
+			(*this)();
+		}
+	}
+	std::copy(s, s + 4, state_);
+}
+
+
+
+// --- RandomXoshiro256PlusPlusX8 ------------------------------------------------------------------
+
+/** default constructor.
+ *  will seed with default value
+ */
+RandomXoshiro256PlusPlusX8::RandomXoshiro256PlusPlusX8()
+{
+	seed(0);
+}
+
+
+
+/** construct with seed.
+ */
+RandomXoshiro256PlusPlusX8::RandomXoshiro256PlusPlusX8(result_type seed)
+{
+	this->seed(seed);
+}
+
+
+
+/** initializes with a seed, lane k being RandomXoshiro256PlusPlus(seed) jumped k times.
+ */
+void RandomXoshiro256PlusPlusX8::seed(result_type seed)
+{
+	RandomXoshiro256PlusPlus lane(seed);
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		result_type s[4];
+		lane.getState(s);
+		for (size_t k = 0; k < 4; ++k)
+		{
+			state_[k][j] = s[k];
+		}
+		lane.jump();
+	}
+	index_ = numLanes;
+}
+
+
+
+/** draw last - first random numbers in [first, last)
+ */
+void RandomXoshiro256PlusPlusX8::fill(result_type* first, result_type* last)
+{
+	while (index_ < numLanes && first != last)
+	{
+		*first++ = buffer_[index_++];
+	}
+	result_type state[4][numLanes]; // can't alias first
+	std::copy(&state_[0][0], &state_[0][0] + 4 * numLanes, &state[0][0]);
+	while (static_cast<size_t>(last - first) >= numLanes)
+	{
+		step(state, first);
+		first += numLanes;
+	}
+	std::copy(&state[0][0], &state[0][0] + 4 * numLanes, &state_[0][0]);
+	if (first != last)
+	{
+		step(state_, buffer_);
+		index_ = 0;
+		while (first != last)
+		{
+			*first++ = buffer_[index_++];
+		}
+	}
+}
+
+
+
+/** advance all lanes by 2^192 draws, and drop buffered draws.
+ */
+void RandomXoshiro256PlusPlusX8::longJump()
+{
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		result_type s[4];
+		for (size_t k = 0; k < 4; ++k)
+		{
+			s[k] = state_[k][j];
+		}
+		RandomXoshiro256PlusPlus lane;
+		lane.setState(s, s + 4);
+		lane.longJump();
+		lane.getState(s);
+		for (size_t k = 0; k < 4; ++k)
+		{
+			state_[k][j] = s[k];
+		}
+	}
+	index_ = numLanes;
+}
+
+
+
+/** returns a copy of the generator, and long-jumps itself past the draws of the copy.
+ */
+RandomXoshiro256PlusPlusX8 RandomXoshiro256PlusPlusX8::split()
+{
+	RandomXoshiro256PlusPlusX8 result = *this;
+	longJump();
+	return result;
+}
+
+
+
+/** writes one draw of each lane to output, and advances all lanes.
+ */
+void RandomXoshiro256PlusPlusX8::step(result_type (&state)[4][numLanes], result_type* output)
+{
+	result_type* const s0 = state[0];
+	result_type* const s1 = state[1];
+	result_type* const s2 = state[2];
+	result_type* const s3 = state[3];
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		output[j] = impl::rotateLeft(s0[j] + s3[j], 23) + s0[j];
+	}
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		const result_type t = s1[j] << 17;
+		s2[j] ^= s0[j];
+		s3[j] ^= s1[j];
+		s1[j] ^= s2[j];
+		s0[j] ^= s3[j];
+		s2[j] ^= t;
+		s3[j] = impl::rotateLeft(s3[j], 45);
+	}
+}
+
+
+
 // --- RandomHalton --------------------------------------------------------------------------------
 
 RandomRadicalInverse::RandomRadicalInverse(size_t base) :
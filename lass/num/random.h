@@ -49,6 +49,9 @@
  *  - @ref RandomStandard : uses the C standard function rand().
  *  - @ref RandomParkMiller : Minimal Standard generator by Park and Miller.
  *  - @ref RandomMT19937 : uses a mersenne twister MT19937.
+ *  - @ref RandomXorShift128Plus : xorshift128+ generator.
+ *  - @ref RandomXoshiro256PlusPlus : xoshiro256++ generator, with jump ahead to split streams.
+ *  - @ref RandomXoshiro256PlusPlusX8 : eight interleaved xoshiro256++ lanes, for bulk generation.
  */
 
 #ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_RANDOM_H
@@ -229,6 +232,7 @@ public:
 	explicit RandomXorShift128Plus(result_type seed);
 
 	result_type operator()();
+	void fill(result_type* first, result_type* last);
 
 	void seed(result_type index);
 
@@ -237,6 +241,92 @@ private:
 };
 
 
+
+/** xoshiro256++ pseudorandom number generator
+ *  @ingroup Random
+ *
+ *  All-purpose 64-bit generator with 256 bits of state and a period of 2^256-1.  It passes all
+ *  known statistical tests, and is small and fast enough to give each task its own.
+ *
+ *  jump() advances the generator by 2^128 draws, longJump() by 2^192.  split() returns a copy of
+ *  the generator and long-jumps itself, so that the copy has a stream of 2^192 draws of its own.
+ *  To get results that don't depend on the number of threads, split a stream off for each work
+ *  item in a fixed order, rather than one for each thread.
+ *
+ *  <i>D. Blackman and S. Vigna, "Scrambled linear pseudorandom number generators", 
+ *  ACM Trans. Math. Softw. 47, 2021</i>, https://prng.di.unimi.it/
+ */
+class LASS_DLL RandomXoshiro256PlusPlus
+{
+public:
+	using result_type = num::Tuint64; /**< type of return value. */
+
+	static constexpr result_type min() { return 0; }   /**< minimum return value. */
+	static constexpr result_type max() { return 0xffffffffffffffff; }    /**< maximum return value. */
+
+	RandomXoshiro256PlusPlus();
+	explicit RandomXoshiro256PlusPlus(result_type seed);
+
+	void seed(result_type seed);
+
+	result_type operator()();
+	void fill(result_type* first, result_type* last);
+
+	void jump();
+	void longJump();
+	RandomXoshiro256PlusPlus split();
+
+	template <typename OutputIterator> OutputIterator getState(OutputIterator first) const;
+	template <typename InputIterator> void setState(InputIterator first, InputIterator last);
+
+private:
+	void jump(const result_type (&polynomial)[4]);
+
+	result_type state_[4];
+};
+
+
+
+/** eight xoshiro256++ generators drawn in turn, for bulk generation.
+ *  @ingroup Random
+ *
+ *  Draw n comes from lane n % 8, and lane k is a RandomXoshiro256PlusPlus with the same seed,
+ *  jumped k times.  Advancing all lanes at once is a loop the compiler can vectorize, which 
+ *  fill() uses to write numLanes draws at a time.  The sequence is the same, whether it's drawn 
+ *  by operator() or by fill().
+ *
+ *  split() returns a copy and long-jumps all lanes, like RandomXoshiro256PlusPlus::split().  Draws
+ *  that are already buffered stay with the copy.
+ */
+class LASS_DLL RandomXoshiro256PlusPlusX8
+{
+public:
+	using result_type = num::Tuint64; /**< type of return value. */
+
+	static constexpr result_type min() { return 0; }   /**< minimum return value. */
+	static constexpr result_type max() { return 0xffffffffffffffff; }    /**< maximum return value. */
+	static constexpr size_t numLanes = 8;
+
+	RandomXoshiro256PlusPlusX8();
+	explicit RandomXoshiro256PlusPlusX8(result_type seed);
+
+	void seed(result_type seed);
+
+	result_type operator()();
+	void fill(result_type* first, result_type* last);
+
+	void longJump();
+	RandomXoshiro256PlusPlusX8 split();
+
+private:
+	static void step(result_type (&state)[4][numLanes], result_type* output);
+
+	result_type state_[4][numLanes];
+	result_type buffer_[numLanes];
+	size_t index_;
+};
+
+
 /** Halton sequence
  *  @ingroup Random
  *
@@ -60,6 +60,15 @@ namespace lass
 {
 namespace num
 {
+namespace impl
+{
+
+inline Tuint64 rotateLeft(Tuint64 x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+}
 
 // --- RandomStandard ------------------------------------------------------------------------------
 
@@ -232,6 +241,58 @@ void RandomMT19937::setState(InputIterator first, InputIterator last)
 
 
 
+// --- RandomXoshiro256PlusPlus --------------------------------------------------------------------
+
+/** draw a random number
+ */
+inline RandomXoshiro256PlusPlus::result_type RandomXoshiro256PlusPlus::operator()()
+{
+	const result_type result = impl::rotateLeft(state_[0] + state_[3], 23) + state_[0];
+	const result_type t = state_[1] << 17;
+	state_[2] ^= state_[0];
+	state_[3] ^= state_[1];
+	state_[1] ^= state_[2];
+	state_[0] ^= state_[3];
+	state_[2] ^= t;
+	state_[3] = impl::rotateLeft(state_[3], 45);
+	return result;
+}
+
+
+
+template <typename OutputIterator>
+OutputIterator RandomXoshiro256PlusPlus::getState(OutputIterator first) const
+{
+	return std::copy(state_, state_ + 4, first);
+}
+
+
+
+template <typename InputIterator>
+void RandomXoshiro256PlusPlus::setState(InputIterator first, InputIterator last)
+{
+	[[maybe_unused]] result_type* end = std::copy(first, last, state_);
+	LASS_ASSERT(end == state_ + 4);
+}
+
+
+
+// --- RandomXoshiro256PlusPlusX8 ------------------------------------------------------------------
+
+/** draw a random number
+ */
+inline RandomXoshiro256PlusPlusX8::result_type RandomXoshiro256PlusPlusX8::operator()()
+{
+	if (index_ == numLanes)
+	{
+		step(state_, buffer_);
+		index_ = 0;
+	}
+	return buffer_[index_++];
+}
+
+
+
 }
 
 }
@@ -0,0 +1,146 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+/** @class lass::num::SparseMatrix
+ *  @brief a sparse matrix in compressed sparse row (CSR) format.
+ *
+ *  Only the nonzero elements are stored, row by row: values() holds them in order of increasing
+ *  row, and of increasing column within a row, columnIndices() holds their columns, and the
+ *  elements of row @c i are in [rowPointers()[i], rowPointers()[i + 1]). The compressed sparse 
+ *  column (CSC) format of a matrix is the CSR format of its transpose, see transposed().
+ *
+ *  Multiplying with a Vector gives a vector expression, just like a dense Matrix does. Assigning
+ *  the product to a storage vector evaluates it in parallel:
+ *
+ *  @code
+ *  num::SparseMatrix<double> a(n, n, entries.begin(), entries.end());
+ *  num::Vector<double> y;
+ *  y = a * x;
+ *  @endcode
+ *
+ *  See conjugateGradient() and biConjugateGradientStabilized() to solve sparse systems.
+ */
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_SPARSE_MATRIX_H
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_SPARSE_MATRIX_H
+
+#include "num_common.h"
+#include "matrix_vector.h"
+#include "impl/sparse_expressions.h"
+
+#include <vector>
+
+namespace lass
+{
+namespace num
+{
+
+template <typename T>
+class SparseMatrix
+{
+public:
+
+	typedef SparseMatrix<T> TSelf;
+	typedef typename util::CallTraits<T>::TValue TValue;
+	typedef typename util::CallTraits<T>::TParam TParam;
+	typedef num::NumTraits<T> TNumTraits;
+	typedef size_t TSize;
+	typedef std::vector<TSize> TIndices;
+	typedef std::vector<T> TValues;
+
+	/** a nonzero element at (row, column), to build a SparseMatrix from.
+	 */
+	struct Entry
+	{
+		TSize row;
+		TSize column;
+		TValue value;
+	};
+
+	SparseMatrix();
+	SparseMatrix(TSize rows, TSize columns);
+	template <typename InputIterator> SparseMatrix(TSize rows, TSize columns, 
+		InputIterator firstEntry, InputIterator lastEntry);
+	SparseMatrix(TSize rows, TSize columns, TIndices rowPointers, TIndices columnIndices, TValues values);
+	template <typename S> explicit SparseMatrix(const Matrix<T, S>& dense);
+
+	TSize rows() const;
+	TSize columns() const;
+	TSize nonZeros() const;
+
+	const TValue operator()(TSize row, TSize column) const;
+
+	bool isEmpty() const;
+	bool isSquare() const;
+
+	const SparseMatrix<T> transposed() const;
+	const Vector<T> diagonal() const;
+	const Matrix<T> dense() const;
+
+	const TIndices& rowPointers() const;
+	const TIndices& columnIndices() const;
+	const TValues& values() const;
+	TValues& values();
+
+	void swap(SparseMatrix<T>& other);
+
+private:
+
+	TIndices rowPointers_;
+	TIndices columnIndices_;
+	TValues values_;
+	TSize columns_;
+};
+
+template <typename T, typename S>
+const Vector<T, impl::VSparseProd<T, SparseMatrix<T>, S> > operator*(const SparseMatrix<T>& a, const Vector<T, S>& b);
+
+}
+
+}
+
+#include "sparse_matrix.inl"
+
+#endif
+
+// EOF
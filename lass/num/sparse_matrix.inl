@@ -0,0 +1,443 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_NUM_SPARSE_MATRIX_INL
+#define LASS_GUARDIAN_OF_INCLUSION_NUM_SPARSE_MATRIX_INL
+
+#include "num_common.h"
+#include "sparse_matrix.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace lass
+{
+namespace num
+{
+
+/** constructs an empty matrix
+ *
+ *  @par Exception safety:
+ *		strong guarantee.
+ */
+template <typename T>
+SparseMatrix<T>::SparseMatrix():
+	rowPointers_(1, 0),
+	columnIndices_(),
+	values_(),
+	columns_(0)
+{
+}
+
+
+
+/** constructs a @a rows x @a columns matrix without nonzero elements.
+ *
+ *  @par Exception safety:
+ *		strong guarantee.
+ */
+template <typename T>
+SparseMatrix<T>::SparseMatrix(TSize rows, TSize columns):
+	rowPointers_(rows + 1, 0),
+	columnIndices_(),
+	values_(),
+	columns_(columns)
+{
+}
+
+
+
+/** constructs a @a rows x @a columns matrix from a range of Entry elements, in any order.
+ *
+ *  Values of entries with the same row and column are summed, which is convenient to assemble
+ *  finite element or finite volume systems.
+ *
+ *  @par Complexity:
+ *		O(N log N), with N the number of entries.
+ *
+ *  @throw an exception is thrown if an entry is out of bounds.
+ */
+template <typename T>
+template <typename InputIterator>
+SparseMatrix<T>::SparseMatrix(TSize rows, TSize columns, InputIterator firstEntry, InputIterator lastEntry):
+	rowPointers_(rows + 1, 0),
+	columnIndices_(),
+	values_(),
+	columns_(columns)
+{
+	const std::vector<Entry> entries(firstEntry, lastEntry);
+	for (const Entry& entry : entries)
+	{
+		LASS_ENFORCE(entry.row < rows && entry.column < columns);
+		++rowPointers_[entry.row + 1];
+	}
+	for (TSize i = 0; i < rows; ++i)
+	{
+		rowPointers_[i + 1] += rowPointers_[i];
+	}
+
+	TIndices next(rowPointers_.begin(), rowPointers_.end() - 1);
+	columnIndices_.resize(entries.size());
+	values_.resize(entries.size());
+	for (const Entry& entry : entries)
+	{
+		const TSize k = next[entry.row]++;
+		columnIndices_[k] = entry.column;
+		values_[k] = entry.value;
+	}
+
+	// sort rows by column and merge duplicates, compacting in place.
+	std::vector< std::pair<TSize, T> > row;
+	TSize n = 0;
+	for (TSize i = 0; i < rows; ++i)
+	{
+		const TSize first = rowPointers_[i];
+		const TSize last = rowPointers_[i + 1];
+		row.clear();
+		for (TSize k = first; k < last; ++k)
+		{
+			row.emplace_back(columnIndices_[k], values_[k]);
+		}
+		std::sort(row.begin(), row.end(), 
+			[](const std::pair<TSize, T>& a, const std::pair<TSize, T>& b) { return a.first < b.first; });
+		rowPointers_[i] = n;
+		for (const auto& element : row)
+		{
+			if (n > rowPointers_[i] && columnIndices_[n - 1] == element.first)
+			{
+				values_[n - 1] += element.second;
+			}
+			else
+			{
+				columnIndices_[n] = element.first;
+				values_[n] = element.second;
+				++n;
+			}
+		}
+	}
+	rowPointers_[rows] = n;
+	columnIndices_.resize(n);
+	values_.resize(n);
+}
+
+
+
+/** constructs a @a rows x @a columns matrix directly from its CSR arrays.
+ *
+ *  @throw an exception is thrown if the arrays are not consistent, or if the columns of a row are 
+ *		not strictly increasing.
+ */
+template <typename T>
+SparseMatrix<T>::SparseMatrix(TSize rows, TSize columns, TIndices rowPointers, TIndices columnIndices, TValues values):
+	rowPointers_(std::move(rowPointers)),
+	columnIndices_(std::move(columnIndices)),
+	values_(std::move(values)),
+	columns_(columns)
+{
+	LASS_ENFORCE(rowPointers_.size() == rows + 1 && rowPointers_.front() == 0);
+	LASS_ENFORCE(rowPointers_.back() == columnIndices_.size() && columnIndices_.size() == values_.size());
+	for (TSize i = 0; i < rows; ++i)
+	{
+		LASS_ENFORCE(rowPointers_[i] <= rowPointers_[i + 1]);
+		for (TSize k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k)
+		{
+			LASS_ENFORCE(columnIndices_[k] < columns);
+			LASS_ENFORCE(k == rowPointers_[i] || columnIndices_[k - 1] < columnIndices_[k]);
+		}
+	}
+}
+
+
+
+/** constructs a sparse matrix from the nonzero elements of a dense one.
+ */
+template <typename T>
+template <typename S>
+SparseMatrix<T>::SparseMatrix(const Matrix<T, S>& dense):
+	rowPointers_(dense.rows() + 1, 0),
+	columnIndices_(),
+	values_(),
+	columns_(dense.columns())
+{
+	const TSize rows = dense.rows();
+	for (TSize i = 0; i < rows; ++i)
+	{
+		for (TSize j = 0; j < columns_; ++j)
+		{
+			const TValue x = dense(i, j);
+			if (!(x == TNumTraits::zero))
+			{
+				columnIndices_.push_back(j);
+				values_.push_back(x);
+			}
+		}
+		rowPointers_[i + 1] = values_.size();
+	}
+}
+
+
+
+template <typename T> inline
+typename SparseMatrix<T>::TSize
+SparseMatrix<T>::rows() const
+{
+	return rowPointers_.size() - 1;
+}
+
+
+
+template <typename T> inline
+typename SparseMatrix<T>::TSize
+SparseMatrix<T>::columns() const
+{
+	return columns_;
+}
+
+
+
+/** number of stored elements.
+ */
+template <typename T> inline
+typename SparseMatrix<T>::TSize
+SparseMatrix<T>::nonZeros() const
+{
+	return values_.size();
+}
+
+
+
+/** returns element (@a row, @a column), or zero if it isn't stored.
+ *
+ *  @par Complexity:
+ *		O(log N), with N the number of nonzeros in @a row.
+ */
+template <typename T>
+const typename SparseMatrix<T>::TValue
+SparseMatrix<T>::operator()(TSize row, TSize column) const
+{
+	LASS_ASSERT(row < rows() && column < columns());
+	const auto first = columnIndices_.begin() + static_cast<std::ptrdiff_t>(rowPointers_[row]);
+	const auto last = columnIndices_.begin() + static_cast<std::ptrdiff_t>(rowPointers_[row + 1]);
+	const auto i = std::lower_bound(first, last, column);
+	if (i == last || *i != column)
+	{
+		return TNumTraits::zero;
+	}
+	return values_[static_cast<TSize>(i - columnIndices_.begin())];
+}
+
+
+
+template <typename T> inline
+bool SparseMatrix<T>::isEmpty() const
+{
+	return rows() == 0 || columns_ == 0;
+}
+
+
+
+template <typename T> inline
+bool SparseMatrix<T>::isSquare() const
+{
+	return rows() == columns_;
+}
+
+
+
+/** returns the transpose, which holds the CSC format of this matrix.
+ *
+ *  @par Complexity:
+ *		O(rows + columns + nonZeros)
+ */
+template <typename T>
+const SparseMatrix<T> SparseMatrix<T>::transposed() const
+{
+	const TSize m = rows();
+	TIndices rowPointers(columns_ + 1, 0);
+	for (TSize column : columnIndices_)
+	{
+		++rowPointers[column + 1];
+	}
+	for (TSize j = 0; j < columns_; ++j)
+	{
+		rowPointers[j + 1] += rowPointers[j];
+	}
+	TIndices next(rowPointers.begin(), rowPointers.end() - 1);
+	TIndices columnIndices(nonZeros());
+	TValues values(nonZeros());
+	for (TSize i = 0; i < m; ++i)
+	{
+		for (TSize k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k)
+		{
+			const TSize dest = next[columnIndices_[k]]++;
+			columnIndices[dest] = i;
+			values[dest] = values_[k];
+		}
+	}
+	SparseMatrix<T> result;
+	result.rowPointers_.swap(rowPointers);
+	result.columnIndices_.swap(columnIndices);
+	result.values_.swap(values);
+	result.columns_ = m;
+	return result;
+}
+
+
+
+/** returns the main diagonal, as a vector of min(rows, columns) elements.
+ */
+template <typename T>
+const Vector<T> SparseMatrix<T>::diagonal() const
+{
+	const TSize n = std::min(rows(), columns_);
+	Vector<T> result(n);
+	for (TSize i = 0; i < n; ++i)
+	{
+		result[i] = (*this)(i, i);
+	}
+	return result;
+}
+
+
+
+/** returns a dense copy.
+ */
+template <typename T>
+const Matrix<T> SparseMatrix<T>::dense() const
+{
+	const TSize m = rows();
+	Matrix<T> result(m, columns_);
+	for (TSize i = 0; i < m; ++i)
+	{
+		for (TSize k = rowPointers_[i]; k < rowPointers_[i + 1]; ++k)
+		{
+			result(i, columnIndices_[k]) = values_[k];
+		}
+	}
+	return result;
+}
+
+
+
+template <typename T> inline
+const typename SparseMatrix<T>::TIndices&
+SparseMatrix<T>::rowPointers() const
+{
+	return rowPointers_;
+}
+
+
+
+template <typename T> inline
+const typename SparseMatrix<T>::TIndices&
+SparseMatrix<T>::columnIndices() const
+{
+	return columnIndices_;
+}
+
+
+
+template <typename T> inline
+const typename SparseMatrix<T>::TValues&
+SparseMatrix<T>::values() const
+{
+	return values_;
+}
+
+
+
+/** access to the nonzero values, to change them while keeping the sparsity pattern.
+ */
+template <typename T> inline
+typename SparseMatrix<T>::TValues&
+SparseMatrix<T>::values()
+{
+	return values_;
+}
+
+
+
+/** @par Complexity:
+ *		O(1)
+ *
+ *  @par Exception safety:
+ *		no-fail
+ */
+template <typename T>
+void SparseMatrix<T>::swap(SparseMatrix<T>& other)
+{
+	rowPointers_.swap(other.rowPointers_);
+	columnIndices_.swap(other.columnIndices_);
+	values_.swap(other.values_);
+	std::swap(columns_, other.columns_);
+}
+
+
+
+/** multiply sparse matrix with vector.
+ *  @relates lass::num::SparseMatrix
+ *
+ *  Assigning the result to a storage vector evaluates the rows in parallel.
+ *
+ *  @relatesalso lass::num::Vector
+ *
+ *  @par Complexity:
+ *		O(1), the product is evaluated lazily in O(nonZeros)
+ *
+ *  @throw an exception is thrown if dimensions don't match (a.columns() == b.size())
+ */
+template <typename T, typename S>
+const Vector<T, impl::VSparseProd<T, SparseMatrix<T>, S> > operator*(const SparseMatrix<T>& a, const Vector<T, S>& b)
+{
+	LASS_NUM_MATRIX_VECTOR_ENFORCE_ADJACENT_DIMENSION(a, b);
+	typedef impl::VSparseProd<T, SparseMatrix<T>, S> TExpression;
+	return Vector<T, TExpression>(TExpression(a, b.storage()));
+}
+
+}
+
+}
+
+#endif
+
+// EOF
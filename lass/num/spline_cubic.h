@@ -52,6 +52,7 @@
 
 #include "num_common.h"
 #include "spline.h"
+#include "impl/spline_lookup.h"
 
 namespace lass
 {
@@ -89,6 +90,11 @@ public:
 	bool isEmpty() const override;
 	const TControlRange controlRange() const override;
 
+	template <typename ScalarInputIterator, typename DataOutputIterator>
+	DataOutputIterator evaluate(ScalarInputIterator first, ScalarInputIterator last, DataOutputIterator output) const;
+
+	void setLookupCells(size_t numCells);
+
 private:
 
 	struct Node
@@ -105,8 +111,10 @@ private:
 
 	void init();
 	const TNodeConstIterator findNode(TScalar iX) const;
+	static const TData evaluateNode(const Node& node, TScalar x);
 
 	TNodes nodes_;
+	impl::SplineLookup<TScalar> lookup_;
 	size_t dataDimension_;
 };
 
@@ -51,7 +51,9 @@
 #include "impl/matrix_solve.h"
 #include "../stde/extended_iterator.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <type_traits>
 
 namespace lass
 {
@@ -154,14 +156,7 @@ const typename SplineCubic<S, D, T>::TData
 SplineCubic<S, D, T>::operator ()(TScalar iX) const
 {
 	LASS_ASSERT(!isEmpty());
-
-	const TNodeConstIterator n = findNode(iX);
-	const TScalar s = iX - n->x;
-	TData result(n->d);
-	TDataTraits::multiplyAccumulate(result, n->c, s);
-	TDataTraits::multiplyAccumulate(result, n->b, num::sqr(s));
-	TDataTraits::multiplyAccumulate(result, n->a, num::cubic(s));
-	return result;
+	return evaluateNode(*findNode(iX), iX);
 }
 
 
@@ -317,6 +312,87 @@ SplineCubic<S, D, T>::controlRange() const
 
 
 
+/** Get the data values that correspond with a range of control values.
+ *
+ *  Writes (*this)(x) to @a output for each x in [@a first, @a last).
+ *  Each control value is first looked for near the node of the previous one, so that runs of
+ *  sorted or nearby control values don't need a full search.  The lookups are done in chunks,
+ *  and the polynomials of a chunk are evaluated in a loop of their own, that the compiler can 
+ *  vectorize for scalar data.
+ *
+ *  @pre this->isEmpty() == false
+ *
+ *  @return @a output advanced past the last data value.
+ *
+ *  @par Complexity: 
+ *		O(D * M) for M sorted or clustered control values, O(D * M * log(N)) otherwise, with 
+ *		@arg D = a figure that indicates the complexity of operations on data values.
+ *				 Is most probably linear with the dimension of the data value
+ *		@arg N = number of nodes
+ */
+template <typename S, typename D, typename T>
+template <typename ScalarInputIterator, typename DataOutputIterator>
+DataOutputIterator SplineCubic<S, D, T>::evaluate(
+		ScalarInputIterator first, ScalarInputIterator last, DataOutputIterator output) const
+{
+	LASS_ASSERT(!isEmpty());
+
+	enum { chunkSize = 64 };
+	TScalar xs[chunkSize];
+	size_t indices[chunkSize];
+	typename impl::SplineLookup<TScalar>::Cursor cursor;
+	while (first != last)
+	{
+		size_t m = 0;
+		for (; m < chunkSize && first != last; ++m)
+		{
+			xs[m] = *first++;
+		}
+		lookup_.find(xs, m, indices, cursor);
+
+		if constexpr (std::is_same_v<TData, TScalar>)
+		{
+			const Node* const nodes = &nodes_[0];
+			TScalar ys[chunkSize];
+			for (size_t k = 0; k < m; ++k)
+			{
+				const Node& node = nodes[indices[k]];
+				const TScalar s = xs[k] - node.x;
+				ys[k] = node.d + node.c * s + node.b * num::sqr(s) + node.a * num::cubic(s);
+			}
+			output = std::copy(ys, ys + m, output);
+		}
+		else
+		{
+			for (size_t k = 0; k < m; ++k)
+			{
+				*output++ = evaluateNode(nodes_[indices[k]], xs[k]);
+			}
+		}
+	}
+	return output;
+}
+
+
+
+/** Use a uniform grid of @a numCells cells over the control range to find nodes.
+ *
+ *  By default, a node is found by binary search in O(log N).  With a grid, it's looked up
+ *  in the cell of the control value, and from there it takes as many steps as there are nodes
+ *  in that cell.  About as many cells as nodes is a good choice if nodes are evenly spread.
+ *  Use zero to go back to binary search.
+ *
+ *  @par complexity: 
+ *		O(numCells * log(N))
+ */
+template <typename S, typename D, typename T>
+void SplineCubic<S, D, T>::setLookupCells(size_t numCells)
+{
+	lookup_.setNumCells(numCells);
+}
+
+
+
 // --- private -------------------------------------------------------------------------------------
 
 template <typename S, typename D, typename T>
@@ -353,6 +429,13 @@ void SplineCubic<S, D, T>::init()
 		}
 	}
 
+	std::vector<TScalar> controls(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		controls[i] = nodes_[i].x;
+	}
+	lookup_ = impl::SplineLookup<TScalar>(controls.begin(), controls.end(), n - 2);
+
 	if (n == 2)
 	{
 		// linear interpolation between node 0 and 1.
@@ -449,7 +532,7 @@ void SplineCubic<S, D, T>::init()
 }
 
 
-/** binary search to find node that belongs to iX
+/** find node that belongs to iX
  *
  *  @return
  *  @arg the index @a i if @a iX is in the interval [@c nodes_[i].x, @c nodes_[i+1].x)
@@ -457,48 +540,28 @@ void SplineCubic<S, D, T>::init()
  *  @arg @c nodes_.size()-2 if @a iX is greater than @c nodes_[nodes_.size()-1].x
  *
  *  @par complexity: 
- *		O(log N)
+ *		O(log N), or O(1) with evenly spread nodes and a lookup grid.
  */
 template <typename S, typename D, typename T>
 const typename SplineCubic<S, D, T>::TNodeConstIterator
 SplineCubic<S, D, T>::findNode(TScalar iX) const
 {
-	const typename TNodes::size_type size = nodes_.size();
 	LASS_ASSERT(nodes_.size() >= 2);
+	return nodes_.begin() + static_cast<std::ptrdiff_t>(lookup_.find(iX));
+}
 
-	// early outs
-	//
-	if (iX < nodes_[1].x)
-	{
-		return nodes_.begin();
-	}
-	if (iX >= nodes_[size - 2].x)
-	{
-		return stde::prev(nodes_.end(), 2);
-	}
-
-	// binary search
-	//
-	TNodeConstIterator first = nodes_.begin();
-	TNodeConstIterator last = nodes_.end();
-	while (stde::next(first) != last)
-	{
-		TNodeConstIterator middle = stde::next(first, std::distance(first, last) / 2);
-		LASS_ASSERT(middle != first && middle != last);
 
-		if (middle->x <= iX)
-		{
-			first = middle;
-		}
-		else
-		{
-			last = middle;
-		}
-		LASS_ASSERT(first != last);
-	}
 
-	LASS_ASSERT(first->x <= iX && last->x > iX);
-	return first;
+template <typename S, typename D, typename T>
+const typename SplineCubic<S, D, T>::TData
+SplineCubic<S, D, T>::evaluateNode(const Node& node, TScalar x)
+{
+	const TScalar s = x - node.x;
+	TData result(node.d);
+	TDataTraits::multiplyAccumulate(result, node.c, s);
+	TDataTraits::multiplyAccumulate(result, node.b, num::sqr(s));
+	TDataTraits::multiplyAccumulate(result, node.a, num::cubic(s));
+	return result;
 }
 
 
@@ -49,6 +49,9 @@
 #include "spline_linear.h"
 #include "../stde/extended_iterator.h"
 
+#include <algorithm>
+#include <type_traits>
+
 namespace lass
 {
 namespace num
@@ -149,13 +152,7 @@ const typename SplineLinear<S, D, T>::TData
 SplineLinear<S, D, T>::operator ()(TScalar iX) const
 {
 	LASS_ASSERT(!isEmpty());
-
-	const typename TNodes::const_iterator n = findNode(iX);
-	const TScalar dx = iX - n->x;
-
-	TData result(n->y);
-	TDataTraits::multiplyAccumulate(result, n->dy, dx);
-	return result;
+	return evaluateNode(*findNode(iX), iX);
 }
 
 
@@ -301,6 +298,86 @@ SplineLinear<S, D, T>::controlRange() const
 
 
 
+/** Get the data values that correspond with a range of control values.
+ *
+ *  Writes (*this)(x) to @a output for each x in [@a first, @a last).
+ *  Each control value is first looked for near the node of the previous one, so that runs of
+ *  sorted or nearby control values don't need a full search.  The lookups are done in chunks,
+ *  and the interpolation of a chunk is done in a loop of its own, that the compiler can 
+ *  vectorize for scalar data.
+ *
+ *  @pre this->isEmpty() == false
+ *
+ *  @return @a output advanced past the last data value.
+ *
+ *  @par complexity: 
+ *		O(D * M) for M sorted or clustered control values, O(D * M * log(N)) otherwise, with 
+ *		@arg D = a figure that indicates the complexity of operations on data values.
+ *				 Is most probably linear with the dimension of the data value
+ *		@arg N = number of nodes
+ */
+template <typename S, typename D, typename T>
+template <typename ScalarInputIterator, typename DataOutputIterator>
+DataOutputIterator SplineLinear<S, D, T>::evaluate(
+		ScalarInputIterator first, ScalarInputIterator last, DataOutputIterator output) const
+{
+	LASS_ASSERT(!isEmpty());
+
+	enum { chunkSize = 64 };
+	TScalar xs[chunkSize];
+	size_t indices[chunkSize];
+	typename impl::SplineLookup<TScalar>::Cursor cursor;
+	while (first != last)
+	{
+		size_t m = 0;
+		for (; m < chunkSize && first != last; ++m)
+		{
+			xs[m] = *first++;
+		}
+		lookup_.find(xs, m, indices, cursor);
+
+		if constexpr (std::is_same_v<TData, TScalar>)
+		{
+			const Node* const nodes = &nodes_[0];
+			TScalar ys[chunkSize];
+			for (size_t k = 0; k < m; ++k)
+			{
+				const Node& node = nodes[indices[k]];
+				ys[k] = node.y + node.dy * (xs[k] - node.x);
+			}
+			output = std::copy(ys, ys + m, output);
+		}
+		else
+		{
+			for (size_t k = 0; k < m; ++k)
+			{
+				*output++ = evaluateNode(nodes_[indices[k]], xs[k]);
+			}
+		}
+	}
+	return output;
+}
+
+
+
+/** Use a uniform grid of @a numCells cells over the control range to find nodes.
+ *
+ *  By default, a node is found by binary search in O(log N).  With a grid, it's looked up
+ *  in the cell of the control value, and from there it takes as many steps as there are nodes
+ *  in that cell.  About as many cells as nodes is a good choice if nodes are evenly spread.
+ *  Use zero to go back to binary search.
+ *
+ *  @par complexity: 
+ *		O(numCells * log(N))
+ */
+template <typename S, typename D, typename T>
+void SplineLinear<S, D, T>::setLookupCells(size_t numCells)
+{
+	lookup_.setNumCells(numCells);
+}
+
+
+
 // --- private -------------------------------------------------------------------------------------
 
 template <typename S, typename D, typename T>
@@ -344,58 +421,44 @@ void SplineLinear<S, D, T>::init()
 
 	// extend last node with same derivative as last edge.
 	stde::prev(end)->dy = stde::prev(end, 2)->dy;
+
+	std::vector<TScalar> controls;
+	controls.reserve(size);
+	for (const Node& node : nodes_)
+	{
+		controls.push_back(node.x);
+	}
+	lookup_ = impl::SplineLookup<TScalar>(controls.begin(), controls.end(), size - 1);
 }
 
 
 
-/** binary search to find node that belongs to iX
+/** find node that belongs to iX
  *
  *  @return
  *  @arg the index @a i if @a iX is in the interval [@c nodes_[i].x, @c nodes_[i+1].x)
  *  @arg 0 if @a iX is smaller than @c nodes_[0].x</tt>
- *  @arg @c nodes_.size()-2 if @a iX is greater than @c nodes_[nodes_.size()-1].x
+ *  @arg @c nodes_.size()-1 if @a iX is greater than @c nodes_[nodes_.size()-1].x
  *
- *  complexity: O(ln N)
+ *  complexity: O(ln N), or O(1) with evenly spread nodes and a lookup grid.
  */
 template <typename S, typename D, typename T>
 const typename SplineLinear<S, D, T>::TNodeConstIterator
 SplineLinear<S, D, T>::findNode(TScalar iX) const
 {
 	LASS_ASSERT(nodes_.size() >= 2);
+	return nodes_.begin() + static_cast<std::ptrdiff_t>(lookup_.find(iX));
+}
 
-	// early outs
-	//
-	if (iX < nodes_.front().x)
-	{
-		return nodes_.begin();
-	}
-	if (iX >= nodes_.back().x)
-	{
-		return stde::prev(nodes_.end());
-	}
-
-	// binary search
-	//
-	TNodeConstIterator first = nodes_.begin();
-	TNodeConstIterator last = nodes_.end();
-	while (stde::next(first) != last)
-	{
-		TNodeConstIterator middle = stde::next(first, std::distance(first, last) / 2);
-		LASS_ASSERT(middle != first && middle != last);
 
-		if (middle->x <= iX)
-		{
-			first = middle;
-		}
-		else
-		{
-			last = middle;
-		}
-		LASS_ASSERT(first != last);
-	}
 
-	LASS_ASSERT(first->x <= iX && last->x > iX);
-	return first;
+template <typename S, typename D, typename T>
+const typename SplineLinear<S, D, T>::TData
+SplineLinear<S, D, T>::evaluateNode(const Node& node, TScalar x)
+{
+	TData result(node.y);
+	TDataTraits::multiplyAccumulate(result, node.dy, x - node.x);
+	return result;
 }
 
 
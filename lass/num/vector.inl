@@ -145,12 +145,8 @@ template <typename T, typename S>
 template <typename T2, typename S2>
 Vector<T, S>::Vector(const Vector<T2, S2>& iOther)
 {
-	TSize n = iOther.storage_.size();
-	storage_.resize(n);
-	for (TSize i = 0; i < n; ++i)
-	{
-		storage_[i] = iOther.storage_[i];
-	}
+	using impl::evaluateVector;
+	evaluateVector(storage_, iOther.storage_);
 }
 
 
@@ -169,12 +165,8 @@ template <typename T, typename S>
 template <typename T2, typename S2>
 Vector<T, S>& Vector<T, S>::operator=(const Vector<T2, S2>& iOther)
 {
-	TSize n = iOther.storage_.size();
-	storage_.resize(n);
-	for (TSize i = 0; i < n; ++i)
-	{
-		storage_[i] = iOther.storage_[i];
-	}
+	using impl::evaluateVector;
+	evaluateVector(storage_, iOther.storage_);
 	return *this;
 }
 
@@ -531,6 +523,8 @@ bool Vector<T, S>::isZero() const
 
 
 /** Return sum of all components of vector.
+ *
+ *  Components are added pairwise, so that the rounding error stays small for long vectors.
  *
  *  @par Complexity: 
  *		O(this->size())
@@ -539,13 +533,7 @@ template <typename T, typename S>
 const typename Vector<T, S>::TValue
 Vector<T, S>::sum() const
 {
-	const TSize n = storage_.size();
-	TValue result = TNumTraits::zero;
-	for (TSize i = 0; i < n; ++i)
-	{
-		result += storage_[i];
-	}
-	return result;
+	return impl::pairwiseSum<T>(storage_.size(), [this](TSize i) { return storage_[i]; }, S::parallel);
 }
 
 
@@ -608,13 +596,7 @@ template <typename T, typename S>
 const typename Vector<T, S>::TValue
 Vector<T, S>::squaredNorm() const
 {
-	const TSize n = storage_.size();
-	TValue result = TNumTraits::zero;
-	for (TSize i = 0; i < n; ++i)
-	{
-		result += num::sqr(storage_[i]);
-	}
-	return result;
+	return impl::pairwiseSum<T>(storage_.size(), [this](TSize i) { return num::sqr(storage_[i]); }, S::parallel);
 }
 
 
@@ -671,6 +653,23 @@ Vector<T, S>::reciprocal() const
 
 
 
+/** return a vector with @a iOperator applied to each component: v.transform(f)[i] == f(v[i]).
+ *
+ *  The result is evaluated serially and in order, so @a iOperator doesn't need to be thread safe.
+ *
+ *  @par Complexity: 
+ *		O(1)
+ */
+template <typename T, typename S>
+const Vector<T, impl::VFun<T, S> >
+Vector<T, S>::transform(T (*iOperator)(T))
+{
+	typedef impl::VFun<T, S> TExpression;
+	return Vector<T, TExpression>(TExpression(storage_, iOperator));
+}
+
+
+
 /** Project vector on this one
  *
  *  @pre this->size() == iB.size()
@@ -833,6 +832,8 @@ bool operator!=(const Vector<T, S1>& iA, const Vector<T, S2>& iB)
 /** dot product.
  *  @relates lass::num::Vector
  *
+ *  Products are added pairwise, like in Vector::sum.
+ *
  *  @pre iA.size() == iB.size()
  *
  *  @par Complexity: 
@@ -842,15 +843,7 @@ template <typename T, typename S1, typename S2>
 const T dot(const Vector<T, S1>& iA, const Vector<T, S2>& iB)
 {
 	LASS_NUM_VECTOR_ENFORCE_EQUAL_DIMENSION(iA, iB);
-	typedef typename Vector<T, S1>::TSize TSize;
-	const TSize n = iA.size();
-
-	T result = NumTraits<T>::zero;
-	for (TSize i = 0; i < n; ++i)
-	{
-		result += iA[i] * iB[i];
-	}
-	return result;
+	return impl::pairwiseSum<T>(iA.size(), [&iA, &iB](size_t i) { return iA[i] * iB[i]; }, S1::parallel && S2::parallel);
 }
 
 
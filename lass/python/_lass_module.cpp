@@ -49,6 +49,13 @@
 #include "export_traits_function.h"
 #include "callback_python.h"
 #include "pyobject_macros.h"
+#include "gil.h"
+#include "call_stats.h"
+#include "per_interpreter.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
 
 PY_DECLARE_MODULE_NAME( lassMod, "_lass")
 PY_MODULE_CLASS( lassMod, lass::python::PyObjectPlus )
@@ -62,13 +69,88 @@ PY_MODULE_CLASS( lassMod, lass::python::impl::PyCallback )
 namespace lass::python::impl
 {
 
-int initLassModule()
+namespace
 {
-	if (lassMod.module())
+
+std::map<std::string, size_t> shadowRegistryStatsDict()
+{
+	const ShadowRegistryStats stats = shadowRegistryStats();
+	return {
+		{ "lookups", stats.lookups },
+		{ "hits", stats.hits },
+		{ "intrusiveLookups", stats.intrusiveLookups },
+		{ "intrusiveHits", stats.intrusiveHits },
+		{ "size", stats.size },
+		{ "intrusiveSize", stats.intrusiveSize },
+		{ "capacity", stats.capacity },
+		{ "shards", stats.shards },
+	};
+}
+
+TPyObjPtr newDict()
+{
+	TPyObjPtr dict(PyDict_New());
+	if (!dict)
 	{
-		return 0;
+		fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
 	}
-	LockGIL lock;
+	return dict;
+}
+
+void setDictItem(const TPyObjPtr& dict, const char* key, const TPyObjPtr& value)
+{
+	if (!value || PyDict_SetItemString(dict.get(), key, value.get()) != 0)
+	{
+		fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+	}
+}
+
+template <typename T>
+void setDictItem(const TPyObjPtr& dict, const char* key, const T& value)
+{
+	setDictItem(dict, key, TPyObjPtr(pyBuildSimpleObject(value)));
+}
+
+TPyObjPtr callStatsDict()
+{
+	TPyObjPtr functions = newDict();
+	for (const CallStats& stats : callStats())
+	{
+		TPyObjPtr function = newDict();
+		setDictItem(function, "calls", stats.calls);
+		setDictItem(function, "overloadMisses", stats.overloadMisses);
+		setDictItem(function, "conversionTime", stats.conversionTime);
+		setDictItem(function, "calleeTime", stats.calleeTime);
+		setDictItem(functions, stats.name.c_str(), function);
+	}
+	TPyObjPtr result = newDict();
+	setDictItem(result, "enabled", callStatsEnabled());
+	setDictItem(result, "shadowCreations", shadowCreations());
+	setDictItem(result, "functions", functions);
+	return result;
+}
+
+}
+
+}
+
+PY_MODULE_FUNCTION_NAME_DOC( lassMod, lass::python::impl::shadowRegistryStatsDict, "shadowRegistryStats",
+	"Returns the counters of the registry mapping C++ objects on their shadow objects." )
+// callStatsDict builds Python objects itself, so it must hold on to the GIL.
+PY_MODULE_FUNCTION_GIL_EX( lassMod, lass::python::impl::callStatsDict, "callStats",
+	"Returns the call statistics of exported functions and methods, if Lass is built with Lass_WITH_PYTHON_CALL_STATS.",
+	lassPyImpl_function_lassMod_callStats, lass::python::GilPolicy::hold )
+PY_MODULE_FUNCTION_NAME_DOC( lassMod, lass::python::resetCallStats, "resetCallStats",
+	"Resets the call statistics of exported functions and methods." )
+
+namespace lass::python::impl
+{
+
+namespace
+{
+
+int doInitLassModule()
+{
 	TPyObjPtr mod(lassMod.inject());
 	if (!mod)
 	{
@@ -80,6 +162,17 @@ int initLassModule()
 		return -1;
 	}
 
+	// The state lass_python keeps for a subinterpreter must be released when the subinterpreter
+	// ends, which is when its _lass module goes away.
+	if (!isMainInterpreter())
+	{
+		TPyObjPtr sentinel(PyCapsule_New(&lassMod, "_lass._interpreterSentinel", [](PyObject*) { forgetInterpreter(); }));
+		if (!sentinel || PyModule_AddObjectRef(mod.get(), "_interpreterSentinel", sentinel.get()) != 0)
+		{
+			return -1;
+		}
+	}
+
 	// register lass containers with abstract base classes
 	// so that they will be recognized when using isinstance(x, collections.abc.Sequence)
 	//
@@ -131,3 +224,44 @@ int initLassModule()
 }
 
 }
+
+int initLassModule()
+{
+	// On free-threaded builds, several threads may race to create the first lass object.
+	// The module may already be visible in lassMod while it's still being injected, so that
+	// can't be used as flag. Objects created during injection call this reentrantly.
+	// Each interpreter gets its own _lass module.
+	static PerInterpreter<std::atomic<bool>> isInitialized;
+	static thread_local bool isInitializing = false;
+	static FreeThreadingMutex mutex;
+	if (isInitializing)
+	{
+		return 0;
+	}
+	LockGIL lock;
+	std::atomic<bool>& initialized = isInitialized.get();
+	if (initialized.load(std::memory_order_acquire))
+	{
+		return 0;
+	}
+	std::lock_guard<FreeThreadingMutex> guard(mutex);
+	if (initialized.load(std::memory_order_relaxed))
+	{
+		return 0;
+	}
+	if (lassMod.module())
+	{
+		initialized.store(true, std::memory_order_release);
+		return 0;
+	}
+	isInitializing = true;
+	const int result = doInitLassModule();
+	isInitializing = false;
+	if (result == 0)
+	{
+		initialized.store(true, std::memory_order_release);
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,242 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "python_common.h"
+#include "buffer_traits.h"
+
+namespace lass
+{
+namespace python
+{
+namespace impl
+{
+
+namespace
+{
+
+enum BufferKind
+{
+	bkNone,
+	bkSigned,
+	bkUnsigned,
+	bkFloat,
+	bkBool,
+};
+
+BufferKind bufferKind(char format)
+{
+	if (std::strchr("bhilqn", format))
+	{
+		return bkSigned;
+	}
+	if (std::strchr("BHILQN", format))
+	{
+		return bkUnsigned;
+	}
+	if (std::strchr("efd", format))
+	{
+		return bkFloat;
+	}
+	if (format == '?')
+	{
+		return bkBool;
+	}
+	return bkNone;
+}
+
+bool isNativeByteOrder(char order)
+{
+	switch (order)
+	{
+	case '@':
+	case '=':
+		return true;
+#if PY_LITTLE_ENDIAN
+	case '<':
+		return true;
+#else
+	case '>':
+	case '!':
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+/** True if items are laid out without gaps, in row-major (C) or column-major (F) @a order.
+ *  Dimensions of size 1 don't count, and empty arrays are always contiguous.
+ */
+bool isContiguousLayout(int ndim, const Py_ssize_t* shape, const Py_ssize_t* strides, Py_ssize_t itemsize, char order)
+{
+	for (int k = 0; k < ndim; ++k)
+	{
+		if (shape[k] == 0)
+		{
+			return true;
+		}
+	}
+	Py_ssize_t expected = itemsize;
+	for (int i = 0; i < ndim; ++i)
+	{
+		const int k = order == 'C' ? ndim - 1 - i : i;
+		if (shape[k] > 1 && strides[k] != expected)
+		{
+			return false;
+		}
+		expected *= shape[k];
+	}
+	return true;
+}
+
+}
+
+int fillBufferInfo(Py_buffer* view, PyObject* exporter, void* buf, Py_ssize_t length,
+	Py_ssize_t itemStride, const char* format, Py_ssize_t itemsize, Py_ssize_t components, bool readOnly, int flags)
+{
+	LASS_ASSERT(length >= 0 && components >= 1);
+	const Py_ssize_t shape[2] = { length, components };
+	const Py_ssize_t strides[2] = { itemStride, itemsize };
+	return fillBufferInfo(view, exporter, buf, components > 1 ? 2 : 1, shape, strides, format, itemsize, readOnly, flags);
+}
+
+int fillBufferInfo(Py_buffer* view, PyObject* exporter, void* buf, int ndim, const Py_ssize_t* shape,
+	const Py_ssize_t* strides, const char* format, Py_ssize_t itemsize, bool readOnly, int flags)
+{
+	LASS_ASSERT(view && exporter && ndim >= 1 && shape && strides);
+	view->obj = nullptr;
+	if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && readOnly)
+	{
+		PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+		return -1;
+	}
+	const bool isContiguous = isContiguousLayout(ndim, shape, strides, itemsize, 'C');
+	const bool isFortran = isContiguousLayout(ndim, shape, strides, itemsize, 'F');
+	const bool wantsStrides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES;
+	const bool wantsContiguous = (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS;
+	const bool wantsAnyContiguous = (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS;
+	const bool wantsFortran = (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS;
+	if ((!wantsStrides || wantsContiguous || (wantsAnyContiguous && !isFortran)) && !isContiguous)
+	{
+		PyErr_SetString(PyExc_BufferError, "Object is not contiguous because items are padded, request a strided buffer.");
+		return -1;
+	}
+	if (wantsFortran && !isFortran)
+	{
+		PyErr_SetString(PyExc_BufferError, "Object is not Fortran contiguous.");
+		return -1;
+	}
+
+	static char empty = 0;
+	Py_ssize_t* const shapeAndStrides = new Py_ssize_t[2 * static_cast<size_t>(ndim)];
+	Py_ssize_t len = itemsize;
+	for (int k = 0; k < ndim; ++k)
+	{
+		LASS_ASSERT(shape[k] >= 0);
+		shapeAndStrides[k] = shape[k];
+		shapeAndStrides[ndim + k] = strides[k];
+		len *= shape[k];
+	}
+
+	view->buf = buf ? buf : &empty;
+	view->obj = exporter;
+	Py_INCREF(exporter);
+	view->len = len;
+	view->readonly = readOnly ? 1 : 0;
+	view->itemsize = itemsize;
+	view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(format) : nullptr;
+	view->ndim = ndim;
+	view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shapeAndStrides : nullptr;
+	view->strides = wantsStrides ? shapeAndStrides + ndim : nullptr;
+	view->suboffsets = nullptr;
+	view->internal = shapeAndStrides;
+	return 0;
+}
+
+void releaseBufferInfo(Py_buffer* view)
+{
+	delete[] static_cast<Py_ssize_t*>(view->internal);
+	view->internal = nullptr;
+}
+
+bool isCompatibleBufferFormat(const char* format, Py_ssize_t itemsize, char expected, Py_ssize_t expectedSize)
+{
+	if (!format)
+	{
+		format = "B";
+	}
+	if (*format && std::strchr("@=<>!", *format))
+	{
+		if (!isNativeByteOrder(*format))
+		{
+			return false;
+		}
+		++format;
+	}
+	if (format[0] == 0 || format[1] != 0 || itemsize != expectedSize)
+	{
+		return false;
+	}
+	const BufferKind kind = bufferKind(format[0]);
+	return kind != bkNone && kind == bufferKind(expected);
+}
+
+Py_ssize_t checkBufferLayout(const Py_buffer& view, char format, Py_ssize_t itemsize, Py_ssize_t components)
+{
+	if (!isCompatibleBufferFormat(view.format, view.itemsize, format, itemsize) || view.suboffsets || !view.shape)
+	{
+		return -1;
+	}
+	if (view.ndim == 1)
+	{
+		// scalars, or flat arrays of components like array.array
+		return view.shape[0] % components == 0 ? view.shape[0] / components : -1;
+	}
+	return (view.ndim == 2 && view.shape[1] == components) ? view.shape[0] : -1;
+}
+
+}
+}
+}
+
+// EOF
@@ -0,0 +1,327 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_PYTHON_BUFFER_TRAITS_H
+#define LASS_GUARDIAN_OF_INCLUSION_PYTHON_BUFFER_TRAITS_H
+
+#include "python_common.h"
+#include "../meta/bool.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace lass
+{
+namespace python
+{
+
+/** Describes the memory layout of a C++ value type in a PEP 3118 buffer.
+ *
+ *  If BufferTraits<T>::value is true, a contiguous array of T can be exported through the
+ *  Python buffer protocol without copying, so that memoryview or NumPy can wrap it directly.
+ *  Each T is described as @a components scalars of type TScalar, with struct format character
+ *  @a format, starting at data(v) and laid out consecutively. sizeof(T) may be larger than
+ *  components * sizeof(TScalar) (padding due to SIMD alignment): strides take care of that.
+ *
+ *  A scalar T is exported as a one dimensional buffer of shape (n,), a T with components > 1 as
+ *  a two dimensional buffer of shape (n, components).
+ *
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits: meta::False
+{
+};
+
+namespace impl
+{
+
+/** @ingroup Python
+ *  @internal
+ */
+template <typename T, typename ScalarType, Py_ssize_t numComponents, char formatCode>
+struct BufferTraitsBase: meta::True
+{
+	typedef T TValue;
+	typedef ScalarType TScalar;
+	constexpr static Py_ssize_t components = numComponents;
+	constexpr static char format[2] = { formatCode, 0 };
+	static_assert(sizeof(T) >= components * sizeof(TScalar), "BufferTraits: value type too small for its components");
+};
+
+/** @ingroup Python
+ *  @internal
+ */
+template <typename T, char formatCode>
+struct BufferTraitsScalar: BufferTraitsBase<T, T, 1, formatCode>
+{
+	static T* data(T& v) { return &v; }
+	static const T* data(const T& v) { return &v; }
+};
+
+/** Buffer traits for value types made of @a numComponents consecutive scalars, like prim::Vector3D
+ *  @ingroup Python
+ *  @internal
+ */
+template <typename T, typename ScalarType, Py_ssize_t numComponents, typename Enable = void>
+struct BufferTraitsArray: meta::False
+{
+};
+
+template <typename T, typename ScalarType, Py_ssize_t numComponents>
+struct BufferTraitsArray<T, ScalarType, numComponents, std::enable_if_t<BufferTraits<ScalarType>::value && BufferTraits<ScalarType>::components == 1> >:
+	BufferTraitsBase<T, ScalarType, numComponents, BufferTraits<ScalarType>::format[0]>
+{
+	static ScalarType* data(T& v) { return &v[0]; }
+	static const ScalarType* data(const T& v) { return &v[0]; }
+};
+
+/** Fill in a Py_buffer for a contiguous array of @a length items, exported by @a exporter.
+ *  @ingroup Python
+ *  @internal
+ *  Shape and strides are allocated in view->internal and must be freed by releaseBufferInfo().
+ *  Returns 0 on success. On failure, sets a BufferError, sets view->obj to NULL and returns -1.
+ */
+LASS_PYTHON_DLL int fillBufferInfo(Py_buffer* view, PyObject* exporter, void* buf, Py_ssize_t length,
+	Py_ssize_t itemStride, const char* format, Py_ssize_t itemsize, Py_ssize_t components, bool readOnly, int flags);
+
+/** Fill in a Py_buffer for an array of @a ndim dimensions, like rows, columns and channels of an image.
+ *  @ingroup Python
+ *  @internal
+ *  @a strides are in bytes.  Both @a shape and @a strides are copied.  Same as above otherwise.
+ */
+LASS_PYTHON_DLL int fillBufferInfo(Py_buffer* view, PyObject* exporter, void* buf, int ndim, const Py_ssize_t* shape,
+	const Py_ssize_t* strides, const char* format, Py_ssize_t itemsize, bool readOnly, int flags);
+
+/** @ingroup Python
+ *  @internal
+ */
+LASS_PYTHON_DLL void releaseBufferInfo(Py_buffer* view);
+
+/** Returns true if a buffer with struct format @a format and @a itemsize holds values that
+ *  can be read as scalars with format character @a expected of @a expectedSize bytes.
+ *  @ingroup Python
+ *  @internal
+ */
+LASS_PYTHON_DLL bool isCompatibleBufferFormat(const char* format, Py_ssize_t itemsize, char expected, Py_ssize_t expectedSize);
+
+/** Returns number of items in @a view if its shape matches (n,) for scalars or (n, components),
+ *  and its format matches TScalar. A flat buffer of shape (n * components,), like an array.array,
+ *  is accepted as well. Returns -1 otherwise, without setting a Python error.
+ *  @ingroup Python
+ *  @internal
+ */
+LASS_PYTHON_DLL Py_ssize_t checkBufferLayout(const Py_buffer& view, char format, Py_ssize_t itemsize, Py_ssize_t components);
+
+/** Copy items of a buffer object into @a first .. @a first + n, respecting its strides.
+ *  @ingroup Python
+ *  @internal
+ *  Call checkBufferLayout() first to get @a n.
+ */
+template <typename T>
+void copyFromBuffer(const Py_buffer& view, Py_ssize_t n, T* first)
+{
+	typedef BufferTraits<T> TBufferTraits;
+	typedef typename TBufferTraits::TScalar TScalar;
+	constexpr Py_ssize_t components = TBufferTraits::components;
+	const char* const buf = static_cast<const char*>(view.buf);
+	const Py_ssize_t colStride = view.strides ? view.strides[view.ndim - 1] : static_cast<Py_ssize_t>(sizeof(TScalar));
+	const Py_ssize_t rowStride = view.ndim > 1
+		? (view.strides ? view.strides[0] : components * static_cast<Py_ssize_t>(sizeof(TScalar)))
+		: components * colStride; // flat buffer
+	if (sizeof(T) == components * sizeof(TScalar) && rowStride == static_cast<Py_ssize_t>(sizeof(T)) && colStride == static_cast<Py_ssize_t>(sizeof(TScalar)))
+	{
+		if (n > 0)
+		{
+			std::memcpy(TBufferTraits::data(*first), buf, static_cast<size_t>(n) * sizeof(T));
+		}
+		return;
+	}
+	for (Py_ssize_t i = 0; i < n; ++i)
+	{
+		const char* row = buf + i * rowStride;
+		TScalar* dest = TBufferTraits::data(first[i]);
+		for (Py_ssize_t k = 0; k < components; ++k)
+		{
+			std::memcpy(dest + k, row + k * colStride, sizeof(TScalar));
+		}
+	}
+}
+
+/** Gets @a value from @a obj if it is an exact Python float or int that fits, without going
+ *  through PyExportTraits. Returns false otherwise, without setting a Python error.
+ *  @ingroup Python
+ *  @internal
+ */
+template <typename TScalar>
+bool getExactScalar(PyObject* obj, TScalar& value)
+{
+	if constexpr (std::is_floating_point_v<TScalar>)
+	{
+#if LASS_USE_OLD_EXPORTRAITS_FLOAT
+		if constexpr (sizeof(TScalar) < sizeof(double))
+		{
+			return false; // PyExportTraitsFloat checks the range
+		}
+#endif
+		if (PyFloat_CheckExact(obj))
+		{
+			value = static_cast<TScalar>(PyFloat_AS_DOUBLE(obj));
+			return true;
+		}
+		if (PyLong_CheckExact(obj))
+		{
+			const double x = PyLong_AsDouble(obj);
+			if (x == -1.0 && PyErr_Occurred())
+			{
+				PyErr_Clear();
+				return false;
+			}
+			value = static_cast<TScalar>(x);
+			return true;
+		}
+		return false;
+	}
+	else if constexpr (std::is_integral_v<TScalar> && !std::is_same_v<TScalar, bool>)
+	{
+		if (!PyLong_CheckExact(obj))
+		{
+			return false;
+		}
+		int overflow = 0;
+		const long long x = PyLong_AsLongLongAndOverflow(obj, &overflow);
+		if (overflow || (x == -1 && PyErr_Occurred()))
+		{
+			PyErr_Clear();
+			return false;
+		}
+		if constexpr (std::is_signed_v<TScalar>)
+		{
+			if (x < static_cast<long long>(std::numeric_limits<TScalar>::min()) ||
+				x > static_cast<long long>(std::numeric_limits<TScalar>::max()))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			if (x < 0 || static_cast<unsigned long long>(x) > std::numeric_limits<TScalar>::max())
+			{
+				return false;
+			}
+		}
+		value = static_cast<TScalar>(x);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/** Fast path to get a value with BufferTraits, like prim::Point3D, from an exact tuple or list
+ *  of exact floats or ints, writing the components straight into @a value.
+ *
+ *  Returns 0 on success, or 1 if @a obj must go through PyExportTraits instead, so that it gets
+ *  the full conversion rules and error messages. Never sets a Python error.
+ *
+ *  @ingroup Python
+ *  @internal
+ */
+template <typename T>
+int getFromExactSequence(PyObject* obj, T& value)
+{
+	typedef BufferTraits<T> TBufferTraits;
+	typedef typename TBufferTraits::TScalar TScalar;
+	constexpr Py_ssize_t components = TBufferTraits::components;
+	TScalar* const dest = TBufferTraits::data(value);
+	if constexpr (components == 1)
+	{
+		return getExactScalar(obj, *dest) ? 0 : 1;
+	}
+	else
+	{
+		if (!(PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) || PySequence_Fast_GET_SIZE(obj) != components)
+		{
+			return 1;
+		}
+		PyObject** const items = PySequence_Fast_ITEMS(obj);
+		for (Py_ssize_t k = 0; k < components; ++k)
+		{
+			if (!getExactScalar(items[k], dest[k]))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	}
+}
+
+}
+
+#define LASS_PYTHON_BUFFER_TRAITS_SCALAR(t_type, c_format) \
+	template <> struct BufferTraits<t_type>: impl::BufferTraitsScalar<t_type, c_format> {};
+
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(bool, '?')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(signed char, 'b')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(unsigned char, 'B')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(short, 'h')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(unsigned short, 'H')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(int, 'i')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(unsigned int, 'I')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(long, 'l')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(unsigned long, 'L')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(long long, 'q')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(unsigned long long, 'Q')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(float, 'f')
+LASS_PYTHON_BUFFER_TRAITS_SCALAR(double, 'd')
+
+#undef LASS_PYTHON_BUFFER_TRAITS_SCALAR
+
+}
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,205 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "python_common.h"
+#include "call_stats.h"
+#include "gil.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace lass
+{
+namespace python
+{
+
+#if LASS_PYTHON_CALL_STATS
+
+namespace impl
+{
+
+namespace
+{
+
+struct CounterRegistry
+{
+	FreeThreadingMutex mutex;
+	std::vector<CallStatsCounter*> counters;
+	std::atomic<size_t> shadowCreations { 0 };
+};
+
+CounterRegistry& counterRegistry()
+{
+	// Deliberately leaked: counters of other libraries may be destroyed after static destruction.
+	static CounterRegistry* registry = new CounterRegistry;
+	return *registry;
+}
+
+double toSeconds(std::int64_t ns)
+{
+	return static_cast<double>(ns) * 1e-9;
+}
+
+}
+
+CallStatsCounter::CallStatsCounter():
+	calls(0),
+	overloadMisses(0),
+	conversionNs(0),
+	calleeNs(0)
+{
+	CounterRegistry& registry = counterRegistry();
+	std::lock_guard<impl::FreeThreadingMutex> lock(registry.mutex);
+	registry.counters.push_back(this);
+}
+
+CallStatsCounter::~CallStatsCounter()
+{
+	CounterRegistry& registry = counterRegistry();
+	std::lock_guard<impl::FreeThreadingMutex> lock(registry.mutex);
+	registry.counters.erase(std::remove(registry.counters.begin(), registry.counters.end(), this), registry.counters.end());
+}
+
+void CallStatsCounter::setName(const char* scope, const char* name)
+{
+	CounterRegistry& registry = counterRegistry();
+	std::lock_guard<impl::FreeThreadingMutex> lock(registry.mutex);
+	name_ = scope ? (std::string(scope) + "." + name) : std::string(name);
+}
+
+CallStats CallStatsCounter::stats() const
+{
+	CallStats result;
+	result.name = name_;
+	result.calls = calls.load(std::memory_order_relaxed);
+	result.overloadMisses = overloadMisses.load(std::memory_order_relaxed);
+	result.conversionTime = toSeconds(conversionNs.load(std::memory_order_relaxed));
+	result.calleeTime = toSeconds(calleeNs.load(std::memory_order_relaxed));
+	return result;
+}
+
+void CallStatsCounter::reset()
+{
+	calls.store(0, std::memory_order_relaxed);
+	overloadMisses.store(0, std::memory_order_relaxed);
+	conversionNs.store(0, std::memory_order_relaxed);
+	calleeNs.store(0, std::memory_order_relaxed);
+}
+
+CallFrame*& currentCallFrame()
+{
+	static thread_local CallFrame* frame = nullptr;
+	return frame;
+}
+
+void countShadowCreation()
+{
+	counterRegistry().shadowCreations.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+bool callStatsEnabled()
+{
+	return true;
+}
+
+std::vector<CallStats> callStats()
+{
+	impl::CounterRegistry& registry = impl::counterRegistry();
+	std::lock_guard<impl::FreeThreadingMutex> lock(registry.mutex);
+	std::vector<CallStats> result;
+	for (const impl::CallStatsCounter* counter : registry.counters)
+	{
+		CallStats stats = counter->stats();
+		if (stats.calls > 0)
+		{
+			result.push_back(std::move(stats));
+		}
+	}
+	return result;
+}
+
+size_t shadowCreations()
+{
+	return impl::counterRegistry().shadowCreations.load(std::memory_order_relaxed);
+}
+
+void resetCallStats()
+{
+	impl::CounterRegistry& registry = impl::counterRegistry();
+	std::lock_guard<impl::FreeThreadingMutex> lock(registry.mutex);
+	for (impl::CallStatsCounter* counter : registry.counters)
+	{
+		counter->reset();
+	}
+	registry.shadowCreations.store(0, std::memory_order_relaxed);
+}
+
+#else
+
+bool callStatsEnabled()
+{
+	return false;
+}
+
+std::vector<CallStats> callStats()
+{
+	return std::vector<CallStats>();
+}
+
+size_t shadowCreations()
+{
+	return 0;
+}
+
+void resetCallStats()
+{
+}
+
+#endif
+
+}
+}
+
+// EOF
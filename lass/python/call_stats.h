@@ -0,0 +1,219 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_PYTHON_CALL_STATS_H
+#define LASS_GUARDIAN_OF_INCLUSION_PYTHON_CALL_STATS_H
+
+#include "python_common.h"
+
+#include <string>
+#include <vector>
+
+#if LASS_PYTHON_CALL_STATS
+#	include <atomic>
+#	include <chrono>
+#	include <cstdint>
+#endif
+
+/** @defgroup CallStats Call Statistics
+ *  @ingroup Python
+ *  @brief Where the time goes in calls to exported functions and methods.
+ *
+ *  When Lass is configured with `Lass_WITH_PYTHON_CALL_STATS=ON` (which defines
+ *  LASS_PYTHON_CALL_STATS to 1), every call from Python to an exported function or method is
+ *  counted, and its duration is split in two parts:
+ *  - callee time: spent in the C++ function or method itself.
+ *  - conversion time: everything else, like overload resolution, converting arguments and
+ *    building the result.
+ *
+ *  It also counts overloads rejecting the arguments by raising TypeError or NotImplementedError
+ *  (the expensive way of trying the next overload), and the creation of shadow objects.
+ *
+ *  The statistics are available in Python as well. _lass.callStats() returns a dict with the keys
+ *  "enabled", "shadowCreations" and "functions", the latter mapping each name on a dict with
+ *  "calls", "overloadMisses", "conversionTime" and "calleeTime":
+ *  @code{.py}
+ *  import _lass
+ *  _lass.resetCallStats()
+ *  run_my_script()
+ *  stats = _lass.callStats()
+ *  if not stats["enabled"]:
+ *      print("Lass is built without Lass_WITH_PYTHON_CALL_STATS")
+ *  for name, s in sorted(stats["functions"].items(), key=lambda x: -x[1]["conversionTime"]):
+ *      print(name, s["calls"], s["conversionTime"], s["calleeTime"], s["overloadMisses"])
+ *  @endcode
+ *
+ *  When LASS_PYTHON_CALL_STATS is 0 (the default), none of this is compiled in: callStats() returns
+ *  an empty vector, shadowCreations() returns 0, and callStatsEnabled() returns false. In Python,
+ *  _lass.callStats() still returns the same dict, with "enabled" false, "shadowCreations" 0 and
+ *  "functions" empty, so the example above works in both configurations.
+ *
+ *  Calls are attributed to the Python function or method that was called. Nested calls,
+ *  made by the C++ callee through Python back into another exported function, are counted as
+ *  calls of their own, and their time is also included in the callee time of the outer call.
+ */
+
+namespace lass
+{
+namespace python
+{
+
+/** Statistics of one exported function or method.
+ *  @ingroup CallStats
+ */
+struct CallStats
+{
+	std::string name; ///< qualified name, like "module.function" or "Class.method".
+	size_t calls = 0; ///< number of calls from Python
+	size_t overloadMisses = 0; ///< number of overloads that rejected the arguments by raising an exception
+	double conversionTime = 0; ///< seconds spent outside the C++ callee: dispatching and converting.
+	double calleeTime = 0; ///< seconds spent in the C++ callee.
+};
+
+/** Returns true if Lass is built with LASS_PYTHON_CALL_STATS.
+ *  @ingroup CallStats
+ */
+LASS_PYTHON_DLL bool callStatsEnabled();
+
+/** Returns the statistics of all exported functions and methods that have been called.
+ *  @ingroup CallStats
+ */
+LASS_PYTHON_DLL std::vector<CallStats> callStats();
+
+/** Returns the number of shadow objects created.
+ *  @ingroup CallStats
+ */
+LASS_PYTHON_DLL size_t shadowCreations();
+
+/** Resets all counters to zero.
+ *  @ingroup CallStats
+ */
+LASS_PYTHON_DLL void resetCallStats();
+
+namespace impl
+{
+
+#if LASS_PYTHON_CALL_STATS
+
+/** Counters of one overload chain, owned by its OverloadLink.
+ *  @ingroup CallStats
+ *  @internal
+ */
+class LASS_PYTHON_DLL CallStatsCounter
+{
+public:
+	CallStatsCounter();
+	~CallStatsCounter();
+	void setName(const char* scope, const char* name);
+	CallStats stats() const;
+	void reset();
+
+	std::atomic<size_t> calls;
+	std::atomic<size_t> overloadMisses;
+	std::atomic<std::int64_t> conversionNs;
+	std::atomic<std::int64_t> calleeNs;
+private:
+	CallStatsCounter(const CallStatsCounter&) = delete;
+	CallStatsCounter& operator=(const CallStatsCounter&) = delete;
+	std::string name_;
+};
+
+/** The call being dispatched by the current thread.
+ *  @ingroup CallStats
+ *  @internal
+ */
+struct CallFrame
+{
+	CallStatsCounter* counter;
+	std::int64_t calleeNs;
+};
+
+/** Null while not dispatching, or while running the C++ callee.
+ *  @ingroup CallStats
+ *  @internal
+ */
+LASS_PYTHON_DLL CallFrame*& currentCallFrame();
+
+LASS_PYTHON_DLL void countShadowCreation();
+
+/** Adds the time of the current scope to the callee time of the call being dispatched.
+ *  @ingroup CallStats
+ *  @internal
+ *
+ *  While the callee runs, currentCallFrame() is null, so that calls it makes back into Python
+ *  are dispatched as calls of their own.
+ */
+class CalleeTimer
+{
+public:
+	CalleeTimer():
+		frame_(currentCallFrame()),
+		start_(std::chrono::steady_clock::now())
+	{
+		currentCallFrame() = nullptr;
+	}
+	~CalleeTimer()
+	{
+		if (frame_)
+		{
+			frame_->calleeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start_).count();
+		}
+		currentCallFrame() = frame_;
+	}
+private:
+	CalleeTimer(const CalleeTimer&) = delete;
+	CalleeTimer& operator=(const CalleeTimer&) = delete;
+	CallFrame* frame_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+#endif
+
+}
+}
+}
+
+#endif
+
+// EOF
@@ -51,6 +51,7 @@
 #include "../stde/extended_cstring.h"
 #include <iostream>
 #include <cstring>
+#include <mutex>
 
 #if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_WIN32
 #	pragma warning(disable: 4996) // This function or variable may be unsafe ...
@@ -75,6 +76,48 @@ PyMethodDef createPyMethodDef(const char *ml_name, PyCFunction ml_meth, int ml_f
 	return temp;
 }
 
+PyMethodDef createPyFastCallMethodDef(const char *ml_name, FastCallFunction ml_meth, int ml_flags, const char *ml_doc)
+{
+	LASS_ASSERT(ml_flags & METH_FASTCALL);
+	// cast via void(*)() like CPython's _PyCFunction_CAST, to avoid -Wcast-function-type
+	return createPyMethodDef(ml_name, reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(ml_meth)), ml_flags, ml_doc);
+}
+
+namespace
+{
+
+/** Install @a method in @a methods, or make it the head of the overload chain of an existing method
+ *  with the same name.  Existing overloads can be METH_VARARGS or METH_FASTCALL.
+ */
+void addMethodOverload(std::vector<PyMethodDef>& methods, const PyMethodDef& method, OverloadLink& overloadChain)
+{
+	std::vector<PyMethodDef>::iterator i = std::find_if(methods.begin(), methods.end(), NamePredicate(method.ml_name));
+	if (i == methods.end())
+	{
+		methods.insert(methods.begin(), method);
+		overloadChain.setNull();
+		return;
+	}
+	LASS_ASSERT((i->ml_flags & METH_STATIC) == (method.ml_flags & METH_STATIC));
+	if (i->ml_flags & METH_FASTCALL)
+	{
+		overloadChain.setFastCallFunction(reinterpret_cast<FastCallFunction>(reinterpret_cast<void(*)()>(i->ml_meth)));
+	}
+	else
+	{
+		LASS_ASSERT(i->ml_flags & METH_VARARGS);
+		overloadChain.setPyCFunction(i->ml_meth);
+	}
+	i->ml_meth = method.ml_meth;
+	i->ml_flags = method.ml_flags;
+	if (i->ml_doc == 0)
+	{
+		i->ml_doc = method.ml_doc;
+	}
+}
+
+}
+
 
 
 PyGetSetDef createPyGetSetDef( const char* name, getter get, setter set, const char* doc, void* closure )
@@ -97,6 +140,22 @@ void dealloc(PyObject* obj)
 
 
 
+namespace
+{
+
+/** Guards the parts of ClassDefinitions that are shared by all interpreters, as interpreters
+ *  with their own GIL may freeze them concurrently. Never hold it while running Python code.
+ */
+std::mutex& definitionMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+}
+
+
+
 ClassDefinition::ClassDefinition(
 		const char* name, const char* doc, Py_ssize_t typeSize, 
 		richcmpfunc richcmp, ClassDefinition* parent, TClassRegisterHook registerHook):
@@ -106,7 +165,8 @@ ClassDefinition::ClassDefinition(
 	className_(name),
 	doc_(doc),
 	implicitConvertersSlot_(0),
-	isFrozen_(false)
+	isFrozen_(false),
+	isRegistered_(false)
 {
 	PyType_Spec spec = {
 		nullptr, /* name */
@@ -135,16 +195,18 @@ ClassDefinition::~ClassDefinition()
 
 const PyTypeObject* ClassDefinition::type() const
 {
-	LASS_ENFORCE(type_)(name())(" is not frozen yet");
-	return reinterpret_cast<PyTypeObject*>(type_.get());
+	const InterpreterType* t = types_.find();
+	LASS_ENFORCE(t && t->type)(name())(" is not frozen yet");
+	return reinterpret_cast<PyTypeObject*>(t->type.get());
 }
 
 
 
 PyTypeObject* ClassDefinition::type()
 {
-	LASS_ENFORCE(type_)(name())(" is not frozen yet");
-	return reinterpret_cast<PyTypeObject*>(type_.get());
+	const InterpreterType* t = types_.find();
+	LASS_ENFORCE(t && t->type)(name())(" is not frozen yet");
+	return reinterpret_cast<PyTypeObject*>(t->type.get());
 }
 
 
@@ -219,27 +281,19 @@ void ClassDefinition::addConstructor(newfunc dispatcher, newfunc& overloadChain)
 }
 
 
+void ClassDefinition::addMethod(const char* name, const char* doc, FastCallFunction dispatcher, OverloadLink& overloadChain) 
+{
+	overloadChain.setName(this->name(), name);
+	addMethodOverload(methods_, createPyFastCallMethodDef(name, dispatcher, METH_FASTCALL | METH_KEYWORDS, doc), overloadChain);
+}
+
 void ClassDefinition::addMethod(const char* name, const char* doc, PyCFunction dispatcher, OverloadLink& overloadChain) 
 {
-	TMethods::iterator i = std::find_if(methods_.begin(), methods_.end(), NamePredicate(name));
-	if (i == methods_.end())
-	{
-		methods_.insert(methods_.begin(), createPyMethodDef(name, dispatcher, METH_VARARGS , doc));
-		overloadChain.setNull();
-	}
-	else
-	{
-		LASS_ASSERT(i->ml_flags == METH_VARARGS);
-		overloadChain.setPyCFunction(i->ml_meth);
-		i->ml_meth = dispatcher;
-		if (i->ml_doc == 0)
-		{
-			i->ml_doc = const_cast<char*>(doc);
-		}
-	};
+	overloadChain.setName(this->name(), name);
+	addMethodOverload(methods_, createPyMethodDef(name, dispatcher, METH_VARARGS, doc), overloadChain);
 }
 
-void ClassDefinition::addMethod(const ComparatorSlot& slot, const char*, PyCFunction dispatcher, OverloadLink&) 
+void ClassDefinition::addMethod(const ComparatorSlot& slot, const char*, FastCallFunction dispatcher, OverloadLink&) 
 {
 	compareFuncs_.push_back(CompareFunc(dispatcher, slot.slot));
 }
@@ -256,46 +310,55 @@ void ClassDefinition::addMethod(const UnarySlot& slot, const char*, unaryfunc di
 
 void ClassDefinition::addMethod(const BinarySlot& slot, const char*, binaryfunc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setBinaryfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const TernarySlot& slot, const char*, ternaryfunc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setTernaryfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const SsizeArgSlot& slot, const char*, ssizeargfunc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setSsizeArgfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const SsizeObjArgSlot& slot, const char*, ssizeobjargproc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setSsizeObjArgProcfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const ObjObjSlot& slot, const char*, objobjproc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setObjObjProcfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const ObjObjArgSlot& slot, const char*, objobjargproc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setObjObjArgProcfunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const IterSlot& slot, const char*, getiterfunc dispatcher, OverloadLink& overloadChain)
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setGetIterFunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const IterNextSlot& slot, const char*, iternextfunc dispatcher, OverloadLink& overloadChain)
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setIterNextFunc(setSlot(slot.slot, dispatcher));
 }
 
 void ClassDefinition::addMethod(const ArgKwSlot& slot, const char*, ternaryfunc dispatcher, OverloadLink& overloadChain) 
 {
+	overloadChain.setName(name(), slot.name);
 	overloadChain.setArgKwfunc(setSlot(slot.slot, dispatcher));
 }
 
@@ -309,24 +372,10 @@ void ClassDefinition::addGetSetter(const char* name, const char* doc, getter get
 	getSetters_.insert(getSetters_.begin(), impl::createPyGetSetDef(name, get, set, doc, 0));
 }
 
-void ClassDefinition::addStaticMethod(const char* name, const char* doc, PyCFunction dispatcher, PyCFunction& overloadChain)
+void ClassDefinition::addStaticMethod(const char* name, const char* doc, FastCallFunction dispatcher, OverloadLink& overloadChain)
 {
-	std::vector<PyMethodDef>::iterator i = ::std::find_if(methods_.begin(), methods_.end(), NamePredicate(name));
-	if (i == methods_.end())
-	{
-		methods_.insert(methods_.begin(), createPyMethodDef(name, dispatcher, METH_VARARGS | METH_STATIC, doc));
-		overloadChain = 0;
-	}
-	else
-	{
-		LASS_ASSERT(i->ml_flags == (METH_VARARGS | METH_STATIC));
-		overloadChain = i->ml_meth;
-		i->ml_meth = dispatcher;
-		if (i->ml_doc == 0)
-		{
-			i->ml_doc = const_cast<char*>(doc);
-		}
-	}
+	overloadChain.setName(this->name(), name);
+	addMethodOverload(methods_, createPyFastCallMethodDef(name, dispatcher, METH_FASTCALL | METH_KEYWORDS | METH_STATIC, doc), overloadChain);
 }	
 
 void ClassDefinition::addInnerClass(ClassDefinition& innerClass)
@@ -346,12 +395,16 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module)
 	return freezeDefinition(module, nullptr);
 }
 
+/** Creates the type object for the current interpreter, if not done already.
+ *
+ *  Each interpreter gets its own type object from the same spec, which is only finalized once.
+ */
 PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeName)
 {
-	LASS_ASSERT(!isFrozen_);
-	if (isFrozen_)
+	InterpreterType& interpType = types_.get();
+	if (interpType.isFrozen)
 	{
-		return type_.get();
+		return interpType.type.get();
 	}
 
 	if (parent_)
@@ -365,12 +418,17 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeN
 				return nullptr;
 			}
 		}
-		if (!parent_->type_)
+		const InterpreterType* parentType = parent_->types_.find();
+		if (!parentType || !parentType->type)
 		{
 			PyErr_Format(PyExc_AssertionError, "Parent class %s of %s is not frozen yet", parent_->className_, className_);
 			return nullptr;
 		}
-		parent_->subClasses_.push_back(this);
+		std::lock_guard<std::mutex> lock(definitionMutex());
+		if (std::find(parent_->subClasses_.begin(), parent_->subClasses_.end(), this) == parent_->subClasses_.end())
+		{
+			parent_->subClasses_.push_back(this);
+		}
 	}
 
 	const char* moduleName = nullptr;
@@ -381,56 +439,73 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeN
 		{
 			return nullptr;
 		}
-		LASS_ASSERT(!spec_.name || std::strcmp(spec_.name, moduleName) == 0);
-		if (!spec_.name)
+	}
+
+	if (!interpType.type)
+	{
+		std::lock_guard<std::mutex> lock(definitionMutex());
+		if (moduleName)
 		{
-			const size_t n = std::strlen(moduleName) + std::strlen(className_) + 2; // one extra for dot, and one extra for null
-			char* buf = static_cast<char*>(std::malloc(n));
-			if (!buf)
+			LASS_ASSERT(!spec_.name || std::strncmp(spec_.name, moduleName, std::strlen(moduleName)) == 0);
+			if (!spec_.name)
 			{
-				PyErr_NoMemory();
-				return nullptr;
+				const size_t n = std::strlen(moduleName) + std::strlen(className_) + 2; // one extra for dot, and one extra for null
+				char* buf = static_cast<char*>(std::malloc(n));
+				if (!buf)
+				{
+					PyErr_NoMemory();
+					return nullptr;
+				}
+				const int r = ::snprintf(buf, n, "%s.%s", moduleName, className_);
+				LASS_ENFORCE(r > 0 && static_cast<size_t>(r) < n);
+				spec_.name = buf; // leaked on purpose
 			}
-			const int r = ::snprintf(buf, n, "%s.%s", moduleName, className_);
-			LASS_ENFORCE(r > 0 && static_cast<size_t>(r) < n);
-			spec_.name = buf; // leaked on purpose
 		}
-	}
-	else
-	{
-		LASS_ASSERT(!spec_.name || std::strcmp(spec_.name, className_) == 0);
-		if (!spec_.name)
+		else
 		{
-			spec_.name = className_;
+			LASS_ASSERT(!spec_.name || std::strcmp(spec_.name, className_) == 0);
+			if (!spec_.name)
+			{
+				spec_.name = className_;
+			}
 		}
-	}
 
-	if (!type_)
-	{
-		setSlot(Py_tp_base, parent_ ? parent_->type() : &PyBaseObject_Type); // INCREF???
-		setSlot(Py_tp_methods, &methods_[0]);
-		setSlot(Py_tp_getset, &getSetters_[0]);
-		if (doc_) // a nullptr as Py_tp_doc causes access violation in PyType_FromSpec 
+		if (!spec_.slots)
 		{
-			setSlot(Py_tp_doc, const_cast<char*>(doc_));
-		}
-		LASS_ASSERT(slots_.back().slot == 0);
-		spec_.slots = &slots_[0];
+			if (!parent_)
+			{
+				setSlot(Py_tp_base, &PyBaseObject_Type);
+			}
+			setSlot(Py_tp_methods, &methods_[0]);
+			setSlot(Py_tp_getset, &getSetters_[0]);
+			if (doc_) // a nullptr as Py_tp_doc causes access violation in PyType_FromSpec 
+			{
+				setSlot(Py_tp_doc, const_cast<char*>(doc_));
+			}
+			LASS_ASSERT(slots_.back().slot == 0);
+			spec_.slots = &slots_[0];
 
-		if (getSlot(Py_tp_new) == nullptr)
-		{
-			// We don't have a constructor, so we disallow instantiation.
-			spec_.flags |= Py_TPFLAGS_DISALLOW_INSTANTIATION;
+			if (getSlot(Py_tp_new) == nullptr)
+			{
+				// We don't have a constructor, so we disallow instantiation.
+				spec_.flags |= Py_TPFLAGS_DISALLOW_INSTANTIATION;
+			}
 		}
+	}
 
-		type_.reset(PyType_FromModuleAndSpec(module, &spec_, nullptr));
-		if (!type_)
+	if (!interpType.type)
+	{
+
+		// The parent's type object is passed as base, as it differs per interpreter.
+		PyObject* base = parent_ ? reinterpret_cast<PyObject*>(parent_->type()) : nullptr;
+		interpType.type.reset(PyType_FromModuleAndSpec(module, &spec_, base));
+		if (!interpType.type)
 		{
 			return nullptr;
 		}
 	}
 
-	PyObject* type = type_.get();
+	PyObject* type = interpType.type.get();
 
 	const char* qualname = className_;
 	std::string scopedQualname;
@@ -473,7 +548,13 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeN
 
 	if (classRegisterHook_)
 	{
-		classRegisterHook_();
+		// the hook registers with the parent definition, once for all interpreters.
+		std::lock_guard<std::mutex> lock(definitionMutex());
+		if (!isRegistered_)
+		{
+			classRegisterHook_();
+			isRegistered_ = true;
+		}
 	}
 
 	if (freezeType() != 0)
@@ -481,6 +562,7 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeN
 		return nullptr;
 	}
 
+	interpType.isFrozen = true;
 	isFrozen_ = true;
 	return type;
 }
@@ -489,7 +571,7 @@ PyObject* ClassDefinition::freezeDefinition(PyObject* module, const char* scopeN
 
 int ClassDefinition::freezeType()
 {
-	PyTypeObject* type = reinterpret_cast<PyTypeObject*>(type_.get());
+	PyTypeObject* type = this->type();
 #if PY_VERSION_HEX >= 0x030e0000 // >= 3.14
 	if (!PyType_HasFeature(type, Py_TPFLAGS_IMMUTABLETYPE))
 	{
@@ -505,11 +587,20 @@ int ClassDefinition::freezeType()
 		}
 	}
 
-	// freeze types of all subclasses that we've skipped
-	for (auto *subClass : subClasses_)
+	// freeze types of all subclasses that we've skipped. Copy them first, as other interpreters may add more.
+	TClassDefs subClasses;
+	{
+		std::lock_guard<std::mutex> lock(definitionMutex());
+		subClasses = subClasses_;
+	}
+	for (auto *subClass : subClasses)
 	{
-		// their definition should already be frozen if they're in this list
-		LASS_ASSERT(subClass->isFrozen_);
+		// skip the ones that aren't frozen in this interpreter (yet), they'll freeze their own type.
+		const InterpreterType* subType = subClass->types_.find();
+		if (!subType || !subType->isFrozen)
+		{
+			continue;
+		}
 		if (subClass->freezeType() != 0)
 		{
 			return -1;
@@ -554,13 +645,13 @@ PyObject* ClassDefinition::callRichCompare(PyObject* self, PyObject* other, int
 		};
 	}
 
-	TPyObjPtr args(Py_BuildValue("(O)", other));
+	PyObject* args[] = { other };
 	const TCompareFuncs::const_iterator end = compareFuncs_.end();
 	for (TCompareFuncs::const_iterator i = compareFuncs_.begin(); i != end; ++i)
 	{
 		if (i->op == op)
 		{
-			PyObject* result = (i->dispatcher)(self, args.get());\
+			PyObject* result = (i->dispatcher)(self, args, 1, nullptr);
 			if (result || (PyErr_Occurred() && !PyErr_ExceptionMatches(PyExc_TypeError)))
 			{
 				return result;
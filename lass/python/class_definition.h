@@ -47,8 +47,11 @@
 #include "pyobject_special_methods.h"
 #include "overload_link.h"
 #include "export_traits.h"
+#include "per_interpreter.h"
 #include "../util/shared_ptr.h"
 
+#include <atomic>
+
 namespace lass
 {
 	namespace python
@@ -174,6 +177,9 @@ namespace lass
 			LASS_PYTHON_DLL PyMethodDef LASS_CALL createPyMethodDef(
 				const char *ml_name, PyCFunction ml_meth, int ml_flags, 
 				const char *ml_doc);
+			LASS_PYTHON_DLL PyMethodDef LASS_CALL createPyFastCallMethodDef(
+				const char *ml_name, FastCallFunction ml_meth, int ml_flags,
+				const char *ml_doc);
 			LASS_PYTHON_DLL PyGetSetDef LASS_CALL createPyGetSetDef(
 				const char* name, getter get, setter set, const char* doc, void* closure);
 
@@ -247,9 +253,9 @@ namespace lass
 
 			struct LASS_PYTHON_DLL CompareFunc
 			{
-				PyCFunction dispatcher;
+				FastCallFunction dispatcher;
 				int op;
-				CompareFunc(PyCFunction dispatcher, int op): dispatcher(dispatcher), op(op) {}
+				CompareFunc(FastCallFunction dispatcher, int op): dispatcher(dispatcher), op(op) {}
 			};
 
 			template <typename CppClass> PyObject* richCompareDispatcher(PyObject* self, PyObject* other, int op)
@@ -317,11 +323,16 @@ namespace lass
 				 *  @param doc  Method docstring
 				 *  @param dispatcher Dispatcher implementing the method
 				 *  @param overloadChain Overload chain for this name
+				 *
+				 *  Named methods are registered with METH_FASTCALL, unless @a dispatcher is a plain
+				 *  PyCFunction taking an argument tuple.  Both kinds can be overloads of the same name.
 				 */
 				/// @{
+				void addMethod(const char* name, const char* doc, FastCallFunction dispatcher, OverloadLink& overloadChain);
+				/** Add a named method taking an argument tuple (METH_VARARGS). */
 				void addMethod(const char* name, const char* doc, PyCFunction dispatcher, OverloadLink& overloadChain);
 				/** Add a comparator-slot method (rich compare operator). */
-				void addMethod(const ComparatorSlot& slot, const char* doc, PyCFunction dispatcher, OverloadLink& overloadChain);
+				void addMethod(const ComparatorSlot& slot, const char* doc, FastCallFunction dispatcher, OverloadLink& overloadChain);
 				/** Add a unary-slot method (e.g., \_\_neg__, \_\_pos__, ...). */ 
 				void addMethod(const UnarySlot& slot, const char* doc, unaryfunc dispatcher, OverloadLink& overloadChain); 
 				/** Add a binary-slot method (e.g., arithmetic, comparisons). */ 
@@ -349,7 +360,7 @@ namespace lass
 				/** Add a property with optional getter/setter. */
 				void addGetSetter(const char* name, const char* doc, getter get, setter set);
 				/** Add a static method with overload support. */
-				void addStaticMethod(const char* name, const char* doc, PyCFunction dispatcher, PyCFunction& overloadChain);
+				void addStaticMethod(const char* name, const char* doc, FastCallFunction dispatcher, OverloadLink& overloadChain);
 				/// @}
 			
 				template <typename T> void addStaticConst(const char* name, const T& value)
@@ -398,11 +409,21 @@ namespace lass
 				typedef std::vector<EnumDefinitionBase*> TEnumDefs;
 				typedef std::vector<PyType_Slot> TSlots;
 
+				/** Type object of one interpreter, as they can't be shared between interpreters.
+				 *  The type object exists before it is fully frozen, so that nested classes can refer to it.
+				 */
+				struct InterpreterType
+				{
+					TPyObjPtr type;
+					bool isFrozen = false;
+				};
+				typedef PerInterpreter<InterpreterType> TTypes;
+
 				PyObject* freezeDefinition(PyObject* module, const char* scopeName);
 				int freezeType();
 
 				PyType_Spec spec_;
-				TPyObjPtr type_;
+				TTypes types_;
 				TSlots slots_;
 				TMethods methods_;
 				TGetSetters getSetters_;
@@ -426,7 +447,8 @@ namespace lass
 				*/
 				void* implicitConvertersSlot_;
 
-				bool isFrozen_;
+				std::atomic<bool> isFrozen_; ///< frozen in at least one interpreter
+				bool isRegistered_; ///< classRegisterHook_ has run, guarded by a mutex in class_definition.cpp
 			};
 		}
 	}
@@ -55,6 +55,7 @@
 #include <deque>
 #include <map>
 #include <typeinfo>
+#include <type_traits>
 
 namespace lass
 {
@@ -70,6 +71,7 @@ struct ContainerTraitsBase
 	typedef typename Container::value_type value_type;
 	typedef typename Container::const_iterator const_iterator;
 	typedef typename Container::iterator iterator;
+	constexpr static bool is_contiguous = false; ///< if true, data() returns pointer to size() consecutive elements
 	static Py_ssize_t size(const container_type& c)
 	{
 		const Py_ssize_t size = static_cast<Py_ssize_t>(c.size());
@@ -133,6 +135,12 @@ template <typename T, typename A>
 struct ContainerTraits< std::vector<T, A> >: ContainerTraitsBase< std::vector<T, A> >
 {
 	typedef typename ContainerTraitsBase< std::vector<T, A> >::container_type container_type;
+	typedef typename ContainerTraitsBase< std::vector<T, A> >::value_type value_type;
+	constexpr static bool is_contiguous = !std::is_same<T, bool>::value;
+	static value_type* data(container_type& c)
+	{
+		return c.data();
+	}
 	static void reserve( container_type& c, Py_ssize_t n ) 
 	{ 
 		LASS_ASSERT(n >= 0);
@@ -224,7 +224,8 @@ namespace lass
 
 		PyObject* EnumDefinitionBase::type() const
 		{
-			return type_.get();
+			const TPyObjPtr* type = type_.find();
+			return type ? type->get() : nullptr;
 		}
 
 		TPyObjPtr EnumDefinitionBase::valueObject(PyObject* obj) const
@@ -246,7 +247,8 @@ namespace lass
 
 		PyObject* EnumDefinitionBase::freezeDefinition(const char* moduleName, const char* scopeName)
 		{
-			if (!type_)
+			TPyObjPtr& type = type_.get(); // each interpreter has its own enum type.
+			if (!type)
 			{
 				TPyObjPtr kwargs(PyDict_New());
 				if (!kwargs)
@@ -270,8 +272,8 @@ namespace lass
 						return nullptr;
 					}
 				}
-				type_ = doFreezeDefinition(std::move(kwargs));
-				if (!type_)
+				type = doFreezeDefinition(std::move(kwargs));
+				if (!type)
 				{	
 					return nullptr;
 				}
@@ -280,12 +282,12 @@ namespace lass
 			{
 				// set the docstring
 				TPyObjPtr docStr(pyBuildSimpleObject(doc_));
-				if (!docStr || PyObject_SetAttrString(type_.get(), "__doc__", docStr.get()) != 0)
+				if (!docStr || PyObject_SetAttrString(type.get(), "__doc__", docStr.get()) != 0)
 				{
 					return nullptr;
 				}
 			}
-			return type_.get();
+			return type.get();
 		}
 	}
 }
@@ -45,6 +45,7 @@
 #include "python_common.h"
 #include "pyobject_ptr.h"
 #include "py_tuple.h"
+#include "per_interpreter.h"
 #include "../num/num_traits.h"
 #include "../stde/vector_map.h"
 
@@ -263,7 +264,7 @@ namespace lass
 			 */
 			virtual TPyObjPtr doValueObject(PyObject* obj) const;
 
-			TPyObjPtr type_;
+			impl::PerInterpreter<TPyObjPtr> type_;
 			const char* name_;
 			const char* doc_;
 		};
@@ -156,6 +156,28 @@ void addMessageHeader(const char* header)
 
 
 
+namespace
+{
+	thread_local PyObject* typeMismatch = nullptr;
+}
+
+void markTypeMismatch(PyObject* obj)
+{
+	typeMismatch = obj;
+}
+
+void clearTypeMismatch()
+{
+	typeMismatch = nullptr;
+}
+
+bool isTypeMismatch(PyObject* obj)
+{
+	return obj && obj == typeMismatch;
+}
+
+
+
 void fetchAndThrowPythonException(std::string loc)
 {
 	LockGIL lock;
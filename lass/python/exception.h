@@ -154,6 +154,31 @@ namespace impl
 
 
 
+	/** Mark that the TypeError just raised rejects @a obj for its type alone, without looking at its value.
+	 *
+	 *  OverloadLink only remembers rejections of arguments that are marked as such, as any other
+	 *  value of the same type would be rejected too.  Conversions that clear an error to try
+	 *  something else on the same object must call clearTypeMismatch().
+	 *
+	 *  @ingroup PythonExceptions
+	 *  @internal
+	 */
+	LASS_PYTHON_DLL void LASS_CALL markTypeMismatch(PyObject* obj);
+
+	/** Forget the object marked by markTypeMismatch()
+	 *  @ingroup PythonExceptions
+	 *  @internal
+	 */
+	LASS_PYTHON_DLL void LASS_CALL clearTypeMismatch();
+
+	/** True if @a obj is the last object marked by markTypeMismatch()
+	 *  @ingroup PythonExceptions
+	 *  @internal
+	 */
+	LASS_PYTHON_DLL bool LASS_CALL isTypeMismatch(PyObject* obj);
+
+
+
 	/** Fetch the current Python exception and throw it as a C++ PythonException
 	 * 
 	 *  @ingroup PythonExceptions
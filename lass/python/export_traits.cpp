@@ -55,6 +55,7 @@ int getStringImpl(PyObject* obj, string_type& v)
 	if (!PyUnicode_Check(obj))
 	{
 		PyErr_SetString(PyExc_TypeError, "not a string");
+		lass::python::impl::markTypeMismatch(obj);
 		return 1;
 	}
 	Py_ssize_t size;
@@ -75,6 +76,7 @@ int getWideStringImpl(PyObject * obj, string_type& v)
 	if (!PyUnicode_Check(obj))
 	{
 		PyErr_SetString(PyExc_TypeError, "not a string");
+		lass::python::impl::markTypeMismatch(obj);
 		return 1;
 	}
 	Py_ssize_t n = PyUnicode_AsWideChar(obj, 0, 0); // takes care of UTF-16 and UTF-32 conversions
@@ -458,6 +460,7 @@ int PyExportTraits<std::u16string>::get(PyObject* obj, std::u16string& v)
 	if (!PyUnicode_Check(obj))
 	{
 		PyErr_SetString(PyExc_TypeError, "not a string");
+		impl::markTypeMismatch(obj);
 		return 1;
 	}
 	if (PyUnicode_READY(obj) != 0)
@@ -510,6 +513,7 @@ int PyExportTraits<std::u32string>::get(PyObject* obj, std::u32string& v)
 	if (!PyUnicode_Check(obj))
 	{
 		PyErr_SetString(PyExc_TypeError, "not a string");
+		impl::markTypeMismatch(obj);
 		return 1;
 	}
 	Py_ssize_t size = PyUnicode_GetLength(obj);
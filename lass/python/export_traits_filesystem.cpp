@@ -42,6 +42,7 @@
 
 #include "python_common.h"
 #include "export_traits_filesystem.h"
+#include "per_interpreter.h"
 
 #if LASS_HAVE_STD_FILESYSTEM
 
@@ -90,7 +91,8 @@ PyObject* PyExportTraits<std::filesystem::path>::build(const std::filesystem::pa
 	TPyObjPtr path{ PyUnicode_DecodeFSDefaultAndSize(s.data(), static_cast<Py_ssize_t>(s.size())) };
 #endif
 
-	static TPyObjPtr pathType;
+	static impl::PerInterpreter<TPyObjPtr> pathTypes; // each interpreter has its own pathlib
+	TPyObjPtr& pathType = pathTypes.get();
 	if (!pathType)
 	{
 		TPyObjPtr pathlib(PyImport_ImportModule("pathlib"));
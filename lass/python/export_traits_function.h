@@ -71,7 +71,7 @@ public:
 
 	PyObject* call(PyObject* args) const override
 	{
-		return impl::callFunction(args, func_);
+		return impl::callFunction(impl::FastCallArgs(args), func_);
 	}
 
 	TFunction function() const { return func_; }
@@ -47,6 +47,7 @@
 #include "python_common.h"
 #include "pyobject_plus.h"
 #include "py_tuple.h"
+#include "buffer_traits.h"
 
 namespace lass
 {
@@ -78,6 +79,15 @@ struct PyExportTraitsVectorPoint
 
 	static int get(PyObject* obj, ObjectType& v)
 	{
+		if constexpr (BufferTraits<ObjectType>::value)
+		{
+			ObjectType result;
+			if (impl::getFromExactSequence(obj, result) == 0)
+			{
+				v = result;
+				return 0;
+			}
+		}
 		const TPyObjPtr tuple = impl::checkedFastSequence(obj, dimension);
 		if (!tuple)
 		{
@@ -315,6 +325,15 @@ struct PyExportTraits< prim::Vector2D<T> >:
 	static const char* className() { return "Vector2D"; }
 };
 
+/** Exports contiguous arrays of prim::Vector2D<T> as buffers of shape (n, 2).
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits< prim::Vector2D<T> >:
+	public impl::BufferTraitsArray< prim::Vector2D<T>, T, 2 >
+{
+};
+
 #	endif
 #endif
 
@@ -337,6 +356,15 @@ struct PyExportTraits< prim::Vector3D<T> >:
 	static const char* className() { return "Vector3D"; }
 };
 
+/** Exports contiguous arrays of prim::Vector3D<T> as buffers of shape (n, 3).
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits< prim::Vector3D<T> >:
+	public impl::BufferTraitsArray< prim::Vector3D<T>, T, 3 >
+{
+};
+
 #	endif
 #endif
 
@@ -358,6 +386,15 @@ struct PyExportTraits< prim::Vector4D<T> >:
 	static const char* className() { return "Vector4D"; }
 };
 
+/** Exports contiguous arrays of prim::Vector4D<T> as buffers of shape (n, 4).
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits< prim::Vector4D<T> >:
+	public impl::BufferTraitsArray< prim::Vector4D<T>, T, 4 >
+{
+};
+
 #	endif
 #endif
 
@@ -382,6 +419,15 @@ struct PyExportTraits< prim::Point2D<T> >:
 	static const char* className() { return "Point2D"; }
 };
 
+/** Exports contiguous arrays of prim::Point2D<T> as buffers of shape (n, 2).
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits< prim::Point2D<T> >:
+	public impl::BufferTraitsArray< prim::Point2D<T>, T, 2 >
+{
+};
+
 #	endif
 #endif
 
@@ -404,6 +450,15 @@ struct PyExportTraits< prim::Point3D<T> >:
 	static const char* className() { return "Point3D"; }
 };
 
+/** Exports contiguous arrays of prim::Point3D<T> as buffers of shape (n, 3).
+ *  @ingroup Python
+ */
+template <typename T>
+struct BufferTraits< prim::Point3D<T> >:
+	public impl::BufferTraitsArray< prim::Point3D<T>, T, 3 >
+{
+};
+
 #	endif
 #endif
 
@@ -699,6 +754,15 @@ struct PyExportTraits<prim::ColorRGBA>
 	}
 };
 
+/** Exports contiguous arrays of prim::ColorRGBA as buffers of shape (n, 4) of floats.
+ *  @ingroup Python
+ */
+template <>
+struct BufferTraits<prim::ColorRGBA>:
+	public impl::BufferTraitsArray<prim::ColorRGBA, prim::ColorRGBA::TValue, 4>
+{
+};
+
 #	endif
 #endif
 
@@ -94,6 +94,7 @@ struct PyExportTraitsVariantImpl<Variant, Head, Tail...>
 			return 0;
 		}
 		PyErr_Clear();
+		impl::clearTypeMismatch();
 		return PyExportTraitsVariantImpl<Variant, Tail...>::get(obj, v);
 	}
 };
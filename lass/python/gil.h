@@ -45,26 +45,64 @@
 
 #include "python_common.h"
 
+#if LASS_PYTHON_PER_INTERPRETER_GIL && PY_VERSION_HEX < 0x030d0000 // < 3.13
+#	error "LASS_PYTHON_PER_INTERPRETER_GIL requires Python 3.13 or later"
+#endif
+
 namespace lass
 {
 namespace python
 {
+namespace impl
+{
+
+/** The thread state attached to the current thread, or nullptr if it doesn't hold the GIL.
+ *  @internal
+ */
+inline PyThreadState* currentThreadState()
+{
+#if PY_VERSION_HEX >= 0x030d0000 // >= 3.13
+	return PyThreadState_GetUnchecked();
+#else
+	return _PyThreadState_UncheckedGet();
+#endif
+}
+
+/** The thread state UnblockThreads has detached from the current thread, if any.
+ *  Lets code that runs without the GIL still find out which interpreter it was called from.
+ *  @internal
+ */
+LASS_PYTHON_DLL PyThreadState*& detachedThreadState();
+
+}
 
 /** acquire the GIL for the current scope.
+ *
+ *  If the current thread already holds the GIL (or on free-threaded builds, already has an
+ *  attached thread state), this does nothing. That's not just faster, it's also required in
+ *  subinterpreters, as PyGILState_Ensure would switch to the main interpreter.
  */
 class LockGIL
 {
 public:
 	LockGIL():
-		state_(PyGILState_Ensure())
+		isAttached_(impl::currentThreadState() != nullptr)
 	{
+		if (!isAttached_)
+		{
+			state_ = PyGILState_Ensure();
+		}
 	}
 	~LockGIL() 
 	{
-		PyGILState_Release(state_);
+		if (!isAttached_)
+		{
+			PyGILState_Release(state_);
+		}
 	}
 private:
-	PyGILState_STATE state_;
+	PyGILState_STATE state_ = PyGILState_UNLOCKED;
+	bool isAttached_;
 };
 
 
@@ -72,20 +110,137 @@ private:
 class UnblockThreads
 {
 public:
-	UnblockThreads()
+	UnblockThreads():
+		detached_(impl::detachedThreadState()),
+		previous_(detached_)
 	{
 		Py_UNBLOCK_THREADS
+		detached_ = _save;
 	}
 	~UnblockThreads()
 	{
+		detached_ = previous_;
 		Py_BLOCK_THREADS
 	}
 private:
 	PyThreadState *_save;
+	PyThreadState*& detached_;
+	PyThreadState* previous_;
+};
+
+
+
+/** Whether exported functions and methods release the GIL while the C++ code runs.
+ *
+ *  Arguments are always converted, and results always built, while holding the GIL.
+ *  Releasing it lets other Python threads run during long computations, but costs two
+ *  thread state swaps per call. For cheap accessors, holding on to it is faster.
+ *
+ *  @sa PY_MODULE_FUNCTION_GIL, PY_CLASS_METHOD_GIL
+ */
+enum class GilPolicy
+{
+	release, ///< release the GIL during the C++ call (default)
+	hold, ///< keep the GIL during the C++ call, the C++ code must not block on other Python threads.
 };
 
 
 
+/** lock a Python object for the current scope, on free-threaded Python builds.
+ *
+ *  This is the equivalent of Py_BEGIN_CRITICAL_SECTION / Py_END_CRITICAL_SECTION.
+ *  On regular builds with a GIL, this does nothing as the GIL already serializes access.
+ *  Use this to protect the C++ state owned by a Python object, like the container of a Sequence.
+ */
+class LockObject
+{
+public:
+	explicit LockObject(const PyObject* obj)
+	{
+#ifdef Py_GIL_DISABLED
+		PyCriticalSection_Begin(&section_, const_cast<PyObject*>(obj));
+#else
+		(void) obj;
+#endif
+	}
+	~LockObject()
+	{
+#ifdef Py_GIL_DISABLED
+		PyCriticalSection_End(&section_);
+#endif
+	}
+	LockObject(const LockObject&) = delete;
+	LockObject& operator=(const LockObject&) = delete;
+private:
+#ifdef Py_GIL_DISABLED
+	PyCriticalSection section_;
+#endif
+};
+
+
+
+/** lock two Python objects for the current scope, on free-threaded Python builds.
+ *
+ *  This is the equivalent of Py_BEGIN_CRITICAL_SECTION2 / Py_END_CRITICAL_SECTION2, and avoids
+ *  deadlocks that could arise from nesting two LockObject. @a a and @a b may be the same object.
+ */
+class LockObjects
+{
+public:
+	LockObjects(PyObject* a, PyObject* b)
+	{
+#ifdef Py_GIL_DISABLED
+		PyCriticalSection2_Begin(&section_, a, b);
+#else
+		(void) a;
+		(void) b;
+#endif
+	}
+	~LockObjects()
+	{
+#ifdef Py_GIL_DISABLED
+		PyCriticalSection2_End(&section_);
+#endif
+	}
+	LockObjects(const LockObjects&) = delete;
+	LockObjects& operator=(const LockObjects&) = delete;
+private:
+#ifdef Py_GIL_DISABLED
+	PyCriticalSection2 section_;
+#endif
+};
+
+
+
+namespace impl
+{
+
+/** Mutex for shared C++ state of lass_python that regular Python builds protect by the GIL.
+ *  @internal
+ *
+ *  On free-threaded builds, this is a PyMutex, which detaches the thread state while blocking
+ *  so that it cannot deadlock with the garbage collector. The same goes if LASS_PYTHON_PER_INTERPRETER_GIL
+ *  is enabled, as subinterpreters with their own GIL don't serialize each other. Otherwise, it does
+ *  nothing. It can be used with std::lock_guard.
+ */
+class FreeThreadingMutex
+{
+public:
+#if defined(Py_GIL_DISABLED) || LASS_PYTHON_PER_INTERPRETER_GIL
+	void lock() { PyMutex_Lock(&mutex_); }
+	void unlock() { PyMutex_Unlock(&mutex_); }
+private:
+	PyMutex mutex_ = {};
+#else
+	void lock() {}
+	void unlock() {}
+#endif
+};
+
+}
+
+
+
 }
 }
 
@@ -51,8 +51,7 @@ namespace python
 {
 
 ModuleDefinition::ModuleDefinition(const char* name, const char* doc):
-	module_(0),
-	isInjected_(false)
+	isPrepared_(false)
 {
 	PyModuleDef def = {
 		PyModuleDef_HEAD_INIT,
@@ -63,9 +62,28 @@ ModuleDefinition::ModuleDefinition(const char* name, const char* doc):
 		0, /* m_reload */
 		0, /* m_traverse */
 		0, /* m_clear */
-		0, /* m_free */
+		&ModuleDefinition::freeModule, /* m_free */
 	};
-	def_ = def;
+	static_cast<PyModuleDef&>(def_) = def;
+	def_.self = this;
+	static_cast<PyModuleDef&>(multiPhaseDef_) = def;
+	multiPhaseDef_.self = this;
+
+	slots_.push_back({ Py_mod_create, reinterpret_cast<void*>(&ModuleDefinition::createModule) });
+	slots_.push_back({ Py_mod_exec, reinterpret_cast<void*>(&ModuleDefinition::execModule) });
+#if PY_VERSION_HEX >= 0x030c0000 // >= 3.12
+#	if LASS_PYTHON_PER_INTERPRETER_GIL || defined(Py_GIL_DISABLED)
+	slots_.push_back({ Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED });
+#	else
+	// the state shared between interpreters is only protected by the GIL, so they must share it.
+	slots_.push_back({ Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_SUPPORTED });
+#	endif
+#endif
+#ifdef Py_GIL_DISABLED
+	// lass_python protects its own state, so don't let the interpreter enable the GIL on import.
+	slots_.push_back({ Py_mod_gil, Py_MOD_GIL_NOT_USED });
+#endif
+	slots_.push_back({ 0, nullptr });
 
 	setName(name);
 	setDoc(doc);
@@ -120,19 +138,19 @@ void ModuleDefinition::setPostInject(const TPostInject& callback)
  */
 void ModuleDefinition::addClass(impl::ClassDefinition& classDef)
 {
-	LASS_ASSERT(!isInjected_);
+	LASS_ASSERT(!isPrepared_);
 	classes_.push_back(&classDef);
 }
 
 void ModuleDefinition::addEnum(EnumDefinitionBase* enumDef)
 {
-	LASS_ASSERT(!isInjected_);
+	LASS_ASSERT(!isPrepared_);
 	enums_.push_back(enumDef);
 }
 
 void ModuleDefinition::addObject(PyObject* object, const char* name)
 {
-	LASS_ASSERT(!isInjected_);
+	LASS_ASSERT(!isPrepared_);
 	NamedObject *tempObject = new NamedObject;
 	experimental::assignScopedCString(tempObject->name, name);
 	tempObject->object = object;
@@ -141,7 +159,7 @@ void ModuleDefinition::addObject(PyObject* object, const char* name)
 
 void ModuleDefinition::addLong(long object, const char* name)
 {
-	LASS_ASSERT(!isInjected_);
+	LASS_ASSERT(!isPrepared_);
 	LongObject *tempObject = new LongObject;
 	experimental::assignScopedCString(tempObject->name, name);
 	tempObject->object = object;
@@ -150,7 +168,7 @@ void ModuleDefinition::addLong(long object, const char* name)
 
 void ModuleDefinition::addString(const char* object, const char* name)
 {
-	LASS_ASSERT(!isInjected_);
+	LASS_ASSERT(!isPrepared_);
 	StringObject* tempObject = new StringObject;
 	experimental::assignScopedCString(tempObject->name, name);
 	experimental::assignScopedCString(tempObject->object, object);
@@ -159,33 +177,60 @@ void ModuleDefinition::addString(const char* object, const char* name)
 
 
 void ModuleDefinition::addFunctionDispatcher(
-		PyCFunction dispatcher, const char* name, const char* doc, PyCFunction& overloadChain)
+		impl::FastCallFunction dispatcher, const char* name, const char* doc, impl::OverloadLink& overloadChain)
 {
-	TMethods::iterator i = ::std::find_if(methods_.begin(), methods_.end(), impl::NamePredicate(name));
+	addFunctionDispatcher(impl::createPyFastCallMethodDef(name, dispatcher, METH_FASTCALL | METH_KEYWORDS, doc), overloadChain);
+}
+
+
+void ModuleDefinition::addFunctionDispatcher(
+		PyCFunction dispatcher, const char* name, const char* doc, impl::OverloadLink& overloadChain)
+{
+	addFunctionDispatcher(impl::createPyMethodDef(name, dispatcher, METH_VARARGS, doc), overloadChain);
+}
+
+
+void ModuleDefinition::addFunctionDispatcher(const PyMethodDef& method, impl::OverloadLink& overloadChain)
+{
+	overloadChain.setName(name(), method.ml_name);
+	TMethods::iterator i = ::std::find_if(methods_.begin(), methods_.end(), impl::NamePredicate(method.ml_name));
 	if (i == methods_.end())
 	{
-		methods_.push_back(impl::createPyMethodDef(name, dispatcher, METH_VARARGS , doc));
-		overloadChain = 0;
+		methods_.push_back(method);
+		overloadChain.setNull();
 	}
 	else
 	{
-		overloadChain = i->ml_meth;
-		i->ml_meth = dispatcher;
+		if (i->ml_flags & METH_FASTCALL)
+		{
+			overloadChain.setFastCallFunction(reinterpret_cast<impl::FastCallFunction>(reinterpret_cast<void(*)()>(i->ml_meth)));
+		}
+		else
+		{
+			overloadChain.setPyCFunction(i->ml_meth);
+		}
+		i->ml_meth = method.ml_meth;
+		i->ml_flags = method.ml_flags;
 	};
 }
 
 
+PyObject* ModuleDefinition::module() const
+{
+	const InterpreterModule* state = modules_.find();
+	return state ? state->module : nullptr;
+}
+
+
 void ModuleDefinition::injectLong(const char* name, long value)
 {
-	LASS_ENFORCE_POINTER(module_);
-	PyModule_AddIntConstant(module_, name, value);
+	PyModule_AddIntConstant(LASS_ENFORCE_POINTER(module()), name, value);
 }
 
 
 void ModuleDefinition::injectString(const char* name, const char* value)
 {
-	LASS_ENFORCE_POINTER(module_);
-	PyModule_AddStringConstant(module_, name, value);
+	PyModule_AddStringConstant(LASS_ENFORCE_POINTER(module()), name, value);
 }
 
 
@@ -196,10 +241,10 @@ void ModuleDefinition::injectString(const char* name, const char* value)
  */
 bool ModuleDefinition::injectClass(impl::ClassDefinition& classDef)
 {
-	LASS_ENFORCE_POINTER(module_);
+	PyObject* module = LASS_ENFORCE_POINTER(this->module());
 	const char* shortName = classDef.name(); // finalizePyType will expand tp_name with module name.
-	PyObject* type = classDef.freezeDefinition(module_);
-	return PyModule_AddObjectRef(module_, const_cast<char*>(shortName), type) == 0;
+	PyObject* type = classDef.freezeDefinition(module);
+	return type && PyModule_AddObjectRef(module, const_cast<char*>(shortName), type) == 0;
 }
 
 
@@ -216,69 +261,201 @@ PyObject* ModuleDefinition::inject()
 
 
 
+PyObject* ModuleDefinition::initMultiPhase()
+{
+	prepare();
+	return PyModuleDef_Init(&multiPhaseDef_);
+}
+
+
+
 PyObject* ModuleDefinition::doInject()
 {
-	if (isInjected_)
+	if (!Py_IsInitialized())
+	{
+		prepare(); // the pre-inject callback may need to run before Python is initialized.
+		Py_Initialize();
+	}
+	InterpreterModule& state = modules_.get();
+	if (state.isInjected)
 	{
 		// this can happen when the module was imported before, and then removed
 		// from sys.modules, and then re-imported. In that case, the module will
 		// be injected again. The only thing we can do is to return the same
 		// module again.
-		Py_INCREF(module_);
-		return module_;
+		Py_INCREF(state.module);
+		return state.module;
+	}
+	if (!state.module)
+	{
+		LASS_ASSERT(name_.get());
+		prepare();
+		TPyObjPtr module(PyModule_Create(&def_));
+		if (!module)
+		{
+			return nullptr;
+		}
+#ifdef Py_GIL_DISABLED
+		// lass_python protects its own state, so don't let the interpreter enable the GIL on import.
+		if (PyUnstable_Module_SetGIL(module.get(), Py_MOD_GIL_NOT_USED) != 0)
+		{
+			return nullptr;
+		}
+#endif
+		if (exec(module.get()) != 0)
+		{
+			return nullptr;
+		}
+		return fromSharedPtrToNakedCast(module);
+	}
+	if (exec(state.module) != 0)
+	{
+		return nullptr;
 	}
-	if (!module_)
+	Py_INCREF(state.module);
+	return state.module;
+}
+
+
+
+/** Completes the definition, before the first module object is created.
+ *
+ *  Only once for all interpreters, as those with their own GIL may import the module concurrently.
+ */
+void ModuleDefinition::prepare()
+{
+	std::call_once(prepareOnce_, [this]()
 	{
 		LASS_ASSERT(name_.get());
 		preInject_();
 		methods_.push_back(impl::createPyMethodDef(0, 0, 0, 0));
-		Py_Initialize();
 		def_.m_name = name_.get();
 		def_.m_doc = doc_.get();
 		def_.m_methods = &methods_[0];
-		module_ = PyModule_Create(&def_);
-		if (!module_)
-		{
-			return nullptr;
-		}
+		multiPhaseDef_.m_name = name_.get();
+		multiPhaseDef_.m_doc = doc_.get();
+		multiPhaseDef_.m_methods = &methods_[0];
+		multiPhaseDef_.m_slots = &slots_[0];
+		isPrepared_ = true;
+	});
+}
+
+
+
+/** Adds classes, enums and constants to a new module object of the current interpreter.
+ */
+int ModuleDefinition::exec(PyObject* module)
+{
+	InterpreterModule& state = modules_.get();
+	if (state.isInjected && state.module == module)
+	{
+		// reimported after it was removed from sys.modules, see createModule.
+		return 0;
 	}
+	state.module = module;
 	for (auto def: classes_)
 	{
 		if (!injectClass(*def))
 		{
-			return nullptr;
+			return -1;
 		}
 	}
 	for (auto def: enums_)
 	{
 		PyObject* enumType = def->freezeDefinition(name_.get(), nullptr);
-		if (PyModule_AddObjectRef(module_, def->name(), enumType) != 0)
+		if (!enumType || PyModule_AddObjectRef(module, def->name(), enumType) != 0)
 		{
-			return nullptr;
+			return -1;
 		}
 	}
+	if (!objects_.empty() && !impl::isMainInterpreter())
+	{
+		PyErr_Format(PyExc_ImportError, "%s has objects of the main interpreter, which can't be shared with subinterpreters", name_.get());
+		return -1;
+	}
 	for (TObjects::const_iterator obj = objects_.begin(); obj != objects_.end(); ++obj)
 	{
-		PyModule_AddObject(module_, (*obj)->name.get(), (*obj)->object);
+		if (PyModule_AddObjectRef(module, (*obj)->name.get(), (*obj)->object) != 0)
+		{
+			return -1;
+		}
 	}
 	for (TLongObjects::const_iterator obj = longObjects_.begin(); obj != longObjects_.end(); ++obj)
 	{
-		if (PyModule_AddIntConstant(module_, (*obj)->name.get(), (*obj)->object) != 0)
+		if (PyModule_AddIntConstant(module, (*obj)->name.get(), (*obj)->object) != 0)
 		{
-			return nullptr;
+			return -1;
 		}
 	}
 	for (TStringObjects::const_iterator obj = stringObjects_.begin(); obj != stringObjects_.end(); ++obj)
 	{
-		if (PyModule_AddStringConstant(module_, (*obj)->name.get(), (*obj)->object.get()) != 0)
+		if (PyModule_AddStringConstant(module, (*obj)->name.get(), (*obj)->object.get()) != 0)
 		{
-			return nullptr;
+			return -1;
 		}
 	}
-	postInject_(module_);
-	isInjected_ = true;
-	Py_INCREF(module_);
-	return module_;
+	postInject_(module);
+	state.isInjected = true;
+	if (impl::isMainInterpreter())
+	{
+		// the main interpreter keeps its module forever, like it always did.
+		Py_INCREF(module);
+	}
+	return 0;
+}
+
+
+
+/** Returns the existing module object of the current interpreter, if any.
+ *
+ *  This can happen when the module was imported before, then removed from sys.modules,
+ *  and then reimported. The only thing we can do is to return the same module again.
+ */
+PyObject* ModuleDefinition::createModule(PyObject* spec, PyModuleDef* def)
+{
+	InterpreterModule& state = static_cast<Definition*>(def)->self->modules_.get();
+	if (state.module)
+	{
+		Py_INCREF(state.module);
+		return state.module;
+	}
+	TPyObjPtr name(PyObject_GetAttrString(spec, "name"));
+	if (!name)
+	{
+		return nullptr;
+	}
+	return PyModule_NewObject(name.get());
+}
+
+
+
+int ModuleDefinition::execModule(PyObject* module)
+{
+	PyModuleDef* def = PyModule_GetDef(module);
+	if (!def)
+	{
+		return -1;
+	}
+	return static_cast<Definition*>(def)->self->exec(module);
+}
+
+
+
+/** Forgets the module object when it's destroyed, so that a new one is created on next import.
+ */
+void ModuleDefinition::freeModule(void* module)
+{
+	PyModuleDef* def = PyModule_GetDef(static_cast<PyObject*>(module));
+	if (!def)
+	{
+		PyErr_Clear();
+		return;
+	}
+	InterpreterModule& state = static_cast<Definition*>(def)->self->modules_.get();
+	if (state.module == module)
+	{
+		state = InterpreterModule();
+	}
 }
 
 }
@@ -45,9 +45,12 @@
 
 #include "python_common.h"
 #include "pyobject_plus.h"
+#include "per_interpreter.h"
 #include "../util/callback_0.h"
 #include "../util/callback_1.h"
 
+#include <mutex>
+
 namespace lass
 {
 namespace python
@@ -144,8 +147,8 @@ public:
 	 */
 	void setDoc(const char* doc);
 	
-	/** Get the Python module object (available after inject() has been called). */
-	PyObject* module() const { return module_; }
+	/** Get the Python module object of the current interpreter (available after it has been injected). */
+	PyObject* module() const;
 
 	/** Set callback to be executed before module injection.
 	 *  Useful for performing setup tasks before the module is created.
@@ -165,8 +168,15 @@ public:
 	 *  @param name Python function name
 	 *  @param doc Function documentation string
 	 *  @param overloadChain Reference to overload chain for this function name
+	 *
+	 *  Generated dispatchers are called with METH_FASTCALL, so no argument tuple is built.
+	 */
+	void addFunctionDispatcher(impl::FastCallFunction dispatcher, const char* name, const char* doc, impl::OverloadLink& overloadChain);
+
+	/** Add a raw PyCFunction to the module, called with an argument tuple (METH_VARARGS).
+	 *  Used by PY_MODULE_PY_FUNCTION_EX.
 	 */
-	void addFunctionDispatcher(PyCFunction dispatcher, const char* name, const char* doc, PyCFunction& overloadChain);
+	void addFunctionDispatcher(PyCFunction dispatcher, const char* name, const char* doc, impl::OverloadLink& overloadChain);
 	
 	/** Add a class definition to the module.
 	 *  The class will be created and added when the module is injected.
@@ -221,7 +231,7 @@ public:
 	template <typename T>
 	void injectObject(T&& object, const char* name)
 	{
-		PyModule_AddObject(module_, name, lass::python::pyBuildSimpleObject( std::forward<T>(object) ));
+		PyModule_AddObject(module(), name, lass::python::pyBuildSimpleObject( std::forward<T>(object) ));
 	}
 
 	/** Inject a class definition directly into an already created module.
@@ -236,6 +246,12 @@ public:
 	 *  @return The created Python module object
 	 */
 	PyObject* inject();
+
+	/** Returns the module definition for multi-phase initialization (PEP 489).
+	 *  This is what the `PyInit_*` function of PY_MODULE_ENTRYPOINT() returns. Python then creates
+	 *  the module object itself, a new one for each interpreter that imports the module.
+	 */
+	PyObject* initMultiPhase();
 private:
 	typedef std::unique_ptr<char[]> TScopedCString;
 	typedef std::vector<impl::ClassDefinition*> TClassDefs;
@@ -259,9 +275,29 @@ private:
 	typedef std::vector<NamedObject*> TObjects;
 	typedef std::vector<LongObject*> TLongObjects;
 	typedef std::vector<StringObject*> TStringObjects;
+	typedef std::vector<PyModuleDef_Slot> TSlots;
+
+	/** PyModuleDef that knows its ModuleDefinition, so that it can be found from the module object. */
+	struct Definition: PyModuleDef
+	{
+		ModuleDefinition* self;
+	};
+
+	/** The module object of one interpreter, borrowed. */
+	struct InterpreterModule
+	{
+		PyObject* module = nullptr;
+		bool isInjected = false;
+	};
 
 	/** Implementation of module injection process. */
 	PyObject* doInject();
+	void prepare();
+	int exec(PyObject* module);
+	static PyObject* createModule(PyObject* spec, PyModuleDef* def);
+	static int execModule(PyObject* module);
+	static void freeModule(void* module);
+	void addFunctionDispatcher(const PyMethodDef& method, impl::OverloadLink& overloadChain);
 
 	TClassDefs classes_;
 	TEnumDefs enums_;
@@ -273,9 +309,12 @@ private:
 	TScopedCString doc_;
 	TPreInject preInject_;
 	TPostInject postInject_;
-	PyObject* module_;
-	PyModuleDef def_;
-	bool isInjected_;
+	impl::PerInterpreter<InterpreterModule> modules_;
+	TSlots slots_;
+	Definition def_; ///< for single-phase initialization by inject()
+	Definition multiPhaseDef_; ///< for multi-phase initialization by initMultiPhase()
+	std::once_flag prepareOnce_;
+	bool isPrepared_;
 };
 
 }
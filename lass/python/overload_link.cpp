@@ -46,6 +46,12 @@
 #include "overload_link.h"
 #include "py_tuple.h"
 
+#include <algorithm>
+#include <mutex>
+#if LASS_PYTHON_CALL_STATS
+#	include <chrono>
+#endif
+
 namespace lass
 {
 namespace python
@@ -53,81 +59,266 @@ namespace python
 namespace impl
 {
 
+namespace
+{
+
+/** Build an argument tuple for overloads that still need one.
+ */
+TPyObjPtr makeArgsTuple(const FastCallArgs& args)
+{
+	TPyObjPtr tuple(PyTuple_New(args.nargs));
+	if (!tuple)
+	{
+		return tuple;
+	}
+	for (Py_ssize_t i = 0; i < args.nargs; ++i)
+	{
+		Py_INCREF(args.args[i]);
+		PyTuple_SET_ITEM(tuple.get(), i, args.args[i]);
+	}
+	return tuple;
+}
+
+/** Arguments last rejected by decodeArgs for their types alone, see markRejectedArgs.
+ *  The args array identifies the call, as it stays the same through the whole chain.
+ */
+thread_local PyObject* const* rejectedArgs = nullptr;
+
+}
+
+
+
+void markRejectedArgs(const FastCallArgs& args, Py_ssize_t index)
+{
+	rejectedArgs = (index < 0 || isTypeMismatch(args.args[index])) ? args.args : nullptr;
+}
+
+
+
+/** @internal
+ *  Argument types of a call, as key of RejectCache.
+ */
+class OverloadLink::RejectKey
+{
+public:
+	enum
+	{
+		maxArgs = 4,
+	};
+
+	/** Returns false if @a args can't be cached: too many or keyword arguments, or types without
+	 *  valid version tag.  The version tag guards against a new type reusing the address of
+	 *  a deallocated one.  Values, like the length of lists, are not part of the key, as only
+	 *  rejections that don't depend on them are cached.
+	 */
+	bool assign(const FastCallArgs& args)
+	{
+		if (args.hasKeywords() || args.nargs > maxArgs)
+		{
+			return false;
+		}
+		nargs_ = args.nargs;
+		for (Py_ssize_t i = 0; i < nargs_; ++i)
+		{
+			PyTypeObject* const type = Py_TYPE(args.args[i]);
+			if (!PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+			{
+				return false;
+			}
+			args_[i].type = type;
+			args_[i].versionTag = type->tp_version_tag;
+		}
+		return true;
+	}
+	bool operator==(const RejectKey& other) const
+	{
+		if (nargs_ != other.nargs_)
+		{
+			return false;
+		}
+		for (Py_ssize_t i = 0; i < nargs_; ++i)
+		{
+			const Arg& a = args_[i];
+			const Arg& b = other.args_[i];
+			if (a.type != b.type || a.versionTag != b.versionTag)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+private:
+	struct Arg
+	{
+		PyTypeObject* type;
+		unsigned int versionTag;
+	};
+	Py_ssize_t nargs_ = -1;
+	Arg args_[maxArgs];
+};
+
+/** @internal
+ *  Small cache of argument types that were rejected by the chain of an OverloadLink.
+ *  When full, the oldest entry is replaced.
+ */
+class OverloadLink::RejectCache
+{
+public:
+	enum
+	{
+		capacity = 8,
+	};
+	typedef RejectKey Key;
+
+	bool contains(const Key& key) const
+	{
+		return find(key) != size_;
+	}
+	void insert(const Key& key)
+	{
+		if (contains(key))
+		{
+			return;
+		}
+		keys_[next_] = key;
+		next_ = (next_ + 1) % capacity;
+		size_ = std::min<size_t>(size_ + 1, capacity);
+	}
+	void erase(const Key& key)
+	{
+		const size_t i = find(key);
+		if (i != size_)
+		{
+			keys_[i] = Key(); // an unassigned key never equals an assigned one.
+		}
+	}
+private:
+	size_t find(const Key& key) const
+	{
+		for (size_t i = 0; i < size_; ++i)
+		{
+			if (keys_[i] == key)
+			{
+				return i;
+			}
+		}
+		return size_;
+	}
+
+	Key keys_[capacity];
+	size_t size_ = 0;
+	size_t next_ = 0;
+};
+
+
+
 OverloadLink::OverloadLink()
 {
 	setNull();
 }
 
+OverloadLink::~OverloadLink() = default;
+
 void OverloadLink::setNull()
 {
 	signature_ = sNull;
+	rejects_.reset();
 }
 
 void OverloadLink::setPyCFunction(PyCFunction iOverload)
 {
 	signature_ = iOverload ? sPyCFunction : sNull;
+	rejects_.reset();
 	pyCFunction_ = iOverload;
 }
 
+void OverloadLink::setFastCallFunction(FastCallFunction iOverload)
+{
+	signature_ = iOverload ? sFastCall : sNull;
+	rejects_.reset();
+	fastCallFunction_ = iOverload;
+}
+
 void OverloadLink::setBinaryfunc(binaryfunc iOverload)
 {
 	signature_ = iOverload ? sBinary : sNull;
+	rejects_.reset();
 	binaryfunc_ = iOverload;
 }
 
 void OverloadLink::setTernaryfunc(ternaryfunc iOverload)
 {
 	signature_ = iOverload ? sTernary : sNull;
+	rejects_.reset();
 	ternaryfunc_ = iOverload;
 }
 void OverloadLink::setSsizeArgfunc(ssizeargfunc iOverload)
 {
 	signature_ = iOverload ? sSsizeArg : sNull;
+	rejects_.reset();
 	ssizeargfunc_ = iOverload;
 }
 void OverloadLink::setSsizeSsizeArgfunc(ssizessizeargfunc iOverload)
 {
 	signature_ = iOverload ? sSsizeSsizeArg : sNull;
+	rejects_.reset();
 	ssizessizeargfunc_ = iOverload;
 }
 
 void OverloadLink::setSsizeObjArgProcfunc(ssizeobjargproc iOverload)
 {
 	signature_ = iOverload ? sSsizeObjArg : sNull;
+	rejects_.reset();
 	ssizeobjargproc_ = iOverload;
 }
 void OverloadLink::setSsizeSsizeObjArgProcfunc(ssizessizeobjargproc iOverload)
 {
 	signature_ = iOverload ? sSsizeSsizeObjArg : sNull;
+	rejects_.reset();
 	ssizessizeobjargproc_ = iOverload;
 }
 void OverloadLink::setObjObjProcfunc(objobjproc iOverload)
 {
 	signature_ = iOverload ? sObjObj : sNull;
+	rejects_.reset();
 	objobjproc_ = iOverload;
 }
 void OverloadLink::setObjObjArgProcfunc(objobjargproc iOverload)
 {
 	signature_ = iOverload ? sObjObjArg : sNull;
+	rejects_.reset();
 	objobjargproc_ = iOverload;
 }
 void OverloadLink::setGetIterFunc(getiterfunc iOverload)
 {
 	signature_ = iOverload ? sGetIterFunc : sNull;
+	rejects_.reset();
 	getiterfunc_ = iOverload;
 }
 void OverloadLink::setIterNextFunc(iternextfunc iOverload)
 {
 	signature_ = iOverload ? sIterNextFunc : sNull;
+	rejects_.reset();
 	iternextfunc_ = iOverload;
 }
 void OverloadLink::setArgKwfunc(ternaryfunc iOverload)
 {
 	signature_ = iOverload ? sArgKw : sNull;
+	rejects_.reset();
 	ternaryfunc_ = iOverload;
 }
 
-bool OverloadLink::operator ()(PyObject* iSelf, PyObject* iArgs, PyObject*& oResult) const
+void OverloadLink::setName(const char* scope, const char* name)
+{
+#if LASS_PYTHON_CALL_STATS
+	stats_.setName(scope, name);
+#else
+	(void) scope;
+	(void) name;
+#endif
+}
+
+bool OverloadLink::operator ()(PyObject* iSelf, const FastCallArgs& iArgs, PyObject*& oResult) const
 {
 	if (signature_ == sNull)
 	{
@@ -144,7 +335,159 @@ bool OverloadLink::operator ()(PyObject* iSelf, PyObject* iArgs, PyObject*& oRes
 	return true;
 }
 
-PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
+PyObject* OverloadLink::dispatch(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload) const
+{
+#if LASS_PYTHON_CALL_STATS
+	if (currentCallFrame())
+	{
+		// an earlier link of the same chain, already counted by the last one.
+		return doDispatch(iSelf, iArgs, iOverload);
+	}
+	typedef std::chrono::steady_clock TClock;
+	CallFrame frame = { &stats_, 0 };
+	currentCallFrame() = &frame;
+	const TClock::time_point start = TClock::now();
+	PyObject* result = doDispatch(iSelf, iArgs, iOverload);
+	const std::int64_t total = std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now() - start).count();
+	currentCallFrame() = nullptr;
+	stats_.calls.fetch_add(1, std::memory_order_relaxed);
+	stats_.calleeNs.fetch_add(frame.calleeNs, std::memory_order_relaxed);
+	stats_.conversionNs.fetch_add(total - frame.calleeNs, std::memory_order_relaxed);
+	return result;
+#else
+	return doDispatch(iSelf, iArgs, iOverload);
+#endif
+}
+
+PyObject* OverloadLink::doDispatch(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload) const
+{
+	if (signature_ == sNull)
+	{
+		return callOverload(iSelf, iArgs, iOverload, true);
+	}
+
+	RejectKey key;
+	const bool cacheable = key.assign(iArgs);
+	if (!(cacheable && isCachedReject(key)))
+	{
+		clearTypeMismatch();
+		rejectedArgs = nullptr;
+		PyObject* result = call(iSelf, iArgs);
+		if (!isRejected())
+		{
+			return result;
+		}
+		const bool isChainRejectedByType = isRejectedByType(iArgs);
+		PyErr_Clear();
+		countOverloadMiss();
+		Py_XDECREF(result);
+		if (cacheable && isChainRejectedByType)
+		{
+			cacheReject(key, true);
+		}
+		return callOverload(iSelf, iArgs, iOverload, isChainRejectedByType);
+	}
+
+	PyObject* result = callOverload(iSelf, iArgs, iOverload, true);
+	if (result || !isRejected())
+	{
+		return result;
+	}
+
+	// The chain was skipped because it rejected these argument types before, but this overload
+	// rejects these particular values.  So the chain gets another chance, as it would without cache.
+	const bool isRejectedByTypeToo = isRejectedByType(iArgs);
+	PyObject *type, *value, *traceback;
+	PyErr_Fetch(&type, &value, &traceback);
+	countOverloadMiss();
+	cacheReject(key, false);
+	clearTypeMismatch();
+	rejectedArgs = nullptr;
+	result = call(iSelf, iArgs);
+	if (!isRejected())
+	{
+		Py_XDECREF(type);
+		Py_XDECREF(value);
+		Py_XDECREF(traceback);
+		return result;
+	}
+	const bool isChainRejectedByType = isRejectedByType(iArgs);
+	if (isChainRejectedByType)
+	{
+		cacheReject(key, true);
+	}
+	PyErr_Clear();
+	countOverloadMiss();
+	Py_XDECREF(result);
+	PyErr_Restore(type, value, traceback);
+	rejectedArgs = isChainRejectedByType && isRejectedByTypeToo ? iArgs.args : nullptr;
+	return 0;
+}
+
+/** Calls the overload of a link itself.  If it rejects @a iArgs, they're only marked as rejected
+ *  by type for the link that has this one in its chain, if the chain rejected them by type too.
+ */
+PyObject* OverloadLink::callOverload(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload, bool isChainRejectedByType)
+{
+	clearTypeMismatch();
+	rejectedArgs = nullptr;
+	PyObject* result = iOverload(iSelf, iArgs);
+	if (!isChainRejectedByType)
+	{
+		rejectedArgs = nullptr;
+	}
+	return result;
+}
+
+/** The reject cache is only a hint, so on free-threaded builds, it's fine if another thread
+ *  changes it in between isCachedReject and cacheReject.
+ */
+bool OverloadLink::isCachedReject(const RejectKey& key) const
+{
+	std::lock_guard<FreeThreadingMutex> lock(rejectsMutex_);
+	return rejects_ && rejects_->contains(key);
+}
+
+void OverloadLink::cacheReject(const RejectKey& key, bool rejected) const
+{
+	std::lock_guard<FreeThreadingMutex> lock(rejectsMutex_);
+	if (rejected)
+	{
+		if (!rejects_)
+		{
+			rejects_.reset(new RejectCache);
+		}
+		rejects_->insert(key);
+	}
+	else if (rejects_)
+	{
+		rejects_->erase(key);
+	}
+}
+
+void OverloadLink::countOverloadMiss()
+{
+#if LASS_PYTHON_CALL_STATS
+	if (CallFrame* frame = currentCallFrame())
+	{
+		frame->counter->overloadMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+#endif
+}
+
+bool OverloadLink::isRejected()
+{
+	return PyErr_Occurred() && (PyErr_ExceptionMatches(PyExc_TypeError) || PyErr_ExceptionMatches(PyExc_NotImplementedError));
+}
+
+/** True if the current rejection of @a iArgs is a TypeError that depends on their types alone.
+ */
+bool OverloadLink::isRejectedByType(const FastCallArgs& iArgs)
+{
+	return iArgs.args && rejectedArgs == iArgs.args && PyErr_ExceptionMatches(PyExc_TypeError);
+}
+
+PyObject* OverloadLink::call(PyObject* iSelf, const FastCallArgs& iArgs) const
 {
 	switch (signature_)
 	{
@@ -152,12 +495,27 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 		return 0;
 
 	case sPyCFunction:
-		return pyCFunction_(iSelf, iArgs);
+		{
+			if (iArgs.hasKeywords())
+			{
+				PyErr_SetString(PyExc_TypeError, "function takes no keyword arguments");
+				return 0;
+			}
+			const TPyObjPtr args = makeArgsTuple(iArgs);
+			if (!args)
+			{
+				return 0;
+			}
+			return pyCFunction_(iSelf, args.get());
+		}
+
+	case sFastCall:
+		return fastCallFunction_(iSelf, iArgs.args, iArgs.nargs, iArgs.kwnames);
 
 	case sBinary:
 		{
 			TPyObjPtr arg;
-			if (decodeTuple(iArgs, arg) != 0)
+			if (decodeArgs(iArgs, arg) != 0)
 			{
 				return 0;
 			}
@@ -167,7 +525,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 	case sTernary:
 		{
 			TPyObjPtr arg1, arg2;
-			if (decodeTuple(iArgs, arg1, arg2) != 0)
+			if (decodeArgs(iArgs, arg1, arg2) != 0)
 			{
 				return 0;
 			}
@@ -177,7 +535,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 	case sSsizeArg:
 		{
 			Py_ssize_t size1;
-			if (decodeTuple(iArgs, size1) != 0)
+			if (decodeArgs(iArgs, size1) != 0)
 			{
 				return 0;
 			}
@@ -188,7 +546,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 		{
 			Py_ssize_t size1;
 			Py_ssize_t size2;
-			if (decodeTuple(iArgs, size1, size2) != 0)
+			if (decodeArgs(iArgs, size1, size2) != 0)
 			{
 				return 0;
 			}
@@ -199,7 +557,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 		{
 			Py_ssize_t size1;
 			TPyObjPtr obj1;
-			if (decodeTuple(iArgs, size1, obj1) != 0)
+			if (decodeArgs(iArgs, size1, obj1) != 0)
 			{
 				return 0;
 			}
@@ -211,7 +569,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 			Py_ssize_t size1;
 			Py_ssize_t size2;
 			TPyObjPtr obj1;
-			if (decodeTuple(iArgs, size1, size2, obj1) != 0)
+			if (decodeArgs(iArgs, size1, size2, obj1) != 0)
 			{
 				return 0;
 			}
@@ -221,7 +579,7 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 	case sObjObj:
 		{
 			TPyObjPtr obj1;
-			if (decodeTuple(iArgs, obj1) != 0)
+			if (decodeArgs(iArgs, obj1) != 0)
 			{
 				return 0;
 			}
@@ -230,20 +588,17 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 
 	case sObjObjArg:
 		{
-			// iArgs can be a tuple of one or two elements.
-			// If it's two elements, it's key and value for __setitem__.
-			// If it's one element, we are infact the slot as __delitem__,
+			// iArgs can be one or two arguments.
+			// If it's two arguments, it's key and value for __setitem__.
+			// If it's one argument, we are infact the slot as __delitem__,
 			// and value is implicitly NULL.
 			//
-			const TPyObjPtr args = impl::checkedFastSequence(iArgs, 1, 2);
-			if (!args)
+			if ((iArgs.nargs != 2 || iArgs.hasKeywords()) && !checkArgsSize(iArgs, 1))
 			{
 				return 0;
 			}
-			const Py_ssize_t argc = PySequence_Fast_GET_SIZE(args.get());
-			PyObject** const argv = PySequence_Fast_ITEMS(args.get());
-			PyObject* const key = argv[0];
-			PyObject* const value = argc == 2 ? argv[1] : 0;
+			PyObject* const key = iArgs.args[0];
+			PyObject* const value = iArgs.nargs == 2 ? iArgs.args[1] : 0;
 			const int ret = objobjargproc_(iSelf, key, value);
 			switch (ret)
 			{
@@ -258,21 +613,45 @@ PyObject* OverloadLink::call(PyObject* iSelf, PyObject* iArgs) const
 		}
 
 	case sGetIterFunc:
-		if (decodeTuple(iArgs) != 0)
+		if (decodeArgs(iArgs) != 0)
 		{
 			return 0;
 		}
 		return getiterfunc_(iSelf);
 
 	case sIterNextFunc:
-		if (decodeTuple(iArgs) != 0)
+		if (decodeArgs(iArgs) != 0)
 		{
 			return 0;
 		}
 		return iternextfunc_(iSelf);
 
 	case sArgKw:
-		return ternaryfunc_(iSelf, iArgs, 0);
+		{
+			const TPyObjPtr args = makeArgsTuple(iArgs);
+			if (!args)
+			{
+				return 0;
+			}
+			TPyObjPtr kwargs;
+			if (iArgs.hasKeywords())
+			{
+				kwargs.reset(PyDict_New());
+				if (!kwargs)
+				{
+					return 0;
+				}
+				const Py_ssize_t nkw = PyTuple_GET_SIZE(iArgs.kwnames);
+				for (Py_ssize_t i = 0; i < nkw; ++i)
+				{
+					if (PyDict_SetItem(kwargs.get(), PyTuple_GET_ITEM(iArgs.kwnames, i), iArgs.args[iArgs.nargs + i]) != 0)
+					{
+						return 0;
+					}
+				}
+			}
+			return ternaryfunc_(iSelf, args.get(), kwargs.get());
+		}
 
 	default:
 		PyErr_SetString(PyExc_AssertionError, "OverloadChain: invalid signature type");
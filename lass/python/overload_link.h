@@ -45,6 +45,10 @@
 #define LASS_GUARDIAN_OF_INCLUSION_PYTHON_OVERLOAD_LINK_H
 
 #include "python_common.h"
+#include "gil.h"
+#include "call_stats.h"
+
+#include <memory>
 
 namespace lass
 {
@@ -52,8 +56,73 @@ namespace lass
 	{
 		namespace impl
 		{
+			/**	Signature of dispatchers called with METH_FASTCALL | METH_KEYWORDS.
+			 *	@ingroup Python
+			 *	@internal
+			 *
+			 *	Same as CPython's PyCFunctionFastWithKeywords, which only became public in 3.13.
+			 */
+			typedef PyObject* (*FastCallFunction)(PyObject* self, PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames);
+
+			/**	View on the arguments of a vectorcall or METH_FASTCALL call.
+			 *	@ingroup Python
+			 *	@internal
+			 *
+			 *	Positional arguments are a plain array of borrowed references, so decoding them doesn't
+			 *	need an argument tuple.  @a kwnames is a tuple with names of the keyword arguments that
+			 *	follow the positional ones in @a args, or null if there are none.  The items of a tuple
+			 *	are an array as well, so a tuple can be viewed as FastCallArgs without copying.
+			 */
+			struct FastCallArgs
+			{
+				FastCallArgs(PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames = nullptr):
+					args(args), nargs(nargs), kwnames(kwnames)
+				{
+				}
+				explicit FastCallArgs(PyObject* tuple):
+					args(PySequence_Fast_ITEMS(tuple)), nargs(PyTuple_GET_SIZE(tuple)), kwnames(nullptr)
+				{
+					LASS_ASSERT(PyTuple_Check(tuple));
+				}
+				bool hasKeywords() const { return kwnames && PyTuple_GET_SIZE(kwnames) > 0; }
+
+				PyObject* const* args;
+				Py_ssize_t nargs;
+				PyObject* kwnames;
+			};
+
+			/**	Calls one overload of a chain, without trying the overloads chained before it.
+			 *	@ingroup Python
+			 *	@internal
+			 */
+			typedef PyObject* (*OverloadFunction)(PyObject* self, const FastCallArgs& args);
+
+			/**	Called by decodeArgs when it rejects @a args, with @a index the bad argument, or -1 if
+			 *	it's the number of arguments that's wrong.
+			 *	@ingroup Python
+			 *	@internal
+			 *
+			 *	Tells OverloadLink whether the rejection is due to the argument types alone, see
+			 *	markTypeMismatch.
+			 */
+			LASS_PYTHON_DLL void LASS_CALL markRejectedArgs(const FastCallArgs& args, Py_ssize_t index);
+
 			/**	@ingroup Python
 			 *	@internal
+			 *
+			 *	Links an overload to the ones exported before it with the same name, which are tried
+			 *	first.  An overload rejects a call by raising TypeError or NotImplementedError, after
+			 *	which the next one is tried.
+			 *
+			 *	dispatch() remembers per link which argument types were rejected by the chain
+			 *	with a TypeError, so that following calls with the same types skip it and go straight
+			 *	to the right overload, without raising and clearing an exception for each earlier one.
+			 *	The key is the number and exact type of the positional arguments.  Only rejections that
+			 *	depend on those alone are remembered: a wrong number of arguments, or an argument that
+			 *	is marked by markTypeMismatch, like a str passed as an exported class.  Rejections by
+			 *	numeric or container conversions depend on the values, and are never cached.  If the
+			 *	overload still rejects the arguments, the chain is tried anyway, so the cache never
+			 *	turns a valid call into an error.  Like the rest of the dispatching, it relies on the GIL.
 			 */
 			class LASS_PYTHON_DLL OverloadLink
 			{
@@ -62,6 +131,7 @@ namespace lass
 				{
 					sNull,
 					sPyCFunction,
+					sFastCall,
 					sBinary,
 					sTernary,
 					sSsizeArg,
@@ -75,8 +145,10 @@ namespace lass
 					sArgKw
 				};
 				OverloadLink();
+				~OverloadLink();
 				void setNull();
 				void setPyCFunction(PyCFunction iOverload);
+				void setFastCallFunction(FastCallFunction iOverload);
 				void setBinaryfunc(binaryfunc iOverload);
 				void setTernaryfunc(ternaryfunc iOverload);
 				
@@ -91,13 +163,34 @@ namespace lass
 
 				void setArgKwfunc(ternaryfunc iOverload);
 
-				bool operator()(PyObject* iSelf, PyObject* iArgs, 
+				/**	Name under which the calls are counted, if LASS_PYTHON_CALL_STATS is enabled.
+				 */
+				void setName(const char* scope, const char* name);
+
+				bool operator()(PyObject* iSelf, const FastCallArgs& iArgs,
 					PyObject*& result) const;
+
+				/**	Try the chain, and if it rejects the arguments, call @a iOverload.
+				 */
+				PyObject* dispatch(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload) const;
+
 			private:
-				PyObject* call(PyObject* iSelf, PyObject* iArgs) const;
+				class RejectKey;
+				class RejectCache;
+
+				PyObject* doDispatch(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload) const;
+				PyObject* call(PyObject* iSelf, const FastCallArgs& iArgs) const;
+				static void countOverloadMiss();
+				static bool isRejected();
+				static bool isRejectedByType(const FastCallArgs& iArgs);
+				static PyObject* callOverload(PyObject* iSelf, const FastCallArgs& iArgs, OverloadFunction iOverload, bool isChainRejectedByType);
+				bool isCachedReject(const RejectKey& key) const;
+				void cacheReject(const RejectKey& key, bool rejected) const;
+
 				union
 				{
 					PyCFunction pyCFunction_;
+					FastCallFunction fastCallFunction_;
 					binaryfunc binaryfunc_;
 					ternaryfunc ternaryfunc_;
 
@@ -112,6 +205,11 @@ namespace lass
 					iternextfunc iternextfunc_;
 				};
 				Signature signature_;
+				mutable std::unique_ptr<RejectCache> rejects_;
+				mutable FreeThreadingMutex rejectsMutex_;
+#if LASS_PYTHON_CALL_STATS
+				mutable CallStatsCounter stats_;
+#endif
 			};
 		}
 	}
@@ -0,0 +1,222 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_PYTHON_PER_INTERPRETER_H
+#define LASS_GUARDIAN_OF_INCLUSION_PYTHON_PER_INTERPRETER_H
+
+#include "python_common.h"
+#include "gil.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace lass
+{
+namespace python
+{
+namespace impl
+{
+
+/** Returns the interpreter the current thread runs in.
+ *
+ *  Unlike PyInterpreterState_Get(), this also works while the GIL is released by an exported
+ *  function, in which case it returns the interpreter that called the function.
+ *  Threads that never had a thread state are assumed to belong to the main interpreter.
+ *
+ *  @ingroup Python
+ *  @internal
+ */
+inline PyInterpreterState* currentInterpreter()
+{
+	if (PyThreadState* tstate = currentThreadState())
+	{
+		return PyThreadState_GetInterpreter(tstate);
+	}
+	if (PyThreadState* tstate = detachedThreadState())
+	{
+		return PyThreadState_GetInterpreter(tstate);
+	}
+	return PyInterpreterState_Main();
+}
+
+/** Returns true if the current thread runs in the main interpreter.
+ *  @ingroup Python
+ *  @internal
+ */
+inline bool isMainInterpreter()
+{
+	return currentInterpreter() == PyInterpreterState_Main();
+}
+
+/** @ingroup Python
+ *  @internal
+ *
+ *  Base of PerInterpreter, so that forgetInterpreter() can find all instances that have state
+ *  for subinterpreters.
+ */
+class LASS_PYTHON_DLL PerInterpreterBase
+{
+public:
+	PerInterpreterBase(const PerInterpreterBase&) = delete;
+	PerInterpreterBase& operator=(const PerInterpreterBase&) = delete;
+protected:
+	PerInterpreterBase() = default;
+	virtual ~PerInterpreterBase();
+	void registerInstance(); ///< so that forgetInterpreter() can find it, does nothing if already registered.
+private:
+	friend LASS_PYTHON_DLL void forgetInterpreter();
+	virtual void erase(PyInterpreterState* interp) = 0;
+	bool isRegistered_ = false;
+};
+
+/** @ingroup Python
+ *  @internal
+ *
+ *  A value of type @a T for each Python interpreter, like the type object of a class definition.
+ *
+ *  Python objects can't be shared between interpreters, so state that refers to them must be
+ *  kept per interpreter. The main interpreter doesn't need a lookup or lock, as that's the one
+ *  that's used most, if not exclusively. The values of subinterpreters are created on first
+ *  access, and destroyed by forgetInterpreter(), which must be called by the subinterpreter
+ *  itself before it ends. They're keyed by interpreter ID rather than address, as the address
+ *  of an interpreter that ended may be reused by a new one.
+ */
+template <typename T>
+class PerInterpreter: public PerInterpreterBase
+{
+public:
+	PerInterpreter() = default;
+	~PerInterpreter() = default;
+
+	/** Returns the value of the current interpreter, creating a default one if needed.
+	 */
+	T& get()
+	{
+		PyInterpreterState* interp = currentInterpreter();
+		if (interp == PyInterpreterState_Main())
+		{
+			return main_;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (T* value = find(interp))
+			{
+				return *value;
+			}
+			others_.emplace_back(PyInterpreterState_GetID(interp), std::make_unique<T>());
+		}
+		registerInstance();
+		std::lock_guard<std::mutex> lock(mutex_);
+		return *find(interp);
+	}
+
+	/** Returns the value of the current interpreter, or null if it has none.
+	 */
+	const T* find() const
+	{
+		PyInterpreterState* interp = currentInterpreter();
+		if (interp == PyInterpreterState_Main())
+		{
+			return &main_;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		return const_cast<PerInterpreter*>(this)->find(interp);
+	}
+
+private:
+	typedef std::vector<std::pair<std::int64_t, std::unique_ptr<T>>> TOthers;
+
+	T* find(PyInterpreterState* interp)
+	{
+		const std::int64_t id = PyInterpreterState_GetID(interp);
+		for (auto& other : others_)
+		{
+			if (other.first == id)
+			{
+				return other.second.get();
+			}
+		}
+		return nullptr;
+	}
+
+	void erase(PyInterpreterState* interp) override
+	{
+		const std::int64_t id = PyInterpreterState_GetID(interp);
+		std::unique_ptr<T> value; // destroyed outside of the lock, as it may release Python objects.
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			for (auto i = others_.begin(); i != others_.end(); ++i)
+			{
+				if (i->first == id)
+				{
+					value = std::move(i->second);
+					others_.erase(i);
+					break;
+				}
+			}
+		}
+	}
+
+	T main_ {};
+	TOthers others_;
+	mutable std::mutex mutex_;
+};
+
+/** Destroys the state that PerInterpreter instances keep for the current subinterpreter.
+ *  @ingroup Python
+ *  @internal
+ *
+ *  Called when the `_lass` module of a subinterpreter goes away. Does nothing for the main interpreter.
+ */
+LASS_PYTHON_DLL void forgetInterpreter();
+
+}
+}
+}
+
+#endif
+
+// EOF
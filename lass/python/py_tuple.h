@@ -100,7 +100,7 @@ namespace impl
 	 *  @internal
 	 */
 	template <typename P>
-	inline bool decodeObjects(PyObject** objects, Py_ssize_t index, P& p)
+	inline bool decodeObjects(PyObject* const* objects, Py_ssize_t index, P& p)
 	{
 		return impl::decodeObject(objects[index], index, p);
 	}
@@ -109,7 +109,7 @@ namespace impl
 	 *  @internal
 	 */
 	template <typename P, typename... Ptail>
-	inline bool decodeObjects(PyObject** objects, Py_ssize_t index, P& p, Ptail&... tail)
+	inline bool decodeObjects(PyObject* const* objects, Py_ssize_t index, P& p, Ptail&... tail)
 	{
 		return impl::decodeObject(objects[index], index, p)
 			&& decodeObjects(objects, index + 1, tail...);
@@ -119,7 +119,7 @@ namespace impl
 	 *  @internal
 	 */
 	template <typename P>
-	inline bool decodeObjectsMinimum(PyObject** objects, Py_ssize_t index, Py_ssize_t size, P& p)
+	inline bool decodeObjectsMinimum(PyObject* const* objects, Py_ssize_t index, Py_ssize_t size, P& p)
 	{
 		return index >= size
 			|| impl::decodeObject(objects[index], index, p);
@@ -129,12 +129,25 @@ namespace impl
 	 *  @internal
 	 */
 	template <typename P, typename... Ptail>
-	inline bool decodeObjectsMinimum(PyObject** objects, Py_ssize_t index, Py_ssize_t size, P& p, Ptail&... tail)
+	inline bool decodeObjectsMinimum(PyObject* const* objects, Py_ssize_t index, Py_ssize_t size, P& p, Ptail&... tail)
 	{
 		return index >= size
 			|| (impl::decodeObject(objects[index], index, p)
 				&& decodeObjectsMinimum(objects, index + 1, size, tail...));
 	}
+
+	/** @ingroup Python
+	 *  @internal
+	 */
+	inline bool checkArgsSize(const FastCallArgs& args, Py_ssize_t expectedSize)
+	{
+		if (args.nargs == expectedSize && !args.hasKeywords())
+		{
+			return true;
+		}
+		raiseBadArgsSize(args, expectedSize);
+		return false;
+	}
 }
 
 
@@ -235,6 +248,43 @@ int decodeTupleMinimum(const TPyObjPtr& obj, Py_ssize_t minumumLength, P&... p)
 
 
 
+/** Decode positional arguments of a METH_FASTCALL call, without building a tuple.
+ *  @ingroup Python
+ *  The GIL must be held, as is always the case when called from a dispatcher.
+ */
+inline int decodeArgs(const impl::FastCallArgs& args)
+{
+	if (!impl::checkArgsSize(args, 0))
+	{
+		impl::markRejectedArgs(args, -1);
+		return 1;
+	}
+	return 0;
+}
+
+/** Decode positional arguments of a METH_FASTCALL call, without building a tuple.
+ *  @ingroup Python
+ *  The GIL must be held, as is always the case when called from a dispatcher.
+ */
+template <typename... P>
+int decodeArgs(const impl::FastCallArgs& args, P&... p)
+{
+	if (!impl::checkArgsSize(args, sizeof...(P)))
+	{
+		impl::markRejectedArgs(args, -1);
+		return 1;
+	}
+	Py_ssize_t index = 0; // ends up at the bad argument, if any.
+	if (((impl::decodeObject(args.args[index], index, p) && ++index) && ...))
+	{
+		return 0;
+	}
+	impl::markRejectedArgs(args, index);
+	return 1;
+}
+
+
+
 // --- pairs ---------------------------------------------------------------------------------------
 
 /** std::pair translates to a tuple by copy.
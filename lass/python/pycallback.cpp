@@ -119,12 +119,15 @@ const std::string MultiCallbackImplBase::repr() const
 	
 	void MultiCallback::reset()
 	{
+		LockGIL lock;
+		LockObject guard(this);
 		pimpl_->reset();
 	}
 
 	void MultiCallback::call(const python::TPyObjPtr& args)
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		pimpl_->call(args,this);
 	}
 	PyObject* MultiCallback::callVar(PyObject* args) 
@@ -148,11 +151,13 @@ const std::string MultiCallbackImplBase::repr() const
 
 	Py_ssize_t MultiCallback::length( PyObject* self)
 	{
+		LockObject guard(self);
 		return static_cast<MultiCallback*>(self)->pimpl_->length();
 	}
 	void MultiCallback::add(const python::TPyObjPtr& args)
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		pimpl_->add(args);
 	}
 	PyObject* MultiCallback::addVar(PyObject* args)
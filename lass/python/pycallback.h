@@ -210,7 +210,7 @@ namespace impl
 	void MultiCallbackImpl<C>::call(const python::TPyObjPtr& args, PyObject* self)
 	{
 		LockGIL lock; // as we're going to release it again ...
-		impl::CallMethod< CallIntermediateShadowTraits<C> >::call(args.get(), self, &C::call ); 
+		impl::CallMethod< CallIntermediateShadowTraits<C> >::call(impl::FastCallArgs(args.get()), self, &C::call ); 
 	}
 }
 
@@ -51,10 +51,52 @@ namespace lass
 {
 namespace python
 {
+namespace impl
+{
+	Py_ssize_t PyIteratorRangeImplBase::iterNextChunk(PyObject** items, Py_ssize_t n)
+	{
+		Py_ssize_t i = 0;
+		for (; i < n; ++i)
+		{
+			items[i] = iterNext();
+			if (!items[i])
+			{
+				if (!PyErr_Occurred())
+				{
+					break;
+				}
+				while (i > 0)
+				{
+					Py_DECREF(items[--i]);
+				}
+				return -1;
+			}
+		}
+		return i;
+	}
+
+	Py_ssize_t PyIteratorRangeImplBase::lengthHint() const
+	{
+		return -1;
+	}
+
+	int PyIteratorRangeImplBase::getBuffer(Py_buffer* view, PyObject*, int, bool)
+	{
+		view->obj = nullptr;
+		PyErr_SetString(PyExc_BufferError, "PyIteratorRange does not support the buffer protocol: items are not stored contiguously as a primitive type");
+		return -1;
+	}
+}
+
 	PY_DECLARE_CLASS( PyIteratorRange )
+	PY_CLASS_METHOD_GIL( PyIteratorRange, nextChunk, GilPolicy::hold )
+	PY_CLASS_METHOD_GIL_EX( PyIteratorRange, lengthHint, "__length_hint__", 0,
+		LASS_UNIQUENAME(lassPyImpl_method_PyIteratorRange), GilPolicy::hold )
 	LASS_EXECUTE_BEFORE_MAIN_EX( PyIteratorRange_executeBeforeMain,
 		PyIteratorRange::_lassPyClassDef.setSlot(Py_tp_iter, &PyIteratorRange::iter);
 		PyIteratorRange::_lassPyClassDef.setSlot(Py_tp_iternext, &PyIteratorRange::iterNext);
+		PyIteratorRange::_lassPyClassDef.setSlot(Py_bf_getbuffer, &PyIteratorRange::getBuffer);
+		PyIteratorRange::_lassPyClassDef.setSlot(Py_bf_releasebuffer, &PyIteratorRange::releaseBuffer);
 	)
 
 	PyIteratorRange::PyIteratorRange(TPimpl pimpl):
@@ -73,14 +115,137 @@ namespace python
 	PyObject* PyIteratorRange::iterNext( PyObject* iPO) 
 	{
 		PyIteratorRange* self = static_cast<PyIteratorRange*>(iPO);
-		if (!self->owner_)
+		if (!self->checkOwner())
 		{
-			PyErr_SetString(PyExc_AssertionError, "PyIteratorRange has no owner");
 			return 0;
 		}
 		return self->pimpl_->iterNext(); 
 	}
 
+	const TPyObjPtr PyIteratorRange::nextChunk(Py_ssize_t size)
+	{
+		if (!checkOwner())
+		{
+			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+		}
+		const Py_ssize_t hint = pimpl_->lengthHint();
+		if (size < 0 || (hint >= 0 && size > hint))
+		{
+			size = hint;
+		}
+		if (size >= 0)
+		{
+			// convert straight into the list, and drop the slots that are left unused.
+			TPyObjPtr result(PyList_New(size));
+			if (!result)
+			{
+				impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+			}
+			const Py_ssize_t n = pimpl_->iterNextChunk(PySequence_Fast_ITEMS(result.get()), size);
+			if (n < 0 || (n < size && PyList_SetSlice(result.get(), n, size, nullptr) != 0))
+			{
+				impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+			}
+			return result;
+		}
+
+		// unknown length: convert in chunks until the end.
+		constexpr Py_ssize_t chunkSize = 256;
+		PyObject* items[chunkSize];
+		TPyObjPtr result(PyList_New(0));
+		if (!result)
+		{
+			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+		}
+		Py_ssize_t n = 0;
+		do
+		{
+			n = pimpl_->iterNextChunk(items, chunkSize);
+			if (n < 0)
+			{
+				impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+			}
+			int error = 0;
+			for (Py_ssize_t i = 0; i < n; ++i)
+			{
+				if (!error)
+				{
+					error = PyList_Append(result.get(), items[i]);
+				}
+				Py_DECREF(items[i]);
+			}
+			if (error)
+			{
+				impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
+			}
+		}
+		while (n == chunkSize);
+		return result;
+	}
+
+	const TPyObjPtr PyIteratorRange::lengthHint() const
+	{
+		const Py_ssize_t n = pimpl_->lengthHint();
+		if (n < 0)
+		{
+			Py_INCREF(Py_NotImplemented);
+			return TPyObjPtr(Py_NotImplemented);
+		}
+		return TPyObjPtr(PyLong_FromSsize_t(n));
+	}
+
+	int PyIteratorRange::getBuffer(PyObject* iPO, Py_buffer* view, int flags)
+	{
+		PyIteratorRange* self = static_cast<PyIteratorRange*>(iPO);
+		if (!self->checkOwner())
+		{
+			view->obj = nullptr;
+			return -1;
+		}
+		if (!PyObject_CheckBuffer(self->owner_.get()))
+		{
+			return self->pimpl_->getBuffer(view, iPO, flags, true);
+		}
+
+		// Let the owner account for the export, so that it refuses to resize and to hand out
+		// writable views if it's read-only.
+		Py_buffer ownerView;
+		if (PyObject_GetBuffer(self->owner_.get(), &ownerView, PyBUF_RECORDS_RO | (flags & PyBUF_WRITABLE)) != 0)
+		{
+			view->obj = nullptr;
+			return -1;
+		}
+		if (self->pimpl_->getBuffer(view, iPO, flags, ownerView.readonly != 0) != 0)
+		{
+			PyBuffer_Release(&ownerView);
+			return -1;
+		}
+		self->ownerViews_.push_back(ownerView);
+		return 0;
+	}
+
+	void PyIteratorRange::releaseBuffer(PyObject* iPO, Py_buffer* view)
+	{
+		PyIteratorRange* self = static_cast<PyIteratorRange*>(iPO);
+		impl::releaseBufferInfo(view);
+		if (!self->ownerViews_.empty())
+		{
+			// all owner views are alike, it doesn't matter which one is released.
+			PyBuffer_Release(&self->ownerViews_.back());
+			self->ownerViews_.pop_back();
+		}
+	}
+
+	bool PyIteratorRange::checkOwner() const
+	{
+		if (!owner_)
+		{
+			PyErr_SetString(PyExc_AssertionError, "PyIteratorRange has no owner");
+			return false;
+		}
+		return true;
+	}
+
 	const TPyObjPtr& PyIteratorRange::owner() const
 	{
 		return owner_;
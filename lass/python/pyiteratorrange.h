@@ -48,6 +48,10 @@
 #include "pyobject_plus.h"
 #include "_lass_module.h"
 #include "pyshadow_object.h"
+#include "buffer_traits.h"
+
+#include <iterator>
+#include <vector>
 
 
 #if LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_MSVC
@@ -116,7 +120,70 @@ namespace impl
 		PyIteratorRangeImplBase() = default;
 		virtual ~PyIteratorRangeImplBase() = default;
 		virtual PyObject* iterNext() = 0;
+
+		/** Converts up to @a n next items at once, storing new references in @a items.
+		 *  Returns the number of items stored, which is less than @a n only if the end is reached.
+		 *  On error, returns -1 with a Python exception set, and no references are left in @a items.
+		 *  The default implementation calls iterNext() for each item.
+		 */
+		virtual Py_ssize_t iterNextChunk(PyObject** items, Py_ssize_t n);
+
+		/** Number of items left, or -1 if unknown. Returns -1 by default. */
+		virtual Py_ssize_t lengthHint() const;
+
+		/** Exports the items left through the buffer protocol, without copying.
+		 *  Only possible if they are stored contiguously and have BufferTraits.
+		 *  If @a readOnly is true, the view is read-only even if the iterators are not.
+		 *  The default implementation raises a BufferError.
+		 */
+		virtual int getBuffer(Py_buffer* view, PyObject* exporter, int flags, bool readOnly);
+	};
+
+	/** @ingroup PythonIterators
+	 *  @internal
+	 *  True if the distance between two Iterators can be computed in constant time.
+	 *  Not all iterator adaptors that claim to be random access implement `operator-`.
+	 */
+	template <typename Iterator, typename Enable = void>
+	struct HasIteratorDistance: std::false_type
+	{
+	};
+
+	template <typename Iterator>
+	struct HasIteratorDistance<Iterator, std::void_t<decltype(std::declval<const Iterator&>() - std::declval<const Iterator&>())>>:
+		std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>
+	{
+	};
+
+	/** @ingroup PythonIterators
+	 *  @internal
+	 *  True if Iterator points to consecutive elements in memory, so that the range can be exported as buffer.
+	 *  Before C++20, only pointers and std::vector iterators are recognized.
+	 */
+	template <typename Iterator, typename Enable = void>
+	struct IsContiguousIterator: std::is_pointer<Iterator>
+	{
+	};
+
+#if defined(__cpp_lib_concepts) && __cpp_lib_concepts >= 202002L
+	template <typename Iterator>
+	struct IsContiguousIterator<Iterator, std::enable_if_t<!std::is_pointer_v<Iterator>>>:
+		std::bool_constant<std::contiguous_iterator<Iterator>>
+	{
+	};
+#else
+	template <typename Iterator>
+	struct IsContiguousIterator<Iterator, std::enable_if_t<!std::is_pointer_v<Iterator>>>
+	{
+	private:
+		using TValue = typename std::iterator_traits<Iterator>::value_type;
+		constexpr static bool isCandidate = BufferTraits<TValue>::value && !std::is_same_v<TValue, bool>;
+		using TVector = std::vector<std::conditional_t<isCandidate, TValue, char>>;
+	public:
+		constexpr static bool value = isCandidate &&
+			(std::is_same_v<Iterator, typename TVector::iterator> || std::is_same_v<Iterator, typename TVector::const_iterator>);
 	};
+#endif
 
 	/** Implementation of PyIteratorRangeImplBase that iterates over a C++ iterator pair.
 	 *  @ingroup PythonIterators
@@ -137,6 +204,53 @@ namespace impl
 			// stopiteration exception
 			return nullptr;
 		}
+		Py_ssize_t iterNextChunk(PyObject** items, Py_ssize_t n) override
+		{
+			Py_ssize_t i = 0;
+			for (; i < n && current_ != last_; ++i)
+			{
+				items[i] = pyBuildSimpleObject(*current_++);
+				if (!items[i])
+				{
+					while (i > 0)
+					{
+						Py_DECREF(items[--i]);
+					}
+					return -1;
+				}
+			}
+			return i;
+		}
+		Py_ssize_t lengthHint() const override
+		{
+			if constexpr (HasIteratorDistance<Iterator>::value)
+			{
+				return static_cast<Py_ssize_t>(last_ - current_);
+			}
+			else
+			{
+				return -1;
+			}
+		}
+		int getBuffer(Py_buffer* view, PyObject* exporter, int flags, bool readOnly) override
+		{
+			using TReference = typename std::iterator_traits<Iterator>::reference;
+			using TValue = std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+			if constexpr (IsContiguousIterator<Iterator>::value && BufferTraits<TValue>::value)
+			{
+				typedef BufferTraits<TValue> TBufferTraits;
+				const Py_ssize_t length = static_cast<Py_ssize_t>(last_ - current_);
+				const void* buf = length > 0 ? TBufferTraits::data(*current_) : nullptr;
+				const bool isReadOnly = readOnly || std::is_const_v<std::remove_reference_t<TReference>>;
+				return fillBufferInfo(view, exporter, const_cast<void*>(buf), length, static_cast<Py_ssize_t>(sizeof(TValue)),
+					TBufferTraits::format, static_cast<Py_ssize_t>(sizeof(typename TBufferTraits::TScalar)),
+					TBufferTraits::components, isReadOnly, flags);
+			}
+			else
+			{
+				return PyIteratorRangeImplBase::getBuffer(view, exporter, flags, readOnly);
+			}
+		}
 	private:
 		Iterator first_;
 		Iterator last_;
@@ -161,6 +275,27 @@ namespace impl
 			}
 			return nullptr; // equivalent to StopIteration in Python
 		}
+		Py_ssize_t iterNextChunk(PyObject** items, Py_ssize_t n) override
+		{
+			Py_ssize_t i = 0;
+			for (; i < n && index_ < size_; ++i)
+			{
+				items[i] = pyBuildSimpleObject(atFunc_(index_++));
+				if (!items[i])
+				{
+					while (i > 0)
+					{
+						Py_DECREF(items[--i]);
+					}
+					return -1;
+				}
+			}
+			return i;
+		}
+		Py_ssize_t lengthHint() const override
+		{
+			return index_ < size_ ? static_cast<Py_ssize_t>(size_ - index_) : 0;
+		}
 	private:
 		AtFunc atFunc_;
 		SizeType size_;
@@ -174,6 +309,15 @@ namespace impl
  *  This is the class that implements the Python iterator interface and that is exposed
  *  to Python. It can be created directly with two iterators, or with a custom
  *  implementation deriving from `PyIteratorRangeImplBase`.
+ *
+ *  Next to the iterator protocol, it has two faster ways to get at the items:
+ *  - `nextChunk(size)` converts many items at once to a list.
+ *  - If the items are stored contiguously and have BufferTraits, like a
+ *    `std::vector<Point3D<double>>`, the items left are exported through the buffer
+ *    protocol, so that `memoryview(it)` or `numpy.asarray(it)` wraps them without copying.
+ *    If the owner supports the buffer protocol itself, like a Sequence, each export also
+ *    holds a buffer of the owner: it can't be resized while the view lives, and the view
+ *    is only writable if the owner is. Otherwise, the view is always read-only.
  * 
  *  @ingroup PythonIterators
  */
@@ -212,12 +356,27 @@ public:
 	void setOwner(const TPyObjPtr& owner);
 	///@}
 
+	/** Returns a list with the next @a size items, or all items left if @a size is negative.
+	 *
+	 *  The list is shorter than @a size only if the end is reached, and empty after that.
+	 *  Converting items in chunks avoids the overhead of the iterator protocol per item.
+	 */
+	const TPyObjPtr nextChunk(Py_ssize_t size);
+
+	/** Number of items left, or NotImplemented if unknown. Lets `list(iterator)` preallocate. */
+	const TPyObjPtr lengthHint() const;
+
 	static PyObject* iter( PyObject* iPo);
 	static PyObject* iterNext( PyObject* iPO);
+	static int getBuffer(PyObject* self, Py_buffer* view, int flags);
+	static void releaseBuffer(PyObject* self, Py_buffer* view);
 	
 private:
+	bool checkOwner() const;
+
 	TPimpl pimpl_;
 	TPyObjPtr owner_;
+	std::vector<Py_buffer> ownerViews_;
 };
 
 
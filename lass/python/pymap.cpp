@@ -90,30 +90,35 @@ namespace impl
 	std::string Map::repr() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return pimpl_->repr();
 	}
 	
 	const TPyObjPtr Map::keys() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return TPyObjPtr(pimpl_->keys());
 	}
 
 	const TPyObjPtr Map::values() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return TPyObjPtr(pimpl_->values());
 	}
 
 	const TPyObjPtr Map::items() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return TPyObjPtr(pimpl_->items());
 	}
 
 	const TPyObjPtr Map::get(const TPyObjPtr& key, const TPyObjPtr& defaultValue) const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		TPyObjPtr result(pimpl_->subscript(key.get()));
 		if (!result && PyErr_ExceptionMatches(PyExc_KeyError))
 		{
@@ -132,6 +137,7 @@ namespace impl
 	const TMapPtr Map::copy() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		TPimpl pimpl = pimpl_->copy();
 		return TMapPtr(new Map(std::move(pimpl)));
 	}
@@ -139,12 +145,14 @@ namespace impl
 	const TPyObjPtr Map::asDict() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return pimpl_->asNative();
 	}
 
 	void Map::clear()
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		if (!pimpl_->clear())
 		{
 			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
@@ -162,16 +170,19 @@ namespace impl
 
 	Py_ssize_t Map::length( PyObject* self)
 	{
+		LockObject guard(self);
 		return static_cast<Map*>(self)->pimpl_->length();
 	}
 
 	PyObject* Map::subscript( PyObject* self, PyObject* key)
 	{
+		LockObject guard(self);
 		return static_cast<Map*>(self)->pimpl_->subscript(key);
 	}
 
 	int Map::assSubscript( PyObject* self, PyObject* key, PyObject* value)
 	{
+		LockObject guard(self);
 		return static_cast<Map*>(self)->pimpl_->assSubscript(key, value);
 	}
 }
@@ -50,6 +50,7 @@
 #include "argument_traits.h"
 #include "exception.h"
 #include "gil.h"
+#include "call_stats.h"
 #include "../util/call_traits.h"
 #include "../meta/if.h"
 #include "../meta/select.h"
@@ -58,6 +59,8 @@
 #include "../meta/type_tuple.h"
 #include "../meta/is_const.h"
 
+#include <functional>
+
 
 #if LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_MSVC
 #	pragma warning(push)
@@ -79,55 +82,55 @@ namespace impl
 
 // --- actual callers ------------------------------------------------------------------------------
 
+/** invokes @a function, with the GIL released if @a policy says so.
+ *
+ *  The GIL is reacquired before returning, so that the result can be converted to Python right away.
+ */
+template <GilPolicy policy, typename Function, typename... P>
+decltype(auto) invokeWithGilPolicy(Function&& function, P&&... p)
+{
+	if constexpr (policy == GilPolicy::release)
+	{
+		UnblockThreads unlock;
+#if LASS_PYTHON_CALL_STATS
+		CalleeTimer timer;
+#endif
+		return std::invoke(std::forward<Function>(function), std::forward<P>(p)...);
+	}
+	else
+	{
+#if LASS_PYTHON_CALL_STATS
+		CalleeTimer timer;
+#endif
+		return std::invoke(std::forward<Function>(function), std::forward<P>(p)...);
+	}
+}
+
 /** calls the actual function with provided parameters, and returns result as a PyObject pointer.
  */
-template <typename R>
+template <typename R, GilPolicy policy = GilPolicy::release>
 struct Caller
 {
 	// free function
 
-	template <typename Function>
-	static PyObject* callFunction( Function function )
-	{
-		try
-		{
-			UnblockThreads unlock;
-			return pyBuildSimpleObject( function() );
-		}
-		LASS_PYTHON_CATCH_AND_RETURN
-	};
-
 	template <typename Function, typename... P>
 	static PyObject* callFunction(Function function, P&&... p)
 	{
 		try
 		{
-			UnblockThreads unlock;
-			return pyBuildSimpleObject(function(std::forward<P>(p)...));
+			return pyBuildSimpleObject(invokeWithGilPolicy<policy>(function, std::forward<P>(p)...));
 		}
 		LASS_PYTHON_CATCH_AND_RETURN
 	}
 
 	// method
 
-	template <typename CppClassRef, typename Method>
-	static PyObject* callMethod( CppClassRef object, Method method )
-	{
-		try
-		{
-			UnblockThreads unlock;
-			return pyBuildSimpleObject( (object.*method)() );
-		}
-		LASS_PYTHON_CATCH_AND_RETURN
-	};
-
 	template <typename CppClassRef, typename Method, typename... P>
 	static PyObject* callMethod(CppClassRef object, Method method, P&&... p)
 	{
 		try
 		{
-			UnblockThreads unlock;
-			return pyBuildSimpleObject((object.*method)(std::forward<P>(p)...));
+			return pyBuildSimpleObject(invokeWithGilPolicy<policy>(method, object, std::forward<P>(p)...));
 		}
 		LASS_PYTHON_CATCH_AND_RETURN
 	}
@@ -135,56 +138,30 @@ struct Caller
 
 /** specialisation for functions without return value, calls function and returns Py_None.
  */
-template <>
-struct Caller<void>
+template <GilPolicy policy>
+struct Caller<void, policy>
 {
 	// free functions
 
-	template <typename Function>
-	static PyObject* callFunction( Function function )
-	{
-		try
-		{
-			UnblockThreads unlock;
-			function();
-		}
-		LASS_PYTHON_CATCH_AND_RETURN
-		Py_RETURN_NONE;
-	};
-
 	template <typename Function, typename... P>
 	static PyObject* callFunction(Function function, P&&... p)
 	{
 		try
 		{
-			UnblockThreads unlock;
-			function(std::forward<P>(p)...);
+			invokeWithGilPolicy<policy>(function, std::forward<P>(p)...);
 		}
 		LASS_PYTHON_CATCH_AND_RETURN
-			Py_RETURN_NONE;
+		Py_RETURN_NONE;
 	}
 
 	// methods
 
-	template <typename CppClassRef, typename Method>
-	static PyObject* callMethod( CppClassRef object, Method method )
-	{
-		try
-		{
-			UnblockThreads unlock;
-			(object.*method)();
-		}
-		LASS_PYTHON_CATCH_AND_RETURN
-		Py_RETURN_NONE;
-	};
-
 	template <typename CppClassRef, typename Method, typename... P>
 	static PyObject* callMethod( CppClassRef object, Method method, P&&... p)
 	{
 		try
 		{
-			UnblockThreads unlock;
-			(object.*method)(std::forward<P>(p)...);
+			invokeWithGilPolicy<policy>(method, object, std::forward<P>(p)...);
 		}
 		LASS_PYTHON_CATCH_AND_RETURN
 		Py_RETURN_NONE;
@@ -197,60 +174,60 @@ struct Caller<void>
 
 /** calls C++ function without arguments
  */
-template <typename R>
-PyObject* callFunction( PyObject* args, R (*function)() )
+template <GilPolicy policy = GilPolicy::release, typename R>
+PyObject* callFunction( const FastCallArgs& args, R (*function)() )
 {
 	typedef R(*TFunction)();
-	if( decodeTuple(args) != 0 )
+	if( decodeArgs(args) != 0 )
 	{
 		return 0;
 	}
-	return Caller<R>::template callFunction<TFunction>( function );
+	return Caller<R, policy>::template callFunction<TFunction>( function );
 }
 $[
 /** calls C++ function with $x arguments, translated from python arguments
  */
-template <typename R, $(typename P$x)$>
-PyObject* callFunction( PyObject* args, R (*function)($(P$x)$) )
+template <GilPolicy policy = GilPolicy::release, typename R, $(typename P$x)$>
+PyObject* callFunction( const FastCallArgs& args, R (*function)($(P$x)$) )
 {
 	typedef R (*TFunction)($(P$x)$);
 	$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x = S$x();
 	)$
-	if( decodeTuple<$(S$x)$>( args, $(p$x)$ ) != 0 )
+	if( decodeArgs<$(S$x)$>( args, $(p$x)$ ) != 0 )
 	{
 		return 0;
 	}
-	return Caller<R>::template callFunction<TFunction>(
+	return Caller<R, policy>::template callFunction<TFunction>(
 		function, $(TArg$x::arg(p$x))$ );
 }
 ]$
 
 /** calls std::function without arguments
  */
-template <typename R>
-PyObject* callFunction( PyObject* args, std::function<R()> function )
+template <GilPolicy policy = GilPolicy::release, typename R>
+PyObject* callFunction( const FastCallArgs& args, std::function<R()> function )
 {
 	typedef std::function<R()> TFunction;
-	if( decodeTuple(args) != 0 )
+	if( decodeArgs(args) != 0 )
 	{
 		return 0;
 	}
-	return Caller<R>::template callFunction<TFunction>( function );
+	return Caller<R, policy>::template callFunction<TFunction>( function );
 }
 $[
 /** calls std::function with $x arguments, translated from python arguments
  */
-template <typename R, $(typename P$x)$>
-PyObject* callFunction( PyObject* args, std::function<R($(P$x)$)> function )
+template <GilPolicy policy = GilPolicy::release, typename R, $(typename P$x)$>
+PyObject* callFunction( const FastCallArgs& args, std::function<R($(P$x)$)> function )
 {
 	typedef std::function<R($(P$x)$)> TFunction;
 	$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x = S$x();
 	)$
-	if( decodeTuple<$(S$x)$>( args, $(p$x)$ ) != 0 )
+	if( decodeArgs<$(S$x)$>( args, $(p$x)$ ) != 0 )
 	{
 		return 0;
 	}
-	return Caller<R>::template callFunction<TFunction>(
+	return Caller<R, policy>::template callFunction<TFunction>(
 		function, $(TArg$x::arg(p$x))$ );
 }
 ]$
@@ -259,7 +236,7 @@ PyObject* callFunction( PyObject* args, std::function<R($(P$x)$)> function )
 
 // --- methods -------------------------------------------------------------------------------------
 
-template <typename ShadowTraits>
+template <typename ShadowTraits, GilPolicy policy = GilPolicy::release>
 struct CallMethod
 {
 	// non const methods
@@ -267,17 +244,17 @@ struct CallMethod
 	/** call non const method without arguments
 	 */
 	template <typename C, typename R>
-	static PyObject* call( PyObject* args, PyObject* object, R (C::*method)() )
+	static PyObject* call( const FastCallArgs& args, PyObject* object, R (C::*method)() )
 	{
 		typedef typename ShadowTraits::TCppClass TCppClass;
 		typedef typename ShadowTraits::TCppClassPtr TCppClassPtr;
 		typedef R (C::*TMethod)();
 		TCppClassPtr self;
-		if ( ShadowTraits::getObject(object, self) != 0 || decodeTuple(args) != 0 )
+		if ( ShadowTraits::getObject(object, self) != 0 || decodeArgs(args) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callMethod<TCppClass&, TMethod>(
+		PyObject* result = Caller<R, policy>::template callMethod<TCppClass&, TMethod>(
 			*self, method);
 		return establishMagicalBackLinks(result, object);
 	}
@@ -285,7 +262,7 @@ $[
 	/** call non const method with $x arguments, translated from python arguments
 	 */
 	template <typename C, typename R, $(typename P$x)$>
-	static PyObject* call( PyObject* args, PyObject* object, R (C::*method)($(P$x)$) )
+	static PyObject* call( const FastCallArgs& args, PyObject* object, R (C::*method)($(P$x)$) )
 	{
 		typedef typename ShadowTraits::TCppClass TCppClass;
 		typedef typename ShadowTraits::TCppClassPtr TCppClassPtr;
@@ -293,11 +270,11 @@ $[
 		TCppClassPtr self;
 		$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x;
 		)$
-		if ( ShadowTraits::getObject(object, self) != 0 || decodeTuple<$(S$x)$>(args, $(p$x)$) != 0 )
+		if ( ShadowTraits::getObject(object, self) != 0 || decodeArgs<$(S$x)$>(args, $(p$x)$) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callMethod<TCppClass&, TMethod>(
+		PyObject* result = Caller<R, policy>::template callMethod<TCppClass&, TMethod>(
 			*self, method, $(TArg$x::arg(p$x))$ );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -308,17 +285,17 @@ $[
 	/** call const method without arguments
 	 */
 	template <typename C, typename R>
-	static PyObject* call( PyObject* args, PyObject* object, R (C::*method)() const )
+	static PyObject* call( const FastCallArgs& args, PyObject* object, R (C::*method)() const )
 	{
 		typedef typename ShadowTraits::TCppClass TCppClass;
 		typedef typename ShadowTraits::TConstCppClassPtr TConstCppClassPtr;
 		typedef R (C::*TMethod)() const;
 		TConstCppClassPtr self;
-		if ( ShadowTraits::getObject(object, self) != 0 || decodeTuple(args) != 0 )
+		if ( ShadowTraits::getObject(object, self) != 0 || decodeArgs(args) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callMethod<const TCppClass&, TMethod>( 
+		PyObject* result = Caller<R, policy>::template callMethod<const TCppClass&, TMethod>( 
 			*self, method);
 		return establishMagicalBackLinks(result, object);
 	}
@@ -326,7 +303,7 @@ $[
 	/** call const method with $x argument, translated from python arguments
 	 */
 	template <typename C, typename R, $(typename P$x)$>
-	static PyObject* call( PyObject* args, PyObject* object, R (C::*method)($(P$x)$) const )
+	static PyObject* call( const FastCallArgs& args, PyObject* object, R (C::*method)($(P$x)$) const )
 	{
 		typedef typename ShadowTraits::TCppClass TCppClass;
 		typedef typename ShadowTraits::TConstCppClassPtr TConstCppClassPtr;
@@ -334,11 +311,11 @@ $[
 		TConstCppClassPtr self;
 		$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x = S$x();
 		)$
-		if ( ShadowTraits::getObject(object, self) != 0 || decodeTuple<$(S$x)$>(args, $(p$x)$) != 0 )
+		if ( ShadowTraits::getObject(object, self) != 0 || decodeArgs<$(S$x)$>(args, $(p$x)$) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callMethod<const TCppClass&, TMethod>(
+		PyObject* result = Caller<R, policy>::template callMethod<const TCppClass&, TMethod>(
 			*self, method, $(TArg$x::arg(p$x))$ );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -348,15 +325,15 @@ $[
 	/** call "free method" without arguments, passing object as first argument
 	 */
 	template <typename R, typename P0>
-	static PyObject* callFree( PyObject* args, PyObject* object, R (*freeMethod)(P0) )
+	static PyObject* callFree( const FastCallArgs& args, PyObject* object, R (*freeMethod)(P0) )
 	{
 		typedef R (*TFunction)(P0);
 		typedef ArgumentTraits<P0> TArg0; typedef typename TArg0::TStorage S0; S0 p0 = S0();
-		if ( pyGetSimpleObject(object, p0) != 0 || decodeTuple(args) != 0 )
+		if ( pyGetSimpleObject(object, p0) != 0 || decodeArgs(args) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callFunction<TFunction>(
+		PyObject* result = Caller<R, policy>::template callFunction<TFunction>(
 			freeMethod, TArg0::arg(p0) );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -364,17 +341,17 @@ $[
 	/** call "free method" with $x arguments translated from python arguments, passing object as first argument
 	 */
 	template <typename R, typename P0, $(typename P$x)$>
-	static PyObject* callFree( PyObject* args, PyObject* object, R (*freeMethod)(P0, $(P$x)$) )
+	static PyObject* callFree( const FastCallArgs& args, PyObject* object, R (*freeMethod)(P0, $(P$x)$) )
 	{
 		typedef R (*TFunction)(P0, $(P$x)$);
 		typedef ArgumentTraits<P0> TArg0; typedef typename TArg0::TStorage S0; S0 p0 = S0();
 		$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x = S$x();
 		)$
-		if ( pyGetSimpleObject(object, p0) != 0 || decodeTuple<$(S$x)$>(args, $(p$x)$) != 0 )
+		if ( pyGetSimpleObject(object, p0) != 0 || decodeArgs<$(S$x)$>(args, $(p$x)$) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callFunction<TFunction>(
+		PyObject* result = Caller<R, policy>::template callFunction<TFunction>(
 			freeMethod, TArg0::arg(p0), $(TArg$x::arg(p$x))$ );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -383,15 +360,15 @@ $[
 	/** call std::function as "free method" without arguments, passing object as first argument
 	 */
 	template <typename R, typename P0>
-	static PyObject* callFree( PyObject* args, PyObject* object, std::function<R(P0)> freeMethod )
+	static PyObject* callFree( const FastCallArgs& args, PyObject* object, std::function<R(P0)> freeMethod )
 	{
 		typedef std::function<R(P0)> TFunction;
 		typedef ArgumentTraits<P0> TArg0; typedef typename TArg0::TStorage S0; S0 p0 = S0();
-		if ( pyGetSimpleObject(object, p0) != 0 || decodeTuple(args) != 0 )
+		if ( pyGetSimpleObject(object, p0) != 0 || decodeArgs(args) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callFunction<TFunction>(
+		PyObject* result = Caller<R, policy>::template callFunction<TFunction>(
 			freeMethod, TArg0::arg(p0) );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -399,17 +376,17 @@ $[
 	/** call "free method" with $x arguments translated from python arguments, passing object as first argument
 	 */
 	template <typename R, typename P0, $(typename P$x)$>
-	static PyObject* callFree( PyObject* args, PyObject* object, std::function<R(P0, $(P$x)$)> freeMethod )
+	static PyObject* callFree( const FastCallArgs& args, PyObject* object, std::function<R(P0, $(P$x)$)> freeMethod )
 	{
 		typedef std::function<R(P0, $(P$x)$)> TFunction;
 		typedef ArgumentTraits<P0> TArg0; typedef typename TArg0::TStorage S0; S0 p0 = S0();
 		$(typedef ArgumentTraits<P$x> TArg$x; typedef typename TArg$x::TStorage S$x; S$x p$x = S$x();
 		)$
-		if ( pyGetSimpleObject(object, p0) != 0 || decodeTuple<$(S$x)$>(args, $(p$x)$) != 0 )
+		if ( pyGetSimpleObject(object, p0) != 0 || decodeArgs<$(S$x)$>(args, $(p$x)$) != 0 )
 		{
 			return 0;
 		}
-		PyObject* result = Caller<R>::template callFunction<TFunction>(
+		PyObject* result = Caller<R, policy>::template callFunction<TFunction>(
 			freeMethod, TArg0::arg(p0), $(TArg$x::arg(p$x))$ );
 		return establishMagicalBackLinks(result, object);
 	}
@@ -606,21 +583,25 @@ PyObject* construct( PyTypeObject* subType, PyObject* args )
 template <typename ShadowTraits, typename R, typename... P>
 struct ExplicitResolver
 {
-	static PyObject* callFunction(PyObject* args, R(*iFunction)(P...))
+	template <GilPolicy policy = GilPolicy::release>
+	static PyObject* callFunction(const FastCallArgs& args, R(*iFunction)(P...))
 	{
-		return ::lass::python::impl::callFunction<R, P...>(args, iFunction);
+		return ::lass::python::impl::callFunction<policy>(args, iFunction);
 	}
-	template <typename C> static PyObject* callMethod(PyObject* args, PyObject* object, R(C::* method)(P...))
+	template <GilPolicy policy = GilPolicy::release, typename C>
+	static PyObject* callMethod(const FastCallArgs& args, PyObject* object, R(C::* method)(P...))
 	{
-		return CallMethod<ShadowTraits>::call(args, object, method);
+		return CallMethod<ShadowTraits, policy>::call(args, object, method);
 	}
-	template <typename C> static PyObject* callMethod(PyObject* args, PyObject* object, R(C::* method)(P...) const)
+	template <GilPolicy policy = GilPolicy::release, typename C>
+	static PyObject* callMethod(const FastCallArgs& args, PyObject* object, R(C::* method)(P...) const)
 	{
-		return CallMethod<ShadowTraits>::call(args, object, method);
+		return CallMethod<ShadowTraits, policy>::call(args, object, method);
 	}
-	static PyObject* callFreeMethod(PyObject* args, PyObject* object, R(*freeMethod)(P...))
+	template <GilPolicy policy = GilPolicy::release>
+	static PyObject* callFreeMethod(const FastCallArgs& args, PyObject* object, R(*freeMethod)(P...))
 	{
-		return CallMethod<ShadowTraits>::callFree(args, object, freeMethod);
+		return CallMethod<ShadowTraits, policy>::callFree(args, object, freeMethod);
 	}
 	static PyObject* callConstructor(PyTypeObject* subType, PyObject* args)
 	{
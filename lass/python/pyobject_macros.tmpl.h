@@ -142,6 +142,9 @@
  *
  *  Generates the `PyInit_*` function required for Python extension modules.
  *  This function will be called by Python when the module is imported.
+ *
+ *  The module uses multi-phase initialization (PEP 489), so it can also be imported
+ *  in subinterpreters, each getting its own module object and heap types.
  * 
  *  ```cpp
  *  PY_DECLARE_MODULE_NAME_DOC(mymodule, "mymodule", "My example module")
@@ -153,7 +156,7 @@
  *  @param i_name Name for the initialization function (PyInit_<i_name> will be generated)
  */
 #define PY_MODULE_ENTRYPOINT_NAME( i_module, i_name ) \
-	PyMODINIT_FUNC LASS_CONCATENATE(PyInit_, i_name)() { return i_module.inject(); }
+	PyMODINIT_FUNC LASS_CONCATENATE(PyInit_, i_name)() { return i_module.initMultiPhase(); }
 
 /** @ingroup ModuleDefinition
  *  Create a Python module initialization function using the module identifier as the function name.
@@ -379,7 +382,7 @@
  *  @deprecated Use PY_MODULE_FUNCTION_EX instead for automatic wrapper generation
  */
 #define PY_MODULE_PY_FUNCTION_EX( i_module, f_cppFunction, s_functionName, s_doc )\
-	static PyCFunction LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ) = 0;\
+	static ::lass::python::impl::OverloadLink LASS_CONCATENATE( pyOverloadChain_, i_dispatcher );\
 	LASS_EXECUTE_BEFORE_MAIN_EX\
 	( LASS_CONCATENATE_3( lassExecutePyModulePyFunction_, i_module, f_cppFunction ),\
 		i_module.addFunctionDispatcher( \
@@ -422,20 +425,39 @@
  *  @endcode
  */
 #define PY_MODULE_FUNCTION_EX( i_module, f_cppFunction, s_functionName, s_doc, i_dispatcher )\
-	static PyCFunction LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ) = 0;\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher( PyObject* iIgnore, PyObject* iArgs )\
+	PY_MODULE_FUNCTION_GIL_EX( i_module, f_cppFunction, s_functionName, s_doc, i_dispatcher,\
+		::lass::python::GilPolicy::release )
+
+/** @ingroup ModuleDefinition
+ *  Export a C++ free function to Python with full control over overloading and the GIL.
+ *
+ *  Same as PY_MODULE_FUNCTION_EX(), but lets you choose whether the GIL is released while
+ *  the C++ function runs. Arguments are converted, and the result is built, with the GIL held.
+ *
+ *  @param i_module Module identifier declared by PY_DECLARE_MODULE_*
+ *  @param f_cppFunction C++ function to export
+ *  @param s_functionName Python function name (const char* string with static storage duration)
+ *  @param s_doc Function documentation string (const char* string with static storage duration, or nullptr)
+ *  @param i_dispatcher Unique name for the generated dispatcher function (must be unscoped identifier for token concatenation)
+ *  @param e_gilPolicy lass::python::GilPolicy::release (default of the other macros) or lass::python::GilPolicy::hold
+ *
+ *  @par Example:
+ *  @code
+ *  int cheapLookup(int key);
+ *
+ *  PY_MODULE_FUNCTION_GIL_EX(foo_module, cheapLookup, "lookup", nullptr, foo_lookup, lass::python::GilPolicy::hold)
+ *  @endcode
+ */
+#define PY_MODULE_FUNCTION_GIL_EX( i_module, f_cppFunction, s_functionName, s_doc, i_dispatcher, e_gilPolicy )\
+	static ::lass::python::impl::OverloadLink LASS_CONCATENATE( pyOverloadChain_, i_dispatcher );\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject*, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		if (LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ))\
-		{\
-			PyObject* result = LASS_CONCATENATE( pyOverloadChain_, i_dispatcher )(iIgnore, iArgs);\
-			if (!(PyErr_Occurred() && PyErr_ExceptionMatches(PyExc_TypeError)))\
-			{\
-				return result;\
-			}\
-			PyErr_Clear();\
-			Py_XDECREF(result);\
-		}\
-		return ::lass::python::impl::callFunction( iArgs, &f_cppFunction );\
+		return ::lass::python::impl::callFunction< e_gilPolicy >( args, &f_cppFunction );\
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iIgnore, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ).dispatch(\
+			iIgnore, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX\
 	( LASS_CONCATENATE_3( lassExecutePyModuleFunction_, i_module, i_dispatcher ), \
@@ -490,6 +512,18 @@
 #define PY_MODULE_FUNCTION( i_module, f_cppFunction)\
 	PY_MODULE_FUNCTION_NAME_DOC( i_module, f_cppFunction, LASS_STRINGIFY(f_cppFunction), 0)
 
+/** @ingroup ModuleDefinition
+ *  Export a C++ free function to Python using the C++ function name, choosing the GIL policy.
+ *  Convenience macro that wraps PY_MODULE_FUNCTION_GIL_EX() with defaults.
+ *
+ *  @param i_module Module identifier declared by PY_DECLARE_MODULE_*
+ *  @param f_cppFunction C++ function to export (name will be used as Python name)
+ *  @param e_gilPolicy lass::python::GilPolicy::release or lass::python::GilPolicy::hold
+ */
+#define PY_MODULE_FUNCTION_GIL( i_module, f_cppFunction, e_gilPolicy )\
+	PY_MODULE_FUNCTION_GIL_EX( i_module, f_cppFunction, LASS_STRINGIFY(f_cppFunction), 0,\
+		LASS_UNIQUENAME(LASS_CONCATENATE(lassPyImpl_function_, i_module)), e_gilPolicy)
+
 /** @} */
 
 // --- casting free functions -----------------------------------------------------------
@@ -706,26 +740,21 @@ $[
  */
 
 #define PY_MODULE_FUNCTION_QUALIFIED_EX(i_module, f_cppFunction, t_return, t_params, s_functionName, s_doc, i_dispatcher)\
-	static PyCFunction LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ) = 0;\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher( PyObject* iIgnore, PyObject* iArgs )\
+	static ::lass::python::impl::OverloadLink LASS_CONCATENATE( pyOverloadChain_, i_dispatcher );\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject*, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		if (LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ))\
-		{\
-			PyObject* result = LASS_CONCATENATE( pyOverloadChain_, i_dispatcher )(iIgnore, iArgs);\
-			if (!(PyErr_Occurred() && PyErr_ExceptionMatches(PyExc_TypeError)))\
-			{\
-				return result;\
-			}\
-			PyErr_Clear();\
-			Py_XDECREF(result);\
-		}\
 		return ::lass::python::impl::ExplicitResolver\
 		<\
 			lass::meta::NullType,\
 			t_return,\
 			t_params\
 		>\
-		::callFunction(iArgs, &f_cppFunction);\
+		::callFunction(args, &f_cppFunction);\
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iIgnore, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE( pyOverloadChain_, i_dispatcher ).dispatch(\
+			iIgnore, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX\
 	( LASS_CONCATENATE_3( lassExecutePyModuleFunction_, i_module, i_dispatcher ),\
@@ -1468,6 +1497,30 @@ $[
 	PY_CLASS_METHOD_IMPL(t_cppClass, &TCppClass::i_cppMethod, s_methodName, s_doc, i_dispatcher,\
 		::lass::python::impl::CallMethod<TShadowTraits>::call)
 
+/** @ingroup ClassDefinition
+ *  @brief Export a C++ method to Python with full control over overloading and the GIL.
+ *
+ *  Same as PY_CLASS_METHOD_EX(), but lets you choose whether the GIL is released while
+ *  the C++ method runs. Arguments are converted, and the result is built, with the GIL held.
+ *
+ *  @param t_cppClass C++ class containing the method
+ *  @param i_cppMethod C++ method name to export
+ *  @param s_methodName Python method name (null-terminated C string literal or special method from lass::python::methods namespace)
+ *  @param s_doc Method documentation string (null-terminated C string literal, may be nullptr)
+ *  @param i_dispatcher Unique identifier for the generated dispatcher function
+ *  @param e_gilPolicy lass::python::GilPolicy::release (default of the other macros) or lass::python::GilPolicy::hold
+ *
+ *  ```cpp
+ *  PY_CLASS_METHOD_GIL_EX(Foo, size, "__len__", nullptr, foo_len, lass::python::GilPolicy::hold)
+ *  PY_CLASS_METHOD_GIL_EX(Foo, solve, "solve", nullptr, foo_solve, lass::python::GilPolicy::release)
+ *  ```
+ *
+ *  @sa PY_CLASS_METHOD_EX
+ */
+#define PY_CLASS_METHOD_GIL_EX(t_cppClass, i_cppMethod, s_methodName, s_doc, i_dispatcher, e_gilPolicy)\
+	PY_CLASS_METHOD_IMPL(t_cppClass, &TCppClass::i_cppMethod, s_methodName, s_doc, i_dispatcher,\
+		(::lass::python::impl::CallMethod< TShadowTraits, e_gilPolicy >::call))
+
 /** @ingroup ClassDefinition
  *  @brief Export a C++ method to Python with custom name and documentation.
  *  
@@ -1547,6 +1600,25 @@ $[
 #define PY_CLASS_METHOD( i_cppClass, i_cppMethod )\
 		PY_CLASS_METHOD_DOC( i_cppClass, i_cppMethod, 0 )
 
+/** @ingroup ClassDefinition
+ *  @brief Export a C++ method to Python using the C++ method name, choosing the GIL policy.
+ *
+ *  @param i_cppClass C++ class containing the method
+ *  @param i_cppMethod C++ method name to export (name will be used as Python name)
+ *  @param e_gilPolicy lass::python::GilPolicy::release or lass::python::GilPolicy::hold
+ *
+ *  ```cpp
+ *  PY_CLASS_METHOD_GIL(Foo, getX, lass::python::GilPolicy::hold)
+ *  // Python: foo_instance.getX()
+ *  ```
+ *
+ *  @sa PY_CLASS_METHOD_GIL_EX
+ */
+#define PY_CLASS_METHOD_GIL( i_cppClass, i_cppMethod, e_gilPolicy )\
+		PY_CLASS_METHOD_GIL_EX(\
+			i_cppClass, i_cppMethod, LASS_STRINGIFY(i_cppMethod), 0,\
+			LASS_UNIQUENAME(LASS_CONCATENATE(lassPyImpl_method_, i_cppClass)), e_gilPolicy)
+
 /** @} */
 
 // --- explicit qualified methods ------------------------------------------------------------------
@@ -1610,18 +1682,17 @@ $[
  */
 #define PY_CLASS_METHOD_QUALIFIED_EX(t_cppClass, i_cppMethod, t_return, t_params, s_methodName, s_doc, i_dispatcher)\
 	static ::lass::python::impl::OverloadLink LASS_CONCATENATE(i_dispatcher, _overloadChain);\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iObject, PyObject* iArgs)\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject* iObject, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		PyObject* result = 0;\
-		if (LASS_CONCATENATE(i_dispatcher, _overloadChain)(iObject, iArgs, result))\
-		{\
-			return result;\
-		}\
-		LASS_ASSERT(result == 0);\
 		typedef ::lass::python::impl::ShadowTraits< t_cppClass > TShadowTraits;\
 		typedef TShadowTraits::TCppClass TCppClass;\
 		return ::lass::python::impl::ExplicitResolver<TShadowTraits,t_return,t_params>::callMethod(\
-			iArgs, iObject, &TCppClass::i_cppMethod); \
+			args, iObject, &TCppClass::i_cppMethod); \
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iObject, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE(i_dispatcher, _overloadChain).dispatch(\
+			iObject, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX(LASS_CONCATENATE(i_dispatcher, _executeBeforeMain),\
 		t_cppClass ::_lassPyClassDef.addMethod(\
@@ -2040,17 +2111,16 @@ $[
  */
 #define PY_CLASS_FREE_METHOD_QUALIFIED_EX(t_cppClass, f_cppFreeMethod, t_return, t_params, s_methodName, s_doc, i_dispatcher)\
 	static ::lass::python::impl::OverloadLink LASS_CONCATENATE(i_dispatcher, _overloadChain);\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iObject, PyObject* iArgs)\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject* iObject, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		PyObject* result = 0;\
-		if (LASS_CONCATENATE(i_dispatcher, _overloadChain)(iObject, iArgs, result))\
-		{\
-			return result;\
-		}\
-		LASS_ASSERT(result == 0);\
 		typedef ::lass::python::impl::ShadowTraits< t_cppClass > TShadowTraits;\
 		return ::lass::python::impl::ExplicitResolver<TShadowTraits,t_return,t_params>::callFreeMethod(\
-			iArgs, iObject, f_cppFreeMethod); \
+			args, iObject, f_cppFreeMethod); \
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iObject, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE(i_dispatcher, _overloadChain).dispatch(\
+			iObject, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX(LASS_CONCATENATE(i_dispatcher, _executeBeforeMain),\
 		t_cppClass ::_lassPyClassDef.addMethod(\
@@ -2531,20 +2601,15 @@ $[
  *  ```
  */
 #define PY_CLASS_STATIC_METHOD_EX( t_cppClass, f_cppFunction, s_methodName, s_doc, i_dispatcher )\
-	static PyCFunction LASS_CONCATENATE(i_dispatcher, _overloadChain) = 0;\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher( PyObject* iIgnore, PyObject* iArgs )\
+	static ::lass::python::impl::OverloadLink LASS_CONCATENATE(i_dispatcher, _overloadChain);\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject*, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		if (LASS_CONCATENATE(i_dispatcher, _overloadChain))\
-		{\
-			PyObject* result = LASS_CONCATENATE(i_dispatcher, _overloadChain)(iIgnore, iArgs);\
-			if (!(PyErr_Occurred() && PyErr_ExceptionMatches(PyExc_TypeError)))\
-			{\
-				return result;\
-			}\
-			PyErr_Clear();\
-			Py_XDECREF(result);\
-		}\
-		return ::lass::python::impl::callFunction( iArgs, f_cppFunction );\
+		return ::lass::python::impl::callFunction( args, f_cppFunction );\
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iIgnore, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE(i_dispatcher, _overloadChain).dispatch(\
+			iIgnore, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX\
 	( LASS_CONCATENATE(i_dispatcher, _excecuteBeforeMain ),\
@@ -3559,7 +3624,7 @@ $[
 			PyErr_Clear();\
 			Py_XDECREF(result);\
 		}\
-		return ::lass::python::impl::callFunction( iArgs, f_cppFunction );\
+		return ::lass::python::impl::callFunction( ::lass::python::impl::FastCallArgs(iArgs), f_cppFunction );\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX(LASS_CONCATENATE(i_dispatcher, _executeBeforeMain), \
 		t_cppClass::_lassPyClassDef.addConstructor(\
@@ -3624,17 +3689,16 @@ $[
  */
 #define PY_CLASS_METHOD_IMPL(t_cppClass, i_cppMethod, s_methodName, s_doc, i_dispatcher, i_caller)\
 	static ::lass::python::impl::OverloadLink LASS_CONCATENATE(i_dispatcher, _overloadChain);\
-	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iSelf, PyObject* iArgs)\
+	static PyObject* LASS_CONCATENATE(i_dispatcher, _overload)(PyObject* iSelf, const ::lass::python::impl::FastCallArgs& args)\
 	{\
-		PyObject* result = 0;\
-		if (LASS_CONCATENATE(i_dispatcher, _overloadChain)(iSelf, iArgs, result))\
-		{\
-			return result;\
-		}\
 		[[maybe_unused]] typedef ::lass::python::impl::ShadowTraits< t_cppClass > TShadowTraits;\
 		[[maybe_unused]] typedef TShadowTraits::TCppClass TCppClass;\
-		LASS_ASSERT(result == 0);\
-		return i_caller(iArgs, iSelf, i_cppMethod);\
+		return i_caller(args, iSelf, i_cppMethod);\
+	}\
+	extern "C" LASS_DLL_LOCAL PyObject* i_dispatcher(PyObject* iSelf, PyObject* const* iArgs, Py_ssize_t iNargs, PyObject* iKwnames)\
+	{\
+		return LASS_CONCATENATE(i_dispatcher, _overloadChain).dispatch(\
+			iSelf, ::lass::python::impl::FastCallArgs(iArgs, iNargs, iKwnames), LASS_CONCATENATE(i_dispatcher, _overload));\
 	}\
 	LASS_EXECUTE_BEFORE_MAIN_EX(LASS_CONCATENATE(i_dispatcher, _executeBeforeMain),\
 		t_cppClass ::_lassPyClassDef.addMethod(\
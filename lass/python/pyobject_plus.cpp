@@ -110,6 +110,7 @@ bool checkSequenceSize(PyObject* obj, Py_ssize_t expectedSize)
 	if (!PySequence_Check(obj))
 	{
 		PyErr_SetString(PyExc_TypeError, "not a python sequence (tuple, list, ...)");
+		markTypeMismatch(obj);
 		return false;
 	}
 	const Py_ssize_t size = PySequence_Size(obj);
@@ -123,6 +124,21 @@ bool checkSequenceSize(PyObject* obj, Py_ssize_t expectedSize)
 	return true;
 }
 
+/** @internal
+ *  Set TypeError because @a args has keyword arguments or not @a expectedSize positional ones.
+ */
+void raiseBadArgsSize(const FastCallArgs& args, Py_ssize_t expectedSize)
+{
+	if (args.hasKeywords())
+	{
+		PyErr_SetString(PyExc_TypeError, "function takes no keyword arguments");
+		return;
+	}
+	std::ostringstream buffer;
+	buffer << "expected " << expectedSize << " arguments (got " << args.nargs << ")";
+	PyErr_SetString(PyExc_TypeError, buffer.str().c_str());
+}
+
 /** @internal
  *  Check that @a obj is a sequence, and return it as a "FAST sequence"
  *  so that you can use PySequence_Fast_GET_ITEM to get its items with borrowed references.
@@ -130,7 +146,13 @@ bool checkSequenceSize(PyObject* obj, Py_ssize_t expectedSize)
 TPyObjPtr checkedFastSequence(PyObject* obj)
 {
 	LockGIL lock;
-	return TPyObjPtr(PySequence_Fast(obj, "expected a sequence (tuple, list, ...)"));
+	TPyObjPtr result(PySequence_Fast(obj, "expected a sequence (tuple, list, ...)"));
+	if (!result && !PySequence_Check(obj) && !Py_TYPE(obj)->tp_iter)
+	{
+		// not even iterable, so it's rejected for its type.
+		markTypeMismatch(obj);
+	}
+	return result;
 }
 
 /** @internal
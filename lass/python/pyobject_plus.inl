@@ -51,78 +51,85 @@ namespace impl
 {
 
 /** @internal
+ *  Adapts a METH_FASTCALL dispatcher to the signature of slot @a T.
+ *
+ *  Arguments are passed to the dispatcher as a stack array, so no argument tuple needs to be built.
  */
-template <typename T, PyCFunction dispatcher> struct FunctionTypeDispatcher
+template <typename T, FastCallFunction dispatcher> struct FunctionTypeDispatcher
 {
-	static PyObject* fun(PyObject* self, PyObject* args) { return dispatcher(self,args); }
-	typedef PyCFunction OverloadType;
+	static constexpr FastCallFunction fun = dispatcher;
+	typedef FastCallFunction OverloadType;
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::UnarySlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::UnarySlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf)
 	{
-		TPyObjPtr args(PyTuple_New(0));
-		return DispatcherAddress(iSelf, args.get());
+		return DispatcherAddress(iSelf, nullptr, 0, nullptr);
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::BinarySlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::BinarySlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf, PyObject* iOther)
 	{
-		TPyObjPtr args(Py_BuildValue("(O)", iOther));
-		return DispatcherAddress(iSelf, args.get());
+		PyObject* args[] = { iOther };
+		return DispatcherAddress(iSelf, args, 1, nullptr);
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::TernarySlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::TernarySlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf, PyObject* iOther, PyObject* iThird)
 	{
-		TPyObjPtr args(Py_BuildValue("(O,O)", iOther, iThird));
-		PyObject* result = DispatcherAddress(iSelf, args.get());
+		PyObject* args[] = { iOther, iThird };
+		PyObject* result = DispatcherAddress(iSelf, args, 2, nullptr);
 		if (!result && PyErr_ExceptionMatches(PyExc_TypeError) && iThird == Py_None)
 		{
 			// try as a binary function
 			PyErr_Clear();
-			TPyObjPtr args2(Py_BuildValue("(O)", iOther));
-			return DispatcherAddress(iSelf, args2.get());
+			return DispatcherAddress(iSelf, args, 1, nullptr);
 		}
 		return result;	
 	}
 };
 /** @internal
 */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeArgSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeArgSlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf, Py_ssize_t iSize) 
 	{
-		TPyObjPtr args(Py_BuildValue("(n)", iSize));
-		return DispatcherAddress(iSelf,args.get());
+		TPyObjPtr size(PyLong_FromSsize_t(iSize));
+		if (!size)
+			return 0;
+		PyObject* args[] = { size.get() };
+		return DispatcherAddress(iSelf, args, 1, nullptr);
 	}
 };
 /** @internal
 */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeSsizeArgSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeSsizeArgSlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf, Py_ssize_t iSize, Py_ssize_t iSize2)
 	{
-		TPyObjPtr args(Py_BuildValue("(n,n)", iSize, iSize2));
-		return DispatcherAddress(iSelf,args.get());
+		TPyObjPtr size(PyLong_FromSsize_t(iSize));
+		TPyObjPtr size2(PyLong_FromSsize_t(iSize2));
+		if (!size || !size2)
+			return 0;
+		PyObject* args[] = { size.get(), size2.get() };
+		return DispatcherAddress(iSelf, args, 2, nullptr);
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::LenSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::LenSlot ,DispatcherAddress>
 {
 	static Py_ssize_t fun(PyObject* iSelf) 
 	{
-		TPyObjPtr args(Py_BuildValue("()"));
-		TPyObjPtr temp(DispatcherAddress(iSelf,args.get()));
+		TPyObjPtr temp(DispatcherAddress(iSelf, nullptr, 0, nullptr));
 		if (!temp)
 			return -1;
 		Py_ssize_t result;
@@ -133,34 +140,41 @@ template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::pyt
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeObjArgSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeObjArgSlot ,DispatcherAddress>
 {
 	static int fun(PyObject * iSelf, Py_ssize_t iSize, PyObject * iOther)
 	{
-		TPyObjPtr args(Py_BuildValue("(n,O)",iSize,iOther));
-		TPyObjPtr temp(DispatcherAddress(iSelf,args.get()));
+		TPyObjPtr size(PyLong_FromSsize_t(iSize));
+		if (!size)
+			return -1;
+		PyObject* args[] = { size.get(), iOther };
+		TPyObjPtr temp(DispatcherAddress(iSelf, args, 2, nullptr));
 		return temp ? 0 : -1;
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeSsizeObjArgSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::SsizeSsizeObjArgSlot ,DispatcherAddress>
 {
 	static int fun(PyObject * iSelf, Py_ssize_t iSize, Py_ssize_t iSize2, PyObject * iOther)
 	{
-		TPyObjPtr args(Py_BuildValue("(n,n,O)",iSize,iSize2,iOther));
-		TPyObjPtr temp(DispatcherAddress(iSelf,args.get()));
+		TPyObjPtr size(PyLong_FromSsize_t(iSize));
+		TPyObjPtr size2(PyLong_FromSsize_t(iSize2));
+		if (!size || !size2)
+			return -1;
+		PyObject* args[] = { size.get(), size2.get(), iOther };
+		TPyObjPtr temp(DispatcherAddress(iSelf, args, 3, nullptr));
 		return temp ? 0 : -1;
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ObjObjSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ObjObjSlot ,DispatcherAddress>
 {
 	static int fun(PyObject * iSelf, PyObject * iOther)
 	{
-		TPyObjPtr args(Py_BuildValue("(O)",iOther));
-		TPyObjPtr temp(DispatcherAddress(iSelf,args.get()));
+		PyObject* args[] = { iOther };
+		TPyObjPtr temp(DispatcherAddress(iSelf, args, 1, nullptr));
 		if (!temp)
 			return -1;
 		int result;
@@ -172,7 +186,7 @@ template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::pyt
 
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ObjObjArgSlot, DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ObjObjArgSlot, DispatcherAddress>
 {
 	static int fun(PyObject* self, PyObject* key, PyObject* value)
 	{
@@ -181,10 +195,8 @@ template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::pyt
 		// However, we can't translate NULL back into a valid PyObject*, so
 		// we'll just omit the second argument.
 
-		TPyObjPtr args(value
-			? Py_BuildValue("(O,O)", key, value)
-			: Py_BuildValue("(O)", key));
-		TPyObjPtr temp(DispatcherAddress(self, args.get()));
+		PyObject* args[] = { key, value };
+		TPyObjPtr temp(DispatcherAddress(self, args, value ? 2 : 1, nullptr));
 		if (temp)
 		{
 			LASS_ASSERT(!PyErr_Occurred());
@@ -199,27 +211,25 @@ template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::pyt
 };
 /** @internal
 */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::IterSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::IterSlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf)
 	{
-		TPyObjPtr args(PyTuple_New(0));
-		return DispatcherAddress(iSelf, args.get());
+		return DispatcherAddress(iSelf, nullptr, 0, nullptr);
 	}
 };
 /** @internal
 */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::IterNextSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::IterNextSlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf)
 	{
-		TPyObjPtr args(PyTuple_New(0));
-		return DispatcherAddress(iSelf, args.get());
+		return DispatcherAddress(iSelf, nullptr, 0, nullptr);
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ArgKwSlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::ArgKwSlot ,DispatcherAddress>
 {
 	static PyObject* fun(PyObject* iSelf, PyObject* iArgs, PyObject* iKw)
 	{
@@ -236,17 +246,17 @@ template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::pyt
 				return 0;
 			}
 		}
-		return DispatcherAddress(iSelf, iArgs);
+		const FastCallArgs args(iArgs);
+		return DispatcherAddress(iSelf, args.args, args.nargs, nullptr);
 	}
 };
 /** @internal
  */
-template <PyCFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::InquirySlot ,DispatcherAddress>
+template <FastCallFunction DispatcherAddress> struct FunctionTypeDispatcher<lass::python::impl::InquirySlot ,DispatcherAddress>
 {
 	static int fun(PyObject* iSelf)
 	{
-		TPyObjPtr args(Py_BuildValue("()"));
-		TPyObjPtr temp(DispatcherAddress(iSelf,args.get()));
+		TPyObjPtr temp(DispatcherAddress(iSelf, nullptr, 0, nullptr));
 		if (!temp)
 			return -1;
 		int result;
@@ -53,6 +53,34 @@ namespace python
 {
 namespace impl
 {
+	void PySequenceImplBase::releaseBuffer(Py_buffer* view)
+	{
+		LASS_ASSERT(exports_ > 0);
+		--exports_;
+		releaseBufferInfo(view);
+	}
+
+	int PySequenceImplBase::exportBuffer(Py_buffer* view, PyObject* exporter, void* buf, Py_ssize_t length, Py_ssize_t itemStride, 
+		const char* format, Py_ssize_t itemsize, Py_ssize_t components, int flags)
+	{
+		if (fillBufferInfo(view, exporter, buf, length, itemStride, format, itemsize, components, isReadOnly(), flags) != 0)
+		{
+			return -1;
+		}
+		++exports_;
+		return 0;
+	}
+
+	bool PySequenceImplBase::checkResizable() const
+	{
+		if (exports_ > 0)
+		{
+			PyErr_SetString(PyExc_BufferError, "Existing exports of data: object cannot be re-sized");
+			return false;
+		}
+		return true;
+	}
+
 	PY_DECLARE_CLASS( Sequence )
 	//typedef meta::type_list::Make<PyObject*>::Type TArguments;
 	//PY_CLASS_CONSTRUCTOR(Sequence, TArguments) // constructor with some arguments. *
@@ -78,6 +106,8 @@ namespace impl
 		Sequence::_lassPyClassDef.setSlot(Py_mp_length, &Sequence::length);
 		Sequence::_lassPyClassDef.setSlot(Py_mp_subscript, &Sequence::subscript);
 		Sequence::_lassPyClassDef.setSlot(Py_mp_ass_subscript, &Sequence::assSubscript);
+		Sequence::_lassPyClassDef.setSlot(Py_bf_getbuffer, &Sequence::getBuffer);
+		Sequence::_lassPyClassDef.setSlot(Py_bf_releasebuffer, &Sequence::releaseBuffer);
 	)
 
 	Sequence::Sequence(TPimpl&& pimpl)
@@ -96,12 +126,14 @@ namespace impl
 	const TSequencePtr Sequence::copy() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		Sequence::TPimpl pimpl = pimpl_->copy();
 		return TSequencePtr(new Sequence(std::move(pimpl)));
 	}
 	void Sequence::clear()
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		if (!pimpl_->clear())
 		{
 			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
@@ -110,6 +142,7 @@ namespace impl
 	void Sequence::reserve(Py_ssize_t n)
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		if (!pimpl_->reserve(n))
 		{
 			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
@@ -118,6 +151,7 @@ namespace impl
 	void Sequence::append(const TPyObjPtr& obj)
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		if (!pimpl_->append(obj))
 		{
 			impl::fetchAndThrowPythonException(LASS_PRETTY_FUNCTION);
@@ -126,6 +160,7 @@ namespace impl
 	const TPyObjPtr Sequence::pop(Py_ssize_t i)
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		TPyObjPtr popped(pimpl_->item(i));
 		if (!pimpl_->pop(i))
 		{
@@ -151,22 +186,26 @@ namespace impl
 	std::string Sequence::repr() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return pimpl_->repr();
 	}
 
 	const TPyObjPtr Sequence::asList() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return pimpl_->asNative();
 	}
 	const TPyObjPtr Sequence::iter() const
 	{
 		LockGIL lock;
+		LockObject guard(this);
 		return TPyObjPtr(pimpl_->items());
 	}
 
 	Py_ssize_t Sequence::length(PyObject* self)
 	{
+		LockObject guard(self);
 		return static_cast<Sequence*>(self)->pimpl_->length();
 	}
 	PyObject* Sequence::concat(PyObject* self, PyObject* other)
@@ -181,18 +220,22 @@ namespace impl
 	}
 	PyObject* Sequence::item(PyObject* self, Py_ssize_t i)
 	{
+		LockObject guard(self);
 		return static_cast<Sequence*>(self)->pimpl_->item(i);
 	}
 	int Sequence::assItem(PyObject* self, Py_ssize_t i, PyObject* obj)
 	{
+		LockObject guard(self);
 		return static_cast<Sequence*>(self)->pimpl_->assItem(i, obj);
 	}
 	int Sequence::contains(PyObject* self, PyObject* obj)
 	{
+		LockObject guard(self);
 		return static_cast<Sequence*>(self)->pimpl_->contains(obj);
 	}
 	PyObject* Sequence::inplaceConcat(PyObject* self, PyObject* other)
 	{
+		LockObjects guard(self, other);
 		if (!static_cast<Sequence*>(self)->pimpl_->inplaceConcat(other))
 		{
 			return 0;
@@ -202,6 +245,7 @@ namespace impl
 	}
 	PyObject* Sequence::inplaceRepeat(PyObject* self, Py_ssize_t n)
 	{
+		LockObject guard(self);
 		if (!static_cast<Sequence*>(self)->pimpl_->inplaceRepeat(n))
 		{
 			return 0;
@@ -211,6 +255,7 @@ namespace impl
 	}
 	PyObject* Sequence::subscript(PyObject* self, PyObject* key)
 	{
+		LockObject guard(self);
 		PySequenceImplBase& pimpl = *static_cast<Sequence*>(self)->pimpl_;
 		if (PySlice_Check(key))
 		{
@@ -234,6 +279,7 @@ namespace impl
 	}
 	int Sequence::assSubscript(PyObject* self, PyObject* key, PyObject* value)
 	{
+		LockObjects guard(self, value ? value : self);
 		PySequenceImplBase& pimpl = *static_cast<Sequence*>(self)->pimpl_;
 		if (!pimpl.checkWritable())
 		{
@@ -259,6 +305,16 @@ namespace impl
 		}
 		return pimpl.assItem(i, value);
 	}
+	int Sequence::getBuffer(PyObject* self, Py_buffer* view, int flags)
+	{
+		LockObject guard(self);
+		return static_cast<Sequence*>(self)->pimpl_->getBuffer(view, self, flags);
+	}
+	void Sequence::releaseBuffer(PyObject* self, Py_buffer* view)
+	{
+		LockObject guard(self);
+		static_cast<Sequence*>(self)->pimpl_->releaseBuffer(view);
+	}
 }
 
 }
@@ -50,11 +50,14 @@
 #include "container.h"
 #include "argument_traits.h"
 #include "subscript.h"
+#include "buffer_traits.h"
+#include "gil.h"
 #include "../util/string_cast.h"
 #include "../stde/extended_algorithm.h"
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <deque>
 
 namespace lass
@@ -79,6 +82,14 @@ namespace impl
 		virtual int contains(PyObject* obj) const = 0;
 		virtual bool inplaceConcat(PyObject* obj) = 0;
 		virtual bool inplaceRepeat(Py_ssize_t n) = 0;
+		virtual int getBuffer(Py_buffer* view, PyObject* exporter, int flags) = 0;
+		void releaseBuffer(Py_buffer* view);
+	protected:
+		int exportBuffer(Py_buffer* view, PyObject* exporter, void* buf, Py_ssize_t length, Py_ssize_t itemStride, 
+			const char* format, Py_ssize_t itemsize, Py_ssize_t components, int flags);
+		bool checkResizable() const;
+	private:
+		Py_ssize_t exports_ = 0;
 	};
 
 	template<typename Container> 
@@ -101,6 +112,14 @@ namespace impl
 		~PySequenceContainer() 
 		{
 		}
+		bool clear() override
+		{
+			if (!this->checkResizable())
+			{
+				return false;
+			}
+			return TBase::clear();
+		}
 		const TPyObjPtr asNative() const override
 		{
 			return pyBuildList(this->begin(), this->next(this->begin(), this->length()));
@@ -112,7 +131,7 @@ namespace impl
 		}
 		bool reserve(Py_ssize_t n) override
 		{
-			if (!this->checkWritable())
+			if (!this->checkWritable() || !this->checkResizable())
 			{
 				return false;
 			}
@@ -121,7 +140,7 @@ namespace impl
 		}
 		bool append(const TPyObjPtr& obj) override
 		{
-			if (!this->checkWritable())
+			if (!this->checkWritable() || !this->checkResizable())
 			{
 				return false;
 			}
@@ -136,7 +155,7 @@ namespace impl
 		}
 		bool pop(Py_ssize_t i) override
 		{
-			if (!this->checkWritable())
+			if (!this->checkWritable() || !this->checkResizable())
 			{
 				return false;
 			}
@@ -218,6 +237,11 @@ namespace impl
 			}
 
 			Py_ssize_t sliceLength = slice.adjustIndices(this->length());
+			const Py_ssize_t newLength = b ? TContainerTraits::size(*b) : 0;
+			if ((slice.step == 1 || !b) && newLength != sliceLength && !this->checkResizable())
+			{
+				return -1;
+			}
 			if (slice.step == 1)
 			{
 				LASS_ASSERT(slice.start + sliceLength <= this->length());
@@ -299,7 +323,7 @@ namespace impl
 		}
 		bool inplaceConcat(PyObject* other) override
 		{
-			if (!this->checkWritable())
+			if (!this->checkWritable() || !this->checkResizable())
 			{
 				return false;
 			}
@@ -320,13 +344,30 @@ namespace impl
 		}
 		bool inplaceRepeat(Py_ssize_t n) override
 		{
-			if (!this->checkWritable())
+			if (!this->checkWritable() || !this->checkResizable())
 			{
 				return false;
 			}
 			TContainerTraits::inplace_repeat(this->container(),n);
 			return true;
 		}
+		int getBuffer(Py_buffer* view, PyObject* exporter, int flags) override
+		{
+			typedef typename TContainerTraits::value_type TValue;
+			if constexpr (TContainerTraits::is_contiguous && BufferTraits<TValue>::value)
+			{
+				typedef BufferTraits<TValue> TBufferTraits;
+				return this->exportBuffer(view, exporter, TContainerTraits::data(this->container()), this->length(),
+					static_cast<Py_ssize_t>(sizeof(TValue)), TBufferTraits::format, static_cast<Py_ssize_t>(sizeof(typename TBufferTraits::TScalar)),
+					TBufferTraits::components, flags);
+			}
+			else
+			{
+				view->obj = nullptr;
+				PyErr_SetString(PyExc_BufferError, "Sequence does not support the buffer protocol: elements are not stored contiguously as a primitive type");
+				return -1;
+			}
+		}
 	private:
 		bool checkIndex(Py_ssize_t& i) const
 		{
@@ -392,6 +433,8 @@ namespace impl
 		static PyObject* inplaceRepeat(PyObject* self, Py_ssize_t n);
 		static PyObject* subscript(PyObject* self, PyObject* key);
 		static int assSubscript(PyObject* self, PyObject* key, PyObject* value);
+		static int getBuffer(PyObject* self, Py_buffer* view, int flags);
+		static void releaseBuffer(PyObject* self, Py_buffer* view);
 
 	private:
 		typedef PySequenceImplBase::TPimpl TPimpl;
@@ -407,9 +450,24 @@ namespace impl
 	{
 		template <typename Container> static int getObjectImpl(PyObject* obj, util::SharedPtr<Container>& value, bool writable)
 		{
+			typedef typename Container::value_type TValue;
+			if constexpr (ContainerTraits<Container>::is_contiguous && BufferTraits<TValue>::value)
+			{
+				// bulk copy from objects supporting the buffer protocol with matching layout, like NumPy arrays.
+				// Our own Sequence is excluded, as the shortcut below avoids the copy altogether.
+				if (obj->ob_type != Sequence::_lassPyClassDef.type() && PyObject_CheckBuffer(obj))
+				{
+					if (getFromBuffer(obj, value) == 0)
+					{
+						return 0;
+					}
+				}
+			}
+
 			if (!PySequence_Check(obj))
 			{
 				PyErr_SetString(PyExc_TypeError, "not a sequence");
+				impl::markTypeMismatch(obj);
 				return 1;
 			}
 
@@ -425,14 +483,34 @@ namespace impl
 				}
 			}
 
+			// walk lists and tuples directly, anything else is copied in a list first.
+			const TPyObjPtr fast(PySequence_Fast(obj, "not a sequence"));
+			if (!fast)
+			{
+				return 1;
+			}
+			LockObject lock(fast.get());
 			const util::SharedPtr<Container> result(new Container);
-			const Py_ssize_t size = PySequence_Length(obj);
-			ContainerTraits<Container>::reserve(*result, size);
+			ContainerTraits<Container>::reserve(*result, PySequence_Fast_GET_SIZE(fast.get()));
 			typedef ArgumentTraits<typename Container::value_type> TArgTraits;
-			for (Py_ssize_t i = 0; i < size; ++i)
+			// Converting an element may run Python code that resizes a list, so hold on to each item
+			// and re-read the size every iteration rather than caching PySequence_Fast_ITEMS.
+			// We already hold the GIL, so don't pay for a TPyObjPtr that locks it for every item.
+			typedef std::unique_ptr<PyObject, void(*)(PyObject*)> TItemRef;
+			for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(fast.get()); ++i)
 			{
+				const TItemRef item(Py_NewRef(PySequence_Fast_GET_ITEM(fast.get(), i)), Py_DecRef);
+				if constexpr (BufferTraits<TValue>::value)
+				{
+					// fixed-size prim types like Point3D, straight from tuples of floats.
+					TValue temp;
+					if (getFromExactSequence(item.get(), temp) == 0)
+					{
+						result->push_back(temp);
+						continue;
+					}
+				}
 				typename TArgTraits::TStorage temp;
-				TPyObjPtr item( PySequence_ITEM(obj, i) );
 				if (pyGetSimpleObject( item.get() , temp ) != 0)
 				{
 					std::ostringstream buffer;
@@ -445,6 +523,34 @@ namespace impl
 			value = std::move(result);
 			return 0;
 		}
+
+	private:
+		/** Returns 0 on success, or 1 if the buffer layout doesn't match so that the caller should fall back
+		 *  to the sequence protocol. Never sets a Python error.
+		 */
+		template <typename Container> static int getFromBuffer(PyObject* obj, util::SharedPtr<Container>& value)
+		{
+			typedef typename Container::value_type TValue;
+			typedef BufferTraits<TValue> TBufferTraits;
+			Py_buffer view;
+			if (PyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) != 0)
+			{
+				PyErr_Clear();
+				return 1;
+			}
+			const Py_ssize_t n = checkBufferLayout(view, TBufferTraits::format[0], 
+				static_cast<Py_ssize_t>(sizeof(typename TBufferTraits::TScalar)), TBufferTraits::components);
+			if (n < 0)
+			{
+				PyBuffer_Release(&view);
+				return 1;
+			}
+			util::SharedPtr<Container> result(new Container(static_cast<size_t>(n)));
+			copyFromBuffer(view, n, ContainerTraits<Container>::data(*result));
+			PyBuffer_Release(&view);
+			value = std::move(result);
+			return 0;
+		}
 	};
 }
 
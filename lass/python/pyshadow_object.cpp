@@ -42,6 +42,13 @@
 
 #include "python_common.h"
 #include "pyshadow_object.h" 
+#include "gil.h"
+#include "call_stats.h"
+#include "per_interpreter.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
 namespace lass
 {
@@ -50,8 +57,267 @@ namespace python
 namespace impl
 {
 
+namespace
+{
+
+/** Get a new reference to a registered shadow object, unless it is already being destroyed.
+ *
+ *  On regular builds, the GIL ensures the shadow object is unregistered before anyone can see
+ *  its reference count dropping to zero. On free-threaded builds, another thread may be in the
+ *  middle of deallocating it, and we must not resurrect it.
+ */
+PyObject* tryNewRef(PyObject* obj)
+{
+#ifdef Py_GIL_DISABLED
+	return PyUnstable_TryIncRef(obj) ? obj : nullptr;
+#else
+	Py_INCREF(obj);
+	return obj;
+#endif
+}
+
+/** Each interpreter has its own shadow objects, so the interpreter is part of the key.
+ *  The ID is used rather than the address, as addresses of ended interpreters get reused.
+ */
+std::int64_t currentInterpreterID()
+{
+	return PyInterpreterState_GetID(currentInterpreter());
+}
+
+size_t hashShadoweeID(TShadoweeID shadoweeID, std::int64_t interpreterID = 0)
+{
+	// murmur3 finalizer, shadowee addresses have too little entropy in their low bits.
+	std::uint64_t h = static_cast<std::uint64_t>(shadoweeID) ^ (static_cast<std::uint64_t>(interpreterID) * 0x9e3779b97f4a7c15ULL);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return static_cast<size_t>(h);
+}
+
+/** One shard of the shadow registry: an open-addressing hash table with linear probing.
+ *
+ *  Empty buckets have a zero shadoweeID, deleted ones (tombstones) have a null shadow.
+ *  On free-threaded builds, all access must be done while holding the mutex, which also guards
+ *  the IntrusiveShadowSlot instances that hash to this shard.
+ */
+class Shard
+{
+public:
+	struct Bucket
+	{
+		TShadoweeID shadoweeID = 0;
+		ShadowBaseCommon* shadow = nullptr;
+		std::int64_t interpreterID = 0;
+		ShadoweeConstness constness = scConst;
+
+		bool matches(TShadoweeID id, std::int64_t interp, ShadoweeConstness c) const
+		{
+			return shadoweeID == id && constness == c && interpreterID == interp;
+		}
+	};
+
+	ShadowBaseCommon* find(TShadoweeID shadoweeID, std::int64_t interpreterID, ShadoweeConstness constness, size_t hash)
+	{
+		++lookups;
+		if (buckets_.empty())
+		{
+			return nullptr;
+		}
+		const size_t mask = buckets_.size() - 1;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			const Bucket& b = buckets_[i];
+			if (b.shadoweeID == 0)
+			{
+				return nullptr;
+			}
+			if (b.matches(shadoweeID, interpreterID, constness) && b.shadow)
+			{
+				++hits;
+				return b.shadow;
+			}
+		}
+	}
+
+	/** Returns the existing shadow registered for shadoweeID, or registers @a shadow and returns null.
+	 *  If @a replace is true, an existing shadow is overwritten, but still returned.
+	 */
+	ShadowBaseCommon* insert(TShadoweeID shadoweeID, std::int64_t interpreterID, ShadoweeConstness constness, size_t hash, ShadowBaseCommon* shadow, bool replace)
+	{
+		if ((used_ + 1) * 2 > buckets_.size())
+		{
+			rehash();
+		}
+		const size_t mask = buckets_.size() - 1;
+		Bucket* tombstone = nullptr;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			Bucket& b = buckets_[i];
+			if (b.shadoweeID == 0)
+			{
+				if (tombstone)
+				{
+					--used_; // the tombstone gets reused.
+				}
+				Bucket& target = tombstone ? *tombstone : b;
+				target.shadoweeID = shadoweeID;
+				target.interpreterID = interpreterID;
+				target.constness = constness;
+				target.shadow = shadow;
+				++used_;
+				++size_;
+				return nullptr;
+			}
+			if (!b.shadow)
+			{
+				if (!tombstone)
+				{
+					tombstone = &b;
+				}
+			}
+			else if (b.matches(shadoweeID, interpreterID, constness))
+			{
+				ShadowBaseCommon* existing = b.shadow;
+				if (replace)
+				{
+					b.shadow = shadow;
+				}
+				return existing;
+			}
+		}
+	}
+
+	/** Unregisters @a shadow, returns false if another shadow (or none) is registered for shadoweeID.
+	 */
+	bool erase(TShadoweeID shadoweeID, std::int64_t interpreterID, ShadoweeConstness constness, size_t hash, const ShadowBaseCommon* shadow)
+	{
+		if (buckets_.empty())
+		{
+			return false;
+		}
+		const size_t mask = buckets_.size() - 1;
+		for (size_t i = hash & mask; ; i = (i + 1) & mask)
+		{
+			Bucket& b = buckets_[i];
+			if (b.shadoweeID == 0)
+			{
+				return false;
+			}
+			if (b.matches(shadoweeID, interpreterID, constness) && b.shadow)
+			{
+				if (b.shadow != shadow)
+				{
+					return false;
+				}
+				b.shadow = nullptr; // leave a tombstone
+				--size_;
+				return true;
+			}
+		}
+	}
+
+	size_t size() const { return size_; }
+	size_t capacity() const { return buckets_.size(); }
+
+	FreeThreadingMutex mutex;
+	size_t lookups = 0;
+	size_t hits = 0;
+	size_t intrusiveLookups = 0;
+	size_t intrusiveHits = 0;
+	size_t intrusiveSize = 0;
+
+private:
+	/** Grows the table, or cleans up tombstones if there are many of them.
+	 *  Afterwards, the load factor is at most 1/4.
+	 */
+	void rehash()
+	{
+		size_t capacity = minCapacity;
+		while (capacity < 4 * (size_ + 1))
+		{
+			capacity *= 2;
+		}
+		std::vector<Bucket> buckets(capacity);
+		buckets.swap(buckets_);
+		const size_t mask = capacity - 1;
+		for (const Bucket& b : buckets)
+		{
+			if (b.shadoweeID == 0 || !b.shadow)
+			{
+				continue;
+			}
+			size_t i = hashShadoweeID(b.shadoweeID, b.interpreterID) & mask;
+			while (buckets_[i].shadoweeID != 0)
+			{
+				i = (i + 1) & mask;
+			}
+			buckets_[i] = b;
+		}
+		used_ = size_;
+	}
+
+	enum { minCapacity = 16 };
+
+	std::vector<Bucket> buckets_;
+	size_t size_ = 0; // live entries
+	size_t used_ = 0; // live entries + tombstones
+};
+
+/** Maps shadowees on their shadow objects, of each interpreter.
+ *
+ *  The table is split in shards, each with their own lock, so that free-threaded builds
+ *  don't serialize all shadow object creation on a single mutex.
+ */
+class ShadowRegistry
+{
+public:
+	enum { numShards = 16 };
+
+	static ShadowRegistry& instance()
+	{
+		// Deliberately leaked: shadow objects may still be destroyed after static destruction.
+		static ShadowRegistry* registry = new ShadowRegistry;
+		return *registry;
+	}
+
+	Shard& shard(size_t hash)
+	{
+		// the low bits pick the bucket, use the high ones for the shard.
+		return shards_[(hash >> (8 * sizeof(size_t) - 4)) & (numShards - 1)];
+	}
+
+	ShadowRegistryStats stats()
+	{
+		ShadowRegistryStats result;
+		for (Shard& s : shards_)
+		{
+			std::lock_guard<FreeThreadingMutex> lock(s.mutex);
+			result.lookups += s.lookups;
+			result.hits += s.hits;
+			result.intrusiveLookups += s.intrusiveLookups;
+			result.intrusiveHits += s.intrusiveHits;
+			result.size += s.size();
+			result.intrusiveSize += s.intrusiveSize;
+			result.capacity += s.capacity();
+		}
+		result.shards = numShards;
+		return result;
+	}
+
+private:
+	static_assert((numShards & (numShards - 1)) == 0, "numShards must be a power of two");
+	Shard shards_[numShards];
+};
+
+}
+
 ShadowBaseCommon::ShadowBaseCommon()
 {
+#if LASS_PYTHON_CALL_STATS
+	countShadowCreation();
+#endif
 }
 
 ShadowBaseCommon::~ShadowBaseCommon()
@@ -65,13 +331,36 @@ TPyObjPtr ShadowBaseCommon::findShadowObject(TShadoweeID shadoweeID, ShadoweeCon
 	{
 		return TPyObjPtr();
 	}
-	TCache& c = cache();
-	auto i = c.find(TCacheKey(shadoweeID, constness));
-	if (i == c.end())
+	const std::int64_t interpreterID = currentInterpreterID();
+	const size_t hash = hashShadoweeID(shadoweeID, interpreterID);
+	Shard& shard = ShadowRegistry::instance().shard(hash);
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+	ShadowBaseCommon* shadow = shard.find(shadoweeID, interpreterID, constness, hash);
+	if (!shadow)
+	{
+		return TPyObjPtr();
+	}
+	return TPyObjPtr(tryNewRef(shadow));
+}
+
+
+TPyObjPtr ShadowBaseCommon::findShadowObject(const IntrusiveShadowSlot& slot, ShadoweeConstness constness)
+{
+	if (!isMainInterpreter())
+	{
+		// the slot only has room for the shadow objects of the main interpreter.
+		return findShadowObject(reinterpret_cast<TShadoweeID>(&slot), constness);
+	}
+	Shard& shard = ShadowRegistry::instance().shard(hashShadoweeID(reinterpret_cast<TShadoweeID>(&slot)));
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+	++shard.intrusiveLookups;
+	ShadowBaseCommon* shadow = slot.shadows_[constness];
+	if (!shadow)
 	{
 		return TPyObjPtr();
 	}
-	return fromNakedToSharedPtrCast<PyObject>(i->second);
+	++shard.intrusiveHits;
+	return TPyObjPtr(tryNewRef(shadow));
 }
 
 
@@ -81,8 +370,20 @@ void ShadowBaseCommon::registerShadowee(TShadoweeID shadoweeID, ShadoweeConstnes
 	{
 		return;
 	}
-	auto r = cache().emplace(TCacheKey(shadoweeID, constness), this);
-	LASS_ENFORCE(r.second);
+#ifdef Py_GIL_DISABLED
+	PyUnstable_EnableTryIncRef(this);
+#endif
+	const std::int64_t interpreterID = currentInterpreterID();
+	const size_t hash = hashShadoweeID(shadoweeID, interpreterID);
+	Shard& shard = ShadowRegistry::instance().shard(hash);
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+#ifdef Py_GIL_DISABLED
+	// a shadow object that is being destroyed by another thread may still be registered, replace it.
+	shard.insert(shadoweeID, interpreterID, constness, hash, this, true);
+#else
+	const ShadowBaseCommon* existing = shard.insert(shadoweeID, interpreterID, constness, hash, this, false);
+	LASS_ENFORCE(!existing);
+#endif
 }
 
 
@@ -92,23 +393,73 @@ void ShadowBaseCommon::unregisterShadowee(TShadoweeID shadoweeID, ShadoweeConstn
 	{
 		return;
 	}
-	TCache& c = cache();
-	if (c.empty())
+	const std::int64_t interpreterID = currentInterpreterID();
+	const size_t hash = hashShadoweeID(shadoweeID, interpreterID);
+	Shard& shard = ShadowRegistry::instance().shard(hash);
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+	const bool erased = shard.erase(shadoweeID, interpreterID, constness, hash, this);
+#ifdef Py_GIL_DISABLED
+	(void) erased; // may already be replaced by a new shadow object, see registerShadowee.
+#else
+	LASS_ENFORCE(erased);
+#endif
+}
+
+
+void ShadowBaseCommon::registerShadowee(const IntrusiveShadowSlot& slot, ShadoweeConstness constness)
+{
+	if (!isMainInterpreter())
 	{
-		return; // Cache has already been emptied.
+		registerShadowee(reinterpret_cast<TShadoweeID>(&slot), constness);
+		return;
 	}
-	auto i = c.find(TCacheKey(shadoweeID, constness));
-	LASS_ENFORCE(i != c.end() && i->second == this);
-	c.erase(i);
+#ifdef Py_GIL_DISABLED
+	PyUnstable_EnableTryIncRef(this);
+#endif
+	Shard& shard = ShadowRegistry::instance().shard(hashShadoweeID(reinterpret_cast<TShadoweeID>(&slot)));
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+	ShadowBaseCommon*& shadow = slot.shadows_[constness];
+#ifdef Py_GIL_DISABLED
+	// a shadow object that is being destroyed by another thread may still be registered, replace it.
+	if (!shadow)
+	{
+		++shard.intrusiveSize;
+	}
+#else
+	LASS_ENFORCE(!shadow);
+	++shard.intrusiveSize;
+#endif
+	shadow = this;
 }
 
 
-ShadowBaseCommon::TCache& ShadowBaseCommon::cache()
+void ShadowBaseCommon::unregisterShadowee(const IntrusiveShadowSlot& slot, ShadoweeConstness constness)
 {
-	static TCache cache_;
-	return cache_;
+	if (!isMainInterpreter())
+	{
+		unregisterShadowee(reinterpret_cast<TShadoweeID>(&slot), constness);
+		return;
+	}
+	Shard& shard = ShadowRegistry::instance().shard(hashShadoweeID(reinterpret_cast<TShadoweeID>(&slot)));
+	std::lock_guard<FreeThreadingMutex> lock(shard.mutex);
+	ShadowBaseCommon*& shadow = slot.shadows_[constness];
+#ifdef Py_GIL_DISABLED
+	if (shadow != this)
+	{
+		return; // already replaced by a new shadow object, see registerShadowee.
+	}
+#else
+	LASS_ENFORCE(shadow == this);
+#endif
+	shadow = nullptr;
+	--shard.intrusiveSize;
+}
+
 }
 
+ShadowRegistryStats shadowRegistryStats()
+{
+	return impl::ShadowRegistry::instance().stats();
 }
 
 }
@@ -98,6 +98,74 @@ enum ShadoweeConstness
 	scNonConst
 };
 
+class ShadowBaseCommon;
+
+}
+
+/** @ingroup Python
+ *  @brief Base class for shadowees that keep track of their own shadow objects.
+ *
+ *  Every time a shadowee is converted to Python, its existing shadow object is looked up,
+ *  so that the same C++ object always maps on the same Python object. By default, that
+ *  goes through a global registry keyed on the shadowee's address. If the shadowee derives
+ *  from IntrusiveShadowSlot, the shadow objects are stored in the shadowee itself instead.
+ *
+ *  The slot must be a base of the shadowee type of the root shadow class in a hierarchy
+ *  (the one declared with PY_SHADOW_CLASS), so that all shadow classes agree on using it.
+ *  It's only used if the pointer traits own the shadowee, like SharedPointerTraits and
+ *  StdSharedPointerTraits. With NakedPointerTraits, the shadowee may be destroyed before its
+ *  shadow, so the global registry is used instead.
+ *  Copies of a shadowee don't share its shadow objects. Each interpreter has its own shadow
+ *  objects, the slot only holds the ones of the main interpreter. Subinterpreters use the
+ *  global registry.
+ *
+ *  @code
+ *  class Spam: public lass::python::IntrusiveShadowSlot
+ *  {
+ *      ...
+ *  };
+ *  PY_SHADOW_CLASS(LASS_DLL_EXPORT, PySpam, Spam)
+ *  @endcode
+ */
+class IntrusiveShadowSlot
+{
+protected:
+	IntrusiveShadowSlot() = default;
+	IntrusiveShadowSlot(const IntrusiveShadowSlot&) {}
+	IntrusiveShadowSlot& operator=(const IntrusiveShadowSlot&) { return *this; }
+	~IntrusiveShadowSlot() = default;
+private:
+	friend class impl::ShadowBaseCommon;
+	mutable impl::ShadowBaseCommon* shadows_[2] = { nullptr, nullptr }; // indexed by ShadoweeConstness
+};
+
+/** @ingroup Python
+ *  @brief Counters of the registry that maps shadowees on their shadow objects.
+ *
+ *  @sa shadowRegistryStats
+ */
+struct ShadowRegistryStats
+{
+	size_t lookups = 0; ///< number of lookups in the sharded hash table
+	size_t hits = 0; ///< number of lookups in the hash table that found a shadow object
+	size_t intrusiveLookups = 0; ///< number of lookups in an IntrusiveShadowSlot
+	size_t intrusiveHits = 0; ///< number of lookups in an IntrusiveShadowSlot that found a shadow object
+	size_t size = 0; ///< number of shadow objects registered in the hash table
+	size_t intrusiveSize = 0; ///< number of shadow objects registered in an IntrusiveShadowSlot
+	size_t capacity = 0; ///< total number of buckets of the hash table, over all shards
+	size_t shards = 0; ///< number of independently locked shards of the hash table
+};
+
+/** @ingroup Python
+ *  @brief Returns a snapshot of the counters of the shadow object registry.
+ *
+ *  Available in Python as `_lass.shadowRegistryStats()`, returning a dict.
+ */
+LASS_PYTHON_DLL ShadowRegistryStats shadowRegistryStats();
+
+namespace impl
+{
+
 /** @ingroup Python
  *  @internal
  */
@@ -105,6 +173,7 @@ class LASS_PYTHON_DLL ShadowBaseCommon: public PyObjectPlus
 {
 public:
 	static TPyObjPtr findShadowObject(TShadoweeID shadoweeID, ShadoweeConstness constness);
+	static TPyObjPtr findShadowObject(const IntrusiveShadowSlot& slot, ShadoweeConstness constness);
 
 protected:
 	ShadowBaseCommon();
@@ -112,24 +181,11 @@ protected:
 
 	void registerShadowee(TShadoweeID shadoweeID, ShadoweeConstness constness);
 	void unregisterShadowee(TShadoweeID shadoweeID, ShadoweeConstness constness);
+	void registerShadowee(const IntrusiveShadowSlot& slot, ShadoweeConstness constness);
+	void unregisterShadowee(const IntrusiveShadowSlot& slot, ShadoweeConstness constness);
 private:
-	typedef std::pair<TShadoweeID, ShadoweeConstness> TCacheKey;
-
-	struct CacheKeyHash
-	{
-		std::size_t operator()(const TCacheKey& key) const
-		{
-			std::size_t h1 = std::hash<TShadoweeID>()(key.first);
-			std::size_t h2 = std::hash<ShadoweeConstness>()(key.second);
-			return h1 ^ h2;
-		}
-	};
-
-	typedef std::unordered_map<TCacheKey, ShadowBaseCommon*, CacheKeyHash> TCache;
 	ShadowBaseCommon(const ShadowBaseCommon&);
 	ShadowBaseCommon& operator=(const ShadowBaseCommon&);
-
-	static TCache& cache();
 };
 
 /** @ingroup Python
@@ -218,6 +274,7 @@ private:
 		if (!PyType_IsSubtype(obj->ob_type , T::_lassPyClassDef.type() ))
 		{
 			PyErr_Format(PyExc_TypeError, "%s not castable to %s", obj->ob_type->tp_name, T::_lassPyClassDef.name());
+			impl::markTypeMismatch(obj);
 			return false;
 		}
 		return true;
@@ -255,6 +312,7 @@ public:
 		if (obj == Py_None)
 		{
 			PyErr_Format(PyExc_TypeError, "None not castable to %s", T::_lassPyClassDef.name());
+			impl::markTypeMismatch(obj);
 			return 1;
 		}
 		TConstCppClassPtr p;
@@ -317,9 +375,15 @@ private:
 					return 0;
 				}
 				PyErr_Clear();
+				impl::clearTypeMismatch();
 			}
 		}
 		PyErr_Format(PyExc_TypeError, "%s not convertable to %s", obj->ob_type->tp_name, T::_lassPyClassDef.name());
+		if (!converters || converters->empty())
+		{
+			// no conversion was attempted, so it's the type alone that's rejected.
+			impl::markTypeMismatch(obj);
+		}
 		return 1;
 	}
 
@@ -345,7 +409,17 @@ typename ShadowType::TShadowPtr makeShadow(
 	typedef typename ShadowType::TConstPointerTraits TConstPointerTraits;
 
 	LASS_ASSERT(!TConstPointerTraits::isEmpty(shadowee));
-	if (const auto p = impl::ShadowBaseCommon::findShadowObject(TConstPointerTraits::id(shadowee), constness))
+	TPyObjPtr p;
+	if constexpr (ShadowType::hasIntrusiveShadowSlot)
+	{
+		const IntrusiveShadowSlot& slot = *TConstPointerTraits::get(shadowee);
+		p = impl::ShadowBaseCommon::findShadowObject(slot, constness);
+	}
+	else
+	{
+		p = impl::ShadowBaseCommon::findShadowObject(TConstPointerTraits::id(shadowee), constness);
+	}
+	if (p)
 	{
 		LASS_ASSERT(PyObject_IsInstance(p.get(), reinterpret_cast<PyObject*>(ShadowType::_lassPyClassDef.type())));
 		return p.template staticCast<ShadowType>();
@@ -397,6 +471,7 @@ struct SharedPointerTraits
 	{
 		typedef SharedPointerTraits<U, S, C> Type;
 	};
+	static constexpr bool isOwning = true; ///< the shadow keeps the shadowee alive
 	static void acquire(const TPtr&) {} // TPtr already handles ownership, so nothing to acquire.
 	static void release(const TPtr&) {}
 	static bool isEmpty(const TPtr& p) 
@@ -434,6 +509,7 @@ struct NakedPointerTraits
 	{
 		typedef NakedPointerTraits<U> Type;
 	};
+	static constexpr bool isOwning = false; ///< the shadowee may die before its shadow
 	static void acquire(TPtr) {} // no ownership rules, so nothing to acquire.
 	static void release(TPtr) {}
 	static bool isEmpty(TPtr p) 
@@ -471,6 +547,7 @@ struct StdSharedPointerTraits
 	{
 		typedef StdSharedPointerTraits<U> Type;
 	};
+	static constexpr bool isOwning = true; ///< the shadow keeps the shadowee alive
 	static void acquire(const TPtr&) {} // TPtr already handles ownership, so nothing to acquire.
 	static void release(const TPtr&) {}
 	static bool isEmpty(const TPtr& p)
@@ -610,6 +687,13 @@ public:
 	static void registerWithParent()
 	{
 	}
+
+	/** Whether the shadowees of this hierarchy track their own shadow objects.
+	 *  Decided here at the root, so that derived shadow classes agree on it.
+	 *  Only if the shadow owns its shadowee, as it must still reach the slot when it dies.
+	 */
+	static constexpr bool hasIntrusiveShadowSlot =
+		std::is_base_of_v<IntrusiveShadowSlot, ShadoweeType> && TConstPointerTraits::isOwning;
 protected:
 	typedef TShadowPtr (*TDerivedMaker)(const TConstShadoweePtr&, impl::ShadoweeConstness);
 	ShadowClass(const TConstShadoweePtr& shadowee, impl::ShadoweeConstness constness): 
@@ -617,11 +701,25 @@ protected:
 		constness_(constness)
 	{
 		TConstPointerTraits::acquire(shadowee_);
-		impl::ShadowBaseCommon::registerShadowee(TConstPointerTraits::id(shadowee_), constness_);
+		if constexpr (hasIntrusiveShadowSlot)
+		{
+			impl::ShadowBaseCommon::registerShadowee(static_cast<const IntrusiveShadowSlot&>(*TConstPointerTraits::get(shadowee_)), constness_);
+		}
+		else
+		{
+			impl::ShadowBaseCommon::registerShadowee(TConstPointerTraits::id(shadowee_), constness_);
+		}
 	}
 	~ShadowClass()
 	{
-		impl::ShadowBaseCommon::unregisterShadowee(TConstPointerTraits::id(shadowee_), constness_);
+		if constexpr (hasIntrusiveShadowSlot)
+		{
+			impl::ShadowBaseCommon::unregisterShadowee(static_cast<const IntrusiveShadowSlot&>(*TConstPointerTraits::get(shadowee_)), constness_);
+		}
+		else
+		{
+			impl::ShadowBaseCommon::unregisterShadowee(TConstPointerTraits::id(shadowee_), constness_);
+		}
 		TConstPointerTraits::release(shadowee_);
 	}
 	static void registerDerivedMaker(TDerivedMaker derivedMaker)
@@ -142,6 +142,11 @@ namespace lass::python
 
 #pragma pop_macro("slots")
 
+// Free-threaded builds need PyUnstable_TryIncRef to look up shadow objects, see pyshadow_object.cpp.
+#if defined(Py_GIL_DISABLED) && PY_VERSION_HEX < 0x030e0000 // < 3.14
+#	error "Free-threaded builds of lass_python require Python 3.14 or later"
+#endif
+
 #if LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_MSVC
 #	pragma warning(pop)
 #endif
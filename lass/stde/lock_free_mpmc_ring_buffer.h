@@ -0,0 +1,120 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+/** @class lass::stde::lock_free_mpmc_ring_buffer
+ *  @brief Bounded, non-blocking, multi-producer multi-consumer FIFO
+ *
+ *  D. Vyukov, "Bounded MPMC queue", http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ *  Each slot of the ring carries a sequence number that tells whether it's ready to be written
+ *  or read in the current lap, so producers and consumers only need to compare-and-swap their
+ *  own cursor.  Values are constructed in place in the ring: unlike lock_free_queue or
+ *  lock_free_spmc_object_ring_buffer, pushing or popping never allocates.
+ *
+ *  try_push_n and try_pop_n claim a run of consecutive slots with a single compare-and-swap.
+ *
+ *  The capacity is rounded up to a power of two.  value_type must be default constructible: if
+ *  constructing a pushed value throws, its slot is already claimed and is filled with a default
+ *  constructed value instead, so that consumers are not blocked.
+ */
+
+#pragma once
+
+#include "stde_common.h"
+#include "../util/non_copyable.h"
+#include "../util/atomic.h"
+
+namespace lass
+{
+namespace stde
+{
+
+template <typename T>
+class lock_free_mpmc_ring_buffer: util::NonCopyable
+{
+public:
+	typedef T value_type;
+	typedef size_t size_type;
+
+	lock_free_mpmc_ring_buffer(size_type capacity);
+	~lock_free_mpmc_ring_buffer();
+
+	bool try_push(const value_type& x);
+	bool try_push(value_type&& x);
+	template <class... Args> bool try_emplace(Args&&... args);
+	bool try_pop(value_type& x);
+
+	template <typename InputIterator> size_type try_push_n(InputIterator first, size_type n);
+	template <typename OutputIterator> size_type try_pop_n(OutputIterator first, size_type n);
+
+	bool empty() const;
+	size_type capacity() const;
+
+private:
+
+	struct slot
+	{
+		std::atomic<size_type> sequence;
+		alignas(value_type) unsigned char storage[sizeof(value_type)];
+
+		value_type* value() { return reinterpret_cast<value_type*>(storage); }
+	};
+
+	template <class... Args> bool do_try_emplace(Args&&... args);
+	size_type claim(std::atomic<size_type>& cursor, size_type offset, size_type& n);
+
+	static size_type enforce_valid_size(size_type size);
+
+	slot* ring_;
+	const size_type mask_;
+	alignas(LASS_LOCK_FREE_ALIGNMENT) std::atomic<size_type> head_; /**< next position to push */
+	alignas(LASS_LOCK_FREE_ALIGNMENT) std::atomic<size_type> tail_; /**< next position to pop */
+};
+
+}
+
+}
+
+#include "lock_free_mpmc_ring_buffer.inl"
+
+// EOF
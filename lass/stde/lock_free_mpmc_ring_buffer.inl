@@ -0,0 +1,327 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "lock_free_mpmc_ring_buffer.h"
+
+namespace lass
+{
+namespace stde
+{
+
+template <typename T>
+lock_free_mpmc_ring_buffer<T>::lock_free_mpmc_ring_buffer(size_type capacity):
+	ring_(0),
+	mask_(enforce_valid_size(capacity) - 1),
+	head_(0),
+	tail_(0)
+{
+	ring_ = new slot[mask_ + 1];
+	for (size_type i = 0; i <= mask_; ++i)
+	{
+		ring_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+
+
+template <typename T>
+lock_free_mpmc_ring_buffer<T>::~lock_free_mpmc_ring_buffer()
+{
+	const size_type head = head_.load(std::memory_order_acquire);
+	for (size_type i = tail_.load(std::memory_order_acquire); i != head; ++i)
+	{
+		ring_[i & mask_].value()->~value_type();
+	}
+	delete [] ring_;
+}
+
+
+
+/** Try to push a value x on the front.
+ *  @return false if buffer was full and x could not be pushed.
+ */
+template <typename T>
+bool lock_free_mpmc_ring_buffer<T>::try_push(const value_type& x)
+{
+	return do_try_emplace(x);
+}
+
+
+
+/** Try to push a value x on the front.
+ *  @return false if buffer was full and x could not be pushed.
+ */
+template <typename T>
+bool lock_free_mpmc_ring_buffer<T>::try_push(value_type&& x)
+{
+	return do_try_emplace(std::move(x));
+}
+
+
+
+/** Try to emplace a value on the front.
+ *  @return false if buffer was full and value could not be pushed.
+ */
+template <typename T>
+template <class... Args>
+bool lock_free_mpmc_ring_buffer<T>::try_emplace(Args&&... args)
+{
+	return do_try_emplace(std::forward<Args>(args)...);
+}
+
+
+
+/** Try to pop a value from the back and store it in x.
+ *  @return false if buffer was empty and no element could be popped.
+ */
+template <typename T>
+bool lock_free_mpmc_ring_buffer<T>::try_pop(value_type& x)
+{
+	size_type k = 1;
+	const size_type pos = claim(tail_, 1, k);
+	if (pos == num::NumTraits<size_type>::max)
+	{
+		return false;
+	}
+	slot& s = ring_[pos & mask_];
+	value_type* p = s.value();
+	x = std::move(*p);
+	p->~value_type();
+	s.sequence.store(pos + mask_ + 1, std::memory_order_release);
+	return true;
+}
+
+
+
+/** Try to push up to @a n values from @a first, with a single claim of the ring.
+ *  @return number of values pushed, which is less than @a n if the ring buffer is (nearly) full.
+ *  @warning if constructing a value throws, the values after it in the claimed run are default
+ *		constructed instead, so that the consumers can continue.
+ */
+template <typename T>
+template <typename InputIterator>
+typename lock_free_mpmc_ring_buffer<T>::size_type
+lock_free_mpmc_ring_buffer<T>::try_push_n(InputIterator first, size_type n)
+{
+	if (n == 0)
+	{
+		return 0;
+	}
+	size_type k = n;
+	const size_type pos = claim(head_, 0, k);
+	if (pos == num::NumTraits<size_type>::max)
+	{
+		return 0;
+	}
+	size_type i = 0;
+	try
+	{
+		for (; i < k; ++i, ++first)
+		{
+			slot& s = ring_[(pos + i) & mask_];
+			new (s.storage) value_type(*first);
+			s.sequence.store(pos + i + 1, std::memory_order_release);
+		}
+	}
+	catch (...)
+	{
+		for (; i < k; ++i)
+		{
+			slot& s = ring_[(pos + i) & mask_];
+			new (s.storage) value_type();
+			s.sequence.store(pos + i + 1, std::memory_order_release);
+		}
+		throw;
+	}
+	return k;
+}
+
+
+
+/** Try to pop up to @a n values, with a single claim of the ring, and write them to @a first.
+ *  @return number of values popped, which is less than @a n if the ring buffer is (nearly) empty.
+ */
+template <typename T>
+template <typename OutputIterator>
+typename lock_free_mpmc_ring_buffer<T>::size_type
+lock_free_mpmc_ring_buffer<T>::try_pop_n(OutputIterator first, size_type n)
+{
+	if (n == 0)
+	{
+		return 0;
+	}
+	size_type k = n;
+	const size_type pos = claim(tail_, 1, k);
+	if (pos == num::NumTraits<size_type>::max)
+	{
+		return 0;
+	}
+	for (size_type i = 0; i < k; ++i, ++first)
+	{
+		slot& s = ring_[(pos + i) & mask_];
+		value_type* p = s.value();
+		*first = std::move(*p);
+		p->~value_type();
+		s.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+	}
+	return k;
+}
+
+
+
+/** Return true if ring buffer is empty.
+ *  As other threads may push or pop concurrently, this is only a snapshot.
+ */
+template <typename T>
+bool lock_free_mpmc_ring_buffer<T>::empty() const
+{
+	const size_type tail = tail_.load(std::memory_order_acquire);
+	return ring_[tail & mask_].sequence.load(std::memory_order_acquire) != tail + 1;
+}
+
+
+
+template <typename T>
+typename lock_free_mpmc_ring_buffer<T>::size_type
+lock_free_mpmc_ring_buffer<T>::capacity() const
+{
+	return mask_ + 1;
+}
+
+
+
+// --- private -------------------------------------------------------------------------------------
+
+template <typename T>
+template <class... Args>
+bool lock_free_mpmc_ring_buffer<T>::do_try_emplace(Args&&... args)
+{
+	size_type k = 1;
+	const size_type pos = claim(head_, 0, k);
+	if (pos == num::NumTraits<size_type>::max)
+	{
+		return false;
+	}
+	slot& s = ring_[pos & mask_];
+	try
+	{
+		new (s.storage) value_type(std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		// the slot is claimed and consumers will wait for it, so we must fill it anyway.
+		new (s.storage) value_type();
+		s.sequence.store(pos + 1, std::memory_order_release);
+		throw;
+	}
+	s.sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+
+
+/** Claim a run of at most @a n slots at @a cursor, and store its length back in @a n.
+ *
+ *  A slot at position pos is ready for producers if its sequence equals pos (@a offset 0),
+ *  and ready for consumers if it equals pos + 1 (@a offset 1).
+ *
+ *  @return first position of the claimed run, or max size_type if no slot could be claimed.
+ */
+template <typename T>
+typename lock_free_mpmc_ring_buffer<T>::size_type
+lock_free_mpmc_ring_buffer<T>::claim(std::atomic<size_type>& cursor, size_type offset, size_type& n)
+{
+	size_type pos = cursor.load(std::memory_order_relaxed);
+	while (true)
+	{
+		const size_type seq = ring_[pos & mask_].sequence.load(std::memory_order_acquire);
+		const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + offset));
+		if (diff < 0)
+		{
+			return num::NumTraits<size_type>::max; // full or empty
+		}
+		if (diff > 0)
+		{
+			pos = cursor.load(std::memory_order_relaxed); // someone else got it first.
+			continue;
+		}
+		size_type k = 1;
+		while (k < n && k <= mask_ && ring_[(pos + k) & mask_].sequence.load(std::memory_order_acquire) == pos + k + offset)
+		{
+			++k;
+		}
+		if (cursor.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+		{
+			n = k;
+			return pos;
+		}
+	}
+}
+
+
+
+template <typename T>
+typename lock_free_mpmc_ring_buffer<T>::size_type
+lock_free_mpmc_ring_buffer<T>::enforce_valid_size(size_type size)
+{
+	if (size == 0)
+	{
+		throw std::length_error("ring buffer capacitance cannot be zero");
+	}
+	if (size > (num::NumTraits<size_type>::max >> 2))
+	{
+		throw std::length_error("exceeded maximum ring buffer capacitance");
+	}
+	size_type capacity = 1;
+	while (capacity < size)
+	{
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+}
+
+}
+
+// EOF
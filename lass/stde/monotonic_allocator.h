@@ -0,0 +1,117 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+/** @class lass::stde::monotonic_allocator
+ *  @brief an STL allocator that allocates from a util::AllocatorMonotonic arena
+ *  @author Bram de Greve [Bramz]
+ *
+ *  Unlike lass_allocator, monotonic_allocator does not own its allocator but refers to an
+ *  external arena, so that all copies and rebinds share the same memory.  Two monotonic_allocators
+ *  compare equal if they refer to the same arena.
+ *
+ *  The arena must outlive all containers using it, and must not be reset or rewound past memory
+ *  still in use by a container.
+ *
+ *  @code
+ *  util::AllocatorMonotonic<> arena;
+ *  std::vector<int, stde::monotonic_allocator<int>> vec(arena);
+ *  stde::vector_map<int, float, std::less<int>, stde::monotonic_allocator< std::pair<int, float> > >
+ *      map(std::less<int>(), arena);
+ *  @endcode
+ */
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_STDE_MONOTONIC_ALLOCATOR_H
+#define LASS_GUARDIAN_OF_INCLUSION_STDE_MONOTONIC_ALLOCATOR_H
+
+#include "stde_common.h"
+#include "../util/allocator.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace lass
+{
+namespace stde
+{
+
+template <typename T, typename MonotonicAllocator = util::AllocatorMonotonic<> >
+class monotonic_allocator
+{
+public:
+	typedef T value_type;
+	typedef size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef MonotonicAllocator arena_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+	typedef std::false_type is_always_equal;
+	template <typename U> struct rebind { typedef monotonic_allocator<U, MonotonicAllocator> other; };
+
+	monotonic_allocator(arena_type& arena) noexcept;
+	template <typename U> monotonic_allocator(const monotonic_allocator<U, MonotonicAllocator>& other) noexcept;
+
+	T* allocate(size_type n);
+	void deallocate(T* p, size_type n) noexcept;
+	size_type max_size() const noexcept;
+
+	arena_type& arena() const noexcept;
+
+private:
+	arena_type* arena_;
+};
+
+template <typename T1, typename T2, typename MonotonicAllocator>
+bool operator==(const monotonic_allocator<T1, MonotonicAllocator>&, const monotonic_allocator<T2, MonotonicAllocator>&) noexcept;
+
+template <typename T1, typename T2, typename MonotonicAllocator>
+bool operator!=(const monotonic_allocator<T1, MonotonicAllocator>&, const monotonic_allocator<T2, MonotonicAllocator>&) noexcept;
+
+}
+
+}
+
+#include "monotonic_allocator.inl"
+
+#endif
+
+// EOF
@@ -0,0 +1,132 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+namespace lass
+{
+namespace stde
+{
+
+// --- public --------------------------------------------------------------------------------------
+
+template <typename T, typename MA>
+monotonic_allocator<T, MA>::monotonic_allocator(arena_type& arena) noexcept:
+	arena_(&arena)
+{
+}
+
+
+
+template <typename T, typename MA>
+template <typename U>
+monotonic_allocator<T, MA>::monotonic_allocator(const monotonic_allocator<U, MA>& other) noexcept:
+	arena_(&other.arena())
+{
+}
+
+
+
+template <typename T, typename MA>
+T* monotonic_allocator<T, MA>::allocate(size_type n)
+{
+	if (n > max_size())
+	{
+		throw std::bad_alloc();
+	}
+	void* p = arena_->allocate(n * sizeof(T), alignof(T));
+	if (!p)
+	{
+		throw std::bad_alloc();
+	}
+	return static_cast<T*>(p);
+}
+
+
+
+template <typename T, typename MA>
+void monotonic_allocator<T, MA>::deallocate(T* p, size_type n) noexcept
+{
+	arena_->deallocate(p, n * sizeof(T));
+}
+
+
+
+template <typename T, typename MA>
+typename monotonic_allocator<T, MA>::size_type
+monotonic_allocator<T, MA>::max_size() const noexcept
+{
+	return size_type(-1) / sizeof(T);
+}
+
+
+
+template <typename T, typename MA>
+typename monotonic_allocator<T, MA>::arena_type&
+monotonic_allocator<T, MA>::arena() const noexcept
+{
+	return *arena_;
+}
+
+
+
+// --- free functions ------------------------------------------------------------------------------
+
+template <typename T1, typename T2, typename MA>
+bool operator==(const monotonic_allocator<T1, MA>& a, const monotonic_allocator<T2, MA>& b) noexcept
+{
+	return &a.arena() == &b.arena();
+}
+
+
+
+template <typename T1, typename T2, typename MA>
+bool operator!=(const monotonic_allocator<T1, MA>& a, const monotonic_allocator<T2, MA>& b) noexcept
+{
+	return !(a == b);
+}
+
+
+
+}
+
+}
+
+// EOF
@@ -1070,6 +1070,274 @@ private:
 
 
 
+/** A variable-size bump-pointer allocator that releases everything at once
+ *	@ingroup Allocator
+ *	@arg concept: VariableAllocator
+ *	@arg thread UNSAFE.
+ *	@arg not copy-constructible, not assignable
+ *
+ *	AllocatorMonotonic carves allocations out of a chain of large blocks by simply bumping a
+ *	pointer.  deallocate() is a no-op, except when the memory is the last allocation made, then
+ *	it's given back to the arena.  Memory is released in bulk using reset() or rewind():
+ *
+ *	- reset() releases all allocations at once in O(1).  The blocks are kept for reuse.
+ *	- mark() returns a Marker of the current top of the arena, rewind(marker) releases
+ *	  everything allocated since that marker was taken, again in O(1).
+ *	- ScopedRewind rewinds the arena to its state at construction when it goes out of scope.
+ *
+ *	Blocks are only returned to @a VariableAllocator by purge() or when the arena is destroyed.
+ *	Allocations larger than @a requestedBlockSize get a block of their own.
+ *
+ *	Of course, no destructors are called on reset() or rewind().  Make sure any object living
+ *	in the arena is destroyed before (or doesn't need to be destroyed).
+ *
+ *	@code
+ *	util::AllocatorMonotonic<> arena;
+ *	for (const auto& query : queries)
+ *	{
+ *		util::AllocatorMonotonic<>::ScopedRewind rewind(arena);
+ *		std::vector<int, stde::monotonic_allocator<int>> result(arena);
+ *		...
+ *	}
+ *	@endcode
+ */
+template
+<
+	size_t requestedBlockSize = 65536,
+	typename VariableAllocator = AllocatorMalloc
+>
+class AllocatorMonotonic: public VariableAllocator
+{
+public:
+	static constexpr size_t alignment = VariableAllocator::alignment;
+
+	class Marker
+	{
+	public:
+		Marker(): block_(0), top_(0) {}
+	private:
+		friend class AllocatorMonotonic;
+		Marker(void* block, char* top): block_(block), top_(top) {}
+		void* block_;
+		char* top_;
+	};
+
+	class ScopedRewind
+	{
+	public:
+		explicit ScopedRewind(AllocatorMonotonic& allocator):
+			allocator_(allocator),
+			marker_(allocator.mark())
+		{
+		}
+		~ScopedRewind()
+		{
+			allocator_.rewind(marker_);
+		}
+		ScopedRewind(const ScopedRewind&) = delete;
+		ScopedRewind& operator=(const ScopedRewind&) = delete;
+	private:
+		AllocatorMonotonic& allocator_;
+		Marker marker_;
+	};
+
+	AllocatorMonotonic():
+		VariableAllocator(),
+		head_(0),
+		current_(0),
+		top_(0),
+		end_(0)
+	{
+	}
+	~AllocatorMonotonic()
+	{
+		while (head_)
+		{
+			Block* const block = head_;
+			head_ = block->next;
+			VariableAllocator::deallocate(block, block->size);
+		}
+	}
+
+	void* allocate(size_t size)
+	{
+		return allocate(size, alignment);
+	}
+	/** allocate @a size bytes aligned on an @a align boundary.  @a align must be a power of two.
+	 */
+	void* allocate(size_t size, size_t align)
+	{
+		LASS_ASSERT(align > 0 && (align & (align - 1)) == 0);
+		char* p = alignUp(top_, align);
+		if (!top_ || p > end_ || size > static_cast<size_t>(end_ - p))
+		{
+			if (!grow(size, align))
+			{
+				return 0;
+			}
+			p = alignUp(top_, align);
+		}
+		LASS_ASSERT(p + size <= end_);
+		top_ = p + size;
+		return p;
+	}
+	void deallocate(void* mem, size_t size)
+	{
+		// only the very last allocation can be given back.
+		char* const p = static_cast<char*>(mem);
+		if (p && p + size == top_)
+		{
+			top_ = p;
+		}
+	}
+	void deallocate(void*)
+	{
+	}
+
+	/** Returns marker to the current top of the arena, to rewind() to later.
+	 */
+	Marker mark() const
+	{
+		return Marker(current_, top_);
+	}
+	/** Releases all memory allocated since @a marker was taken.
+	 *	Markers taken after @a marker become invalid.
+	 */
+	void rewind(const Marker& marker)
+	{
+		if (!marker.block_)
+		{
+			reset();
+			return;
+		}
+		current_ = static_cast<Block*>(marker.block_);
+		top_ = marker.top_;
+		end_ = current_->end();
+	}
+	/** Releases all memory allocated from the arena.  The blocks are kept for reuse.
+	 *	All markers become invalid.
+	 */
+	void reset()
+	{
+		current_ = head_;
+		top_ = head_ ? head_->begin() : 0;
+		end_ = head_ ? head_->end() : 0;
+	}
+	/** Gives all blocks beyond the current one back to @a VariableAllocator.
+	 *	Markers taken beyond the current top become invalid.
+	 */
+	void purge()
+	{
+		if (!current_)
+		{
+			return;
+		}
+		Block* block = current_->next;
+		current_->next = 0;
+		while (block)
+		{
+			Block* const next = block->next;
+			VariableAllocator::deallocate(block, block->size);
+			block = next;
+		}
+	}
+	/** Total number of bytes in blocks acquired from @a VariableAllocator.
+	 */
+	size_t capacity() const
+	{
+		size_t result = 0;
+		for (const Block* block = head_; block; block = block->next)
+		{
+			result += block->size;
+		}
+		return result;
+	}
+
+	void swap(AllocatorMonotonic& other)
+	{
+		std::swap(head_, other.head_);
+		std::swap(current_, other.current_);
+		std::swap(top_, other.top_);
+		std::swap(end_, other.end_);
+	}
+
+private:
+
+	struct Block
+	{
+		Block* next;
+		size_t size;
+
+		char* begin()
+		{
+			return reinterpret_cast<char*>(this) + headerSize;
+		}
+		char* end()
+		{
+			return reinterpret_cast<char*>(this) + size;
+		}
+	};
+
+	static constexpr size_t headerSize = (sizeof(Block) + alignment - 1) / alignment * alignment;
+
+	static char* alignUp(char* p, size_t align)
+	{
+		const num::TuintPtr address = reinterpret_cast<num::TuintPtr>(p);
+		const num::TuintPtr aligned = (address + (align - 1)) & ~static_cast<num::TuintPtr>(align - 1);
+		return p + (aligned - address);
+	}
+
+	bool grow(size_t size, size_t align)
+	{
+		// worst case padding to reach alignment from the start of a block.
+		const size_t padding = align > alignment ? align - alignment : 0;
+		const size_t required = size + padding;
+
+		// try to reuse the blocks that are kept after a reset() or rewind()
+		if (current_ && current_->next && current_->next->size - headerSize >= required)
+		{
+			current_ = current_->next;
+			top_ = current_->begin();
+			end_ = current_->end();
+			return true;
+		}
+
+		const size_t blockSize = std::max(requestedBlockSize, headerSize + required);
+		void* mem = VariableAllocator::allocate(blockSize);
+		if (!mem)
+		{
+			return false;
+		}
+		Block* const block = static_cast<Block*>(mem);
+		block->size = blockSize;
+		if (current_)
+		{
+			// insert after current, so that any blocks still to be reused stay in the chain.
+			block->next = current_->next;
+			current_->next = block;
+		}
+		else
+		{
+			block->next = head_;
+			head_ = block;
+		}
+		current_ = block;
+		top_ = block->begin();
+		end_ = block->end();
+		return true;
+	}
+
+	AllocatorMonotonic(const AllocatorMonotonic&) = delete;
+	AllocatorMonotonic& operator=(const AllocatorMonotonic&) = delete;
+
+	Block* head_;
+	Block* current_;
+	char* top_;
+	char* end_;
+};
+
+
+
 /** @ingroup Allocator
  *	@arg concept: VariableAllocator
  *
@@ -0,0 +1,562 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "lass_common.h"
+#include "heap_profiler.h"
+#include "../stde/extended_string.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_WIN32
+#	include <windows.h>
+#else
+#	if LASS_HAVE_EXECINFO_H
+#		include <execinfo.h>
+#	endif
+#	if LASS_HAVE_DLOPEN
+#		include <dlfcn.h>
+#	endif
+#	if LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_GCC || LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_CLANG
+#		include <cxxabi.h>
+#		define LASS_HEAP_PROFILER_DEMANGLE 1
+#	endif
+#endif
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX
+#	include <fstream>
+#endif
+
+namespace lass
+{
+namespace util
+{
+
+namespace
+{
+
+/** Captures the return addresses of the caller's stack, skipping the @a skip innermost frames
+ *  (besides this function's own).
+ */
+LASS_NO_INLINE size_t captureStackTrace(const void** frames, size_t maxDepth, size_t skip)
+{
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_WIN32
+	const USHORT n = ::RtlCaptureStackBackTrace(static_cast<DWORD>(skip + 1), static_cast<DWORD>(maxDepth), const_cast<PVOID*>(frames), 0);
+	return static_cast<size_t>(n);
+#elif LASS_HAVE_EXECINFO_H
+	void* buffer[HeapProfiler::defaultMaxDepth * 4 + 8];
+	const size_t bufferSize = sizeof(buffer) / sizeof(buffer[0]);
+	const int n = ::backtrace(buffer, static_cast<int>(std::min(maxDepth + skip + 1, bufferSize)));
+	if (n <= static_cast<int>(skip + 1))
+	{
+		return 0;
+	}
+	const size_t depth = static_cast<size_t>(n) - (skip + 1);
+	std::copy(buffer + skip + 1, buffer + n, frames);
+	return depth;
+#else
+	return 0;
+#endif
+}
+
+std::string symbolName(const void* address)
+{
+#if LASS_HAVE_DLOPEN
+	Dl_info info;
+	if (::dladdr(const_cast<void*>(address), &info) && info.dli_sname)
+	{
+#	if LASS_HEAP_PROFILER_DEMANGLE
+		int status = 0;
+		char* demangled = abi::__cxa_demangle(info.dli_sname, 0, 0, &status);
+		if (demangled && status == 0)
+		{
+			std::string result(demangled);
+			::free(demangled);
+			return result;
+		}
+		::free(demangled);
+#	endif
+		return info.dli_sname;
+	}
+#endif
+	std::ostringstream buffer;
+	buffer << address;
+	return buffer.str();
+}
+
+std::string foldedName(const void* address)
+{
+	// ; and spaces have a meaning in the folded format.
+	std::string name = symbolName(address);
+	std::replace(name.begin(), name.end(), ';', ':');
+	std::replace(name.begin(), name.end(), '\n', ' ');
+	return name;
+}
+
+/** Xorshift32 generator for the sampling distance, we don't need anything fancy.
+ */
+num::Tuint32 nextRandom(num::Tuint32& seed)
+{
+	num::Tuint32 x = seed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	seed = x;
+	return x;
+}
+
+}
+
+
+
+class HeapProfiler::SiteRecord
+{
+public:
+	SiteRecord(const TStackTrace& stackTrace):
+		stackTrace(stackTrace),
+		liveCount(0),
+		liveBytes(0),
+		totalCount(0),
+		totalBytes(0)
+	{
+	}
+	const TStackTrace stackTrace;
+	std::atomic<size_t> liveCount;
+	std::atomic<size_t> liveBytes;
+	std::atomic<size_t> totalCount;
+	std::atomic<size_t> totalBytes;
+};
+
+
+
+class HeapProfiler::Impl
+{
+public:
+	typedef std::map<TStackTrace, std::unique_ptr<SiteRecord> > TSites;
+	typedef std::vector<std::unique_ptr<ThreadRecord> > TThreads;
+
+	Impl(const std::string& name): name(name) {}
+
+	const std::string name;
+	mutable std::mutex mutex;
+	TSites sites;
+	TThreads threads;
+};
+
+
+
+namespace
+{
+
+typedef std::vector<const HeapProfiler*> TProfilers;
+
+std::mutex& registryMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+TProfilers& registry()
+{
+	static TProfilers profilers;
+	return profilers;
+}
+
+num::Tuint64 nextId()
+{
+	static std::atomic<num::Tuint64> id(0);
+	return ++id;
+}
+
+}
+
+
+
+// --- public --------------------------------------------------------------------------------------
+
+HeapProfiler::HeapProfiler(const std::string& name, size_t sampleRate):
+	pimpl_(new Impl(name)),
+	id_(nextId()),
+	threadRecords_(),
+	sampleRate_(sampleRate),
+	maxDepth_(defaultMaxDepth),
+	liveBytes_(0),
+	peakBytes_(0)
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+	registry().push_back(this);
+}
+
+
+
+HeapProfiler::~HeapProfiler()
+{
+	{
+		std::lock_guard<std::mutex> lock(registryMutex());
+		TProfilers& profilers = registry();
+		profilers.erase(std::remove(profilers.begin(), profilers.end(), this), profilers.end());
+	}
+	delete pimpl_;
+}
+
+
+
+const std::string& HeapProfiler::name() const
+{
+	return pimpl_->name;
+}
+
+
+
+size_t HeapProfiler::sampleRate() const
+{
+	return sampleRate_.load(std::memory_order_relaxed);
+}
+
+
+
+/** Sets the average number of allocations per sample.  Zero disables sampling.
+ *	A new rate takes effect after the next sample of each thread.
+ */
+void HeapProfiler::setSampleRate(size_t sampleRate)
+{
+	sampleRate_.store(sampleRate, std::memory_order_relaxed);
+}
+
+
+
+size_t HeapProfiler::maxDepth() const
+{
+	return maxDepth_.load(std::memory_order_relaxed);
+}
+
+
+
+/** Sets the maximum number of stack frames recorded per sample, to a maximum of defaultMaxDepth * 4.
+ */
+void HeapProfiler::setMaxDepth(size_t maxDepth)
+{
+	maxDepth_.store(std::min(maxDepth, defaultMaxDepth * 4), std::memory_order_relaxed);
+}
+
+
+
+HeapProfiler::Snapshot HeapProfiler::snapshot() const
+{
+	Snapshot result;
+	result.name = pimpl_->name;
+	result.sampleRate = sampleRate();
+	result.allocations = 0;
+	result.deallocations = 0;
+
+	std::lock_guard<std::mutex> lock(pimpl_->mutex);
+
+	std::ptrdiff_t liveBytes = 0;
+	for (const auto& thread : pimpl_->threads)
+	{
+		ThreadStats stats;
+		stats.threadId = thread->threadId;
+		stats.allocations = thread->allocations.load(std::memory_order_relaxed);
+		stats.deallocations = thread->deallocations.load(std::memory_order_relaxed);
+		stats.liveBytes = thread->liveBytes.load(std::memory_order_relaxed);
+		stats.peakBytes = thread->peakBytes.load(std::memory_order_relaxed);
+		result.allocations += stats.allocations;
+		result.deallocations += stats.deallocations;
+		liveBytes += stats.liveBytes;
+		result.threads.push_back(stats);
+	}
+	result.liveBytes = static_cast<size_t>(std::max<std::ptrdiff_t>(liveBytes, 0));
+
+	// the shared peak lags behind by up to flushThreshold per thread, but it can't be lower than
+	// the peak of any thread.
+	std::ptrdiff_t peakBytes = std::max(liveBytes, peakBytes_.load(std::memory_order_relaxed));
+	for (const ThreadStats& stats : result.threads)
+	{
+		peakBytes = std::max(peakBytes, stats.peakBytes);
+	}
+	result.peakBytes = static_cast<size_t>(std::max<std::ptrdiff_t>(peakBytes, 0));
+
+	const size_t scale = std::max<size_t>(result.sampleRate, 1);
+	for (const auto& site : pimpl_->sites)
+	{
+		const SiteRecord& record = *site.second;
+		Site s;
+		s.stackTrace = record.stackTrace;
+		s.liveCount = record.liveCount.load(std::memory_order_relaxed) * scale;
+		s.liveBytes = record.liveBytes.load(std::memory_order_relaxed) * scale;
+		s.totalCount = record.totalCount.load(std::memory_order_relaxed) * scale;
+		s.totalBytes = record.totalBytes.load(std::memory_order_relaxed) * scale;
+		result.sites.push_back(s);
+	}
+	std::stable_sort(result.sites.begin(), result.sites.end(), [](const Site& a, const Site& b)
+	{
+		return a.liveBytes != b.liveBytes ? a.liveBytes > b.liveBytes : a.totalBytes > b.totalBytes;
+	});
+	return result;
+}
+
+
+
+/** Takes a snapshot of all HeapProfilers alive in this process.
+ */
+HeapProfiler::TSnapshots HeapProfiler::snapshotAll()
+{
+	TSnapshots result;
+	std::lock_guard<std::mutex> lock(registryMutex());
+	for (const HeapProfiler* profiler : registry())
+	{
+		result.push_back(profiler->snapshot());
+	}
+	return result;
+}
+
+
+
+/** Writes snapshot in the legacy pprof heap profile format, readable by `pprof` and `go tool pprof`.
+ *
+ *	Counts and bytes are already scaled by the sample rate, so the profile is written as
+ *	unsampled.  On Linux, the memory mappings of the process are appended so pprof can symbolize
+ *	the addresses.
+ */
+void HeapProfiler::Snapshot::writePprof(std::ostream& stream) const
+{
+	size_t liveCount = 0, liveTotal = 0, totalCount = 0, totalBytes = 0;
+	for (const Site& site : sites)
+	{
+		liveCount += site.liveCount;
+		liveTotal += site.liveBytes;
+		totalCount += site.totalCount;
+		totalBytes += site.totalBytes;
+	}
+	stream << "heap profile: " << liveCount << ": " << liveTotal 
+		<< " [" << totalCount << ": " << totalBytes << "] @ heapprofile\n";
+	for (const Site& site : sites)
+	{
+		stream << site.liveCount << ": " << site.liveBytes 
+			<< " [" << site.totalCount << ": " << site.totalBytes << "] @";
+		for (const void* address : site.stackTrace)
+		{
+			stream << " 0x" << std::hex << reinterpret_cast<num::TuintPtr>(address) << std::dec;
+		}
+		stream << "\n";
+	}
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX
+	std::ifstream maps("/proc/self/maps");
+	if (maps)
+	{
+		stream << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+	}
+#endif
+	stream.flush();
+}
+
+
+
+/** Writes snapshot in folded stack format, one line per call stack, outermost frame first.
+ *	@param liveBytes if true, the weight of each stack is the live bytes, otherwise the total
+ *		allocated bytes.
+ */
+void HeapProfiler::Snapshot::writeFolded(std::ostream& stream, bool liveBytes) const
+{
+	std::map<const void*, std::string> names;
+	for (const Site& site : sites)
+	{
+		const size_t weight = liveBytes ? site.liveBytes : site.totalBytes;
+		if (weight == 0 || site.stackTrace.empty())
+		{
+			continue;
+		}
+		for (auto frame = site.stackTrace.rbegin(); frame != site.stackTrace.rend(); ++frame)
+		{
+			auto name = names.find(*frame);
+			if (name == names.end())
+			{
+				name = names.emplace(*frame, foldedName(*frame)).first;
+			}
+			if (frame != site.stackTrace.rbegin())
+			{
+				stream << ";";
+			}
+			stream << name->second;
+		}
+		stream << " " << weight << "\n";
+	}
+	stream.flush();
+}
+
+
+
+/** Writes human readable summary of the snapshot, with the top @a maxSites call stacks.
+ */
+void HeapProfiler::Snapshot::writeSummary(std::ostream& stream, size_t maxSites) const
+{
+	stream << "heap profile '" << name << "' (1 in " << sampleRate << " sampled)\n";
+	stream << "  allocations: " << allocations << ", deallocations: " << deallocations 
+		<< ", live: " << liveBytes << " bytes, peak: " << peakBytes << " bytes\n";
+	for (const ThreadStats& thread : threads)
+	{
+		stream << "  thread " << thread.threadId << ": allocations: " << thread.allocations 
+			<< ", deallocations: " << thread.deallocations << ", live: " << thread.liveBytes 
+			<< " bytes, peak: " << thread.peakBytes << " bytes\n";
+	}
+	const size_t n = std::min(maxSites, sites.size());
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Site& site = sites[i];
+		stream << "  site #" << i << ": live: " << site.liveCount << " / " << site.liveBytes 
+			<< " bytes, total: " << site.totalCount << " / " << site.totalBytes << " bytes\n";
+		for (const void* address : site.stackTrace)
+		{
+			stream << "    " << symbolName(address) << "\n";
+		}
+	}
+	stream.flush();
+}
+
+
+
+// --- private -------------------------------------------------------------------------------------
+
+HeapProfiler::ThreadRecord& HeapProfiler::newThreadRecord()
+{
+	std::unique_ptr<ThreadRecord> thread(new ThreadRecord);
+	thread->threadId = std::this_thread::get_id();
+	thread->allocations = 0;
+	thread->deallocations = 0;
+	thread->liveBytes = 0;
+	thread->peakBytes = 0;
+	thread->pending = 0;
+	thread->seed = static_cast<num::Tuint32>(std::hash<std::thread::id>()(thread->threadId)) | 1;
+	thread->countdown = nextCountdown(*thread);
+
+	ThreadRecord* result = thread.get();
+	{
+		std::lock_guard<std::mutex> lock(pimpl_->mutex);
+		pimpl_->threads.push_back(std::move(thread));
+	}
+	threadRecords_.set(result);
+	return *result;
+}
+
+
+
+/** Draws the number of allocations until the next sample, uniformly in [1, 2 * sampleRate - 1].
+ */
+std::ptrdiff_t HeapProfiler::nextCountdown(ThreadRecord& thread) const
+{
+	const size_t rate = sampleRate();
+	if (rate == 0)
+	{
+		// not sampling, but check back once in a while if it's enabled again.
+		return std::ptrdiff_t(1) << 20;
+	}
+	if (rate == 1)
+	{
+		return 1;
+	}
+	return static_cast<std::ptrdiff_t>(1 + nextRandom(thread.seed) % (2 * rate - 1));
+}
+
+
+
+void HeapProfiler::flush(ThreadRecord& thread)
+{
+	const std::ptrdiff_t live = liveBytes_.fetch_add(thread.pending, std::memory_order_relaxed) + thread.pending;
+	thread.pending = 0;
+	std::ptrdiff_t peak = peakBytes_.load(std::memory_order_relaxed);
+	while (live > peak && !peakBytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+	{
+	}
+}
+
+
+
+LASS_NO_INLINE HeapProfiler::SiteRecord* HeapProfiler::sample(ThreadRecord& thread, size_t size)
+{
+	thread.countdown = nextCountdown(thread);
+	if (sampleRate() == 0)
+	{
+		return 0;
+	}
+
+	const void* frames[defaultMaxDepth * 4];
+	const size_t depth = captureStackTrace(frames, maxDepth(), 1); // skip sample(), allocated() is inlined in the caller.
+	TStackTrace stackTrace(frames, frames + depth);
+
+	SiteRecord* site = 0;
+	{
+		std::lock_guard<std::mutex> lock(pimpl_->mutex);
+		Impl::TSites::iterator i = pimpl_->sites.find(stackTrace);
+		if (i == pimpl_->sites.end())
+		{
+			std::unique_ptr<SiteRecord> record(new SiteRecord(stackTrace));
+			i = pimpl_->sites.emplace(std::move(stackTrace), std::move(record)).first;
+		}
+		site = i->second.get();
+	}
+	site->liveCount.fetch_add(1, std::memory_order_relaxed);
+	site->liveBytes.fetch_add(size, std::memory_order_relaxed);
+	site->totalCount.fetch_add(1, std::memory_order_relaxed);
+	site->totalBytes.fetch_add(size, std::memory_order_relaxed);
+	return site;
+}
+
+
+
+void HeapProfiler::unsample(SiteRecord* site, size_t size)
+{
+	site->liveCount.fetch_sub(1, std::memory_order_relaxed);
+	site->liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+
+
+}
+
+}
+
+// EOF
@@ -0,0 +1,329 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+/** @defgroup HeapProfiler
+ *  @brief Sampling heap profiler for the Allocator library
+ *  @ingroup Allocator
+ *
+ *	HeapProfiler keeps track of the memory allocated through an allocator, and records the call
+ *	stack of one in every N allocations.  It's cheap enough to leave enabled in production:
+ *
+ *	- All allocations are counted per thread, using thread-owned counters without atomic
+ *	  read-modify-write operations.  Per thread live bytes are the number of bytes allocated by
+ *	  that thread minus the number of bytes deallocated by that thread.
+ *	- Live bytes and peak of the whole allocator are tracked using a shared counter that is only
+ *	  updated after a thread has accumulated HeapProfiler::flushThreshold bytes, so the peak is
+ *	  accurate to within that many bytes per thread.
+ *	- Only one in @a sampleRate allocations captures its call stack.  The distance between two
+ *	  samples is randomized to avoid aliasing with periodic allocation patterns.
+ *
+ *	A Snapshot can be taken at any time, and be written in the legacy pprof heap profile format,
+ *	or in the folded stack format used by flamegraph.pl and speedscope.  The sampled counts and
+ *	bytes in the snapshot are scaled by the sample rate, so they estimate the real numbers.
+ *
+ *	Use AllocatorProfiled to put a HeapProfiler in an allocator stack:
+ *
+ *	@code
+ *	typedef util::AllocatorProfiled<util::AllocatorMalloc> TAllocator;
+ *	TAllocator allocator;
+ *	allocator.profiler().setSampleRate(1000);
+ *	...
+ *	std::ofstream stream("heap.prof");
+ *	allocator.profiler().snapshot().writePprof(stream);
+ *	@endcode
+ */
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_UTIL_HEAP_PROFILER_H
+#define LASS_GUARDIAN_OF_INCLUSION_UTIL_HEAP_PROFILER_H
+
+#include "util_common.h"
+#include "allocator.h"
+#include "thread.h"
+#include "non_copyable.h"
+
+#include <atomic>
+#include <thread>
+
+namespace lass
+{
+namespace util
+{
+
+/** Sampling heap profiler.
+ *	@ingroup HeapProfiler
+ *	@arg thread safe
+ */
+class LASS_DLL HeapProfiler: NonCopyable
+{
+public:
+
+	typedef std::vector<const void*> TStackTrace; /**< return addresses, innermost frame first */
+
+	/** Allocation statistics of a single thread.
+	 */
+	struct ThreadStats
+	{
+		std::thread::id threadId;
+		size_t allocations;
+		size_t deallocations;
+		std::ptrdiff_t liveBytes; /**< bytes allocated minus bytes deallocated by this thread. */
+		std::ptrdiff_t peakBytes;
+	};
+
+	/** Estimated allocations of a single call stack.
+	 */
+	struct Site
+	{
+		TStackTrace stackTrace;
+		size_t liveCount;
+		size_t liveBytes;
+		size_t totalCount;
+		size_t totalBytes;
+	};
+
+	/** State of a HeapProfiler at one moment in time.
+	 */
+	struct LASS_DLL Snapshot
+	{
+		std::string name;
+		size_t sampleRate;
+		size_t allocations;
+		size_t deallocations;
+		size_t liveBytes;
+		size_t peakBytes;
+		std::vector<ThreadStats> threads;
+		std::vector<Site> sites; /**< sorted by decreasing liveBytes */
+
+		void writePprof(std::ostream& stream) const;
+		void writeFolded(std::ostream& stream, bool liveBytes = true) const;
+		void writeSummary(std::ostream& stream, size_t maxSites = 10) const;
+	};
+
+	typedef std::vector<Snapshot> TSnapshots;
+
+	/** Opaque record of a call stack, stored in the header of sampled allocations. */
+	class SiteRecord;
+
+	static constexpr size_t defaultSampleRate = 1024;
+	static constexpr size_t defaultMaxDepth = 32;
+	static constexpr std::ptrdiff_t flushThreshold = 64 * 1024;
+
+	explicit HeapProfiler(const std::string& name = std::string(), size_t sampleRate = defaultSampleRate);
+	~HeapProfiler();
+
+	const std::string& name() const;
+
+	size_t sampleRate() const;
+	void setSampleRate(size_t sampleRate);
+	size_t maxDepth() const;
+	void setMaxDepth(size_t maxDepth);
+
+	Snapshot snapshot() const;
+	static TSnapshots snapshotAll();
+
+	/** Registers an allocation of @a size bytes.
+	 *	@return the site record if the allocation was sampled, null otherwise.  Must be passed to
+	 *		deallocated() when the memory is released.
+	 */
+	SiteRecord* allocated(size_t size)
+	{
+		ThreadRecord& thread = threadRecord();
+		thread.allocations.store(thread.allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		const std::ptrdiff_t live = thread.liveBytes.load(std::memory_order_relaxed) + static_cast<std::ptrdiff_t>(size);
+		thread.liveBytes.store(live, std::memory_order_relaxed);
+		if (live > thread.peakBytes.load(std::memory_order_relaxed))
+		{
+			thread.peakBytes.store(live, std::memory_order_relaxed);
+		}
+		thread.pending += static_cast<std::ptrdiff_t>(size);
+		if (thread.pending >= flushThreshold)
+		{
+			flush(thread);
+		}
+		if (--thread.countdown > 0)
+		{
+			return 0;
+		}
+		return sample(thread, size);
+	}
+
+	/** Registers a deallocation of @a size bytes, with the @a site returned by allocated().
+	 */
+	void deallocated(SiteRecord* site, size_t size)
+	{
+		ThreadRecord& thread = threadRecord();
+		thread.deallocations.store(thread.deallocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		thread.liveBytes.store(thread.liveBytes.load(std::memory_order_relaxed) - static_cast<std::ptrdiff_t>(size), std::memory_order_relaxed);
+		thread.pending -= static_cast<std::ptrdiff_t>(size);
+		if (thread.pending <= -flushThreshold)
+		{
+			flush(thread);
+		}
+		if (site)
+		{
+			unsample(site, size);
+		}
+	}
+
+private:
+
+	struct ThreadRecord
+	{
+		std::thread::id threadId;
+		std::atomic<size_t> allocations;
+		std::atomic<size_t> deallocations;
+		std::atomic<std::ptrdiff_t> liveBytes;
+		std::atomic<std::ptrdiff_t> peakBytes;
+		std::ptrdiff_t pending;
+		std::ptrdiff_t countdown;
+		num::Tuint32 seed;
+	};
+
+	ThreadRecord& threadRecord()
+	{
+		// one entry cache in front of the thread local storage, as most threads only use one
+		// profiled allocator at a time.
+		struct Cache
+		{
+			num::Tuint64 owner;
+			ThreadRecord* record;
+		};
+		static thread_local Cache cache = { 0, 0 };
+		if (cache.owner == id_)
+		{
+			return *cache.record;
+		}
+		ThreadRecord* record = static_cast<ThreadRecord*>(threadRecords_.get());
+		if (!record)
+		{
+			record = &newThreadRecord();
+		}
+		cache.owner = id_;
+		cache.record = record;
+		return *record;
+	}
+
+	ThreadRecord& newThreadRecord();
+	std::ptrdiff_t nextCountdown(ThreadRecord& thread) const;
+	void flush(ThreadRecord& thread);
+	SiteRecord* sample(ThreadRecord& thread, size_t size);
+	void unsample(SiteRecord* site, size_t size);
+
+	class Impl;
+	Impl* pimpl_;
+	num::Tuint64 id_; /**< unique for each HeapProfiler ever constructed, never zero */
+	ThreadLocalStorage threadRecords_;
+	std::atomic<size_t> sampleRate_;
+	std::atomic<size_t> maxDepth_;
+	std::atomic<std::ptrdiff_t> liveBytes_;
+	std::atomic<std::ptrdiff_t> peakBytes_;
+};
+
+
+
+/** Profiles the allocations of VariableAllocator with a HeapProfiler.
+ *	@ingroup HeapProfiler
+ *	@arg concept: VariableAllocator
+ *	@arg thread safe if VariableAllocator is.
+ *
+ *	AllocatorProfiled adds a header of VariableAllocator::alignment bytes in front of each
+ *	allocation, to remember whether it was sampled.
+ */
+template
+<
+	typename VariableAllocator = AllocatorMalloc
+>
+class AllocatorProfiled: public VariableAllocator
+{
+public:
+	static constexpr size_t alignment = VariableAllocator::alignment;
+
+	AllocatorProfiled():
+		VariableAllocator(),
+		profiler_(typeid(AllocatorProfiled).name())
+	{
+	}
+	void* allocate(size_t size)
+	{
+		char* p = static_cast<char*>(VariableAllocator::allocate(size + headerSize));
+		if (!p)
+		{
+			return 0;
+		}
+		*reinterpret_cast<HeapProfiler::SiteRecord**>(p) = profiler_.allocated(size);
+		return p + headerSize;
+	}
+	void deallocate(void* mem, size_t size)
+	{
+		if (!mem)
+		{
+			return;
+		}
+		char* p = static_cast<char*>(mem) - headerSize;
+		profiler_.deallocated(*reinterpret_cast<HeapProfiler::SiteRecord**>(p), size);
+		VariableAllocator::deallocate(p, size + headerSize);
+	}
+	HeapProfiler& profiler()
+	{
+		return profiler_;
+	}
+	const HeapProfiler& profiler() const
+	{
+		return profiler_;
+	}
+private:
+	static constexpr size_t headerSize = alignment > sizeof(void*) ? alignment : sizeof(void*);
+
+	AllocatorProfiled(const AllocatorProfiled&) = delete;
+	AllocatorProfiled& operator=(const AllocatorProfiled&) = delete;
+
+	HeapProfiler profiler_;
+};
+
+}
+
+}
+
+#endif
+
+// EOF
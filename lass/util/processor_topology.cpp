@@ -0,0 +1,491 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "lass_common.h"
+#include "processor_topology.h"
+#include "../stde/extended_string.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_WIN32
+#	include <windows.h>
+#elif LASS_HAVE_SCHED_H
+#	include <sched.h>
+#endif
+
+namespace lass
+{
+namespace util
+{
+
+namespace
+{
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX
+
+const std::string sysCpu = "/sys/devices/system/cpu/cpu";
+const std::string sysNode = "/sys/devices/system/node/";
+
+bool readLine(const std::string& path, std::string& line)
+{
+	std::ifstream file(path.c_str());
+	if (!file || !std::getline(file, line))
+	{
+		return false;
+	}
+	line = stde::strip(line);
+	return true;
+}
+
+bool readInt(const std::string& path, long& value)
+{
+	std::string line;
+	if (!readLine(path, line))
+	{
+		return false;
+	}
+	std::istringstream buffer(line);
+	return static_cast<bool>(buffer >> value);
+}
+
+/** Parses a cpu list like "0-3,8-11" in a TCpuSet of size @a n.
+ */
+bool readCpuList(const std::string& path, size_t n, TCpuSet& result)
+{
+	std::string line;
+	if (!readLine(path, line))
+	{
+		return false;
+	}
+	result.assign(n, false);
+	for (const std::string& range : stde::split(line, ","))
+	{
+		if (range.empty())
+		{
+			continue;
+		}
+		const std::vector<std::string> bounds = stde::split(range, "-", 1);
+		size_t first = 0, last = 0;
+		std::istringstream(bounds[0]) >> first;
+		if (bounds.size() > 1)
+		{
+			std::istringstream(bounds[1]) >> last;
+		}
+		else
+		{
+			last = first;
+		}
+		for (size_t i = first; i <= last && i < n; ++i)
+		{
+			result[i] = true;
+		}
+	}
+	return true;
+}
+
+/** Parses cache sizes like "48K".
+ */
+size_t parseSize(const std::string& text)
+{
+	std::istringstream buffer(text);
+	size_t size = 0;
+	buffer >> size;
+	char unit = 0;
+	if (buffer >> unit)
+	{
+		switch (unit)
+		{
+		case 'K': return size << 10;
+		case 'M': return size << 20;
+		case 'G': return size << 30;
+		default: break;
+		}
+	}
+	return size;
+}
+
+#endif
+
+size_t firstProcessor(const TCpuSet& cpuSet)
+{
+	const TCpuSet::const_iterator i = std::find(cpuSet.begin(), cpuSet.end(), true);
+	return static_cast<size_t>(i - cpuSet.begin());
+}
+
+}
+
+
+
+// --- public --------------------------------------------------------------------------------------
+
+const ProcessorTopology& ProcessorTopology::instance()
+{
+	static const ProcessorTopology topology;
+	return topology;
+}
+
+
+
+ProcessorTopology::ProcessorTopology()
+{
+	discover();
+	finish();
+}
+
+
+
+/** Return highest id of processor + 1, same as util::numberOfProcessors()
+ */
+size_t ProcessorTopology::numberOfProcessors() const
+{
+	return processors_.size();
+}
+
+
+
+size_t ProcessorTopology::numberOfPackages() const
+{
+	return packages_.size();
+}
+
+
+
+size_t ProcessorTopology::numberOfNodes() const
+{
+	return nodes_.size();
+}
+
+
+
+size_t ProcessorTopology::numberOfCores() const
+{
+	return cores_.size();
+}
+
+
+
+/** Index of package (or socket) of @a processor, in [0, numberOfPackages())
+ */
+size_t ProcessorTopology::package(size_t processor) const
+{
+	return processors_.at(processor).package;
+}
+
+
+
+/** Index of NUMA node of @a processor, in [0, numberOfNodes())
+ */
+size_t ProcessorTopology::node(size_t processor) const
+{
+	return processors_.at(processor).node;
+}
+
+
+
+/** Index of physical core of @a processor, in [0, numberOfCores())
+ */
+size_t ProcessorTopology::core(size_t processor) const
+{
+	return processors_.at(processor).core;
+}
+
+
+
+const TCpuSet& ProcessorTopology::packageProcessors(size_t package) const
+{
+	return packages_.at(package);
+}
+
+
+
+const TCpuSet& ProcessorTopology::nodeProcessors(size_t node) const
+{
+	return nodes_.at(node);
+}
+
+
+
+/** Set of processors sharing the same physical core as @a processor, @a processor included.
+ */
+const TCpuSet& ProcessorTopology::smtSiblings(size_t processor) const
+{
+	return cores_.at(core(processor));
+}
+
+
+
+/** All caches of the machine, each cache only once.  Sorted on level.
+ */
+const ProcessorTopology::TCaches& ProcessorTopology::caches() const
+{
+	return caches_;
+}
+
+
+
+/** Available processors, in the order you should bind threads to them.
+ *
+ *	First one processor of each physical core, then their SMT siblings.  Both groups are sorted
+ *	node by node, so that a range of consecutive threads shares the same node as much as possible.
+ */
+ProcessorTopology::TProcessors ProcessorTopology::placementOrder() const
+{
+	const TCpuSet available = availableProcessors();
+	TProcessors primaries;
+	TProcessors siblings;
+	for (size_t node = 0; node < nodes_.size(); ++node)
+	{
+		std::vector<bool> seenCore(cores_.size(), false);
+		for (size_t i = 0; i < processors_.size(); ++i)
+		{
+			if (processors_[i].node != node || i >= available.size() || !available[i])
+			{
+				continue;
+			}
+			const size_t c = processors_[i].core;
+			if (!seenCore[c])
+			{
+				seenCore[c] = true;
+				primaries.push_back(i);
+			}
+			else
+			{
+				siblings.push_back(i);
+			}
+		}
+	}
+	std::stable_sort(siblings.begin(), siblings.end(), [this](size_t a, size_t b)
+	{
+		return processors_[a].node < processors_[b].node;
+	});
+	primaries.insert(primaries.end(), siblings.begin(), siblings.end());
+	return primaries;
+}
+
+
+
+/** NUMA node of the processor the calling thread is currently running on.
+ */
+size_t ProcessorTopology::currentNode() const
+{
+	const size_t processor = currentProcessor();
+	return processor < processors_.size() ? processors_[processor].node : 0;
+}
+
+
+
+/** Processor the calling thread is currently running on.
+ *	Unless the thread is bound to a single processor, this is only a hint as the thread may 
+ *	migrate at any time.  Returns 0 if it cannot be determined.
+ */
+size_t ProcessorTopology::currentProcessor()
+{
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_WIN32
+	return static_cast<size_t>(::GetCurrentProcessorNumber());
+#elif LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX && LASS_HAVE_SCHED_H
+	const int cpu = ::sched_getcpu();
+	return cpu >= 0 ? static_cast<size_t>(cpu) : 0;
+#else
+	return 0;
+#endif
+}
+
+
+
+// --- private -------------------------------------------------------------------------------------
+
+void ProcessorTopology::discover()
+{
+	fallback();
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX
+	const size_t n = processors_.size();
+
+	// packages and cores
+	std::map<long, size_t> packageIds;
+	std::map<std::pair<size_t, size_t>, size_t> coreIds;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const std::string topology = sysCpu + util::stringCast<std::string>(i) + "/topology/";
+		long packageId = 0;
+		if (!readInt(topology + "physical_package_id", packageId))
+		{
+			continue; // offline processor
+		}
+		const size_t package = packageIds.emplace(packageId, packageIds.size()).first->second;
+		TCpuSet siblings;
+		if (!readCpuList(topology + "core_cpus_list", n, siblings) && !readCpuList(topology + "thread_siblings_list", n, siblings))
+		{
+			siblings.assign(n, false);
+			siblings[i] = true;
+		}
+		const std::pair<size_t, size_t> coreKey(package, firstProcessor(siblings));
+		processors_[i].package = package;
+		processors_[i].core = coreIds.emplace(coreKey, n + coreIds.size()).first->second;
+	}
+
+	// NUMA nodes
+	TCpuSet onlineNodes;
+	if (readCpuList(sysNode + "online", 4096, onlineNodes))
+	{
+		size_t node = 0;
+		for (size_t id = 0; id < onlineNodes.size(); ++id)
+		{
+			TCpuSet cpus;
+			if (!onlineNodes[id] || !readCpuList(sysNode + "node" + util::stringCast<std::string>(id) + "/cpulist", n, cpus))
+			{
+				continue;
+			}
+			if (std::find(cpus.begin(), cpus.end(), true) == cpus.end())
+			{
+				continue; // memory-only node
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (cpus[i])
+				{
+					processors_[i].node = node;
+				}
+			}
+			++node;
+		}
+	}
+
+	// caches
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t index = 0; ; ++index)
+		{
+			const std::string cache = sysCpu + util::stringCast<std::string>(i) + "/cache/index" + util::stringCast<std::string>(index) + "/";
+			long level = 0;
+			if (!readInt(cache + "level", level))
+			{
+				break;
+			}
+			CacheInfo info;
+			info.level = static_cast<size_t>(level);
+			std::string text;
+			info.type = CacheInfo::ctUnified;
+			if (readLine(cache + "type", text))
+			{
+				if (text == "Data") info.type = CacheInfo::ctData;
+				if (text == "Instruction") info.type = CacheInfo::ctInstruction;
+			}
+			info.size = readLine(cache + "size", text) ? parseSize(text) : 0;
+			long lineSize = 0;
+			info.lineSize = readInt(cache + "coherency_line_size", lineSize) ? static_cast<size_t>(lineSize) : 0;
+			if (!readCpuList(cache + "shared_cpu_list", n, info.processors))
+			{
+				info.processors.assign(n, false);
+				info.processors[i] = true;
+			}
+			const bool known = std::any_of(caches_.begin(), caches_.end(), [&info](const CacheInfo& other)
+			{
+				return other.level == info.level && other.type == info.type && other.processors == info.processors;
+			});
+			if (!known)
+			{
+				caches_.push_back(info);
+			}
+		}
+	}
+	std::stable_sort(caches_.begin(), caches_.end(), [](const CacheInfo& a, const CacheInfo& b)
+	{
+		return a.level < b.level;
+	});
+#endif
+}
+
+
+
+/** Assume one package, one node, and a core per processor
+ */
+void ProcessorTopology::fallback()
+{
+	const size_t n = util::numberOfProcessors();
+	processors_.resize(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		processors_[i].package = 0;
+		processors_[i].node = 0;
+		processors_[i].core = i;
+	}
+	caches_.clear();
+}
+
+
+
+/** Make the core indices dense, and build the processor sets.
+ */
+void ProcessorTopology::finish()
+{
+	const size_t n = processors_.size();
+	std::map<size_t, size_t> coreIndices;
+	size_t numPackages = 0, numNodes = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		Processor& p = processors_[i];
+		p.core = coreIndices.emplace(p.core, coreIndices.size()).first->second;
+		numPackages = std::max(numPackages, p.package + 1);
+		numNodes = std::max(numNodes, p.node + 1);
+	}
+	packages_.assign(numPackages, TCpuSet(n, false));
+	nodes_.assign(numNodes, TCpuSet(n, false));
+	cores_.assign(coreIndices.size(), TCpuSet(n, false));
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Processor& p = processors_[i];
+		packages_[p.package][i] = true;
+		nodes_[p.node][i] = true;
+		cores_[p.core][i] = true;
+	}
+}
+
+}
+
+}
+
+// EOF
@@ -0,0 +1,241 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#ifndef LASS_GUARDIAN_OF_INCLUSION_UTIL_PROCESSOR_TOPOLOGY_H
+#define LASS_GUARDIAN_OF_INCLUSION_UTIL_PROCESSOR_TOPOLOGY_H
+
+#include "util_common.h"
+#include "thread.h"
+#include "allocator.h"
+#include "atomic.h"
+#include "non_copyable.h"
+
+#include <algorithm>
+
+namespace lass
+{
+namespace util
+{
+
+/** Cache that is shared by one or more processors.
+ *  @ingroup Threading
+ *  @sa ProcessorTopology
+ */
+struct CacheInfo
+{
+	enum Type
+	{
+		ctUnified,
+		ctData,
+		ctInstruction,
+	};
+
+	size_t level;
+	Type type;
+	size_t size; /**< in bytes */
+	size_t lineSize; /**< in bytes */
+	TCpuSet processors; /**< processors sharing this cache */
+};
+
+/** How the processors of this machine are organised in packages (sockets), NUMA nodes,
+ *  cores and SMT threads, and which caches they share.
+ *  @ingroup Threading
+ *
+ *	All processors are identified by the same flat index used by Thread::bind and
+ *	availableProcessors().  Packages, nodes and cores get a dense index starting from zero,
+ *	independent of the ids the operating system uses.
+ *
+ *	On Linux, the topology is discovered from sysfs (/sys/devices/system/cpu and
+ *	/sys/devices/system/node).  On other platforms, or if sysfs is not available, each
+ *	processor is assumed to be a core of its own, all in one package and one node.
+ *
+ *	Use ProcessorTopology::instance() to get the topology of this machine, it's discovered only
+ *	once.
+ */
+class LASS_DLL ProcessorTopology
+{
+public:
+
+	typedef std::vector<size_t> TProcessors;
+	typedef std::vector<CacheInfo> TCaches;
+
+	static const ProcessorTopology& instance();
+
+	ProcessorTopology();
+
+	size_t numberOfProcessors() const;
+	size_t numberOfPackages() const;
+	size_t numberOfNodes() const;
+	size_t numberOfCores() const;
+
+	size_t package(size_t processor) const;
+	size_t node(size_t processor) const;
+	size_t core(size_t processor) const;
+
+	const TCpuSet& packageProcessors(size_t package) const;
+	const TCpuSet& nodeProcessors(size_t node) const;
+	const TCpuSet& smtSiblings(size_t processor) const;
+	const TCaches& caches() const;
+
+	TProcessors placementOrder() const;
+
+	size_t currentNode() const;
+
+	static size_t currentProcessor();
+
+private:
+
+	struct Processor
+	{
+		size_t package;
+		size_t node;
+		size_t core;
+	};
+	typedef std::vector<Processor> TProcessorInfos;
+	typedef std::vector<TCpuSet> TCpuSets;
+
+	void discover();
+	void fallback();
+	void finish();
+
+	TProcessorInfos processors_;
+	TCpuSets packages_;
+	TCpuSets nodes_;
+	TCpuSets cores_;
+	TCaches caches_;
+};
+
+
+
+/** Keeps a separate allocator per NUMA node, and allocates from the node of the calling thread.
+ *  @ingroup Allocator
+ *	@arg concept: VariableAllocator
+ *	@arg requirements: VariableAllocator must be thread safe.
+ *
+ *	Operating systems usually place a page of memory on the node of the thread that first touches
+ *	it.  That's fine until the memory is freed and recycled by another thread on another node.
+ *	AllocatorPerNode avoids that by giving each node its own VariableAllocator, and by returning
+ *	each block to the allocator of the node it was allocated on, whatever thread deallocates it.
+ *	Put it on top of a pooling allocator like AllocatorConcurrentFreeList to keep recycled
+ *	blocks on their node; on top of AllocatorMalloc it only adds bookkeeping.
+ *
+ *	AllocatorPerNode adds a header of VariableAllocator::alignment bytes (at least sizeof(size_t))
+ *	in front of each block to remember its node.
+ *
+ *	@code
+ *	typedef util::AllocatorPerNode<util::AllocatorBinned<util::AllocatorConcurrentFreeList<> > > TAllocator;
+ *	@endcode
+ */
+template
+<
+	typename VariableAllocator = AllocatorMalloc
+>
+class AllocatorPerNode: NonCopyable
+{
+public:
+	static constexpr size_t alignment = VariableAllocator::alignment;
+
+	AllocatorPerNode():
+		nodes_(0),
+		numberOfNodes_(std::max<size_t>(ProcessorTopology::instance().numberOfNodes(), 1))
+	{
+		nodes_ = new Node[numberOfNodes_];
+	}
+	~AllocatorPerNode()
+	{
+		delete [] nodes_;
+	}
+	void* allocate(size_t size)
+	{
+		return allocate(size, ProcessorTopology::instance().currentNode());
+	}
+	void* allocate(size_t size, size_t node)
+	{
+		if (node >= numberOfNodes_)
+		{
+			node = 0;
+		}
+		char* p = static_cast<char*>(nodes_[node].allocator.allocate(size + headerSize));
+		if (!p)
+		{
+			return 0;
+		}
+		*reinterpret_cast<size_t*>(p) = node;
+		return p + headerSize;
+	}
+	void deallocate(void* mem, size_t size)
+	{
+		char* p = static_cast<char*>(mem) - headerSize;
+		const size_t node = *reinterpret_cast<size_t*>(p);
+		LASS_ASSERT(node < numberOfNodes_);
+		nodes_[node].allocator.deallocate(p, size + headerSize);
+	}
+	size_t numberOfNodes() const
+	{
+		return numberOfNodes_;
+	}
+	/** Node @a mem was allocated on
+	 */
+	static size_t node(const void* mem)
+	{
+		return *reinterpret_cast<const size_t*>(static_cast<const char*>(mem) - headerSize);
+	}
+private:
+	struct alignas(LASS_LOCK_FREE_ALIGNMENT) Node
+	{
+		VariableAllocator allocator;
+	};
+
+	static constexpr size_t headerSize = (sizeof(size_t) + alignment - 1) / alignment * alignment;
+
+	Node* nodes_;
+	size_t numberOfNodes_;
+};
+
+}
+
+}
+
+#endif
+
+// EOF
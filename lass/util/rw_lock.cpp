@@ -43,6 +43,17 @@
 #include "lass_common.h"
 #include "rw_lock.h"	
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#if LASS_PLATFORM_TYPE == LASS_PLATFORM_TYPE_LINUX && LASS_HAVE_SYS_SYSCALL_H && LASS_HAVE_UNISTD_H
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#	define LASS_RW_LOCK_HAVE_FUTEX 1
+#endif
+
 namespace lass
 {
 namespace util
@@ -146,5 +157,262 @@ LockResult RWLock::tryLockw()
 	}
 }
 
+
+// --- DistributedRWLock ---------------------------------------------------------------------------
+
+namespace
+{
+
+constexpr int maxSpinBackoff = 1024;
+constexpr int maxSpinRounds = 16;
+
+/** Park current thread as long as @a word equals @a expected, or until woken.
+ *  May return spuriously.
+ */
+void futexWait(std::atomic<int>& word, int expected)
+{
+#if LASS_RW_LOCK_HAVE_FUTEX
+	::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+	if (word.load(std::memory_order_relaxed) == expected)
+	{
+		std::this_thread::yield();
+	}
+#endif
+}
+
+/** Wake all threads parked on @a word
+ */
+void futexWakeAll(std::atomic<int>& word)
+{
+#if LASS_RW_LOCK_HAVE_FUTEX
+	::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#else
+	(void) word;
+#endif
+}
+
+/** Spin with exponential backoff as long as pred() is true, for a limited amount of rounds.
+ *  @return true if pred() became false.
+ */
+template <typename Pred>
+bool spinWhile(Pred pred)
+{
+	int backoff = 1;
+	for (int round = 0; round < maxSpinRounds; ++round)
+	{
+		if (!pred())
+		{
+			return true;
+		}
+		for (int i = 0; i < backoff; ++i)
+		{
+			LASS_SPIN_PAUSE;
+		}
+		backoff = std::min(2 * backoff, maxSpinBackoff);
+	}
+	return !pred();
+}
+
+size_t threadIndex()
+{
+	static std::atomic<size_t> nextIndex(0);
+	thread_local const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+	return index;
+}
+
+}
+
+
+
+DistributedRWLock::DistributedRWLock():
+	slots_(0),
+	numSlots_(1),
+	writer_(wsUnlocked)
+{
+	const size_t n = std::max<size_t>(numberOfProcessors(), 1);
+	while (numSlots_ < n)
+	{
+		numSlots_ *= 2;
+	}
+	slots_ = new Slot[numSlots_];
+	for (size_t i = 0; i < numSlots_; ++i)
+	{
+		slots_[i].readers.store(0, std::memory_order_relaxed);
+	}
+}
+
+DistributedRWLock::~DistributedRWLock()
+{
+	LASS_ASSERT(writer_.load(std::memory_order_relaxed) == wsUnlocked);
+#if !defined(NDEBUG)
+	for (size_t i = 0; i < numSlots_; ++i)
+	{
+		LASS_ASSERT(slots_[i].readers.load(std::memory_order_relaxed) == 0);
+	}
+#endif
+	delete [] slots_;
+}
+
+void DistributedRWLock::lockr()
+{
+	Slot& s = slot();
+	while (true)
+	{
+		if (writer_.load(std::memory_order_seq_cst) == wsUnlocked)
+		{
+			s.readers.fetch_add(1, std::memory_order_seq_cst);
+			if (writer_.load(std::memory_order_seq_cst) == wsUnlocked)
+			{
+				return;
+			}
+			// a writer came in between, give it preference.
+			if (s.readers.fetch_sub(1, std::memory_order_seq_cst) == 1)
+			{
+				futexWakeAll(s.readers);
+			}
+		}
+		waitForWriter();
+	}
+}
+
+void DistributedRWLock::unlockr()
+{
+	Slot& s = slot();
+	const int oldReaders = s.readers.fetch_sub(1, std::memory_order_seq_cst);
+	LASS_ASSERT(oldReaders > 0);
+	if (oldReaders == 1 && writer_.load(std::memory_order_seq_cst) != wsUnlocked)
+	{
+		futexWakeAll(s.readers); // writer may be waiting for this slot to drain.
+	}
+}
+
+LockResult DistributedRWLock::tryLockr()
+{
+	if (writer_.load(std::memory_order_seq_cst) != wsUnlocked)
+	{
+		return lockBusy;
+	}
+	Slot& s = slot();
+	s.readers.fetch_add(1, std::memory_order_seq_cst);
+	if (writer_.load(std::memory_order_seq_cst) == wsUnlocked)
+	{
+		return lockSuccess;
+	}
+	if (s.readers.fetch_sub(1, std::memory_order_seq_cst) == 1)
+	{
+		futexWakeAll(s.readers);
+	}
+	return lockBusy;
+}
+
+void DistributedRWLock::lockw()
+{
+	lockWriter();
+	drainReaders();
+}
+
+void DistributedRWLock::unlockw()
+{
+	unlockWriter();
+}
+
+LockResult DistributedRWLock::tryLockw()
+{
+	int expected = wsUnlocked;
+	if (!writer_.compare_exchange_strong(expected, wsLocked, std::memory_order_seq_cst))
+	{
+		return lockBusy;
+	}
+	for (size_t i = 0; i < numSlots_; ++i)
+	{
+		if (slots_[i].readers.load(std::memory_order_seq_cst) != 0)
+		{
+			unlockWriter();
+			return lockBusy;
+		}
+	}
+	return lockSuccess;
+}
+
+DistributedRWLock::Slot& DistributedRWLock::slot()
+{
+	return slots_[threadIndex() & (numSlots_ - 1)];
+}
+
+/** Acquire the writer word, as in U. Drepper, "Futexes Are Tricky", mutex #3.
+ */
+void DistributedRWLock::lockWriter()
+{
+	int state = wsUnlocked;
+	if (writer_.compare_exchange_strong(state, wsLocked, std::memory_order_seq_cst))
+	{
+		return;
+	}
+	spinWhile([this]() { return writer_.load(std::memory_order_relaxed) != wsUnlocked; });
+	state = wsUnlocked;
+	if (writer_.compare_exchange_strong(state, wsLocked, std::memory_order_seq_cst))
+	{
+		return;
+	}
+	if (state != wsContended)
+	{
+		state = writer_.exchange(wsContended, std::memory_order_seq_cst);
+	}
+	while (state != wsUnlocked)
+	{
+		futexWait(writer_, wsContended);
+		state = writer_.exchange(wsContended, std::memory_order_seq_cst);
+	}
+}
+
+void DistributedRWLock::unlockWriter()
+{
+	if (writer_.exchange(wsUnlocked, std::memory_order_seq_cst) == wsContended)
+	{
+		futexWakeAll(writer_);
+	}
+}
+
+/** Wait until there's no writer anymore, parking if it takes too long.
+ */
+void DistributedRWLock::waitForWriter()
+{
+	if (spinWhile([this]() { return writer_.load(std::memory_order_relaxed) != wsUnlocked; }))
+	{
+		return;
+	}
+	int state = writer_.load(std::memory_order_relaxed);
+	while (state != wsUnlocked)
+	{
+		// tell the writer someone's parked, so it will wake us on unlockw.
+		if (state == wsContended || writer_.compare_exchange_weak(state, wsContended, std::memory_order_seq_cst))
+		{
+			futexWait(writer_, wsContended);
+		}
+		state = writer_.load(std::memory_order_relaxed);
+	}
+}
+
+/** Wait until all reader slots have drained, with writer_ already acquired.
+ */
+void DistributedRWLock::drainReaders()
+{
+	for (size_t i = 0; i < numSlots_; ++i)
+	{
+		std::atomic<int>& readers = slots_[i].readers;
+		if (spinWhile([&readers]() { return readers.load(std::memory_order_seq_cst) != 0; }))
+		{
+			continue;
+		}
+		int n = readers.load(std::memory_order_seq_cst);
+		while (n != 0)
+		{
+			futexWait(readers, n);
+			n = readers.load(std::memory_order_seq_cst);
+		}
+	}
+}
+
 } //namespace util
 } //namespace lass
@@ -91,6 +91,69 @@ private:
 	std::atomic<int> writersTrying_;		/**< the number of writers trying to enter */
 };
 
+
+/** Reader-writer lock with distributed reader counters, for read-mostly data.
+*   @ingroup Threading
+*
+*	RWLock makes every reader compare-and-swap the same atomic counter, so readers contend on a
+*	single cache line even though they don't exclude each other.  DistributedRWLock gives each
+*	thread one of a number of reader slots, each on its own cache line.  lockr() and unlockr()
+*	only touch the thread's own slot, unless a writer is around.  The number of slots is the
+*	number of processors rounded up to a power of two.
+*
+*	Writers have preference: as soon as a writer is trying to enter, new readers back off.  The
+*	writer then waits until all slots have drained.  Writers exclude each other using a single
+*	lock word.
+*
+*	Threads that have to wait spin with exponential backoff for a while.  After that they are
+*	parked on a futex on Linux, or yield on other platforms, so that a long write lock does not
+*	burn CPU time.
+*
+*	@warning unlockr() must be called from the same thread as lockr().
+*	@warning DistributedRWLock is not recursive.  Trying to lockr() while holding a write lock
+*		in the same thread, will deadlock.
+*/
+class LASS_DLL DistributedRWLock : NonCopyable
+{
+public:
+	DistributedRWLock();
+	~DistributedRWLock();
+
+	void lockr();
+	void lockw();
+	void unlockr();
+	void unlockw();
+
+	LockResult tryLockr();
+	LockResult tryLockw();
+
+	size_t numberOfSlots() const { return numSlots_; }
+
+private:
+
+	struct alignas(LASS_LOCK_FREE_ALIGNMENT) Slot
+	{
+		std::atomic<int> readers;
+	};
+
+	enum WriterState
+	{
+		wsUnlocked = 0,
+		wsLocked = 1,
+		wsContended = 2, /**< locked, and some threads may be parked waiting for the writer. */
+	};
+
+	Slot& slot();
+	void lockWriter();
+	void unlockWriter();
+	void waitForWriter();
+	void drainReaders();
+
+	Slot* slots_;
+	size_t numSlots_;
+	alignas(LASS_LOCK_FREE_ALIGNMENT) std::atomic<int> writer_;
+};
+
 } //namespace util
 } //namespace lass
 
@@ -91,6 +91,18 @@
  *  @arg numberOfThreads: autoNumberOfThreads
  *  @arg maxNumberOfTasksInQueue: <A LIMITED NUMBER> to avoid an excessive queue size
  *
+ *  @section NUMA
+ *
+ *  Consumer threads are bound to processors in ProcessorTopology::placementOrder(): first one
+ *  thread per physical core, node by node, and only then the SMT siblings.  Each NUMA node has its
+ *  own task queue.  addTask() distributes tasks over the queues in proportion to the number of
+ *  threads on each node, or you can pick the node yourself with addTask(task, node), for example
+ *  to run the task close to its data.  Consumer threads first serve the queue of their own node,
+ *  and only steal from other nodes when it is empty.
+ *
+ *  If maximumNumberOfTasksInQueue is limited, the queues are bounded lock_free_mpmc_ring_buffer
+ *  instances, so that adding a task doesn't need to allocate a queue node.
+ *
  *  @section Policies
  *
  *  @subsection IdlePolicy
@@ -127,11 +139,15 @@
 
 #include "util_common.h"
 #include "thread.h"
+#include "processor_topology.h"
 #include "callback_0.h"
 #include "../stde/lock_free_queue.h"
+#include "../stde/lock_free_mpmc_ring_buffer.h"
 #include "future.h"
+#include <atomic>
 #include <cstring>
 #include <mutex>
+#include <new>
 
 namespace lass
 {
@@ -273,13 +289,33 @@ public:
 	~ThreadPool();
 
 	void addTask(typename util::CallTraits<TTask>::TParam task);
+	void addTask(typename util::CallTraits<TTask>::TParam task, size_t node);
 	void completeAllTasks();
 	void clearQueue();
 	size_t numberOfThreads() const;
+	size_t numberOfNodes() const;
 
 private:
 
 	typedef stde::lock_free_queue<TTask> TTaskQueue;
+	typedef stde::lock_free_mpmc_ring_buffer<TTask> TTaskRing;
+
+	/** One task queue per NUMA node, unbounded or a ring buffer of @a capacity.
+	 */
+	class TaskQueues: NonCopyable
+	{
+	public:
+		TaskQueues(size_t numberOfNodes, size_t capacity);
+		~TaskQueues();
+		void push(size_t node, typename util::CallTraits<TTask>::TParam task);
+		bool pop(size_t preferredNode, TTask& task);
+		bool pop(TTask& task);
+		size_t numberOfNodes() const;
+	private:
+		TTaskQueue* queues_;
+		TTaskRing* rings_;
+		size_t numberOfNodes_;
+	};
 
 	friend class ConsumerThread;
 
@@ -287,18 +323,25 @@ private:
 	{
 	public:
 		ConsumerThread(const TConsumer& consumer, TSelf& pool, const char* name);
-		size_t bindToNextAvailable(size_t processor);
+		size_t bindToNextAvailable(size_t index);
+		size_t node() const;
+		void release();
 	private:
 		void doRun() override;
 		TConsumer consumer_;
 		TSelf& pool_;
+		size_t node_;
+		std::atomic<bool> isReleased_;
 	};
 
 	void startThreads(const TConsumer& consumerPrototype, const char* name);
 	void stopThreads(size_t numAllocatedThreads);
 	void rethrowError();
 
-	TTaskQueue waitingTasks_;
+	TaskQueues waitingTasks_;
+	ProcessorTopology::TProcessors placement_;
+	std::vector<size_t> threadNodes_;
+	size_t nextThreadNode_;
 	std::exception_ptr error_;
 	std::mutex errorMutex_;
 	ConsumerThread* threads_;
@@ -68,6 +68,9 @@ ThreadPool<T, C, IP, PP>::ThreadPool(
 		const TConsumer& consumerPrototype,
 		const char* name):
 	TParticipationPolicy(consumerPrototype),
+	waitingTasks_(ProcessorTopology::instance().numberOfNodes(), maximumNumberOfTasksInQueue),
+	placement_(ProcessorTopology::instance().placementOrder()),
+	nextThreadNode_(0),
 	error_(nullptr),
 	threads_(0),
 	numThreads_(numberOfThreads == autoNumberOfThreads ? numberOfProcessors() : numberOfThreads),
@@ -99,17 +102,38 @@ ThreadPool<T, C, IP, PP>::~ThreadPool()
 /** submit a task to the pool, and block if queue is full.
  *  Function waits until tasks can be added to queue without participating as producer 
  *  	(in case of SelfParticipating).
+ *  Tasks are spread over the queues of the NUMA nodes, in proportion to the number of threads
+ *  	on each node.
  */
 template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
 void ThreadPool<T, C, IP, PP>::addTask(typename util::CallTraits<TTask>::TParam task)
 {
+	size_t node = 0;
+	if (!threadNodes_.empty())
+	{
+		node = threadNodes_[nextThreadNode_];
+		nextThreadNode_ = (nextThreadNode_ + 1) % threadNodes_.size();
+	}
+	addTask(task, node);
+}
+
+
+
+/** submit a task to the queue of NUMA node @a node, and block if queue is full.
+ *  The task will preferably be executed by a thread on that node, but idle threads of other
+ *  	nodes may steal it.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+void ThreadPool<T, C, IP, PP>::addTask(typename util::CallTraits<TTask>::TParam task, size_t node)
+{
+	LASS_ENFORCE_INDEX(node, waitingTasks_.numberOfNodes());
 	while (true)
 	{
 		if (maxWaitingTasks_ == unlimitedNumberOfTasks || numWaitingTasks_ < maxWaitingTasks_)
 		{
 			// because a single producer is assumed, we're certain we can push the task now
 			++numWaitingTasks_;
-			waitingTasks_.push(task);
+			waitingTasks_.push(node, task);
 			this->wakeConsumer();
 			return;
 		}
@@ -162,6 +186,16 @@ size_t ThreadPool<T, C, IP, PP>::numberOfThreads() const
 
 
 
+/** Number of NUMA nodes, and of task queues.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+size_t ThreadPool<T, C, IP, PP>::numberOfNodes() const
+{
+	return waitingTasks_.numberOfNodes();
+}
+
+
+
 // --- private -------------------------------------------------------------------------------------
 
 /** Allocate a bunch of threads and run them.
@@ -197,8 +231,16 @@ void ThreadPool<T, C, IP, PP>::startThreads(const TConsumer& consumerPrototype,
 		throw std::bad_alloc();
 	}
 
+	if (placement_.empty())
+	{
+		for (size_t k = 0, n = numberOfProcessors(); k < n; ++k)
+		{
+			placement_.push_back(k);
+		}
+	}
+
 	size_t i;
-	size_t nextProcessor = numThreads_ - dynThreads; // bind dynamic threads to "upper bits"
+	size_t nextProcessor = numThreads_ - dynThreads; // leave first processor in placement order to control thread
 	try
 	{
 		for (i = 0; i < dynThreads; ++i)
@@ -216,13 +258,26 @@ void ThreadPool<T, C, IP, PP>::startThreads(const TConsumer& consumerPrototype,
 			try
 			{
 				threads_[i].run();
-				nextProcessor = threads_[i].bindToNextAvailable(nextProcessor);
 			}
 			catch (...)
 			{
 				threads_[i].~ConsumerThread();
 				throw;
 			}
+			// the thread is running now and must be joined, even if binding fails.
+			// It only starts consuming when released, after its node is known.
+			try
+			{
+				nextProcessor = threads_[i].bindToNextAvailable(nextProcessor);
+				threadNodes_.push_back(threads_[i].node());
+			}
+			catch (...)
+			{
+				threads_[i].release();
+				++i;
+				throw;
+			}
+			threads_[i].release();
 		}
 	}
 	catch (...)
@@ -278,6 +333,118 @@ void ThreadPool<T, C, IP, PP>::rethrowError()
 
 
 
+// --- TaskQueues ----------------------------------------------------------------------------------
+
+/** Each ring buffer gets the full @a capacity, as all tasks may end up in the queue of one node.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+ThreadPool<T, C, IP, PP>::TaskQueues::TaskQueues(size_t numberOfNodes, size_t capacity):
+	queues_(0),
+	rings_(0),
+	numberOfNodes_(std::max<size_t>(numberOfNodes, 1))
+{
+	if (capacity == unlimitedNumberOfTasks)
+	{
+		queues_ = new TTaskQueue[numberOfNodes_];
+		return;
+	}
+	// the rings are over-aligned to keep head and tail on their own cache lines, malloc won't do.
+	rings_ = static_cast<TTaskRing*>(::operator new(numberOfNodes_ * sizeof(TTaskRing), std::align_val_t(alignof(TTaskRing))));
+	size_t i = 0;
+	try
+	{
+		for (; i < numberOfNodes_; ++i)
+		{
+			new (&rings_[i]) TTaskRing(capacity);
+		}
+	}
+	catch (...)
+	{
+		while (i > 0)
+		{
+			rings_[--i].~TTaskRing();
+		}
+		::operator delete(rings_, std::align_val_t(alignof(TTaskRing)));
+		throw;
+	}
+}
+
+
+
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+ThreadPool<T, C, IP, PP>::TaskQueues::~TaskQueues()
+{
+	if (rings_)
+	{
+		for (size_t i = numberOfNodes_; i > 0; --i)
+		{
+			rings_[i - 1].~TTaskRing();
+		}
+		::operator delete(rings_, std::align_val_t(alignof(TTaskRing)));
+	}
+	delete [] queues_;
+}
+
+
+
+/** With ring buffers, the caller must make sure there's room for the task: it's only a brief spin
+ *  while a consumer that has just claimed a task releases its slot.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+void ThreadPool<T, C, IP, PP>::TaskQueues::push(size_t node, typename util::CallTraits<TTask>::TParam task)
+{
+	LASS_ASSERT(node < numberOfNodes_);
+	if (rings_)
+	{
+		while (!rings_[node].try_push(task))
+		{
+			LASS_SPIN_PAUSE;
+		}
+		return;
+	}
+	queues_[node].push(task);
+}
+
+
+
+/** pop from queue of @a preferredNode, or steal from the other nodes if it's empty.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+bool ThreadPool<T, C, IP, PP>::TaskQueues::pop(size_t preferredNode, TTask& task)
+{
+	LASS_ASSERT(preferredNode < numberOfNodes_);
+	for (size_t k = 0; k < numberOfNodes_; ++k)
+	{
+		const size_t node = (preferredNode + k) % numberOfNodes_;
+		if (rings_ ? rings_[node].try_pop(task) : queues_[node].pop(task))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+/** pop from queue of the node the calling thread is running on, or steal from the other nodes.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+bool ThreadPool<T, C, IP, PP>::TaskQueues::pop(TTask& task)
+{
+	const size_t node = numberOfNodes_ > 1 ? ProcessorTopology::instance().currentNode() : 0;
+	return pop(node < numberOfNodes_ ? node : 0, task);
+}
+
+
+
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+size_t ThreadPool<T, C, IP, PP>::TaskQueues::numberOfNodes() const
+{
+	return numberOfNodes_;
+}
+
+
+
 // --- ConsumerThread ------------------------------------------------------------------------------
 
 template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
@@ -285,27 +452,40 @@ ThreadPool<T, C, IP, PP>::ConsumerThread::ConsumerThread(
 		const TConsumer& consumer, TSelf& pool, const char* name):
 	Thread(threadJoinable, name), 
 	consumer_(consumer),
-	pool_(pool) 
+	pool_(pool),
+	node_(0),
+	isReleased_(false)
 {
 }
 
 
 
+/** bind to processor at @a nextIndex in pool's placement order, or the next one if that fails.
+ *  @return index in placement order for the next thread.
+ */
 template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
-size_t ThreadPool<T, C, IP, PP>::ConsumerThread::bindToNextAvailable(size_t nextProcessor)
+size_t ThreadPool<T, C, IP, PP>::ConsumerThread::bindToNextAvailable(size_t nextIndex)
 {
-	const size_t n = numberOfProcessors();
-	const size_t lastBeforeError = nextProcessor + n;
+	const ProcessorTopology::TProcessors& placement = pool_.placement_;
+	const size_t n = placement.size();
+	const size_t lastBeforeError = nextIndex + n;
 	while (true)
 	{
 		try
 		{
-			this->bind(nextProcessor++ % n);
-			return nextProcessor % n;
+			const size_t processor = placement[nextIndex++ % n];
+			this->bind(processor);
+			const ProcessorTopology& topology = ProcessorTopology::instance();
+			node_ = processor < topology.numberOfProcessors() ? topology.node(processor) : 0;
+			if (node_ >= pool_.waitingTasks_.numberOfNodes())
+			{
+				node_ = 0;
+			}
+			return nextIndex % n;
 		}
 		catch (...)
 		{
-			if (nextProcessor >= lastBeforeError)
+			if (nextIndex >= lastBeforeError)
 			{
 				throw;
 			}
@@ -316,6 +496,24 @@ size_t ThreadPool<T, C, IP, PP>::ConsumerThread::bindToNextAvailable(size_t next
 
 
 
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+size_t ThreadPool<T, C, IP, PP>::ConsumerThread::node() const
+{
+	return node_;
+}
+
+
+
+/** let the thread start consuming tasks, after it's bound and node_ is set.
+ */
+template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
+void ThreadPool<T, C, IP, PP>::ConsumerThread::release()
+{
+	isReleased_.store(true, std::memory_order_release);
+}
+
+
+
 #define LASS_UTIL_THREAD_POOL_CATCH_AND_WRAP(exception_type)\
 catch (const exception_type& error)\
 {\
@@ -326,10 +524,14 @@ catch (const exception_type& error)\
 template <typename T, typename C, typename IP, template <typename, typename, typename> class PP>
 void ThreadPool<T, C, IP, PP>::ConsumerThread::doRun()
 {
+	while (!isReleased_.load(std::memory_order_acquire))
+	{
+		Thread::yield();
+	}
 	TTask task;
 	while (!pool_.abort_)
 	{
-		if (pool_.waitingTasks_.pop(task))
+		if (pool_.waitingTasks_.pop(node_, task))
 		{
 			++pool_.numRunningTasks_;
 			--pool_.numWaitingTasks_;
@@ -42,6 +42,8 @@
 
 #include "pylass_common.h"
 #include "image.h"
+#include <map>
+#include <mutex>
 
 namespace pylass
 {
@@ -55,16 +57,106 @@ inline void setPixel(io::Image& ioImage, unsigned iRow, unsigned iCol, const pri
 {
 	ioImage(iRow, iCol) = iPixel;
 }
+
+// --- buffer protocol ---
+
+/** Number of buffers exported per image.  While there are any, the raster must not be reallocated.
+ *  It's counted per C++ image, as that's what owns the raster.
+ */
+typedef std::map<const io::Image*, Py_ssize_t> TExports;
+TExports exports;
+std::mutex exportsMutex;
+
+void checkResizable(const io::Image& image)
+{
+	std::lock_guard<std::mutex> lock(exportsMutex);
+	if (exports.find(&image) != exports.end())
+	{
+		throw python::PythonException(PyExc_BufferError, "Existing exports of data: object cannot be re-sized");
+	}
+}
+
+/** Exports the raster as rows x cols x 4 floats (r, g, b, a), read-only for const images.
+ */
+int getBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+	typedef python::BufferTraits<prim::ColorRGBA> TBufferTraits;
+	typedef TBufferTraits::TScalar TScalar;
+	static_assert(TBufferTraits::components == 4, "ColorRGBA must be exported as 4 scalars");
+
+	const Image* const pyImage = static_cast<Image*>(self);
+	const util::SharedPtr<io::Image> image = pyImage->cppObject();
+	const util::SharedPtr<const io::Image> constImage = pyImage->constCppObject();
+	if (!constImage)
+	{
+		view->obj = nullptr;
+		PyErr_SetString(PyExc_BufferError, "Image is null");
+		return -1;
+	}
+	const Py_ssize_t rows = static_cast<Py_ssize_t>(constImage->rows());
+	const Py_ssize_t cols = static_cast<Py_ssize_t>(constImage->cols());
+	const Py_ssize_t pixelSize = static_cast<Py_ssize_t>(sizeof(prim::ColorRGBA));
+	const Py_ssize_t scalarSize = static_cast<Py_ssize_t>(sizeof(TScalar));
+	const Py_ssize_t shape[3] = { rows, cols, TBufferTraits::components };
+	const Py_ssize_t strides[3] = { cols * pixelSize, pixelSize, scalarSize };
+	void* const buf = const_cast<prim::ColorRGBA*>(constImage->data());
+	if (python::impl::fillBufferInfo(view, self, buf, 3, shape, strides, TBufferTraits::format, scalarSize, !image, flags) != 0)
+	{
+		return -1;
+	}
+	std::lock_guard<std::mutex> lock(exportsMutex);
+	++exports[constImage.get()];
+	return 0;
+}
+
+void releaseBuffer(PyObject* self, Py_buffer* view)
+{
+	// a shadow object never changes its image, and the view keeps it alive.
+	const io::Image* const image = static_cast<Image*>(self)->constCppObject().get();
+	{
+		std::lock_guard<std::mutex> lock(exportsMutex);
+		TExports::iterator i = exports.find(image);
+		LASS_ASSERT(i != exports.end() && i->second > 0);
+		if (--i->second == 0)
+		{
+			exports.erase(i);
+		}
+	}
+	python::impl::releaseBufferInfo(view);
+}
+
+// --- methods that reallocate the raster ---
+
+void reset(io::Image& self)
+{
+	checkResizable(self);
+	self.reset();
+}
+void reset(io::Image& self, size_t rows, size_t cols)
+{
+	checkResizable(self);
+	self.reset(rows, cols);
+}
+void reset(io::Image& self, const std::string& path)
+{
+	checkResizable(self);
+	self.reset(path);
+}
+void open(io::Image& self, const std::string& path)
+{
+	checkResizable(self);
+	self.open(path);
+}
 }
 
 PY_DECLARE_CLASS(Image)
 PY_CLASS_CONSTRUCTOR_0(Image)
 PY_CLASS_CONSTRUCTOR_2(Image, unsigned, unsigned)
 PY_CLASS_CONSTRUCTOR_1(Image, const std::string&)
-PY_CLASS_METHOD_QUALIFIED_0(Image, reset, void)
-PY_CLASS_METHOD_QUALIFIED_2(Image, reset, void, size_t, size_t)
-PY_CLASS_METHOD_QUALIFIED_1(Image, reset, void, const std::string&)
-PY_CLASS_METHOD_QUALIFIED_1(Image, open, void, const std::string&)
+PY_CLASS_FREE_METHOD_QUALIFIED_NAME_1(Image, image::reset, void, io::Image&, "reset")
+PY_CLASS_FREE_METHOD_QUALIFIED_NAME_3(Image, image::reset, void, io::Image&, size_t, size_t, "reset")
+PY_CLASS_FREE_METHOD_QUALIFIED_NAME_2(Image, image::reset, void, io::Image&, const std::string&, "reset")
+PY_CLASS_FREE_METHOD_QUALIFIED_NAME_2(Image, image::open, void, io::Image&, const std::string&, "open")
 PY_CLASS_METHOD_QUALIFIED_1(Image, save, void, const std::string&)
 PY_CLASS_FREE_METHOD_NAME_DOC(Image, image::getPixel, "get", "get(row, col)")
 PY_CLASS_FREE_METHOD_NAME_DOC(Image, image::setPixel, "set", "set(row, col, color)")
@@ -86,5 +178,9 @@ PY_CLASS_METHOD(Image, filterMedian)
 PY_CLASS_METHOD(Image, filterGamma)
 PY_CLASS_METHOD(Image, filterExposure)
 PY_CLASS_METHOD(Image, filterInverseExposure)
+LASS_EXECUTE_BEFORE_MAIN_EX(Image_executeBeforeMain,
+	Image::_lassPyClassDef.setSlot(Py_bf_getbuffer, &image::getBuffer);
+	Image::_lassPyClassDef.setSlot(Py_bf_releasebuffer, &image::releaseBuffer);
+)
 
 }
@@ -0,0 +1,45 @@
+import lass
+import unittest
+
+
+class TestImageBuffer(unittest.TestCase):
+    def testShape(self):
+        image = lass.Image(2, 3)
+        with memoryview(image) as view:
+            self.assertEqual(view.format, "f")
+            self.assertEqual(view.itemsize, 4)
+            self.assertEqual(view.shape, (2, 3, 4))
+            self.assertEqual(view.strides, (3 * 16, 16, 4))
+            self.assertTrue(view.c_contiguous)
+            self.assertFalse(view.readonly)
+
+    def testReadWrite(self):
+        image = lass.Image(2, 3)
+        image.set(1, 2, (0.25, 0.5, 0.75, 1.0))
+        with memoryview(image) as view:
+            self.assertEqual(view[1, 2, 0], 0.25)
+            self.assertEqual(view[1, 2, 3], 1.0)
+            view[0, 1, 1] = 0.5
+        self.assertEqual(image.get(0, 1)[1], 0.5)
+
+    def testResizeWhileExported(self):
+        image = lass.Image(2, 3)
+        view = memoryview(image)
+        with self.assertRaises(BufferError):
+            image.reset(4, 4)
+        with self.assertRaises(BufferError):
+            image.reset()
+        self.assertEqual((image.rows, image.cols), (2, 3))
+        view.release()
+        image.reset(4, 4)
+        self.assertEqual(memoryview(image).shape, (4, 4, 4))
+
+    def testEmpty(self):
+        image = lass.Image()
+        with memoryview(image) as view:
+            self.assertEqual(view.shape, (0, 0, 4))
+            self.assertEqual(view.nbytes, 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -72,6 +72,7 @@
 #include "../lass/util/multi_callback.h"
 #include "../lass/python/pycallback.h"
 #include "../lass/python/streams.h"
+#include "../lass/prim/point_3d.h"
 
 namespace lass
 {
@@ -167,6 +168,100 @@ float overloadedB(const std::complex<float>& iA)
 	return std::abs(iA);
 }
 
+int callOverhead(int iA, double iB)
+{
+	return iA + static_cast<int>(iB);
+}
+
+int callOverheadOverloaded(const std::string& iA, double iB)
+{
+	return static_cast<int>(iA.size()) + static_cast<int>(iB);
+}
+
+int callOverheadOverloaded(const std::vector<std::string>& iA, double iB)
+{
+	return static_cast<int>(iA.size()) + static_cast<int>(iB);
+}
+
+int callOverheadOverloaded(int iA, double iB)
+{
+	return iA + static_cast<int>(iB);
+}
+
+int callOverheadHoldGil(int iA, double iB)
+{
+	return iA + static_cast<int>(iB);
+}
+
+bool isGilHeld()
+{
+	// PyGILState_Check() always returns true once a subinterpreter has been created.
+	return lass::python::impl::currentThreadState() != nullptr;
+}
+
+typedef std::pair<int, int> TIntPair;
+typedef std::pair<std::string, std::string> TStringPair;
+
+int overloadCache(const TIntPair&)
+{
+	return 1;
+}
+
+int overloadCache(const TStringPair&)
+{
+	return 2;
+}
+
+int overloadCache(const std::vector<int>&)
+{
+	return 3;
+}
+
+typedef std::pair<double, double> TDoublePair;
+
+int overloadCacheValues(const std::vector<int>&)
+{
+	return 1;
+}
+
+int overloadCacheValues(const std::vector<double>&)
+{
+	return 2;
+}
+
+int overloadCacheValues(const TIntPair&, int)
+{
+	return 3;
+}
+
+int overloadCacheValues(const TDoublePair&, int)
+{
+	return 4;
+}
+
+typedef std::vector< prim::Point3D<double> > TPoints;
+
+TPoints makePoints(size_t n)
+{
+	TPoints points;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double x = static_cast<double>(i);
+		points.emplace_back(x, 2 * x, 3 * x);
+	}
+	return points;
+}
+
+prim::Point3D<double> sumPoints(const TPoints& points)
+{
+	prim::Point3D<double> sum;
+	for (const auto& p : points)
+	{
+		sum += p.position();
+	}
+	return sum;
+}
+
 int functionWithDefaultArgs(int iA, int iB=666)
 {
 	LASS_COUT << "functionWithDefaultArgs" << iA << "," << iB << std::endl;
@@ -522,6 +617,7 @@ PY_CLASS_METHOD_NAME( PyClassSeq, popwo, "pop");
 PY_CLASS_METHOD_NAME( PyClassSeq, irepeat, lass::python::methods::_irepeat_);
 PY_CLASS_METHOD_NAME( PyClassSeq, iconcat, lass::python::methods::_iconcat_);
 PY_CLASS_METHOD_NAME( PyClassSeq, size, lass::python::methods::_len_);
+PY_CLASS_METHOD_GIL( PyClassSeq, size, lass::python::GilPolicy::hold );
 PY_CLASS_ITERFUNC( PyClassSeq, begin, end )
 
 // full map protocol
@@ -563,6 +659,30 @@ PY_DECLARE_CLASS(IteratorContainer)
 PY_CLASS_CONSTRUCTOR_1(IteratorContainer, IteratorContainer::TItems)
 PY_CLASS_FREE_METHOD_NAME(IteratorContainer, python::makeContainerRangeView<IteratorContainer>, python::methods::_iter_);
 
+class PointCloud: public python::PyObjectPlus
+{
+	PY_HEADER(python::PyObjectPlus)
+public:
+	using TPoints = std::vector<prim::Point3D<double>>;
+	using TIterator = TPoints::const_iterator;
+	PointCloud(size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double x = static_cast<double>(i);
+			points_.emplace_back(x, 2 * x, 3 * x);
+		}
+	}
+	TIterator begin() const { return points_.begin(); }
+	TIterator end() const { return points_.end(); }
+private:
+	TPoints points_;
+};
+
+PY_DECLARE_CLASS(PointCloud)
+PY_CLASS_CONSTRUCTOR_1(PointCloud, size_t)
+PY_CLASS_FREE_METHOD_NAME(PointCloud, python::makeContainerRangeView<PointCloud>, python::methods::_iter_);
+
 }
 
 
@@ -815,6 +935,30 @@ python::NoNone<RawType*> testNoNoneRaw(python::NoNone<RawType*> bar, bool return
 		: pBar;
 }
 
+/** Has an IntrusiveShadowSlot, but isn't owned by its shadow, so it mustn't use the slot.
+ */
+class RawSlotType: public python::IntrusiveShadowSlot
+{
+public:
+	RawSlotType() = default;
+	num::TuintPtr address() const { return reinterpret_cast<num::TuintPtr>(this); }
+};
+
+python::NoNone<RawSlotType*> newRawSlot()
+{
+	return new RawSlotType;
+}
+
+void deleteRawSlot(python::NoNone<RawSlotType*> raw)
+{
+	delete static_cast<RawSlotType*>(raw);
+}
+
+python::NoNone<RawSlotType*> sameRawSlot(python::NoNone<RawSlotType*> raw)
+{
+	return raw;
+}
+
 lass::python::TPyObjPtr testRawPyObject(PyObject* obj)
 {
 	return lass::python::fromNakedToSharedPtrCast<PyObject>(obj);
@@ -861,6 +1005,7 @@ PY_MODULE_CLASS( embedding, PyClassC );
 PY_MODULE_CLASS( embedding, PyClassSeq );
 PY_MODULE_CLASS( embedding, PyClassMap );
 PY_MODULE_CLASS( embedding, IteratorContainer);
+PY_MODULE_CLASS( embedding, PointCloud );
 PY_MODULE_CLASS( embedding, PyShadowedIteratorContainer );
 PY_MODULE_CLASS( embedding, PyShadowedMemberIteratorContainer );
 PY_MODULE_CLASS( embedding, PyShadowedFreeIteratorContainer );
@@ -868,6 +1013,22 @@ PY_MODULE_CLASS( embedding, PyShadowedIndexContainer );
 PY_MODULE_CLASS( embedding, PyShadowedFreeIndexContainer );
 
 PY_MODULE_FUNCTION( embedding, anotherFreeFunction )
+PY_MODULE_FUNCTION( embedding, callOverhead )
+PY_MODULE_FUNCTION_GIL( embedding, callOverheadHoldGil, lass::python::GilPolicy::hold )
+PY_MODULE_FUNCTION( embedding, isGilHeld )
+PY_MODULE_FUNCTION_GIL_EX( embedding, isGilHeld, "isGilHeldWhenHolding", nullptr, embedding_isGilHeldWhenHolding, lass::python::GilPolicy::hold )
+PY_MODULE_FUNCTION_QUALIFIED_2( embedding, callOverheadOverloaded, int, const std::string&, double )
+PY_MODULE_FUNCTION_QUALIFIED_2( embedding, callOverheadOverloaded, int, const std::vector<std::string>&, double )
+PY_MODULE_FUNCTION_QUALIFIED_2( embedding, callOverheadOverloaded, int, int, double )
+PY_MODULE_FUNCTION_QUALIFIED_1( embedding, overloadCache, int, const TIntPair& )
+PY_MODULE_FUNCTION_QUALIFIED_1( embedding, overloadCache, int, const TStringPair& )
+PY_MODULE_FUNCTION_QUALIFIED_1( embedding, overloadCache, int, const std::vector<int>& )
+PY_MODULE_FUNCTION_QUALIFIED_1( embedding, overloadCacheValues, int, const std::vector<int>& )
+PY_MODULE_FUNCTION_QUALIFIED_1( embedding, overloadCacheValues, int, const std::vector<double>& )
+PY_MODULE_FUNCTION_QUALIFIED_2( embedding, overloadCacheValues, int, const TIntPair&, int )
+PY_MODULE_FUNCTION_QUALIFIED_2( embedding, overloadCacheValues, int, const TDoublePair&, int )
+PY_MODULE_FUNCTION( embedding, makePoints )
+PY_MODULE_FUNCTION( embedding, sumPoints )
 PY_MODULE_FUNCTION( embedding, listInfo )
 PY_MODULE_FUNCTION( embedding, getAFoo )
 PY_MODULE_FUNCTION( embedding, makeSpam )
@@ -937,6 +1098,16 @@ PY_CLASS_MEMBER_R(PyRawType, address)
 PY_MODULE_CLASS(embedding, PyRawType)
 PY_MODULE_FUNCTION(embedding, rawPointer)
 PY_MODULE_FUNCTION(embedding, testNoNoneRaw)
+
+PY_SHADOW_CLASS_PTRTRAITS(LASS_DLL_EXPORT, PyRawSlotType, lass::test::RawSlotType, lass::python::NakedPointerTraits)
+PY_SHADOW_CASTERS(PyRawSlotType)
+PY_DECLARE_CLASS_NAME(PyRawSlotType, "RawSlotType")
+PY_CLASS_MEMBER_R(PyRawSlotType, address)
+PY_MODULE_CLASS(embedding, PyRawSlotType)
+PY_MODULE_FUNCTION(embedding, newRawSlot)
+PY_MODULE_FUNCTION(embedding, deleteRawSlot)
+PY_MODULE_FUNCTION(embedding, sameRawSlot)
+static_assert(!PyRawSlotType::hasIntrusiveShadowSlot, "naked pointers can't use the intrusive slot");
 PY_MODULE_FUNCTION(embedding, isNoneRaw)
 PY_MODULE_FUNCTION(embedding, isNoneShared)
 
@@ -55,7 +55,7 @@ class Spam;
 typedef util::SharedPtr<Spam> TSpamPtr;
 typedef util::SharedPtr<const Spam> TConstSpamPtr;
 
-class Spam
+class Spam: public python::IntrusiveShadowSlot
 {
 public:
 	virtual ~Spam();
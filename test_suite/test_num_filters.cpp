@@ -44,6 +44,8 @@
 
 #include "../lass/num/filters.h"
 
+#include <random>
+
 namespace lass
 {
 namespace test
@@ -80,9 +82,231 @@ void testNumFilters()
 	}
 }
 
+template <typename T>
+void testNumRealFft()
+{
+	typedef std::complex<T> TComplex;
+
+	std::mt19937 rng;
+	std::uniform_real_distribution<T> distribution(-1, 1);
+
+	for (size_t n = 2; n <= 1024; n *= 2)
+	{
+		std::vector<T> x(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			x[i] = distribution(rng);
+		}
+
+		num::impl::RealFft<T> fft(n);
+		LASS_TEST_CHECK_EQUAL(fft.size(), n);
+		LASS_TEST_CHECK_EQUAL(fft.spectrumSize(), n / 2 + 1);
+		std::vector<TComplex> spectrum(fft.spectrumSize());
+		fft.forward(&x[0], &spectrum[0]);
+
+		const double tolerance = 8 * std::numeric_limits<T>::epsilon() * static_cast<double>(n);
+		double maxError = 0;
+		for (size_t k = 0; k <= n / 2; ++k)
+		{
+			std::complex<double> expected = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				expected += static_cast<double>(x[i]) * std::polar(1., -2 * num::NumTraits<double>::pi * static_cast<double>(i * k % n) / static_cast<double>(n));
+			}
+			maxError = std::max(maxError, std::abs(std::complex<double>(spectrum[k]) - expected));
+		}
+		LASS_TEST_CHECK(maxError <= tolerance);
+
+		std::vector<T> y(n);
+		fft.inverse(&spectrum[0], &y[0]);
+		maxError = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			maxError = std::max(maxError, std::abs(static_cast<double>(y[i]) / static_cast<double>(n) - x[i]));
+		}
+		LASS_TEST_CHECK(maxError <= tolerance);
+	}
+
+	LASS_TEST_CHECK_THROW(num::impl::RealFft<T>(48), util::Exception);
+}
+
+template <typename T>
+void testNumFirFilterFft()
+{
+	std::mt19937 rng;
+	std::uniform_real_distribution<T> distribution(-1, 1);
+
+	const size_t numSamples = 10000;
+	std::vector<T> input(numSamples);
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		input[i] = distribution(rng);
+	}
+
+	const size_t numTaps[] = { num::FirFilter<T>::fftThreshold - 1, num::FirFilter<T>::fftThreshold, 257, 1000, 4096 };
+	for (size_t m : numTaps)
+	{
+		std::vector<T> taps(m);
+		for (size_t i = 0; i < m; ++i)
+		{
+			taps[i] = distribution(rng) / static_cast<T>(i + 1);
+		}
+
+		std::vector<double> expected(numSamples);
+		double scale = 0;
+		for (size_t n = 0; n < numSamples; ++n)
+		{
+			for (size_t i = 0; i < m && i <= n; ++i)
+			{
+				expected[n] += static_cast<double>(taps[i]) * input[n - i];
+			}
+			scale = std::max(scale, std::abs(expected[n]));
+		}
+		const double tolerance = 32 * std::numeric_limits<T>::epsilon() * scale;
+
+		// feed the input in chunks that don't line up with any partition
+		num::FirFilter<T> filter(taps);
+		std::vector<T> output(numSamples);
+		for (size_t first = 0, chunk = 1; first < numSamples; first += chunk, chunk = chunk * 3 + 1)
+		{
+			const size_t last = std::min(first + chunk, numSamples);
+			filter(&input[first], &input[0] + last, &output[first]);
+		}
+		double maxError = 0;
+		for (size_t n = 0; n < numSamples; ++n)
+		{
+			maxError = std::max(maxError, std::abs(output[n] - expected[n]));
+		}
+		LASS_TEST_CHECK(maxError <= tolerance);
+
+		// after a reset, the impulse response are the taps again.
+		filter.reset();
+		std::vector<T> impulse(m + 10, T(0));
+		impulse[0] = 1;
+		std::vector<T> response(impulse.size());
+		filter(&impulse[0], &impulse[0] + impulse.size(), &response[0]);
+		maxError = 0;
+		for (size_t i = 0; i < impulse.size(); ++i)
+		{
+			maxError = std::max(maxError, static_cast<double>(std::abs(response[i] - (i < m ? taps[i] : T(0)))));
+		}
+		LASS_TEST_CHECK(maxError <= 8 * std::numeric_limits<T>::epsilon());
+	}
+}
+
+template <typename T>
+void testNumBiquadFilter()
+{
+	typedef num::NumTraits<T> TNumTraits;
+	typedef num::IirFilter<double> TIirFilter;
+	typedef num::BiquadFilter<T> TBiquadFilter;
+
+	const T samplingFrequency = 48000;
+	const T cutoff = 2 * TNumTraits::pi * 1000;
+	const T gain = 2;
+	const T tolerance = 10 * num::sqrt(std::numeric_limits<T>::epsilon());
+
+	// same transfer function as the direct form in double precision, for orders where that one is still accurate.
+	//
+	for (unsigned order = 1; order <= 6; ++order)
+	{
+		TIirFilter iirs[] = { 
+			TIirFilter::makeButterworthLowPass(order, cutoff, gain, samplingFrequency),
+			TIirFilter::makeButterworthHighPass(order, cutoff, gain, samplingFrequency),
+		};
+		TBiquadFilter biquads[] = {
+			TBiquadFilter::makeButterworthLowPass(order, cutoff, gain, samplingFrequency),
+			TBiquadFilter::makeButterworthHighPass(order, cutoff, gain, samplingFrequency),
+		};
+		for (size_t i = 0; i < 2; ++i)
+		{
+			LASS_TEST_CHECK_EQUAL(biquads[i].sections().size(), (order + 1) / 2);
+			std::vector<double> impulse(200, 0);
+			impulse[0] = 1;
+			std::vector<double> expected(impulse.size());
+			iirs[i](&impulse[0], &impulse[0] + impulse.size(), &expected[0]);
+			const std::vector<T> impulseT(impulse.begin(), impulse.end());
+			std::vector<T> result(impulse.size());
+			biquads[i](&impulseT[0], &impulseT[0] + impulse.size(), &result[0]);
+			double maxError = 0;
+			for (size_t k = 0; k < impulse.size(); ++k)
+			{
+				maxError = std::max(maxError, num::abs(result[k] - expected[k]));
+			}
+			LASS_TEST_CHECK(maxError < tolerance * gain);
+		}
+	}
+
+	// a high order low-pass, far too sensitive for the direct form.
+	//
+	{
+		const unsigned order = 16;
+		TBiquadFilter filter = TBiquadFilter::makeButterworthLowPass(order, 2 * TNumTraits::pi * 500, gain, samplingFrequency);
+		const std::vector<T> step(48000, TNumTraits::one);
+		std::vector<T> response(step.size());
+		filter(&step[0], &step[0] + step.size(), &response[0]);
+		LASS_TEST_CHECK_CLOSE(response.back(), gain, tolerance);
+		T peak = 0;
+		for (T y : response)
+		{
+			peak = std::max(peak, num::abs(y));
+		}
+		LASS_TEST_CHECK(peak < 2 * gain);
+	}
+
+	// interleaved channels give the same as filtering each on its own.
+	//
+	{
+		const size_t numChannels = 13;
+		const size_t numFrames = 500;
+		std::mt19937 rng;
+		std::uniform_real_distribution<T> distribution(-1, 1);
+		std::vector<T> input(numChannels * numFrames);
+		for (T& x : input)
+		{
+			x = distribution(rng);
+		}
+
+		TBiquadFilter multi = TBiquadFilter::makeButterworthHighPass(5, cutoff, gain, samplingFrequency, numChannels);
+		LASS_TEST_CHECK_EQUAL(multi.numChannels(), numChannels);
+		std::vector<T> output(input.size());
+		const size_t split = 7 * numChannels;
+		multi(&input[0], &input[0] + split, &output[0]);
+		multi(&input[0] + split, &input[0] + input.size(), &output[0] + split);
+
+		for (size_t c = 0; c < numChannels; ++c)
+		{
+			TBiquadFilter single = TBiquadFilter::makeButterworthHighPass(5, cutoff, gain, samplingFrequency);
+			T maxError = 0;
+			for (size_t k = 0; k < numFrames; ++k)
+			{
+				T y;
+				single(&input[k * numChannels + c], &input[k * numChannels + c] + 1, &y);
+				maxError = std::max(maxError, num::abs(y - output[k * numChannels + c]));
+			}
+			LASS_TEST_CHECK_EQUAL(maxError, T(0));
+		}
+
+		multi.reset();
+		LASS_TEST_CHECK_THROW(multi(&input[0], &input[0] + numChannels + 1, &output[0]), util::Exception);
+	}
+
+	const std::vector<T> cubic(4, TNumTraits::one);
+	LASS_TEST_CHECK_THROW(TBiquadFilter(std::make_pair(cubic, cubic)), util::Exception);
+	LASS_TEST_CHECK_THROW(TBiquadFilter::makeButterworthLowPass(0, cutoff, gain, samplingFrequency), util::Exception);
+}
+
 TUnitTest test_num_filters()
 {
-	return TUnitTest(1, LASS_TEST_CASE(testNumFilters<double>));
+	return TUnitTest{
+		LASS_TEST_CASE(testNumFilters<double>),
+		LASS_TEST_CASE(testNumRealFft<float>),
+		LASS_TEST_CASE(testNumRealFft<double>),
+		LASS_TEST_CASE(testNumFirFilterFft<float>),
+		LASS_TEST_CASE(testNumFirFilterFft<double>),
+		LASS_TEST_CASE(testNumBiquadFilter<float>),
+		LASS_TEST_CASE(testNumBiquadFilter<double>),
+	};
 }
 
 
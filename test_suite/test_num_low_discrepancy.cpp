@@ -0,0 +1,337 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "test_common.h"
+
+#include "../lass/num/low_discrepancy.h"
+#include "../lass/num/inverse_transform_sampling.h"
+
+#include <random>
+
+namespace lass
+{
+namespace test
+{
+namespace low_discrepancy
+{
+
+/** checks that each of the first size samples falls in its own stratum of width 1 / size.
+ */
+template <typename Sequence>
+bool isStratified(const Sequence& sequence, size_t dimension, size_t size)
+{
+	std::vector<double> xs(size);
+	sequence.generate(0, size, dimension, &xs[0]);
+	std::vector<bool> hit(size, false);
+	for (double x : xs)
+	{
+		if (!(x >= 0 && x < 1))
+		{
+			return false;
+		}
+		const size_t i = static_cast<size_t>(x * static_cast<double>(size));
+		if (hit[i])
+		{
+			return false;
+		}
+		hit[i] = true;
+	}
+	return true;
+}
+
+/** checks that the first 2^m samples of a pair of dimensions form a (0, m, 2)-net: each
+ *  elementary interval of 2^i by 2^(m-i) strata holds exactly one sample.
+ */
+bool isNet(const num::SobolSequence& sequence, size_t dimX, size_t dimY, unsigned m)
+{
+	const size_t size = size_t(1) << m;
+	std::vector<num::SobolSequence::TBits> xs(size);
+	std::vector<num::SobolSequence::TBits> ys(size);
+	sequence.generateBits(0, size, dimX, &xs[0]);
+	sequence.generateBits(0, size, dimY, &ys[0]);
+	for (unsigned i = 0; i <= m; ++i)
+	{
+		std::vector<bool> hit(size, false);
+		for (size_t k = 0; k < size; ++k)
+		{
+			const num::Tuint64 x = xs[k];
+			const num::Tuint64 y = ys[k];
+			const size_t cell = static_cast<size_t>(((x >> (32 - i)) << (m - i)) | (y >> (32 - (m - i))));
+			if (hit[cell])
+			{
+				return false;
+			}
+			hit[cell] = true;
+		}
+	}
+	return true;
+}
+
+}
+
+void testNumSobolSequence()
+{
+	using namespace low_discrepancy;
+	typedef num::SobolSequence TSobol;
+
+	// first points of Joe and Kuo's reference implementation, which runs in Gray code order.
+	//
+	const double expected[8][3] = 
+	{
+		{ 0, 0, 0 },
+		{ .5, .5, .5 },
+		{ .75, .25, .25 },
+		{ .25, .75, .75 },
+		{ .375, .375, .625 },
+		{ .875, .875, .125 },
+		{ .625, .125, .875 },
+		{ .125, .625, .375 },
+	};
+	const TSobol plain(TSobol::numBaseDimensions, num::stNone);
+	for (size_t n = 0; n < 8; ++n)
+	{
+		for (size_t d = 0; d < 3; ++d)
+		{
+			LASS_TEST_CHECK_EQUAL(plain(n ^ (n >> 1), d), expected[n][d]);
+		}
+	}
+	LASS_TEST_CHECK_THROW(TSobol(TSobol::numBaseDimensions + 1, num::stNone), util::Exception);
+
+	// stratification survives scrambling and padding
+	//
+	const size_t numDimensions = 3 * TSobol::numBaseDimensions;
+	const TSobol owen(numDimensions, num::stOwen, 42);
+	for (size_t d = 0; d < TSobol::numBaseDimensions; ++d)
+	{
+		LASS_TEST_CHECK(isStratified(plain, d, 1024));
+	}
+	for (size_t d = 0; d < numDimensions; ++d)
+	{
+		LASS_TEST_CHECK(isStratified(owen, d, 1024));
+	}
+	LASS_TEST_CHECK(isNet(plain, 0, 1, 10));
+	LASS_TEST_CHECK(isNet(owen, 0, 1, 10));
+	LASS_TEST_CHECK(isNet(owen, TSobol::numBaseDimensions, TSobol::numBaseDimensions + 1, 10));
+	LASS_TEST_CHECK(isNet(owen, 2 * TSobol::numBaseDimensions, 2 * TSobol::numBaseDimensions + 1, 10));
+
+	// batches equal single samples, from any first index, in float too
+	//
+	const size_t firstIndex = 1000;
+	const size_t count = 777;
+	std::vector<double> batch(numDimensions * count);
+	std::vector<float> batchFloat(numDimensions * count);
+	owen.generate(firstIndex, count, &batch[0]);
+	owen.generate(firstIndex, count, &batchFloat[0]);
+	for (size_t d = 0; d < numDimensions; ++d)
+	{
+		for (size_t k = 0; k < count; ++k)
+		{
+			LASS_TEST_CHECK_EQUAL(batch[d * count + k], owen(firstIndex + k, d));
+			LASS_TEST_CHECK(batchFloat[d * count + k] >= 0 && batchFloat[d * count + k] < 1);
+			LASS_TEST_CHECK(num::abs(batchFloat[d * count + k] - batch[d * count + k]) < 1e-7);
+		}
+	}
+
+	// other seeds give other samples
+	//
+	const TSobol other(numDimensions, num::stOwen, 43);
+	size_t numEqual = 0;
+	for (size_t k = 0; k < 100; ++k)
+	{
+		numEqual += owen.bits(k, 5) == other.bits(k, 5) ? 1 : 0;
+	}
+	LASS_TEST_CHECK(numEqual < 5);
+}
+
+
+
+void testNumHaltonSequence()
+{
+	using namespace low_discrepancy;
+	typedef num::HaltonSequence THalton;
+
+	const THalton plain(4, num::stNone);
+	LASS_TEST_CHECK_EQUAL(plain.base(0), size_t(2));
+	LASS_TEST_CHECK_EQUAL(plain.base(3), size_t(7));
+	const double expected2[] = { 0, 1. / 2, 1. / 4, 3. / 4, 1. / 8, 5. / 8 };
+	const double expected3[] = { 0, 1. / 3, 2. / 3, 1. / 9, 4. / 9, 7. / 9 };
+	for (size_t n = 0; n < 6; ++n)
+	{
+		LASS_TEST_CHECK_CLOSE(plain(n, 0), expected2[n], 1e-15);
+		LASS_TEST_CHECK_CLOSE(plain(n, 1), expected3[n], 1e-15);
+	}
+	LASS_TEST_CHECK_THROW(THalton(THalton::maxDimensions + 1), util::Exception);
+
+	// the first base^m samples of each dimension are stratified, also when scrambled
+	//
+	const THalton owen(THalton::maxDimensions, num::stOwen, 42);
+	for (size_t d = 0; d < THalton::maxDimensions; d += 17)
+	{
+		size_t size = owen.base(d);
+		while (size * owen.base(d) <= 4096)
+		{
+			size *= owen.base(d);
+		}
+		LASS_TEST_CHECK(isStratified(owen, d, size));
+		if (d < plain.numDimensions())
+		{
+			LASS_TEST_CHECK(isStratified(plain, d, size));
+		}
+	}
+
+	// batches equal single samples
+	//
+	const size_t firstIndex = 12345;
+	const size_t count = 100;
+	std::vector<double> batch(owen.numDimensions() * count);
+	owen.generate(firstIndex, count, &batch[0]);
+	for (size_t d = 0; d < owen.numDimensions(); ++d)
+	{
+		for (size_t k = 0; k < count; ++k)
+		{
+			LASS_TEST_CHECK_EQUAL(batch[d * count + k], owen(firstIndex + k, d));
+		}
+	}
+}
+
+
+
+/** integrates a peaked function by importance sampling, from a tabulated version of itself. 
+ *  Owen scrambled Sobol and Halton samples should do better than random ones.  The gain is less 
+ *  than for plain integration of a smooth function, as f / pdf jumps at the cell borders.
+ */
+void testNumLowDiscrepancyImportanceSampling()
+{
+	typedef double TValue;
+	typedef num::InverseTransformSampling2D<TValue> TInverseTransformSampling;
+
+	auto f = [](TValue u, TValue v)
+	{
+		return num::exp(-(num::sqr(u - .3) + num::sqr(v - .6)) / .02) + .1 * (1 + num::sin(7 * u + 3 * v));
+	};
+
+	const size_t gridSize = 16;
+	std::vector<TValue> table(gridSize * gridSize);
+	for (size_t i = 0; i < gridSize; ++i)
+	{
+		for (size_t j = 0; j < gridSize; ++j)
+		{
+			table[i * gridSize + j] = f((static_cast<TValue>(i) + .5) / gridSize, (static_cast<TValue>(j) + .5) / gridSize);
+		}
+	}
+	const TInverseTransformSampling inverse(table.begin(), table.end(), gridSize, gridSize);
+
+	const size_t referenceSize = 2048;
+	TValue reference = 0;
+	for (size_t i = 0; i < referenceSize; ++i)
+	{
+		for (size_t j = 0; j < referenceSize; ++j)
+		{
+			reference += f((static_cast<TValue>(i) + .5) / referenceSize, (static_cast<TValue>(j) + .5) / referenceSize);
+		}
+	}
+	reference /= num::sqr(static_cast<TValue>(referenceSize));
+
+	const size_t numSamples = 4096;
+	const size_t numRuns = 16;
+	std::vector<TValue> us(numSamples);
+	std::vector<TValue> vs(numSamples);
+	std::vector<TValue> pdfs(numSamples);
+	auto estimate = [&]()
+	{
+		inverse(numSamples, &us[0], &vs[0], &us[0], &vs[0], &pdfs[0]);
+		TValue sum = 0;
+		for (size_t k = 0; k < numSamples; ++k)
+		{
+			sum += f(us[k], vs[k]) / pdfs[k];
+		}
+		return sum / numSamples;
+	};
+
+	std::mt19937_64 random;
+	std::uniform_real_distribution<TValue> uniform;
+	TValue errorRandom = 0;
+	TValue errorSobol = 0;
+	TValue errorHalton = 0;
+	for (num::Tuint32 run = 0; run < numRuns; ++run)
+	{
+		std::generate(us.begin(), us.end(), [&]() { return uniform(random); });
+		std::generate(vs.begin(), vs.end(), [&]() { return uniform(random); });
+		errorRandom += num::sqr(estimate() - reference);
+
+		const num::SobolSequence sobol(2, num::stOwen, run);
+		sobol.generate(0, numSamples, 0, &us[0]);
+		sobol.generate(0, numSamples, 1, &vs[0]);
+		errorSobol += num::sqr(estimate() - reference);
+
+		const num::HaltonSequence halton(2, num::stOwen, run);
+		halton.generate(0, numSamples, 0, &us[0]);
+		halton.generate(0, numSamples, 1, &vs[0]);
+		errorHalton += num::sqr(estimate() - reference);
+	}
+	errorRandom = num::sqrt(errorRandom / numRuns) / reference;
+	errorSobol = num::sqrt(errorSobol / numRuns) / reference;
+	errorHalton = num::sqrt(errorHalton / numRuns) / reference;
+	LASS_COUT << "relative RMS error of " << numSamples << " importance samples: random " << errorRandom
+		<< ", Sobol " << errorSobol << ", Halton " << errorHalton << "\n";
+	LASS_TEST_CHECK(errorSobol * 2 < errorRandom);
+	LASS_TEST_CHECK(errorHalton * 1.5 < errorRandom);
+}
+
+
+
+TUnitTest test_num_low_discrepancy()
+{
+	return TUnitTest
+	{
+		LASS_TEST_CASE(testNumSobolSequence),
+		LASS_TEST_CASE(testNumHaltonSequence),
+		LASS_TEST_CASE(testNumLowDiscrepancyImportanceSampling),
+	};
+}
+
+}
+
+}
+
+// EOF
@@ -44,10 +44,14 @@
 
 #include "../lass/num/vector.h"
 #include "../lass/num/matrix.h"
+#include "../lass/num/matrix_decomposition.h"
 #include "../lass/num/random.h"
 #include "../lass/num/distribution.h"
 
+#include <atomic>
 #include <random>
+#include <stdexcept>
+#include <thread>
 
 namespace lass
 {
@@ -74,6 +78,23 @@ struct Generator<std::complex<T> >
 	std::complex<T> operator()() { return std::complex<T>(distribution_(random_), distribution_(random_)); }
 };
 
+std::thread::id callerThread;
+std::atomic<size_t> foreignCalls;
+
+template <typename T>
+T checkedNegate(T x)
+{
+	if (std::this_thread::get_id() != callerThread)
+	{
+		++foreignCalls;
+	}
+	if (x > 1)
+	{
+		throw std::domain_error("out of range");
+	}
+	return -x;
+}
+
 template <typename T>
 void fill(num::Matrix<T>& matrix, Generator<T>& rng)
 {
@@ -427,6 +448,366 @@ void testNumMatrixInverse()
 }
 
 
+template <typename T>
+void testNumVectorLarge()
+{
+	typedef num::Vector<T> TVector;
+	typedef typename TVector::TSize TSize;
+
+	num_vector::Generator<T> rng;
+
+	// long enough to be evaluated and summed in parallel, and not a multiple of any block size.
+	const TSize n = 300007;
+	TVector b(n), c(n), d(n);
+	for (TSize i = 0; i < n; ++i)
+	{
+		b[i] = rng();
+		c[i] = rng();
+		d[i] = rng();
+	}
+
+	TVector a(b + c * d);
+	LASS_TEST_CHECK_EQUAL(a.size(), n);
+	T maxError = 0;
+	for (TSize i = 0; i < n; ++i)
+	{
+		maxError = std::max(maxError, std::abs(a[i] - (b[i] + c[i] * d[i])));
+	}
+	LASS_TEST_CHECK_EQUAL(maxError, T(0));
+
+	a = a * c - b;
+	maxError = 0;
+	for (TSize i = 0; i < n; ++i)
+	{
+		maxError = std::max(maxError, std::abs(a[i] - ((b[i] + c[i] * d[i]) * c[i] - b[i])));
+	}
+	LASS_TEST_CHECK_EQUAL(maxError, T(0));
+
+	double sum = 0, squaredNorm = 0, dotBC = 0;
+	for (TSize i = 0; i < n; ++i)
+	{
+		sum += b[i];
+		squaredNorm += static_cast<double>(b[i]) * b[i];
+		dotBC += static_cast<double>(b[i]) * c[i];
+	}
+	const double tol = 16 * std::numeric_limits<T>::epsilon() * static_cast<double>(n);
+	LASS_TEST_CHECK(std::abs(b.sum() - sum) <= tol * std::sqrt(squaredNorm));
+	LASS_TEST_CHECK(std::abs(b.squaredNorm() - squaredNorm) <= 1e-5 * squaredNorm);
+	LASS_TEST_CHECK(std::abs(b.norm() - std::sqrt(squaredNorm)) <= 1e-5 * std::sqrt(squaredNorm));
+	LASS_TEST_CHECK(std::abs(dot(b, c) - dotBC) <= tol * std::sqrt(squaredNorm));
+
+	// a straight sum of a million tenths is off by percents in single precision, a pairwise one isn't.
+	const TSize m = 1000000;
+	const TVector tenths(m, T(0.1));
+	const double expected = static_cast<double>(T(0.1)) * static_cast<double>(m);
+	LASS_TEST_CHECK(std::abs(tenths.sum() - expected) <= 32 * std::numeric_limits<T>::epsilon() * expected);
+	LASS_TEST_CHECK(std::abs(dot(tenths, tenths) - expected / 10) <= 32 * std::numeric_limits<T>::epsilon() * expected / 10);
+	LASS_TEST_CHECK_EQUAL(TVector().sum(), T(0));
+
+	// user functions are evaluated on the calling thread, so that they needn't be thread safe and can throw.
+	num_vector::callerThread = std::this_thread::get_id();
+	num_vector::foreignCalls = 0;
+	const TVector e(b.transform(num_vector::checkedNegate<T>));
+	maxError = 0;
+	for (TSize i = 0; i < n; ++i)
+	{
+		maxError = std::max(maxError, std::abs(e[i] + b[i]));
+	}
+	LASS_TEST_CHECK_EQUAL(maxError, T(0));
+	LASS_TEST_CHECK_EQUAL(b.transform(num_vector::checkedNegate<T>).sum(), -b.sum());
+	LASS_TEST_CHECK_EQUAL(num_vector::foreignCalls.load(), size_t(0));
+	b[n - 1] = 2;
+	LASS_TEST_CHECK_THROW(TVector(b.transform(num_vector::checkedNegate<T>)), std::domain_error);
+}
+
+
+template <typename T>
+void testNumMatrixProduct()
+{
+	typedef num::Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+
+	num_vector::Generator<T> rng;
+
+	// odd sizes to hit all edge tiles of the blocked product, and a few big enough to be threaded.
+	const TSize sizes[][3] = { { 1, 1, 1 }, { 7, 13, 5 }, { 17, 33, 9 }, { 65, 129, 257 }, { 130, 70, 300 }, { 300, 200, 260 } };
+	for (const auto& size : sizes)
+	{
+		const TSize m = size[0], n = size[1], k = size[2];
+		TMatrix a(m, k);
+		TMatrix b(k, n);
+		num_vector::fill(a, rng);
+		num_vector::fill(b, rng);
+
+		const TMatrix c = a * b;
+		LASS_TEST_CHECK_EQUAL(c.rows(), m);
+		LASS_TEST_CHECK_EQUAL(c.columns(), n);
+
+		const T tol = static_cast<T>(k) * 10 * std::numeric_limits<T>::epsilon();
+		for (TSize i = 0; i < m; ++i)
+		{
+			for (TSize j = 0; j < n; ++j)
+			{
+				T expected = 0;
+				for (TSize p = 0; p < k; ++p)
+				{
+					expected += a(i, p) * b(p, j);
+				}
+				LASS_TEST_CHECK(std::abs(c(i, j) - expected) <= tol);
+			}
+		}
+	}
+
+	// result aliases an operand
+	TMatrix a(40, 40);
+	TMatrix b(40, 40);
+	num_vector::fill(a, rng);
+	num_vector::fill(b, rng);
+	const TMatrix expected = a * b;
+	a = a * b;
+	LASS_TEST_CHECK(a == expected);
+}
+
+
+namespace num_vector
+{
+
+template <typename T>
+typename num::NumTraits<T>::baseType maxAbsDifference(const num::Matrix<T>& a, const num::Matrix<T>& b)
+{
+	typedef typename num::Matrix<T>::TSize TSize;
+	LASS_TEST_CHECK_EQUAL(a.rows(), b.rows());
+	LASS_TEST_CHECK_EQUAL(a.columns(), b.columns());
+	typename num::NumTraits<T>::baseType result = 0;
+	for (TSize i = 0; i < a.rows(); ++i)
+	{
+		for (TSize j = 0; j < a.columns(); ++j)
+		{
+			result = std::max(result, num::abs(a(i, j) - b(i, j)));
+		}
+	}
+	return result;
+}
+
+template <typename T>
+typename num::NumTraits<T>::baseType decompositionTolerance(size_t n)
+{
+	typedef typename num::NumTraits<T>::baseType TBase;
+	return static_cast<TBase>(n + 1) * 1000 * std::numeric_limits<TBase>::epsilon();
+}
+
+}
+
+template <typename T>
+void testNumLuDecomposition()
+{
+	typedef num::Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	using num_vector::maxAbsDifference;
+
+	num_vector::Generator<T> rng;
+
+	// sizes around the block size of the factorization
+	const TSize sizes[] = { 1, 5, 63, 64, 65, 150 };
+	for (TSize n : sizes)
+	{
+		TMatrix a(n, n);
+		TMatrix b(n, 7);
+		num_vector::fill(a, rng);
+		num_vector::fill(b, rng);
+		const auto tol = num_vector::decompositionTolerance<T>(n);
+
+		num::LuDecomposition<T> lu(a);
+		LASS_TEST_CHECK_EQUAL(lu.size(), n);
+
+		TMatrix x = b;
+		lu.solve(x);
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(a * x), b) < tol);
+
+		// reuse decomposition for a single column
+		std::vector<T> column(n);
+		for (TSize i = 0; i < n; ++i)
+		{
+			column[i] = b(i, 3);
+		}
+		lu.solve(column.begin());
+		for (TSize i = 0; i < n; ++i)
+		{
+			LASS_TEST_CHECK(num::abs(column[i] - x(i, 3)) < tol);
+		}
+
+		TMatrix identity;
+		identity.setIdentity(n);
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(a * lu.inverse()), identity) < tol);
+
+		TMatrix inverse = a;
+		inverse.invert();
+		LASS_TEST_CHECK(maxAbsDifference(inverse, lu.inverse()) < tol);
+	}
+
+	TMatrix a(3, 3);
+	a(0, 0) = 2; a(0, 1) = 1; a(0, 2) = 1;
+	a(1, 0) = 4; a(1, 1) = 3; a(1, 2) = 3;
+	a(2, 0) = 8; a(2, 1) = 7; a(2, 2) = 9;
+	num::LuDecomposition<T> lu(a);
+	LASS_TEST_CHECK(num::abs(lu.determinant() - T(4)) < num_vector::decompositionTolerance<T>(3));
+
+	TMatrix singular(3, 3);
+	singular(0, 0) = 1; singular(0, 1) = 2; singular(0, 2) = 3;
+	singular(1, 0) = 2; singular(1, 1) = 4; singular(1, 2) = 6;
+	singular(2, 0) = 1; singular(2, 1) = 0; singular(2, 2) = 1;
+	LASS_TEST_CHECK_THROW(lu.factorize(singular), util::SingularityError);
+	LASS_TEST_CHECK_EQUAL(lu.size(), TSize(3)); // previous decomposition is kept
+	LASS_TEST_CHECK_THROW(lu.factorize(TMatrix(3, 4)), util::Exception);
+}
+
+template <typename T>
+void testNumCholeskyDecomposition()
+{
+	typedef num::Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	using num_vector::maxAbsDifference;
+
+	num_vector::Generator<T> rng;
+
+	const TSize sizes[] = { 1, 5, 64, 65, 150 };
+	for (TSize n : sizes)
+	{
+		TMatrix m(n, n);
+		num_vector::fill(m, rng);
+		TMatrix a(n, n);
+		for (TSize i = 0; i < n; ++i)
+		{
+			for (TSize j = 0; j < n; ++j)
+			{
+				T sum = i == j ? T(static_cast<int>(n)) : T();
+				for (TSize k = 0; k < n; ++k)
+				{
+					sum += m(i, k) * num::conj(m(j, k));
+				}
+				a(i, j) = sum;
+			}
+		}
+		TMatrix b(n, 5);
+		num_vector::fill(b, rng);
+		const auto tol = num_vector::decompositionTolerance<T>(n * n);
+
+		num::CholeskyDecomposition<T> cholesky(a);
+		LASS_TEST_CHECK_EQUAL(cholesky.size(), n);
+
+		// L L^H == A
+		const TMatrix& llh = cholesky.factors();
+		TMatrix l(n, n);
+		TMatrix lh(n, n);
+		for (TSize i = 0; i < n; ++i)
+		{
+			for (TSize j = 0; j <= i; ++j)
+			{
+				l(i, j) = llh(i, j);
+				lh(j, i) = llh(j, i);
+				LASS_TEST_CHECK_EQUAL(llh(j, i), num::conj(llh(i, j)));
+			}
+		}
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(l * lh), a) < tol);
+
+		TMatrix x = b;
+		cholesky.solve(x);
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(a * x), b) < tol);
+
+		if (n <= 5) // larger ones overflow
+		{
+			num::LuDecomposition<T> lu(a);
+			LASS_TEST_CHECK(num::abs(cholesky.determinant() - lu.determinant()) < tol * num::abs(lu.determinant()));
+		}
+	}
+
+	TMatrix indefinite(2, 2);
+	indefinite(0, 0) = 1; indefinite(0, 1) = 2;
+	indefinite(1, 0) = 2; indefinite(1, 1) = 1;
+	LASS_TEST_CHECK_THROW(num::CholeskyDecomposition<T> cholesky(indefinite), util::SingularityError);
+}
+
+template <typename T>
+void testNumQrDecomposition()
+{
+	typedef num::Matrix<T> TMatrix;
+	typedef typename TMatrix::TSize TSize;
+	using num_vector::maxAbsDifference;
+
+	num_vector::Generator<T> rng;
+
+	// square systems
+	const TSize sizes[] = { 1, 5, 64, 65, 150 };
+	for (TSize n : sizes)
+	{
+		TMatrix a(n, n);
+		TMatrix b(n, 3);
+		num_vector::fill(a, rng);
+		num_vector::fill(b, rng);
+		const auto tol = num_vector::decompositionTolerance<T>(n);
+
+		num::QrDecomposition<T> qr(a);
+		TMatrix x = b;
+		qr.solve(x);
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(a * x), b) < tol);
+
+		// R^H R == A^H A
+		const TMatrix r = qr.r();
+		TMatrix rh(n, n);
+		TMatrix ah(n, n);
+		for (TSize i = 0; i < n; ++i)
+		{
+			for (TSize j = 0; j < n; ++j)
+			{
+				rh(i, j) = num::conj(r(j, i));
+				ah(i, j) = num::conj(a(j, i));
+			}
+		}
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(rh * r), TMatrix(ah * a)) < num_vector::decompositionTolerance<T>(n * n));
+	}
+
+	// least squares: residual must be orthogonal to the columns of A
+	const TSize shapes[][2] = { { 10, 3 }, { 200, 70 }, { 300, 150 } };
+	for (const auto& shape : shapes)
+	{
+		const TSize m = shape[0], n = shape[1];
+		TMatrix a(m, n);
+		TMatrix b(m, 2);
+		num_vector::fill(a, rng);
+		num_vector::fill(b, rng);
+		const auto tol = num_vector::decompositionTolerance<T>(m);
+
+		num::QrDecomposition<T> qr(a);
+		LASS_TEST_CHECK_EQUAL(qr.rows(), m);
+		LASS_TEST_CHECK_EQUAL(qr.columns(), n);
+		TMatrix x = b;
+		qr.solve(x);
+		LASS_TEST_CHECK_EQUAL(x.rows(), n);
+		LASS_TEST_CHECK_EQUAL(x.columns(), b.columns());
+
+		const TMatrix residual = a * x - b;
+		TMatrix ah(n, m);
+		for (TSize i = 0; i < n; ++i)
+		{
+			for (TSize j = 0; j < m; ++j)
+			{
+				ah(i, j) = num::conj(a(j, i));
+			}
+		}
+		LASS_TEST_CHECK(maxAbsDifference(TMatrix(ah * residual), TMatrix(n, b.columns())) < tol);
+	}
+
+	TMatrix rankDeficient(3, 2);
+	rankDeficient(0, 0) = 1; rankDeficient(0, 1) = 0;
+	rankDeficient(1, 0) = 2; rankDeficient(1, 1) = 0;
+	rankDeficient(2, 0) = 3; rankDeficient(2, 1) = 0;
+	num::QrDecomposition<T> qr(rankDeficient);
+	TMatrix x(3, 1);
+	LASS_TEST_CHECK_THROW(qr.solve(x), util::SingularityError);
+	LASS_TEST_CHECK_THROW(qr.factorize(TMatrix(2, 3)), util::Exception);
+}
+
+
 template <typename T>
 void testNumCramer()
 {
@@ -525,6 +906,19 @@ TUnitTest test_num_matrix_vector()
 
 		LASS_TEST_CASE(testNumMatrixInverse<float>),
 		LASS_TEST_CASE(testNumMatrixInverse<double>),
+		LASS_TEST_CASE(testNumVectorLarge<float>),
+		LASS_TEST_CASE(testNumVectorLarge<double>),
+		LASS_TEST_CASE(testNumMatrixProduct<float>),
+		LASS_TEST_CASE(testNumMatrixProduct<double>),
+		LASS_TEST_CASE(testNumLuDecomposition<float>),
+		LASS_TEST_CASE(testNumLuDecomposition<double>),
+		LASS_TEST_CASE(testNumLuDecomposition< std::complex<double> >),
+		LASS_TEST_CASE(testNumCholeskyDecomposition<float>),
+		LASS_TEST_CASE(testNumCholeskyDecomposition<double>),
+		LASS_TEST_CASE(testNumCholeskyDecomposition< std::complex<double> >),
+		LASS_TEST_CASE(testNumQrDecomposition<float>),
+		LASS_TEST_CASE(testNumQrDecomposition<double>),
+		LASS_TEST_CASE(testNumQrDecomposition< std::complex<double> >),
 
 		LASS_TEST_CASE(testNumMatrixSolve<float>),
 		LASS_TEST_CASE(testNumMatrixSolve<double>),
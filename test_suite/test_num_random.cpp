@@ -46,6 +46,8 @@
 #include "../lass/num/distribution.h"
 #include "../lass/io/file_attribute.h"
 
+#include <random>
+
 #if LASS_COMPILER_TYPE == LASS_COMPILER_TYPE_MSVC
 #	pragma warning(disable: 4996) // 'deprecated-declaration': deprecation-message (or "was declared deprecated")
 #else
@@ -206,12 +208,166 @@ void testNumDistributions()
 	LASS_TEST_CHECK_CLOSE(variance, 100. * 100., tolerance);
 }
 
+void testNumRandomXoshiro()
+{
+	typedef num::RandomXoshiro256PlusPlus TRandom;
+
+	// first draws of the reference implementation from state {1, 2, 3, 4}
+	//
+	const TRandom::result_type state[4] = { 1, 2, 3, 4 };
+	TRandom random;
+	random.setState(state, state + 4);
+	LASS_TEST_CHECK_EQUAL(random(), TRandom::result_type(41943041));
+	LASS_TEST_CHECK_EQUAL(random(), TRandom::result_type(58720359));
+
+	// fill draws the same sequence as operator()
+	//
+	TRandom a(42);
+	TRandom b(42);
+	std::vector<TRandom::result_type> draws(1000);
+	a.fill(&draws[0], &draws[0] + draws.size());
+	for (size_t k = 0; k < draws.size(); ++k)
+	{
+		LASS_TEST_CHECK_EQUAL(draws[k], b());
+	}
+
+	// split returns the current stream, and long-jumps the generator itself
+	//
+	TRandom c(7);
+	TRandom d(7);
+	TRandom e(7);
+	TRandom f = c.split();
+	d.longJump();
+	for (size_t k = 0; k < 100; ++k)
+	{
+		LASS_TEST_CHECK_EQUAL(f(), e());
+		LASS_TEST_CHECK_EQUAL(c(), d());
+	}
+}
+
+
+void testNumRandomXoshiroX8()
+{
+	typedef num::RandomXoshiro256PlusPlusX8 TRandom;
+	typedef num::RandomXoshiro256PlusPlus TLane;
+	const size_t numLanes = TRandom::numLanes;
+
+	// draw n comes from lane n % numLanes, lane k being the scalar generator jumped k times.
+	// Draw by a mix of operator() and fill() of odd sizes, that should not matter.
+	//
+	TRandom random(1234);
+	std::vector<TRandom::result_type> draws;
+	for (size_t size = 0; size < 30; ++size)
+	{
+		draws.push_back(random());
+		const size_t n = draws.size();
+		draws.resize(n + size);
+		random.fill(&draws[0] + n, &draws[0] + n + size);
+	}
+	std::vector<TLane> lanes;
+	TLane lane(1234);
+	for (size_t k = 0; k < numLanes; ++k)
+	{
+		lanes.push_back(lane);
+		lane.jump();
+	}
+	for (size_t n = 0; n < draws.size(); ++n)
+	{
+		LASS_TEST_CHECK_EQUAL(draws[n], lanes[n % numLanes]());
+	}
+
+	// streams split off in a fixed order are reproducible, and different from each other.
+	//
+	TRandom master1(99);
+	TRandom master2(99);
+	std::vector<TRandom> streams;
+	for (size_t k = 0; k < 4; ++k)
+	{
+		streams.push_back(master1.split());
+	}
+	std::vector<TRandom::result_type> a(100);
+	std::vector<TRandom::result_type> b(100);
+	std::vector<TRandom::result_type> previous;
+	for (size_t k = 0; k < 4; ++k)
+	{
+		TRandom stream = master2.split();
+		streams[k].fill(&a[0], &a[0] + a.size());
+		stream.fill(&b[0], &b[0] + b.size());
+		LASS_TEST_CHECK(a == b);
+		LASS_TEST_CHECK(a != previous);
+		previous = a;
+	}
+}
+
+
+template <typename T, typename RandomGenerator>
+void testNumFillDistributions()
+{
+	const size_t testSize = 100000;
+	const T tolerance = T(.05);
+
+	RandomGenerator random;
+	std::vector<T> draws(testSize);
+
+	auto moments = [&draws](T& mean, T& variance)
+	{
+		double sum = 0;
+		double sum2 = 0;
+		for (T x : draws)
+		{
+			sum += x;
+			sum2 += static_cast<double>(x) * x;
+		}
+		const double n = static_cast<double>(draws.size());
+		mean = static_cast<T>(sum / n);
+		variance = static_cast<T>(sum2 / n - num::sqr(sum / n));
+	};
+	T mean;
+	T variance;
+
+	num::fillUniform(random, draws.begin(), draws.end());
+	for (T x : draws)
+	{
+		LASS_TEST_CHECK(x >= 0 && x < 1);
+	}
+	moments(mean, variance);
+	LASS_TEST_CHECK_CLOSE(mean, T(.5), tolerance);
+	LASS_TEST_CHECK_CLOSE(variance, T(1) / 12, tolerance);
+
+	num::fillUniform(random, draws.begin(), draws.end(), T(-100), T(200));
+	for (T x : draws)
+	{
+		LASS_TEST_CHECK(x >= -100 && x < 200);
+	}
+	moments(mean, variance);
+	LASS_TEST_CHECK_CLOSE(mean, T(50), tolerance);
+	LASS_TEST_CHECK_CLOSE(variance, T(300 * 300) / 12, tolerance);
+
+	num::fillNormal(random, draws.begin(), draws.end());
+	moments(mean, variance);
+	LASS_TEST_CHECK(num::abs(mean) < tolerance);
+	LASS_TEST_CHECK_CLOSE(variance, T(1), tolerance);
+
+	// odd sizes
+	num::fillNormal(random, draws.begin(), draws.begin() + 12345, T(200), T(100));
+	draws.resize(12345);
+	moments(mean, variance);
+	LASS_TEST_CHECK_CLOSE(mean, T(200), tolerance);
+	LASS_TEST_CHECK_CLOSE(variance, T(100 * 100), tolerance);
+}
+
+
 TUnitTest test_num_random()
 {
 	TUnitTest result;
 	result.push_back(LASS_TEST_CASE(testNumRandomMersenne));
 	result.push_back(LASS_TEST_CASE(testNumRandomXKCD));
 	result.push_back(LASS_TEST_CASE(testNumDistributions));
+	result.push_back(LASS_TEST_CASE(testNumRandomXoshiro));
+	result.push_back(LASS_TEST_CASE(testNumRandomXoshiroX8));
+	result.push_back(LASS_TEST_CASE((testNumFillDistributions<float, num::RandomXoshiro256PlusPlusX8>)));
+	result.push_back(LASS_TEST_CASE((testNumFillDistributions<double, num::RandomXoshiro256PlusPlusX8>)));
+	result.push_back(LASS_TEST_CASE((testNumFillDistributions<double, std::mt19937_64>)));
 	return result;
 }
 
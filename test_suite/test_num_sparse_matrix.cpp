@@ -0,0 +1,346 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "test_common.h"
+
+#include "../lass/num/sparse_matrix.h"
+#include "../lass/num/iterative_solvers.h"
+
+#include <random>
+
+namespace lass
+{
+namespace test
+{
+namespace sparse_matrix
+{
+
+template <typename T>
+num::SparseMatrix<T> randomSparseMatrix(size_t rows, size_t columns, size_t nonZerosPerRow, std::mt19937_64& random)
+{
+	typedef typename num::SparseMatrix<T>::Entry TEntry;
+	std::uniform_int_distribution<size_t> column(0, columns - 1);
+	std::uniform_real_distribution<T> value(-1, 1);
+	std::vector<TEntry> entries;
+	for (size_t i = 0; i < rows; ++i)
+	{
+		for (size_t k = 0; k < nonZerosPerRow; ++k)
+		{
+			entries.push_back(TEntry{ i, column(random), value(random) });
+		}
+	}
+	return num::SparseMatrix<T>(rows, columns, entries.begin(), entries.end());
+}
+
+/** 5-point finite difference Laplacian on a size x size grid, plus an upwind convection term
+ *  that makes it nonsymmetric.
+ */
+template <typename T>
+num::SparseMatrix<T> laplacian(size_t size, T convection)
+{
+	typedef typename num::SparseMatrix<T>::Entry TEntry;
+	std::vector<TEntry> entries;
+	const size_t n = size * size;
+	for (size_t y = 0; y < size; ++y)
+	{
+		for (size_t x = 0; x < size; ++x)
+		{
+			const size_t i = y * size + x;
+			entries.push_back(TEntry{ i, i, 4 + convection });
+			if (x > 0) entries.push_back(TEntry{ i, i - 1, -1 - convection });
+			if (x + 1 < size) entries.push_back(TEntry{ i, i + 1, -1 });
+			if (y > 0) entries.push_back(TEntry{ i, i - size, -1 });
+			if (y + 1 < size) entries.push_back(TEntry{ i, i + size, -1 });
+		}
+	}
+	return num::SparseMatrix<T>(n, n, entries.begin(), entries.end());
+}
+
+template <typename T>
+T trueResidual(const num::SparseMatrix<T>& a, const num::Vector<T>& b, const num::Vector<T>& x)
+{
+	num::Vector<T> ax;
+	ax = a * x;
+	return num::Vector<T>(b - ax).norm() / b.norm();
+}
+
+}
+
+template <typename T>
+void testNumSparseMatrix()
+{
+	typedef num::SparseMatrix<T> TSparseMatrix;
+	typedef typename TSparseMatrix::Entry TEntry;
+	typedef typename TSparseMatrix::TIndices TIndices;
+	typedef typename TSparseMatrix::TValues TValues;
+
+	// unsorted entries with duplicates
+	const TEntry entries[] = { { 2, 1, 5 }, { 0, 2, 1 }, { 0, 0, 2 }, { 2, 1, 3 }, { 1, 1, 4 }, { 0, 2, -1 } };
+	const TSparseMatrix a(3, 4, std::begin(entries), std::end(entries));
+	LASS_TEST_CHECK_EQUAL(a.rows(), size_t(3));
+	LASS_TEST_CHECK_EQUAL(a.columns(), size_t(4));
+	LASS_TEST_CHECK_EQUAL(a.nonZeros(), size_t(4)); // explicit zero at (0, 2) is kept.
+	LASS_TEST_CHECK_EQUAL(a(0, 0), T(2));
+	LASS_TEST_CHECK_EQUAL(a(0, 2), T(0));
+	LASS_TEST_CHECK_EQUAL(a(1, 1), T(4));
+	LASS_TEST_CHECK_EQUAL(a(2, 1), T(8));
+	LASS_TEST_CHECK_EQUAL(a(2, 3), T(0));
+	LASS_TEST_CHECK(a.rowPointers() == TIndices({ 0, 2, 3, 4 }));
+	LASS_TEST_CHECK(a.columnIndices() == TIndices({ 0, 2, 1, 1 }));
+
+	const num::Matrix<T> dense = a.dense();
+	LASS_TEST_CHECK_EQUAL(dense(2, 1), T(8));
+	const TSparseMatrix b(dense);
+	LASS_TEST_CHECK_EQUAL(b.nonZeros(), size_t(3));
+	LASS_TEST_CHECK(b.dense() == dense);
+
+	const TSparseMatrix at = a.transposed();
+	LASS_TEST_CHECK_EQUAL(at.rows(), size_t(4));
+	LASS_TEST_CHECK_EQUAL(at.columns(), size_t(3));
+	LASS_TEST_CHECK(at.dense() == dense.transposed());
+	LASS_TEST_CHECK(at.transposed().dense() == dense);
+
+	const num::Vector<T> diagonal = a.diagonal();
+	LASS_TEST_CHECK_EQUAL(diagonal.size(), size_t(3));
+	LASS_TEST_CHECK_EQUAL(diagonal[1], T(4));
+	LASS_TEST_CHECK_EQUAL(diagonal[2], T(0));
+
+	const TSparseMatrix c(2, 2, TIndices{ 0, 1, 2 }, TIndices{ 1, 0 }, TValues{ 3, 7 });
+	LASS_TEST_CHECK_EQUAL(c(0, 1), T(3));
+	LASS_TEST_CHECK_EQUAL(c(1, 0), T(7));
+	LASS_TEST_CHECK_THROW(TSparseMatrix(2, 2, TIndices{ 0, 2, 2 }, TIndices{ 1, 0 }, TValues{ 3, 7 }), util::Exception);
+	LASS_TEST_CHECK_THROW(TSparseMatrix(2, 2, TIndices{ 0, 1, 2 }, TIndices{ 1, 2 }, TValues{ 3, 7 }), util::Exception);
+	const TEntry outOfBounds[] = { { 3, 0, 1 } };
+	LASS_TEST_CHECK_THROW(TSparseMatrix(3, 3, std::begin(outOfBounds), std::end(outOfBounds)), util::Exception);
+}
+
+template <typename T>
+void testNumSparseMatrixVector()
+{
+	typedef num::SparseMatrix<T> TSparseMatrix;
+	typedef num::Vector<T> TVector;
+
+	std::mt19937_64 random;
+	std::uniform_real_distribution<T> value(-1, 1);
+	const T tolerance = 100 * std::numeric_limits<T>::epsilon();
+
+	// small enough to compare with dense product
+	{
+		const TSparseMatrix a = sparse_matrix::randomSparseMatrix<T>(50, 70, 5, random);
+		TVector x(70);
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			x[i] = value(random);
+		}
+		TVector y;
+		y = a * x;
+		const TVector expected = a.dense() * x;
+		LASS_TEST_CHECK_EQUAL(y.size(), size_t(50));
+		for (size_t i = 0; i < y.size(); ++i)
+		{
+			LASS_TEST_CHECK_CLOSE(y[i], expected[i], tolerance);
+		}
+
+		// as part of a larger expression
+		const TVector z = y - a * x;
+		LASS_TEST_CHECK(z.isZero());
+	}
+
+	// large enough to be evaluated in parallel, and result aliasing the operand
+	{
+		const size_t n = 100000;
+		const TSparseMatrix a = sparse_matrix::randomSparseMatrix<T>(n, n, 7, random);
+		TVector x(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			x[i] = value(random);
+		}
+		TVector y;
+		y = a * x;
+		for (size_t i = 0; i < n; i += 997)
+		{
+			T expected = 0;
+			for (size_t k = a.rowPointers()[i]; k < a.rowPointers()[i + 1]; ++k)
+			{
+				expected += a.values()[k] * x[a.columnIndices()[k]];
+			}
+			LASS_TEST_CHECK_EQUAL(y[i], expected);
+		}
+		x = a * x;
+		LASS_TEST_CHECK(x == y);
+	}
+
+	LASS_TEST_CHECK_THROW(TSparseMatrix(3, 4) * TVector(3), util::Exception);
+}
+
+template <typename T>
+void testNumConjugateGradient()
+{
+	typedef num::SparseMatrix<T> TSparseMatrix;
+	typedef num::Vector<T> TVector;
+
+	const size_t size = 100;
+	const TSparseMatrix a = sparse_matrix::laplacian<T>(size, 0);
+	TVector b(size * size);
+	for (size_t i = 0; i < b.size(); ++i)
+	{
+		b[i] = T(1) + T(i % 7);
+	}
+	const T tolerance = static_cast<T>(1e-8);
+	const size_t maxIterations = 1000;
+
+	TVector x0;
+	const auto plain = num::conjugateGradient(a, b, x0, tolerance, maxIterations);
+	LASS_TEST_CHECK(plain.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x0) < 10 * tolerance);
+
+	TVector x1;
+	const auto jacobi = num::conjugateGradient(a, b, x1, num::JacobiPreconditioner<T>(a), tolerance, maxIterations);
+	LASS_TEST_CHECK(jacobi.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x1) < 10 * tolerance);
+
+	TVector x2;
+	const auto ilu = num::conjugateGradient(a, b, x2, num::Ilu0Preconditioner<T>(a), tolerance, maxIterations);
+	LASS_TEST_CHECK(ilu.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x2) < 10 * tolerance);
+	LASS_TEST_CHECK(ilu.iterations < plain.iterations);
+
+	// restarting from the solution takes no iterations
+	const auto restart = num::conjugateGradient(a, b, x2, tolerance, maxIterations);
+	LASS_TEST_CHECK(restart.converged);
+	LASS_TEST_CHECK_EQUAL(restart.iterations, size_t(0));
+
+	// not enough iterations
+	TVector x3;
+	const auto early = num::conjugateGradient(a, b, x3, tolerance, 5);
+	LASS_TEST_CHECK(!early.converged);
+	LASS_TEST_CHECK_EQUAL(early.iterations, size_t(5));
+	LASS_TEST_CHECK(early.residual > tolerance);
+
+	// works with dense matrices too
+	const num::Matrix<T> dense = sparse_matrix::laplacian<T>(10, 0).dense();
+	TVector bb(100, 1);
+	TVector xx;
+	LASS_TEST_CHECK(num::conjugateGradient(dense, bb, xx, tolerance, maxIterations).converged);
+}
+
+template <typename T>
+void testNumBiConjugateGradientStabilized()
+{
+	typedef num::SparseMatrix<T> TSparseMatrix;
+	typedef num::Vector<T> TVector;
+
+	const size_t size = 100;
+	const TSparseMatrix a = sparse_matrix::laplacian<T>(size, 2);
+	TVector b(size * size);
+	for (size_t i = 0; i < b.size(); ++i)
+	{
+		b[i] = T(1) + T(i % 5);
+	}
+	const T tolerance = static_cast<T>(1e-8);
+	const size_t maxIterations = 1000;
+
+	TVector x0;
+	const auto plain = num::biConjugateGradientStabilized(a, b, x0, tolerance, maxIterations);
+	LASS_TEST_CHECK(plain.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x0) < 10 * tolerance);
+
+	TVector x1;
+	const auto jacobi = num::biConjugateGradientStabilized(a, b, x1, num::JacobiPreconditioner<T>(a), tolerance, maxIterations);
+	LASS_TEST_CHECK(jacobi.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x1) < 10 * tolerance);
+
+	TVector x2;
+	const auto ilu = num::biConjugateGradientStabilized(a, b, x2, num::Ilu0Preconditioner<T>(a), tolerance, maxIterations);
+	LASS_TEST_CHECK(ilu.converged);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(a, b, x2) < 10 * tolerance);
+	LASS_TEST_CHECK(ilu.iterations < plain.iterations);
+}
+
+template <typename T>
+void testNumPreconditioners()
+{
+	typedef num::SparseMatrix<T> TSparseMatrix;
+	typedef typename TSparseMatrix::Entry TEntry;
+
+	// ILU(0) of a tridiagonal matrix is its exact LU decomposition.
+	std::vector<TEntry> entries;
+	const size_t n = 20;
+	for (size_t i = 0; i < n; ++i)
+	{
+		entries.push_back(TEntry{ i, i, 2 });
+		if (i > 0) entries.push_back(TEntry{ i, i - 1, -1 });
+		if (i + 1 < n) entries.push_back(TEntry{ i, i + 1, -1 });
+	}
+	const TSparseMatrix tridiagonal(n, n, entries.begin(), entries.end());
+	const num::Ilu0Preconditioner<T> ilu(tridiagonal);
+	num::Vector<T> b(n, 1);
+	num::Vector<T> x;
+	ilu.apply(b, x);
+	LASS_TEST_CHECK(sparse_matrix::trueResidual(tridiagonal, b, x) < 100 * std::numeric_limits<T>::epsilon());
+
+	const TEntry noDiagonal[] = { { 0, 1, 1 }, { 1, 0, 1 } };
+	const TSparseMatrix b2(2, 2, std::begin(noDiagonal), std::end(noDiagonal));
+	LASS_TEST_CHECK_THROW(num::Ilu0Preconditioner<T> ilu2(b2), util::SingularityError);
+	LASS_TEST_CHECK_THROW(num::JacobiPreconditioner<T> jacobi(b2), util::SingularityError);
+}
+
+TUnitTest test_num_sparse_matrix()
+{
+	return TUnitTest{
+		LASS_TEST_CASE(testNumSparseMatrix<float>),
+		LASS_TEST_CASE(testNumSparseMatrix<double>),
+		LASS_TEST_CASE(testNumSparseMatrixVector<float>),
+		LASS_TEST_CASE(testNumSparseMatrixVector<double>),
+		LASS_TEST_CASE(testNumConjugateGradient<double>),
+		LASS_TEST_CASE(testNumBiConjugateGradientStabilized<double>),
+		LASS_TEST_CASE(testNumPreconditioners<float>),
+		LASS_TEST_CASE(testNumPreconditioners<double>),
+	};
+}
+
+}
+
+}
+
+// EOF
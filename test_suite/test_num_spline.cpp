@@ -49,6 +49,8 @@
 #include "../lass/io/file_attribute.h"
 #include "../lass/stde/extended_string.h"
 
+#include <random>
+
 namespace lass
 {
 namespace test
@@ -124,6 +126,32 @@ void testSpline(const SplineType& iSpline, test::TestStream& ioPattern,
 	}
 }
 
+/** checks that evaluate gives the same as evaluating one by one, with and without lookup grid.
+ */
+template <typename SplineType, typename T, typename Distance>
+void testEvaluate(SplineType& spline, const std::vector<T>& xs, Distance distance)
+{
+	typedef typename SplineType::TData TData;
+
+	const size_t gridSizes[] = { 0, 1, 7, 100, 1000 };
+	for (size_t numCells : gridSizes)
+	{
+		spline.setLookupCells(numCells);
+		std::vector<TData> ys(xs.size());
+		LASS_TEST_CHECK(spline.evaluate(xs.begin(), xs.end(), ys.begin()) == ys.end());
+		size_t numErrors = 0;
+		for (size_t i = 0; i < xs.size(); ++i)
+		{
+			if (!(distance(ys[i], spline(xs[i])) <= 1e-12))
+			{
+				++numErrors;
+			}
+		}
+		LASS_TEST_CHECK_EQUAL(numErrors, size_t(0));
+	}
+	spline.setLookupCells(0);
+}
+
 }
 
 /*
@@ -241,11 +269,87 @@ void testNumSpline2Points()
 }
 
 
+void testNumSplineEvaluate()
+{
+	typedef double TScalar;
+	typedef prim::Vector3D<double> TVector3D;
+
+	// unevenly spread nodes
+	std::mt19937 rng;
+	std::uniform_real_distribution<TScalar> step(0.01, 1);
+	std::uniform_real_distribution<TScalar> value(-1, 1);
+	const size_t numNodes = 200;
+	std::vector<TScalar> controls;
+	std::vector<TScalar> scalars;
+	std::vector<TVector3D> vectors;
+	TScalar x = 0;
+	for (size_t i = 0; i < numNodes; ++i)
+	{
+		x += i % 50 < 10 ? step(rng) / 100 : step(rng);
+		controls.push_back(x);
+		scalars.push_back(value(rng));
+		vectors.push_back(TVector3D(value(rng), value(rng), value(rng)));
+	}
+	const TScalar begin = controls.front() - 1;
+	const TScalar end = controls.back() + 1;
+
+	// sorted, reversed, random and clustered control values, all partly out of range.
+	std::vector<TScalar> xs;
+	const size_t numValues = 1000;
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		xs.push_back(begin + (end - begin) * static_cast<TScalar>(i) / static_cast<TScalar>(numValues - 1));
+	}
+	xs.insert(xs.end(), xs.rbegin(), xs.rend());
+	std::uniform_real_distribution<TScalar> anywhere(begin, end);
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		xs.push_back(anywhere(rng));
+	}
+	for (size_t i = 0; i < numValues; ++i)
+	{
+		xs.push_back(controls[(i / 100) * 17 % numNodes] + value(rng) / 10);
+	}
+	xs.insert(xs.end(), controls.begin(), controls.end());
+
+	auto scalarDistance = [](TScalar a, TScalar b) { return num::abs(a - b); };
+	auto vectorDistance = [](const TVector3D& a, const TVector3D& b) { return (a - b).norm(); };
+
+	num::SplineLinear<TScalar, TScalar, num::DataTraitsScalar<TScalar> > linear(controls.begin(), controls.end(), scalars.begin());
+	num_spline::testEvaluate(linear, xs, scalarDistance);
+	num::SplineCubic<TScalar, TScalar, num::DataTraitsScalar<TScalar> > cubic(controls.begin(), controls.end(), scalars.begin());
+	num_spline::testEvaluate(cubic, xs, scalarDistance);
+
+	num::SplineLinear<TScalar, TVector3D, num::DataTraitsStaticVector<TVector3D> > linear3D(controls.begin(), controls.end(), vectors.begin());
+	num_spline::testEvaluate(linear3D, xs, vectorDistance);
+	num::SplineCubic<TScalar, TVector3D, num::DataTraitsStaticVector<TVector3D> > cubic3D(controls.begin(), controls.end(), vectors.begin());
+	num_spline::testEvaluate(cubic3D, xs, vectorDistance);
+
+	// a lookup grid doesn't change single evaluations either.
+	std::vector<TScalar> expected(xs.size());
+	for (size_t i = 0; i < xs.size(); ++i)
+	{
+		expected[i] = cubic(xs[i]);
+	}
+	cubic.setLookupCells(numNodes);
+	size_t numErrors = 0;
+	for (size_t i = 0; i < xs.size(); ++i)
+	{
+		if (cubic(xs[i]) != expected[i])
+		{
+			++numErrors;
+		}
+	}
+	LASS_TEST_CHECK_EQUAL(numErrors, size_t(0));
+}
+
+
 TUnitTest test_num_spline()
 {
 	TUnitTest result;
 	result.push_back(LASS_TEST_CASE(testNumSpline2Points));
 	result.push_back(LASS_TEST_CASE(testNumSpline));
+	result.push_back(LASS_TEST_CASE(testNumSplineEvaluate));
 	return result;
 }
 
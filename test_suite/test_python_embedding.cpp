@@ -104,11 +104,62 @@ void testPythonEmbedding()
 	LASS_TEST_CHECK_EQUAL(PyRun_SimpleFileEx(fp, testFile.c_str(), 1), 0);
 }
 
+/** Measures the time of a call from Python into an exported function or method.
+ *  The time of an empty statement is subtracted, so this is the overhead of the dispatcher
+ *  and argument conversion.
+ */
+void testPythonCallOverhead()
+{
+	initPythonEmbedding();
+
+	python::LockGIL lock;
+	LASS_TEST_CHECK_NO_THROW(python::execute(
+		"import timeit\n"
+		"import embedding\n"
+		"def lassCallOverhead(stmt, number=200000):\n"
+		"    g = {'embedding': embedding, 'bar': embedding.Bar(), 'points': [(float(i), 0.5, 2) for i in range(1000)]}\n"
+		"    base = min(timeit.repeat('pass', globals=g, number=number, repeat=3))\n"
+		"    best = min(timeit.repeat(stmt, globals=g, number=number, repeat=3))\n"
+		"    return max(best - base, 0.0) / number\n"
+	));
+
+	int i = 0;
+	LASS_TEST_CHECK_EQUAL(python::pyGetSimpleObject(python::evaluate("embedding.callOverhead(1, 2.5)").get(), i), 0);
+	LASS_TEST_CHECK_EQUAL(i, 3);
+
+	const char* statements[] =
+	{
+		"embedding.callOverhead(1, 2.5)",
+		"embedding.callOverheadHoldGil(1, 2.5)", // without releasing the GIL
+		"bar.aMoreComplexFunction(1.0, 2.0)",
+		"embedding.Bar.aStaticMethod(1.5)",
+		"embedding.callOverheadOverloaded(1, 2.5)", // third overload in chain
+	};
+	for (const char* stmt : statements)
+	{
+		python::TPyObjPtr result;
+		LASS_TEST_CHECK_NO_THROW(result = python::evaluate(std::string("lassCallOverhead('") + stmt + "')"));
+		double seconds = 0;
+		LASS_TEST_CHECK_EQUAL(python::pyGetSimpleObject(result.get(), seconds), 0);
+		LASS_COUT << "call overhead of " << stmt << ": " << seconds * 1e9 << " ns\n";
+	}
+
+	// converting a list of 1000 tuples to std::vector<Point3D<double>>
+	{
+		python::TPyObjPtr result;
+		LASS_TEST_CHECK_NO_THROW(result = python::evaluate("lassCallOverhead('embedding.sumPoints(points)', number=500)"));
+		double seconds = 0;
+		LASS_TEST_CHECK_EQUAL(python::pyGetSimpleObject(result.get(), seconds), 0);
+		LASS_COUT << "conversion of Point3D from tuple: " << seconds * 1e9 / 1000 << " ns\n";
+	}
+}
+
 TUnitTest test_python_embedding()
 {
 	return TUnitTest({
 		LASS_TEST_CASE(testPythonUtils),
 		LASS_TEST_CASE(testPythonEmbedding),
+		LASS_TEST_CASE(testPythonCallOverhead),
 	});
 }
 
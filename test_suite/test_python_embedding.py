@@ -37,7 +37,9 @@
 
 from __future__ import annotations
 
+import array
 import cmath
+import ctypes
 import datetime
 import enum
 import errno
@@ -47,6 +49,7 @@ import math
 import os
 import struct
 import sys
+import threading
 import unittest
 from collections.abc import (
     Callable,
@@ -57,7 +60,8 @@ from collections.abc import (
     Sequence,
 )
 from contextlib import redirect_stdout
-from typing import TYPE_CHECKING, Any, Optional, Protocol
+from fractions import Fraction
+from typing import TYPE_CHECKING, Any, NamedTuple, Optional, Protocol
 
 if TYPE_CHECKING:
     if sys.version_info < (3, 11):
@@ -538,6 +542,110 @@ class TestSequence(unittest.TestCase):
         self._testConstSequence(bar.constDeque, bar.writeableDeque)  # type: ignore[arg-type]
 
 
+class Point3(NamedTuple):
+    x: float
+    y: float
+    z: float
+
+
+class TestBufferProtocol(unittest.TestCase):
+    def testExportScalars(self) -> None:
+        bar = embedding.Bar()
+        bar.writeableVector = [1.0, 2.0, 3.0]
+        seq = bar.writeableVector
+        assert seq is not None
+        with memoryview(seq) as view:  # type: ignore[arg-type]
+            self.assertEqual(view.format, "d")
+            self.assertEqual(view.shape, (3,))
+            self.assertEqual(view.strides, (8,))
+            self.assertFalse(view.readonly)
+            self.assertEqual(view.tolist(), [1.0, 2.0, 3.0])
+            view[1] = 5.0
+            self.assertEqual(seq[1], 5.0)  # no copy was made
+            seq[0] = 7.0
+            self.assertEqual(view[0], 7.0)
+            with self.assertRaises(BufferError):
+                seq.append(4.0)
+            with self.assertRaises(BufferError):
+                del seq[0]
+            with self.assertRaises(BufferError):
+                seq.clear()
+            seq[0:2] = [8.0, 9.0]  # same size is fine
+        seq.append(4.0)
+        self.assertEqual(list(seq), [8.0, 9.0, 3.0, 4.0])
+
+    def testExportReadOnly(self) -> None:
+        bar = embedding.Bar()
+        bar.writeableVector = [1.0, 2.0]
+        assert bar.constVector is not None
+        with memoryview(bar.constVector) as view:  # type: ignore[arg-type]
+            self.assertTrue(view.readonly)
+            self.assertEqual(view.tolist(), [1.0, 2.0])
+            with self.assertRaises(TypeError):
+                view[0] = 3.0
+
+    def testExportPoints(self) -> None:
+        points = embedding.makePoints(4)
+        with memoryview(points) as view:  # type: ignore[arg-type]
+            self.assertEqual(view.format, "d")
+            self.assertEqual(view.ndim, 2)
+            self.assertEqual(view.shape, (4, 3))
+            self.assertEqual(view.tolist(), [[i, 2 * i, 3 * i] for i in range(4)])
+        with memoryview(embedding.makePoints(0)) as view:  # type: ignore[arg-type]
+            self.assertEqual(view.shape, (0, 3))
+
+    def testExportNotContiguous(self) -> None:
+        bar = embedding.Bar()
+        with self.assertRaises(BufferError):
+            memoryview(bar.writeableList)  # type: ignore[arg-type]
+
+    def testImport(self) -> None:
+        bar = embedding.Bar()
+        bar.writeableVector = array.array("d", [1.0, 2.0, 3.0, 4.0])
+        self.assertEqual(list(bar.writeableVector), [1.0, 2.0, 3.0, 4.0])
+        # strided
+        bar.writeableVector = memoryview(array.array("d", [1.0, 2.0, 3.0, 4.0]))[::2]
+        self.assertEqual(list(bar.writeableVector), [1.0, 3.0])
+        # format mismatch falls back to sequence protocol
+        bar.writeableVector = array.array("i", [1, 2, 3])
+        self.assertEqual(list(bar.writeableVector), [1.0, 2.0, 3.0])
+        # two dimensional
+        flat = array.array("d", range(12))
+        view = memoryview(flat).cast("B").cast("d", (4, 3))
+        self.assertEqual(embedding.sumPoints(view), (18.0, 22.0, 26.0))  # type: ignore[arg-type]
+        self.assertEqual(
+            embedding.sumPoints(embedding.makePoints(4)), (6.0, 12.0, 18.0)
+        )
+        # flat
+        self.assertEqual(embedding.sumPoints(flat), (18.0, 22.0, 26.0))  # type: ignore[arg-type]
+        with self.assertRaises(TypeError):
+            embedding.sumPoints(array.array("d", range(10)))  # type: ignore[arg-type]
+
+    def testImportSequenceOfTuples(self) -> None:
+        expected = (6.0, 12.0, 18.0)
+        points = [(float(i), 2.0 * i, 3.0 * i) for i in range(4)]
+        self.assertEqual(embedding.sumPoints(points), expected)
+        self.assertEqual(embedding.sumPoints(tuple(points)), expected)
+        self.assertEqual(embedding.sumPoints([list(p) for p in points]), expected)
+        # ints, and types that need the full conversion rules, mixed in.
+        mixed = [(0, 0, 0), (1, 2.0, 3), (Fraction(2), 4, 6.0), Point3(3.0, 6.0, 9.0)]
+        self.assertEqual(embedding.sumPoints(mixed), expected)
+        with self.assertRaisesRegex(TypeError, "sequence element 1"):
+            embedding.sumPoints([(1.0, 2.0, 3.0), (1.0, "2", 3.0)])  # type: ignore[list-item]
+        with self.assertRaisesRegex(TypeError, "sequence element 0"):
+            embedding.sumPoints([(1.0, 2.0)])  # type: ignore[list-item]
+
+    def testImportSequenceMutatedDuringConversion(self) -> None:
+        class Shrink:
+            def __float__(self) -> float:
+                del points[:]
+                return 1.0
+
+        # converting the first element empties the list, and drops the last reference to that element.
+        points = [(Shrink(), 0.0, 0.0), (1.0, 2.0, 3.0), (4.0, 5.0, 6.0)]
+        self.assertEqual(embedding.sumPoints(points), (1.0, 0.0, 0.0))  # type: ignore[arg-type]
+
+
 class TestDocstrings(unittest.TestCase):
     def testDocstrings(self) -> None:
         self.assertEqual(embedding.__doc__, "Documentation for module embedding")
@@ -796,6 +904,154 @@ transformation: ((1, 2, 3, 4), (5, 6, 7, 8), (9, 10, 11, 12), (13, 14, 15, 16))
         matrix2 = ((1, 2, 3, 4), [5, 6, 7, 8], (9, 10, 11, 12), (13, 14, 15, 16))
         self.assertEqual(bar.tester(box, "y", matrix2), answer)  # type: ignore[call-overload]
 
+    def testOverloadCache(self) -> None:
+        # resolution is cached on argument types, but must give the same overload as without cache.
+        for _ in range(3):
+            self.assertEqual(embedding.callOverheadOverloaded(1, 2.5), 3)
+            self.assertEqual(embedding.callOverheadOverloaded("abc", 2.5), 5)
+            self.assertEqual(embedding.callOverheadOverloaded(["a", "b"], 2.5), 4)
+        # same types, but only some values are accepted by the first overloads.
+        for _ in range(3):
+            self.assertEqual(embedding.overloadCache(("a", "b")), 2)
+            self.assertEqual(embedding.overloadCache((1, 2)), 1)
+            self.assertEqual(embedding.overloadCache((1, 2, 3)), 3)
+            self.assertEqual(embedding.overloadCache([1, 2]), 1)
+            self.assertEqual(embedding.overloadCache([1, 2, 3]), 3)
+        with self.assertRaises(TypeError):
+            embedding.overloadCache(("a", 2))  # type: ignore[call-overload]
+        self.assertEqual(embedding.overloadCache(("a", "b")), 2)
+
+    def testOverloadCacheValues(self) -> None:
+        # a rejection by the values of a container is not cached for its type.
+        for _ in range(3):
+            self.assertEqual(embedding.overloadCacheValues([1.5]), 2)
+            self.assertEqual(embedding.overloadCacheValues([1]), 1)
+            self.assertEqual(embedding.overloadCacheValues((1.5, 2.5), 0), 4)
+            self.assertEqual(embedding.overloadCacheValues((1, 2), 0), 3)
+
+
+class TestThreading(unittest.TestCase):
+    """Only truly concurrent on free-threaded Python builds"""
+
+    NUM_THREADS = 4
+
+    def _run(self, target: Callable[[int], None]) -> None:
+        threads = [
+            threading.Thread(target=target, args=(i,)) for i in range(self.NUM_THREADS)
+        ]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+    def testSequence(self) -> None:
+        bar = embedding.Bar()
+        seq = bar.writeableVector
+        assert seq is not None
+        n = 1000
+
+        def worker(k: int) -> None:
+            for i in range(n):
+                seq.append(k * n + i)
+                seq[i % len(seq)]
+
+        self._run(worker)
+        self.assertEqual(len(seq), self.NUM_THREADS * n)
+        self.assertEqual(sorted(seq), list(range(self.NUM_THREADS * n)))
+
+    def testOverloadCache(self) -> None:
+        errors: list[str] = []
+
+        def worker(k: int) -> None:
+            for _ in range(1000):
+                if embedding.overloadCache((1, 2)) != 1:
+                    errors.append("int pair")
+                if embedding.overloadCache((1, 2, 3)) != 3:
+                    errors.append("vector")
+                if embedding.overloadCache(("a", "b")) != 2:
+                    errors.append("string pair")
+
+        self._run(worker)
+        self.assertEqual(errors, [])
+
+    def testGilPolicy(self) -> None:
+        self.assertFalse(embedding.isGilHeld())
+        self.assertTrue(embedding.isGilHeldWhenHolding())
+        self.assertEqual(embedding.callOverheadHoldGil(1, 2.5), 3)
+        seq = embedding.ClassSeq()
+        seq.append(1)
+        self.assertEqual(seq.size(), 1)
+
+
+class TestSubinterpreters(unittest.TestCase):
+    """Each subinterpreter gets its own module object and heap types"""
+
+    SCRIPT = """
+import embedding
+bar = embedding.Bar()
+bar["foo"] = "spam"
+assert bar["foo"] == "spam"
+assert embedding.spamToCppByPointer(embedding.Ham()).virtualWho() == "Ham"
+assert embedding.passColor(embedding.Color.RED) == embedding.Color.RED
+assert embedding.INTEGER_CONSTANT == 42
+assert embedding.INJECTED_STRING_CONSTANT == "spam and eggs"
+"""
+
+    def _runInSubinterpreter(self, script: str) -> None:
+        try:
+            import _interpreters as interpreters  # type: ignore[import-not-found]
+        except ImportError:
+            try:
+                import _xxsubinterpreters as interpreters  # type: ignore[import-not-found]
+            except ImportError:
+                self.skipTest("no low-level subinterpreter module")
+        if sys.version_info >= (3, 13):
+            interp = interpreters.create("legacy")
+        elif sys.version_info >= (3, 12):
+            interp = interpreters.create(isolated=False)
+        else:
+            interp = interpreters.create()
+        try:
+            excinfo = interpreters.run_string(interp, script)
+            self.assertIsNone(excinfo)
+        finally:
+            interpreters.destroy(interp)
+
+    def testImport(self) -> None:
+        self._runInSubinterpreter(self.SCRIPT)
+        # the main interpreter's module must be unaffected
+        self.assertEqual(embedding.Color.RED, embedding.passColor(embedding.Color.RED))
+        self.assertEqual(len(embedding.Bar()), 0)
+
+    def testRepeated(self) -> None:
+        for _ in range(3):
+            self._runInSubinterpreter(self.SCRIPT)
+
+    def testOwnGil(self) -> None:
+        """Interpreters with their own GIL import the module concurrently"""
+        if sys.version_info < (3, 13):
+            self.skipTest("isolated subinterpreters need Python 3.13 or later")
+        import _interpreters as interpreters  # type: ignore[import-not-found]
+
+        results: list[Any] = [None] * 4
+
+        def run(index: int) -> None:
+            interp = interpreters.create("isolated")
+            try:
+                results[index] = interpreters.run_string(interp, self.SCRIPT)
+            finally:
+                interpreters.destroy(interp)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for excinfo in results:
+            if excinfo is not None and "does not support loading in subinterpreters" in excinfo.msg:
+                self.skipTest("built without Lass_WITH_PYTHON_PER_INTERPRETER_GIL")
+            self.assertIsNone(excinfo)
+
 
 class TestSpecialFunctionsAndOperators(unittest.TestCase):
     def testSequenceProtocol(self) -> None:
@@ -863,6 +1119,42 @@ class TestShadowHierarchy(unittest.TestCase):
             assert_type(bacon3, embedding.Bacon)
         self.assertIsInstance(bacon3, embedding.Bacon)
 
+    def testShadowRegistry(self) -> None:
+        # Spam derives from IntrusiveShadowSlot, ClassSeq is found through the hash table.
+        before = _lass.shadowRegistryStats()
+        bacon = embedding.Bacon()
+        self.assertIs(embedding.spamToCppByPointer(bacon), bacon)
+        seq = embedding.ClassSeq()
+        stats = _lass.shadowRegistryStats()
+        self.assertEqual(stats["intrusiveSize"], before["intrusiveSize"] + 1)
+        self.assertGreater(stats["intrusiveHits"], before["intrusiveHits"])
+        self.assertEqual(stats["size"], before["size"] + 1)
+        self.assertGreaterEqual(stats["capacity"], 2 * stats["size"])
+        self.assertEqual(stats["shards"], 16)
+        del bacon, seq
+        stats = _lass.shadowRegistryStats()
+        self.assertEqual(stats["intrusiveSize"], before["intrusiveSize"])
+        self.assertEqual(stats["size"], before["size"])
+
+    def testCallStats(self) -> None:
+        _lass.resetCallStats()
+        stats = _lass.callStats()
+        self.assertEqual(set(stats), {"enabled", "shadowCreations", "functions"})
+        if not stats["enabled"]:
+            self.assertEqual(stats["shadowCreations"], 0)
+            self.assertEqual(stats["functions"], {})
+            return
+        self.assertNotIn("embedding.spamToCppByPointer", stats["functions"])
+        bacon = embedding.Bacon()
+        for _ in range(3):
+            embedding.spamToCppByPointer(bacon)
+        stats = _lass.callStats()
+        self.assertGreaterEqual(stats["shadowCreations"], 1)
+        s = stats["functions"]["embedding.spamToCppByPointer"]
+        self.assertEqual(s["calls"], 3)
+        self.assertGreaterEqual(s["conversionTime"], 0)
+        self.assertGreaterEqual(s["calleeTime"], 0)
+
     def testHam(self) -> None:
         ham = embedding.Ham()
         self.assertEqual(ham.virtualWho(), "Ham")
@@ -1896,6 +2188,16 @@ class TestNoNone(unittest.TestCase):
         with self.assertRaises(TypeError):
             embedding.testNoNoneRaw(raw, True)
 
+    def testRawIntrusiveShadowSlot(self) -> None:
+        raw = embedding.newRawSlot()
+        self.assertIs(embedding.sameRawSlot(raw), raw)
+        # the shadow outlives its shadowee, so it must not reach into it when it dies.
+        embedding.deleteRawSlot(raw)
+        del raw
+        raw = embedding.newRawSlot()
+        self.assertIs(embedding.sameRawSlot(raw), raw)
+        embedding.deleteRawSlot(raw)
+
 
 class TestRawPointer(unittest.TestCase):
     def testRawPyObject(self) -> None:
@@ -2069,6 +2371,73 @@ class TestIteratorRanges(unittest.TestCase):
     def testShadowedFreeIndexContainerConst(self) -> None:
         return self._testContainerConst(embedding.ShadowedFreeIndexContainer)
 
+    def testNextChunk(self) -> None:
+        it = iter(embedding.PointCloud(5))
+        self.assertEqual(it.__length_hint__(), 5)  # type: ignore[attr-defined]
+        self.assertEqual(next(it), (0, 0, 0))
+        self.assertEqual(it.nextChunk(2), [(1, 2, 3), (2, 4, 6)])  # type: ignore[attr-defined]
+        self.assertEqual(it.__length_hint__(), 2)  # type: ignore[attr-defined]
+        self.assertEqual(it.nextChunk(-1), [(3, 6, 9), (4, 8, 12)])  # type: ignore[attr-defined]
+        self.assertEqual(it.nextChunk(10), [])  # type: ignore[attr-defined]
+        self.assertEqual(list(it), [])
+        it = iter(embedding.PointCloud(2))
+        self.assertEqual(it.nextChunk(2**40), [(0, 0, 0), (1, 2, 3)])  # type: ignore[attr-defined]
+        self.assertEqual(list(embedding.PointCloud(300)), [(i, 2 * i, 3 * i) for i in range(300)])
+
+    def testNextChunkShadows(self) -> None:
+        items = (embedding.Eggs(0), embedding.Ham(), embedding.Eggs(2))
+        it = iter(embedding.IteratorContainer(items))
+        self.assertEqual(it.nextChunk(2), list(items[:2]))  # type: ignore[attr-defined]
+        self.assertEqual(it.nextChunk(-1), list(items[2:]))  # type: ignore[attr-defined]
+        with self.assertRaises(BufferError):
+            memoryview(it)  # type: ignore[arg-type]
+
+    def testBuffer(self) -> None:
+        cloud = embedding.PointCloud(4)
+        it = iter(cloud)
+        view = memoryview(it)  # type: ignore[arg-type]
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.shape, (4, 3))
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.tolist(), [[i, 2 * i, 3 * i] for i in range(4)])
+        del it, cloud
+        self.assertEqual(view[3, 2], 9)  # the view keeps the container alive
+        view.release()
+
+        it = iter(embedding.PointCloud(4))
+        next(it)
+        self.assertEqual(memoryview(it).shape, (3, 3))  # type: ignore[arg-type]
+        for _ in it:
+            pass
+        self.assertEqual(memoryview(it).shape, (0, 3))  # type: ignore[arg-type]
+
+    def testBufferOwner(self) -> None:
+        bar = embedding.Bar()
+        bar.writeableVector = [1.0, 2.0, 3.0]
+        seq = bar.writeableVector
+        assert seq is not None
+        it = iter(seq)
+        next(it)
+        view = memoryview(it)  # type: ignore[arg-type]
+        self.assertFalse(view.readonly)
+        self.assertEqual(view.tolist(), [2.0, 3.0])
+        view[0] = 5.0
+        self.assertEqual(seq[1], 5.0)
+        with self.assertRaises(BufferError):
+            seq.append(4.0)  # the view pins the sequence
+        view.release()
+        seq.append(4.0)
+        self.assertEqual(list(seq), [1.0, 5.0, 3.0, 4.0])
+
+        assert bar.constVector is not None
+        it = iter(bar.constVector)
+        with memoryview(it) as view:  # type: ignore[arg-type]
+            self.assertTrue(view.readonly)
+            with self.assertRaises(TypeError):
+                view[0] = 3.0
+        with self.assertRaises(TypeError):
+            ctypes.c_double.from_buffer(it)  # requests a writable buffer
+
     def _testContainer(self, constainerType: type[SpamContainer]) -> None:
         items = (embedding.Eggs(0), embedding.Ham(), embedding.Eggs(2))
         constContainer = constainerType.make(items)
@@ -0,0 +1,278 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *
+ *	The contents of this file are subject to the Common Public Attribution License
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with
+ *	the License. You may obtain a copy of the License at
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover
+ *	use of software over a computer network and provide for limited attribution for
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent
+ *	with Exhibit B.
+ *
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific
+ *	language governing rights and limitations under the License.
+ *
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the
+ *	GNU General Public License Version 2 or later (the GPL), in which case the
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow
+ *	others to use your version of this file under the CPAL, indicate your decision by
+ *	deleting the provisions above and replace them with the notice and other
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *
+ *	*** END LICENSE INFORMATION ***
+ */
+
+
+#include "test_common.h"
+#include "../lass/stde/lock_free_mpmc_ring_buffer.h"
+
+#include <thread>
+
+namespace
+{
+
+class Gizmo
+{
+public:
+	Gizmo() : index_(lass::num::NumTraits<size_t>::max)
+	{
+		++constructed_;
+	}
+	explicit Gizmo(size_t index) : index_(index)
+	{
+		++constructed_;
+	}
+	Gizmo(const Gizmo& other) : index_(other.index_)
+	{
+		++constructed_;
+	}
+	Gizmo(Gizmo&& other): index_(other.index_)
+	{
+		++constructed_;
+	}
+	Gizmo& operator=(const Gizmo&) = default;
+	Gizmo& operator=(Gizmo&&) = default;
+	~Gizmo()
+	{
+		++deconstructed_;
+	}
+	size_t index() const { return index_; }
+	static size_t constructed() { return constructed_; }
+	static size_t deconstructed() { return deconstructed_; }
+private:
+	size_t index_;
+	static std::atomic<size_t> constructed_;
+	static std::atomic<size_t> deconstructed_;
+};
+
+alignas(LASS_LOCK_FREE_ALIGNMENT) std::atomic<size_t> Gizmo::constructed_{ 0 };
+alignas(LASS_LOCK_FREE_ALIGNMENT) std::atomic<size_t> Gizmo::deconstructed_{ 0 };
+
+}
+
+namespace lass
+{
+namespace test
+{
+
+void testLockFreeMpmcRingBufferSingleThreaded()
+{
+	stde::lock_free_mpmc_ring_buffer<int> ring(5);
+	LASS_TEST_CHECK_EQUAL(ring.capacity(), size_t(8));
+	LASS_TEST_CHECK(ring.empty());
+
+	for (int i = 0; i < 8; ++i)
+	{
+		LASS_TEST_CHECK(ring.try_push(i));
+	}
+	LASS_TEST_CHECK(!ring.try_push(8));
+	LASS_TEST_CHECK(!ring.empty());
+
+	int x = -1;
+	LASS_TEST_CHECK(ring.try_pop(x));
+	LASS_TEST_CHECK_EQUAL(x, 0);
+
+	int out[8];
+	LASS_TEST_CHECK_EQUAL(ring.try_pop_n(out, 3), size_t(3));
+	LASS_TEST_CHECK_EQUAL(out[0], 1);
+	LASS_TEST_CHECK_EQUAL(out[2], 3);
+
+	// only four slots free, batch push is clipped.
+	const int in[6] = { 10, 11, 12, 13, 14, 15 };
+	LASS_TEST_CHECK_EQUAL(ring.try_push_n(in, 6), size_t(4));
+	LASS_TEST_CHECK_EQUAL(ring.try_push_n(in + 4, 2), size_t(0));
+
+	// wraps around the end of the ring.
+	LASS_TEST_CHECK_EQUAL(ring.try_pop_n(out, 8), size_t(8));
+	const int expected[8] = { 4, 5, 6, 7, 10, 11, 12, 13 };
+	for (size_t i = 0; i < 8; ++i)
+	{
+		LASS_TEST_CHECK_EQUAL(out[i], expected[i]);
+	}
+	LASS_TEST_CHECK(ring.empty());
+	LASS_TEST_CHECK(!ring.try_pop(x));
+	LASS_TEST_CHECK_EQUAL(ring.try_pop_n(out, 8), size_t(0));
+
+	LASS_TEST_CHECK_THROW(stde::lock_free_mpmc_ring_buffer<int>(0), std::length_error);
+}
+
+
+
+void testLockFreeMpmcRingBuffer()
+{
+	const size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+	const size_t p = numThreads / 2;
+	const size_t c = numThreads - p;
+	LASS_COUT << "#producers = " << p << ", #consumers = " << c << std::endl;
+	const size_t k = 16;
+	const size_t n = 400'000;
+	std::vector<std::atomic<int>> flag(n);
+	for (auto& f : flag)
+	{
+		f.store(0, std::memory_order_relaxed);
+	}
+
+	{
+		stde::lock_free_mpmc_ring_buffer<Gizmo> ring(k);
+		std::atomic<size_t> numPopped { 0 };
+
+		// half of the consumers pop in batches
+		auto consumer = [&ring, &flag, &numPopped, n](bool batched)
+		{
+			Gizmo gizmos[4];
+			while (numPopped.load(std::memory_order_acquire) < n)
+			{
+				const size_t m = batched ? ring.try_pop_n(gizmos, 4) : (ring.try_pop(gizmos[0]) ? 1 : 0);
+				if (m == 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				for (size_t i = 0; i < m; ++i)
+				{
+					++flag[gizmos[i].index()];
+				}
+				numPopped += m;
+			}
+		};
+
+		// producer j pushes indices j, j + p, j + 2p, ..., using all flavours of push.
+		auto producer = [&ring, n, p](size_t j)
+		{
+			size_t i = j;
+			while (i < n)
+			{
+				switch ((i / p) % 4)
+				{
+				case 0:
+					{
+						Gizmo gizmo(i);
+						while (!ring.try_push(gizmo))
+						{
+							std::this_thread::yield();
+						}
+						i += p;
+					}
+					break;
+				case 1:
+					while (!ring.try_push(Gizmo(i)))
+					{
+						std::this_thread::yield();
+					}
+					i += p;
+					break;
+				case 2:
+					while (!ring.try_emplace(i))
+					{
+						std::this_thread::yield();
+					}
+					i += p;
+					break;
+				case 3:
+					{
+						Gizmo gizmos[3];
+						size_t m = 0;
+						for (; m < 3 && i + m * p < n; ++m)
+						{
+							gizmos[m] = Gizmo(i + m * p);
+						}
+						size_t pushed = 0;
+						while (pushed < m)
+						{
+							const size_t q = ring.try_push_n(gizmos + pushed, m - pushed);
+							if (q == 0)
+							{
+								std::this_thread::yield();
+							}
+							pushed += q;
+						}
+						i += m * p;
+					}
+					break;
+				};
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t j = 0; j < c; ++j)
+		{
+			threads.emplace_back(consumer, j % 2 == 1);
+		}
+		for (size_t j = 0; j < p; ++j)
+		{
+			threads.emplace_back(producer, j);
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		LASS_TEST_CHECK(ring.empty());
+		LASS_TEST_CHECK_EQUAL(numPopped.load(), n);
+
+		// leave some in the ring, destructor must clean them up.
+		LASS_TEST_CHECK(ring.try_push(Gizmo(0)));
+		LASS_TEST_CHECK(ring.try_emplace(1));
+	}
+
+	LASS_TEST_CHECK_EQUAL(Gizmo::constructed(), Gizmo::deconstructed());
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		LASS_TEST_CHECK_EQUAL(flag[i].load(), 1);
+	}
+}
+
+
+
+TUnitTest test_stde_lock_free_mpmc_ring_buffer()
+{
+	return TUnitTest{
+		LASS_TEST_CASE(testLockFreeMpmcRingBufferSingleThreaded),
+		LASS_TEST_CASE(testLockFreeMpmcRingBuffer)
+	};
+}
+
+}
+
+}
+
+// EOF
@@ -0,0 +1,287 @@
+/**	@file
+ *	@author Bram de Greve (bram@cocamware.com)
+ *	@author Tom De Muer (tom@cocamware.com)
+ *
+ *	*** BEGIN LICENSE INFORMATION ***
+ *	
+ *	The contents of this file are subject to the Common Public Attribution License 
+ *	Version 1.0 (the "License"); you may not use this file except in compliance with 
+ *	the License. You may obtain a copy of the License at 
+ *	http://lass.sourceforge.net/cpal-license. The License is based on the 
+ *	Mozilla Public License Version 1.1 but Sections 14 and 15 have been added to cover 
+ *	use of software over a computer network and provide for limited attribution for 
+ *	the Original Developer. In addition, Exhibit A has been modified to be consistent 
+ *	with Exhibit B.
+ *	
+ *	Software distributed under the License is distributed on an "AS IS" basis, WITHOUT 
+ *	WARRANTY OF ANY KIND, either express or implied. See the License for the specific 
+ *	language governing rights and limitations under the License.
+ *	
+ *	The Original Code is LASS - Library of Assembled Shared Sources.
+ *	
+ *	The Initial Developer of the Original Code is Bram de Greve and Tom De Muer.
+ *	The Original Developer is the Initial Developer.
+ *	
+ *	All portions of the code written by the Initial Developer are:
+ *	Copyright (C) 2004-2026 the Initial Developer.
+ *	All Rights Reserved.
+ *	
+ *	Contributor(s):
+ *
+ *	Alternatively, the contents of this file may be used under the terms of the 
+ *	GNU General Public License Version 2 or later (the GPL), in which case the 
+ *	provisions of GPL are applicable instead of those above.  If you wish to allow use
+ *	of your version of this file only under the terms of the GPL and not to allow 
+ *	others to use your version of this file under the CPAL, indicate your decision by 
+ *	deleting the provisions above and replace them with the notice and other 
+ *	provisions required by the GPL License. If you do not delete the provisions above,
+ *	a recipient may use your version of this file under either the CPAL or the GPL.
+ *	
+ *	*** END LICENSE INFORMATION ***
+ */
+
+#include "test_common.h"
+
+#include "../lass/util/allocator.h"
+#include "../lass/util/heap_profiler.h"
+#include "../lass/util/stop_watch.h"
+#include "../lass/stde/monotonic_allocator.h"
+#include "../lass/stde/vector_map.h"
+
+#include <thread>
+
+namespace lass
+{
+namespace test
+{
+
+void testUtilAllocatorMonotonic()
+{
+	typedef util::AllocatorMonotonic<1024> TArena;
+
+	TArena arena;
+	LASS_TEST_CHECK_EQUAL(arena.capacity(), size_t(0));
+
+	// bump allocation, aligned and contiguous within a block.
+	char* a = static_cast<char*>(arena.allocate(10));
+	char* b = static_cast<char*>(arena.allocate(10));
+	LASS_TEST_CHECK(a != 0 && b != 0);
+	LASS_TEST_CHECK_EQUAL(reinterpret_cast<num::TuintPtr>(a) % TArena::alignment, num::TuintPtr(0));
+	LASS_TEST_CHECK_EQUAL(reinterpret_cast<num::TuintPtr>(b) % TArena::alignment, num::TuintPtr(0));
+	LASS_TEST_CHECK(b > a);
+	LASS_TEST_CHECK_EQUAL(arena.capacity(), size_t(1024));
+
+	// over-aligned allocation
+	void* c = arena.allocate(3, 64);
+	LASS_TEST_CHECK_EQUAL(reinterpret_cast<num::TuintPtr>(c) % 64, num::TuintPtr(0));
+
+	// last allocation can be given back
+	char* d = static_cast<char*>(arena.allocate(16, 1));
+	arena.deallocate(d, 16);
+	LASS_TEST_CHECK(static_cast<char*>(arena.allocate(16, 1)) == d);
+
+	// rewind
+	const TArena::Marker marker = arena.mark();
+	char* e = static_cast<char*>(arena.allocate(100));
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100); // spills over in new blocks
+	}
+	const size_t capacity = arena.capacity();
+	LASS_TEST_CHECK(capacity > 1024);
+	arena.rewind(marker);
+	LASS_TEST_CHECK(static_cast<char*>(arena.allocate(100)) == e);
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100); // must reuse the existing blocks
+	}
+	LASS_TEST_CHECK_EQUAL(arena.capacity(), capacity);
+
+	// oversized allocation gets a block on its own
+	void* big = arena.allocate(10000);
+	LASS_TEST_CHECK(big != 0);
+	std::fill_n(static_cast<char*>(big), 10000, 'x');
+
+	// reset
+	arena.reset();
+	LASS_TEST_CHECK(static_cast<char*>(arena.allocate(10)) == a);
+	arena.purge();
+	LASS_TEST_CHECK_EQUAL(arena.capacity(), size_t(1024));
+
+	// scoped rewind
+	void* f = arena.allocate(10);
+	{
+		TArena::ScopedRewind rewind(arena);
+		arena.allocate(500);
+		arena.allocate(5000);
+	}
+	void* g = arena.allocate(10);
+	LASS_TEST_CHECK(static_cast<char*>(g) == static_cast<char*>(f) + TArena::alignment);
+}
+
+void testStdeMonotonicAllocator()
+{
+	typedef util::AllocatorMonotonic<256> TArena;
+	TArena arena;
+
+	{
+		typedef std::vector<int, stde::monotonic_allocator<int, TArena> > TVector;
+		TVector vec{ stde::monotonic_allocator<int, TArena>(arena) };
+		for (int i = 0; i < 1000; ++i)
+		{
+			vec.push_back(i);
+		}
+		LASS_TEST_CHECK_EQUAL(vec.size(), size_t(1000));
+		for (int i = 0; i < 1000; ++i)
+		{
+			LASS_TEST_CHECK_EQUAL(vec[static_cast<size_t>(i)], i);
+		}
+		TVector copy = vec;
+		LASS_TEST_CHECK(copy == vec);
+		LASS_TEST_CHECK(copy.get_allocator() == vec.get_allocator());
+	}
+	arena.reset();
+
+	{
+		typedef std::pair<int, std::string> TValue;
+		typedef stde::monotonic_allocator<TValue, TArena> TAllocator;
+		typedef stde::vector_map<int, std::string, std::less<int>, TAllocator> TMap;
+		TMap map(std::less<int>{}, TAllocator(arena));
+		map[3] = "three";
+		map[1] = "one";
+		map[2] = "two";
+		LASS_TEST_CHECK_EQUAL(map.size(), size_t(3));
+		LASS_TEST_CHECK_EQUAL(map.begin()->second, std::string("one"));
+		LASS_TEST_CHECK_EQUAL(map.at(3), std::string("three"));
+	}
+
+	{
+		TArena other;
+		stde::monotonic_allocator<int, TArena> a(arena);
+		stde::monotonic_allocator<double, TArena> b(a);
+		stde::monotonic_allocator<int, TArena> c(other);
+		LASS_TEST_CHECK(a == b);
+		LASS_TEST_CHECK(a != c);
+	}
+}
+
+void testUtilAllocatorProfiled()
+{
+	typedef util::AllocatorProfiled<util::AllocatorMalloc> TAllocator;
+
+	{
+		// sample everything
+		TAllocator allocator;
+		allocator.profiler().setSampleRate(1);
+		std::vector<void*> blocks;
+		for (size_t i = 0; i < 100; ++i)
+		{
+			void* p = allocator.allocate(64);
+			LASS_TEST_CHECK_EQUAL(reinterpret_cast<num::TuintPtr>(p) % TAllocator::alignment, num::TuintPtr(0));
+			blocks.push_back(p);
+		}
+		for (size_t i = 0; i < 50; ++i)
+		{
+			allocator.deallocate(blocks[i], 64);
+		}
+
+		util::HeapProfiler::Snapshot snapshot = allocator.profiler().snapshot();
+		LASS_TEST_CHECK_EQUAL(snapshot.allocations, size_t(100));
+		LASS_TEST_CHECK_EQUAL(snapshot.deallocations, size_t(50));
+		LASS_TEST_CHECK_EQUAL(snapshot.liveBytes, size_t(50 * 64));
+		LASS_TEST_CHECK_EQUAL(snapshot.threads.size(), size_t(1));
+		LASS_TEST_CHECK_EQUAL(snapshot.threads[0].peakBytes, std::ptrdiff_t(100 * 64));
+		size_t liveBytes = 0, totalCount = 0;
+		for (const auto& site : snapshot.sites)
+		{
+			liveBytes += site.liveBytes;
+			totalCount += site.totalCount;
+		}
+		LASS_TEST_CHECK_EQUAL(liveBytes, size_t(50 * 64));
+		LASS_TEST_CHECK_EQUAL(totalCount, size_t(100));
+
+		std::ostringstream pprof;
+		snapshot.writePprof(pprof);
+		LASS_TEST_CHECK(pprof.str().find("heap profile: 50: 3200 [100: 6400] @ heapprofile") == 0);
+		std::ostringstream folded;
+		snapshot.writeFolded(folded);
+		std::ostringstream summary;
+		snapshot.writeSummary(summary, 3);
+		LASS_COUT << summary.str();
+
+		bool found = false;
+		for (const auto& s : util::HeapProfiler::snapshotAll())
+		{
+			found |= s.name == allocator.profiler().name();
+		}
+		LASS_TEST_CHECK(found);
+
+		for (size_t i = 50; i < 100; ++i)
+		{
+			allocator.deallocate(blocks[i], 64);
+		}
+		snapshot = allocator.profiler().snapshot();
+		LASS_TEST_CHECK_EQUAL(snapshot.liveBytes, size_t(0));
+		for (const auto& site : snapshot.sites)
+		{
+			LASS_TEST_CHECK_EQUAL(site.liveCount, size_t(0));
+		}
+	}
+
+	{
+		// per thread stats, and overhead of the default sample rate.
+		TAllocator allocator;
+		util::AllocatorMalloc reference;
+		const size_t n = 1000000;
+		auto work = [n](auto& a)
+		{
+			void* volatile p;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const size_t size = 16 + (i % 16) * 8;
+				p = a.allocate(size);
+				a.deallocate(p, size);
+			}
+		};
+		util::Clock clock;
+		util::StopWatch stopWatch(clock);
+		stopWatch.start();
+		work(reference);
+		const double timeReference = stopWatch.stop();
+		stopWatch.restart();
+		work(allocator);
+		const double timeProfiled = stopWatch.stop();
+		LASS_COUT << "malloc: " << timeReference << "s, profiled: " << timeProfiled << "s" << std::endl;
+		std::thread thread([&]() { work(allocator); });
+		thread.join();
+
+		const util::HeapProfiler::Snapshot snapshot = allocator.profiler().snapshot();
+		LASS_TEST_CHECK_EQUAL(snapshot.threads.size(), size_t(2));
+		LASS_TEST_CHECK_EQUAL(snapshot.allocations, 2 * n);
+		LASS_TEST_CHECK_EQUAL(snapshot.deallocations, 2 * n);
+		LASS_TEST_CHECK_EQUAL(snapshot.liveBytes, size_t(0));
+		LASS_TEST_CHECK(snapshot.peakBytes > 0);
+		size_t totalCount = 0;
+		for (const auto& site : snapshot.sites)
+		{
+			totalCount += site.totalCount;
+		}
+		// expect about 2 * n allocations, give or take sampling noise.
+		LASS_TEST_CHECK(totalCount > n && totalCount < 4 * n);
+	}
+}
+
+TUnitTest test_util_allocator()
+{
+	return TUnitTest({
+		LASS_TEST_CASE(testUtilAllocatorMonotonic),
+		LASS_TEST_CASE(testStdeMonotonicAllocator),
+		LASS_TEST_CASE(testUtilAllocatorProfiled),
+		});
+}
+
+}
+
+}
+
+// EOF
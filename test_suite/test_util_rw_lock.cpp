@@ -45,6 +45,7 @@
 #include "../lass/util/rw_lock.h"
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 namespace lass
 {
@@ -105,9 +106,88 @@ void testUtilRWLock()
 
 }
 
+void testUtilDistributedRWLock()
+{
+	const int numThreads = std::max<int>(std::min<int>(static_cast<int>(std::thread::hardware_concurrency()), 16), 4);
+	const int numWriters = std::max<int>(numThreads / 4, 1);
+	const int numReaders = numThreads - numWriters;
+
+	util::DistributedRWLock lock;
+	LASS_COUT << "#slots = " << lock.numberOfSlots() << std::endl;
+	LASS_TEST_CHECK(lock.numberOfSlots() >= 1);
+	LASS_TEST_CHECK((lock.numberOfSlots() & (lock.numberOfSlots() - 1)) == 0);
+
+	// try locks, single threaded
+	LASS_TEST_CHECK_EQUAL(lock.tryLockr(), util::lockSuccess);
+	LASS_TEST_CHECK_EQUAL(lock.tryLockr(), util::lockSuccess);
+	LASS_TEST_CHECK_EQUAL(lock.tryLockw(), util::lockBusy);
+	lock.unlockr();
+	lock.unlockr();
+	LASS_TEST_CHECK_EQUAL(lock.tryLockw(), util::lockSuccess);
+	LASS_TEST_CHECK_EQUAL(lock.tryLockr(), util::lockBusy);
+	LASS_TEST_CHECK_EQUAL(lock.tryLockw(), util::lockBusy);
+	lock.unlockw();
+
+	// writers keep a and b equal under write lock, readers must never see them differ.
+	int a = 0;
+	int b = 0;
+	std::atomic<int> activeReaders(0);
+	std::atomic<int> errors(0);
+	const int numWrites = 2000;
+	const int numReads = 20000;
+
+	auto writer = [&]()
+	{
+		for (int i = 0; i < numWrites; ++i)
+		{
+			lock.lockw();
+			if (activeReaders.load() != 0)
+			{
+				++errors;
+			}
+			++a;
+			std::this_thread::yield();
+			++b;
+			lock.unlockw();
+		}
+	};
+	auto reader = [&]()
+	{
+		for (int i = 0; i < numReads; ++i)
+		{
+			lock.lockr();
+			++activeReaders;
+			if (a != b)
+			{
+				++errors;
+			}
+			--activeReaders;
+			lock.unlockr();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < numReaders; ++i)
+	{
+		workers.emplace_back(reader);
+		if (i < numWriters)
+			workers.emplace_back(writer);
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	LASS_TEST_CHECK_EQUAL(errors.load(), 0);
+	LASS_TEST_CHECK_EQUAL(a, numWriters * numWrites);
+	LASS_TEST_CHECK_EQUAL(b, numWriters * numWrites);
+}
+
 TUnitTest test_util_rw_lock()
 {
-	return TUnitTest(1, LASS_TEST_CASE(testUtilRWLock));
+	return TUnitTest({
+		LASS_TEST_CASE(testUtilRWLock),
+		LASS_TEST_CASE(testUtilDistributedRWLock),
+	});
 }
 
 }
@@ -43,6 +43,9 @@
 #include "test_common.h"
 
 #include "../lass/util/thread_fun.h"
+#include "../lass/util/processor_topology.h"
+
+#include <thread>
 
 namespace lass
 {
@@ -128,11 +131,114 @@ void testUtilThreadAffinity()
 	}
 }
 
+void testUtilProcessorTopology()
+{
+	const util::ProcessorTopology& topology = util::ProcessorTopology::instance();
+	const size_t n = topology.numberOfProcessors();
+	LASS_COUT << "packages: " << topology.numberOfPackages() << ", nodes: " << topology.numberOfNodes()
+		<< ", cores: " << topology.numberOfCores() << ", processors: " << n << "\n";
+
+	LASS_TEST_CHECK_EQUAL(n, util::numberOfProcessors());
+	LASS_TEST_CHECK(topology.numberOfPackages() >= 1);
+	LASS_TEST_CHECK(topology.numberOfNodes() >= 1);
+	LASS_TEST_CHECK(topology.numberOfCores() >= 1 && topology.numberOfCores() <= n);
+
+	// each processor is in exactly one package, node and core.
+	std::vector<size_t> processorsPerNode(topology.numberOfNodes(), 0);
+	for (size_t i = 0; i < n; ++i)
+	{
+		LASS_TEST_CHECK(topology.package(i) < topology.numberOfPackages());
+		LASS_TEST_CHECK(topology.node(i) < topology.numberOfNodes());
+		LASS_TEST_CHECK(topology.core(i) < topology.numberOfCores());
+		LASS_TEST_CHECK(topology.packageProcessors(topology.package(i))[i]);
+		LASS_TEST_CHECK(topology.nodeProcessors(topology.node(i))[i]);
+		LASS_TEST_CHECK(topology.smtSiblings(i)[i]);
+		++processorsPerNode[topology.node(i)];
+	}
+	for (size_t node = 0; node < topology.numberOfNodes(); ++node)
+	{
+		LASS_TEST_CHECK_EQUAL(processorsPerNode[node], static_cast<size_t>(std::count(
+			topology.nodeProcessors(node).begin(), topology.nodeProcessors(node).end(), true)));
+	}
+
+	for (const util::CacheInfo& cache : topology.caches())
+	{
+		LASS_COUT << "L" << cache.level << " cache: " << cache.size << " bytes, shared by " << cache.processors << "\n";
+		LASS_TEST_CHECK(cache.level >= 1);
+		LASS_TEST_CHECK_EQUAL(cache.processors.size(), n);
+	}
+
+	// placement order is a permutation of the available processors, with a processor of each core before any sibling.
+	const util::ProcessorTopology::TProcessors order = topology.placementOrder();
+	LASS_COUT << "placement order:";
+	for (size_t processor : order)
+	{
+		LASS_COUT << " " << processor;
+	}
+	LASS_COUT << "\n";
+	LASS_TEST_CHECK_EQUAL(order.size(), util::numberOfAvailableProcessors());
+	util::TCpuSet seen(n, false);
+	std::vector<bool> seenCore(topology.numberOfCores(), false);
+	bool inSiblings = false;
+	for (size_t processor : order)
+	{
+		LASS_TEST_CHECK(util::isAvailableProcessor(processor));
+		LASS_TEST_CHECK(!seen[processor]);
+		seen[processor] = true;
+		const size_t core = topology.core(processor);
+		if (seenCore[core])
+		{
+			inSiblings = true;
+		}
+		else
+		{
+			LASS_TEST_CHECK(!inSiblings);
+			seenCore[core] = true;
+		}
+	}
+
+	util::Thread::bindCurrent(order.front());
+	LASS_TEST_CHECK_EQUAL(util::ProcessorTopology::currentProcessor(), order.front());
+	LASS_TEST_CHECK_EQUAL(topology.currentNode(), topology.node(order.front()));
+	util::Thread::bindCurrent(util::Thread::anyProcessor);
+}
+
+void testUtilAllocatorPerNode()
+{
+	typedef util::AllocatorPerNode<util::AllocatorMalloc> TAllocator;
+	TAllocator allocator;
+	const util::ProcessorTopology& topology = util::ProcessorTopology::instance();
+	LASS_TEST_CHECK_EQUAL(allocator.numberOfNodes(), topology.numberOfNodes());
+
+	for (size_t node = 0; node < allocator.numberOfNodes(); ++node)
+	{
+		void* p = allocator.allocate(100, node);
+		LASS_TEST_CHECK(p != 0);
+		LASS_TEST_CHECK_EQUAL(reinterpret_cast<num::TuintPtr>(p) % TAllocator::alignment, num::TuintPtr(0));
+		LASS_TEST_CHECK_EQUAL(TAllocator::node(p), node);
+		allocator.deallocate(p, 100);
+	}
+
+	// allocate on the node the thread is bound to, deallocate in another thread.
+	const size_t processor = topology.placementOrder().back();
+	void* p = 0;
+	std::thread thread([&]()
+	{
+		util::Thread::bindCurrent(processor);
+		p = allocator.allocate(1000);
+	});
+	thread.join();
+	LASS_TEST_CHECK_EQUAL(TAllocator::node(p), topology.node(processor));
+	allocator.deallocate(p, 1000);
+}
+
 TUnitTest test_util_thread_affinity()
 {
 	TUnitTest result;
 	result.push_back(LASS_TEST_CASE(testUtilNumberOfProcessors));
 	result.push_back(LASS_TEST_CASE(testUtilThreadAffinity));
+	result.push_back(LASS_TEST_CASE(testUtilProcessorTopology));
+	result.push_back(LASS_TEST_CASE(testUtilAllocatorPerNode));
 	return result;
 }
 
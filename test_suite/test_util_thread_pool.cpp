@@ -104,10 +104,32 @@ void testUtilThreadPool()
 	thread_pool::test<Spinning, SelfParticipating>(0, 0);
 }
 
+void testUtilThreadPoolNodes()
+{
+	using namespace util;
+	typedef DefaultConsumer<util::Callback0> TConsumer;
+	typedef ThreadPool<Callback0, TConsumer, Signaled, SelfParticipating> TThreadPool;
+
+	std::fill(thread_pool::taskIsDone, thread_pool::taskIsDone + thread_pool::numberOfTasks, false);
+	thread_pool::counter = 0;
+
+	TThreadPool pool(4, TThreadPool::unlimitedNumberOfTasks, TConsumer(), "nodes");
+	LASS_TEST_CHECK_EQUAL(pool.numberOfNodes(), ProcessorTopology::instance().numberOfNodes());
+	for (size_t i = 0; i < thread_pool::numberOfTasks; ++i)
+	{
+		pool.addTask(util::bind(thread_pool::task, i), i % pool.numberOfNodes());
+	}
+	pool.completeAllTasks();
+
+	LASS_TEST_CHECK_EQUAL(thread_pool::counter, thread_pool::numberOfTasks);
+	LASS_TEST_CHECK_THROW(pool.addTask(util::bind(thread_pool::task, 0), pool.numberOfNodes()), util::Exception);
+}
+
 TUnitTest test_util_thread_pool()
 {
 	TUnitTest result;
 	result.push_back(LASS_TEST_CASE(testUtilThreadPool));
+	result.push_back(LASS_TEST_CASE(testUtilThreadPoolNodes));
 	return result;
 }
 